@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+// Defined in another translation unit so the compiler has to assume it reads the value
+void benchmarkEscape(const volatile char* pointer);
+#endif
+
+/**
+ * @brief Keep a value alive so the optimizer cannot drop the work producing it
+ */
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(_MSC_VER)
+    benchmarkEscape(&reinterpret_cast<const volatile char&>(value));
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/**
+ * @class BenchmarkRunner
+ * @brief Minimal calibrated microbenchmark loop
+ *
+ * Every benchmark runs in batches sized so one batch takes about a
+ * millisecond; batches repeat until the minimum time is reached. The reported
+ * p50/p99 are over per-batch averages, which keeps timer overhead out of the
+ * numbers while still showing outliers like page faults or scheduler hiccups.
+ */
+class BenchmarkRunner {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Result {
+        std::string name;
+        size_t entities = 0;          // Simulated entity count (0 = not entity dependent)
+        uint64_t iterations = 0;
+        double meanNs = 0.0;          // Per operation
+        double p50Ns = 0.0;
+        double p99Ns = 0.0;
+    };
+
+private:
+    std::chrono::milliseconds m_minTime;
+    std::string m_filter;
+    std::vector<Result> m_results;
+
+public:
+    explicit BenchmarkRunner(std::chrono::milliseconds minTime = std::chrono::milliseconds(500),
+                             std::string filter = "")
+        : m_minTime(minTime), m_filter(std::move(filter)) {}
+
+    /**
+     * @brief Time op() and record the result
+     * @param opsPerCall Operations one call performs (e.g. entities per batch read), for per-op numbers
+     * @param setup Optional untimed work run before every batch
+     */
+    void run(const std::string& name, size_t entities, const std::function<void()>& op,
+             size_t opsPerCall = 1, const std::function<void()>& setup = nullptr) {
+        if (!m_filter.empty() && name.find(m_filter) == std::string::npos) {
+            return;
+        }
+
+        // Warm up and calibrate the batch size to ~1 ms
+        size_t batch = 1;
+        for (;;) {
+            if (setup) setup();
+            auto start = Clock::now();
+            for (size_t i = 0; i < batch; ++i) op();
+            auto elapsed = Clock::now() - start;
+            if (elapsed >= std::chrono::milliseconds(1) || batch >= (size_t{1} << 24)) {
+                break;
+            }
+            batch *= 2;
+        }
+
+        std::vector<double> samples;
+        uint64_t iterations = 0;
+        Clock::duration total{};
+        auto deadline = Clock::now() + m_minTime;
+        do {
+            if (setup) setup();
+            auto start = Clock::now();
+            for (size_t i = 0; i < batch; ++i) op();
+            auto elapsed = Clock::now() - start;
+
+            total += elapsed;
+            iterations += batch;
+            samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / (batch * opsPerCall));
+        } while (Clock::now() < deadline);
+
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = name;
+        result.entities = entities;
+        result.iterations = iterations * opsPerCall;
+        result.meanNs = std::chrono::duration<double, std::nano>(total).count() / result.iterations;
+        result.p50Ns = samples[samples.size() / 2];
+        result.p99Ns = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)];
+        m_results.push_back(result);
+    }
+
+    const std::vector<Result>& getResults() const { return m_results; }
+};
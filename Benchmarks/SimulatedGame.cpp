@@ -0,0 +1,184 @@
+#include "SimulatedGame.h"
+#include "Benchmark.h"
+#include "GameLayouts.h"
+#include "GameState.h"
+#include "EntityManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    constexpr size_t PLAYER_SIZE = 0x100;
+    constexpr size_t MAP_SIZE = 0x100;
+    constexpr size_t SEASON_SIZE = 0x100;
+
+    template<typename Field>
+    void writeField(uint8_t* base, typename Field::Type value) {
+        std::memcpy(base + Field::offset, &value, sizeof(value));
+    }
+
+    template<typename Field>
+    typename Field::Type readField(const uint8_t* base) {
+        typename Field::Type value;
+        std::memcpy(&value, base + Field::offset, sizeof(value));
+        return value;
+    }
+
+    void writeText(uint8_t* destination, size_t capacity, const std::string& text) {
+        size_t length = std::min(text.size(), capacity - 1);
+        std::memcpy(destination, text.data(), length);
+        destination[length] = 0;
+    }
+
+    // Type ids as decoded by EntityManager::determineEntityType()
+    uint32_t pickType(float roll) {
+        if (roll < 0.70f) return 1;   // Monster
+        if (roll < 0.72f) return 2;   // Boss
+        if (roll < 0.92f) return 3;   // Item
+        if (roll < 0.97f) return 4;   // Chest
+        return 5;                     // Portal
+    }
+}
+
+#if defined(_MSC_VER)
+void benchmarkEscape(const volatile char*) {
+}
+#endif
+
+SimulatedGame::SimulatedGame(const Config& config) : m_config(config), m_random(config.seed) {
+    size_t listSize = m_config.entityCount * sizeof(uintptr_t);
+    m_arenaSize = PLAYER_SIZE + MAP_SIZE + SEASON_SIZE + listSize + m_config.entityCount * ENTITY_STRIDE;
+
+    m_arena = static_cast<uint8_t*>(VirtualAlloc(nullptr, m_arenaSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    if (!m_arena) {
+        throw std::runtime_error("Failed to allocate the simulated game arena");
+    }
+
+    m_player = m_arena;
+    m_map = m_player + PLAYER_SIZE;
+    m_season = m_map + MAP_SIZE;
+    m_entityList = reinterpret_cast<uintptr_t*>(m_season + SEASON_SIZE);
+    m_entities = reinterpret_cast<uint8_t*>(m_entityList) + listSize;
+
+    writePlayer();
+    writeMap();
+    writeSeason();
+    for (size_t i = 0; i < m_config.entityCount; ++i) {
+        spawnEntity(i);
+    }
+}
+
+SimulatedGame::~SimulatedGame() {
+    if (m_arena) {
+        VirtualFree(m_arena, 0, MEM_RELEASE);
+    }
+}
+
+void SimulatedGame::attach(GameState& gameState, EntityManager& entityManager) const {
+    gameState.setPlayerBaseAddress(getPlayerAddress());
+    gameState.setMapDataAddress(getMapAddress());
+    gameState.setSeasonDataAddress(getSeasonAddress());
+    entityManager.setEntityList(getEntityListAddress(), getEntityListSize());
+    entityManager.setUpdateRadius(m_config.worldSize);
+}
+
+void SimulatedGame::tick() {
+    std::uniform_real_distribution<float> step(-0.5f, 0.5f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    float half = m_config.worldSize * 0.5f;
+
+    for (size_t i = 0; i < m_config.entityCount; ++i) {
+        uint8_t* entity = m_entities + i * ENTITY_STRIDE;
+        uint32_t type = readField<EntityLayout::Type>(entity);
+        if (type != 1 && type != 2) {
+            continue;
+        }
+
+        float x = readField<EntityLayout::PositionX>(entity) + step(m_random);
+        float y = readField<EntityLayout::PositionY>(entity) + step(m_random);
+        writeField<EntityLayout::PositionX>(entity, std::max(-half, std::min(half, x)));
+        writeField<EntityLayout::PositionY>(entity, std::max(-half, std::min(half, y)));
+
+        if (unit(m_random) < 0.1f) {
+            float health = readField<EntityLayout::Health>(entity) - 5.0f;
+            writeField<EntityLayout::Health>(entity, std::max(0.0f, health));
+            writeField<EntityLayout::IsAlive>(entity, health > 0.0f);
+        }
+    }
+
+    // Replace a share of the entities; the slot keeps its address but gets a new id,
+    // like the game reusing a freed object
+    size_t replaced = static_cast<size_t>(m_config.entityCount * m_config.churnPerTick);
+    std::uniform_int_distribution<size_t> pick(0, m_config.entityCount - 1);
+    for (size_t i = 0; i < replaced; ++i) {
+        spawnEntity(pick(m_random));
+    }
+
+    // The player drifts around the centre
+    float px = readField<PlayerLayout::PositionX>(m_player) + step(m_random) * 0.2f;
+    writeField<PlayerLayout::PositionX>(m_player, px);
+}
+
+void SimulatedGame::writePlayer() {
+    writeField<PlayerLayout::PositionX>(m_player, 0.0f);
+    writeField<PlayerLayout::PositionY>(m_player, 0.0f);
+    writeField<PlayerLayout::PositionZ>(m_player, 0.0f);
+    writeField<PlayerLayout::Health>(m_player, 850.0f);
+    writeField<PlayerLayout::MaxHealth>(m_player, 1000.0f);
+    writeField<PlayerLayout::Mana>(m_player, 300.0f);
+    writeField<PlayerLayout::MaxMana>(m_player, 400.0f);
+    writeField<PlayerLayout::Level>(m_player, 60);
+    writeField<PlayerLayout::InCombat>(m_player, false);
+    writeField<PlayerLayout::IsDead>(m_player, false);
+    writeField<PlayerLayout::MovementSpeed>(m_player, 7.5f);
+    writeField<PlayerLayout::CharacterClass>(m_player, 2);
+}
+
+void SimulatedGame::writeMap() {
+    writeField<MapLayout::MapId>(m_map, 1042u);
+    writeField<MapLayout::Tier>(m_map, 9);
+    writeField<MapLayout::IsCompleted>(m_map, false);
+    writeField<MapLayout::CompletionPercent>(m_map, 0.35f);
+    writeField<MapLayout::HasBoss>(m_map, true);
+    writeField<MapLayout::BossDefeated>(m_map, false);
+    writeText(m_map + MapLayout::nameOffset, MapLayout::maxNameLength, "Simulated Glacial Abyss");
+}
+
+void SimulatedGame::writeSeason() {
+    writeField<SeasonLayout::SeasonLevel>(m_season, 12);
+    writeField<SeasonLayout::HasActiveEvent>(m_season, true);
+    writeField<SeasonLayout::EventId>(m_season, 7u);
+    writeText(m_season + SeasonLayout::seasonNameOffset, SeasonLayout::maxNameLength, "Simulated Season");
+    writeText(m_season + SeasonLayout::eventTypeOffset, SeasonLayout::maxNameLength, "Simulated Event");
+}
+
+void SimulatedGame::spawnEntity(size_t index) {
+    std::uniform_real_distribution<float> position(-m_config.worldSize * 0.5f, m_config.worldSize * 0.5f);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    uint8_t* entity = m_entities + index * ENTITY_STRIDE;
+    std::memset(entity, 0, ENTITY_STRIDE);
+
+    uint64_t id = m_nextId++;
+    uint32_t type = pickType(unit(m_random));
+    float maxHealth = type == 2 ? 5000.0f : 100.0f + 400.0f * unit(m_random);
+
+    writeField<EntityLayout::Id>(entity, id);
+    writeField<EntityLayout::Type>(entity, type);
+    writeField<EntityLayout::PositionX>(entity, position(m_random));
+    writeField<EntityLayout::PositionY>(entity, position(m_random));
+    writeField<EntityLayout::PositionZ>(entity, 0.0f);
+    writeField<EntityLayout::Health>(entity, maxHealth);
+    writeField<EntityLayout::MaxHealth>(entity, maxHealth);
+    writeField<EntityLayout::IsAlive>(entity, true);
+    writeField<EntityLayout::IsTargetable>(entity, type == 1 || type == 2);
+    writeField<EntityLayout::Level>(entity, 55 + static_cast<int>(unit(m_random) * 10));
+
+    char name[32];
+    snprintf(name, sizeof(name), "SimEntity_%llu", static_cast<unsigned long long>(id));
+    writeText(entity + EntityLayout::nameOffset, EntityLayout::maxNameLength, name);
+
+    m_entityList[index] = reinterpret_cast<uintptr_t>(entity);
+}
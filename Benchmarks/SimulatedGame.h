@@ -0,0 +1,84 @@
+#pragma once
+
+#include <Windows.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+class GameState;
+class EntityManager;
+
+/**
+ * @class SimulatedGame
+ * @brief In-process stand-in for the game's memory, laid out like GameLayouts.h
+ *
+ * Allocates one page-aligned arena in the benchmark process and writes player,
+ * map, season and entity structures at the offsets the readers expect, plus
+ * the flat entity pointer list. A Process attached to the benchmark's own id
+ * then reads it through ReadProcessMemory exactly like the live game, so
+ * syscall, batching and parsing costs are representative without attaching
+ * to anything.
+ *
+ * tick() advances the world: monsters wander and take damage, and a share of
+ * the entities despawn and are replaced with new ids so delta scanning sees
+ * realistic churn.
+ */
+class SimulatedGame {
+public:
+    struct Config {
+        size_t entityCount = 500;
+        float worldSize = 100.0f;          // Entities are spread over [-size/2, size/2]^2 around the player
+        float churnPerTick = 0.01f;        // Share of entities replaced by tick()
+        uint32_t seed = 1;
+    };
+
+    static constexpr size_t ENTITY_STRIDE = 0x100;   // Bytes per simulated entity object
+
+private:
+    Config m_config;
+    uint8_t* m_arena = nullptr;
+    size_t m_arenaSize = 0;
+
+    uint8_t* m_player = nullptr;
+    uint8_t* m_map = nullptr;
+    uint8_t* m_season = nullptr;
+    uint8_t* m_entities = nullptr;
+    uintptr_t* m_entityList = nullptr;
+
+    std::mt19937 m_random;
+    uint64_t m_nextId = 1;
+
+public:
+    explicit SimulatedGame(const Config& config);
+    ~SimulatedGame();
+
+    SimulatedGame(const SimulatedGame&) = delete;
+    SimulatedGame& operator=(const SimulatedGame&) = delete;
+
+    /**
+     * @brief Point the readers at the simulated structures
+     */
+    void attach(GameState& gameState, EntityManager& entityManager) const;
+
+    /**
+     * @brief Move monsters, apply damage and replace churnPerTick of the entities
+     */
+    void tick();
+
+    uintptr_t getPlayerAddress() const { return reinterpret_cast<uintptr_t>(m_player); }
+    uintptr_t getMapAddress() const { return reinterpret_cast<uintptr_t>(m_map); }
+    uintptr_t getSeasonAddress() const { return reinterpret_cast<uintptr_t>(m_season); }
+    uintptr_t getEntityListAddress() const { return reinterpret_cast<uintptr_t>(m_entityList); }
+    size_t getEntityListSize() const { return m_config.entityCount * sizeof(uintptr_t); }
+    uintptr_t getEntityAddress(size_t index) const {
+        return reinterpret_cast<uintptr_t>(m_entities + index * ENTITY_STRIDE);
+    }
+    size_t getEntityCount() const { return m_config.entityCount; }
+    const Config& getConfig() const { return m_config; }
+
+private:
+    void writePlayer();
+    void writeMap();
+    void writeSeason();
+    void spawnEntity(size_t index);
+};
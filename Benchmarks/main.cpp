@@ -0,0 +1,584 @@
+#include "Benchmark.h"
+#include "SimulatedGame.h"
+#include "Process.h"
+#include "Memory.h"
+#include "GameLayouts.h"
+#include "GameState.h"
+#include "EntityManager.h"
+#include "PathFinder.h"
+#include "ExplorationGrid.h"
+#include "LootFilter.h"
+#include "LootRoutePlanner.h"
+#include "TargetScorer.h"
+#include "AbilityScheduler.h"
+#include "WorldSnapshot.h"
+#include "SnapshotRecorder.h"
+#include "SnapshotReplay.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Options {
+        std::vector<size_t> entityCounts{100, 500, 1000, 2000};
+        std::chrono::milliseconds minTime{500};
+        std::string filter;
+        std::string csvFile;
+        std::string replayFile;
+        int snapshotIntervalMs = 16;
+    };
+
+    void printUsage() {
+        std::cout << "Usage: Benchmarks [options]\n"
+                  << "  --entities 100,500,1000   Simulated entity counts\n"
+                  << "  --min-time 500            Minimum time per benchmark (ms)\n"
+                  << "  --filter memory/          Only run benchmarks whose name contains this\n"
+                  << "  --csv results.csv         Also write the results as CSV\n"
+                  << "  --interval 16             Snapshot interval the read pass budget is sized against (ms)\n"
+                  << "  --replay bot.snap         Also replay a recording (performance.snapshotRecordFile)\n";
+    }
+
+    bool parseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+
+            if (arg == "--entities" && hasValue) {
+                options.entityCounts.clear();
+                std::stringstream list(argv[++i]);
+                std::string item;
+                while (std::getline(list, item, ',')) {
+                    options.entityCounts.push_back(std::stoul(item));
+                }
+            } else if (arg == "--min-time" && hasValue) {
+                options.minTime = std::chrono::milliseconds(std::atoi(argv[++i]));
+            } else if (arg == "--filter" && hasValue) {
+                options.filter = argv[++i];
+            } else if (arg == "--csv" && hasValue) {
+                options.csvFile = argv[++i];
+            } else if (arg == "--interval" && hasValue) {
+                options.snapshotIntervalMs = std::atoi(argv[++i]);
+            } else if (arg == "--replay" && hasValue) {
+                options.replayFile = argv[++i];
+            } else {
+                return false;
+            }
+        }
+        return !options.entityCounts.empty();
+    }
+
+    void runMemoryBenchmarks(BenchmarkRunner& runner, Memory& memory, SimulatedGame& game, bool firstWorld) {
+        size_t count = game.getEntityCount();
+
+        if (firstWorld) {
+            // Entity independent; only run once
+            runner.run("memory/read_float", 0, [&] {
+                doNotOptimize(memory.read<float>(game.getPlayerAddress() + PlayerLayout::Health::offset));
+            });
+            runner.run("memory/read_player_block", 0, [&] {
+                PlayerLayout::Block block;
+                doNotOptimize(block.read(&memory, game.getPlayerAddress()));
+            });
+            runner.run("memory/read_string", 0, [&] {
+                doNotOptimize(memory.readString(game.getMapAddress() + MapLayout::nameOffset, MapLayout::maxNameLength));
+            });
+        }
+
+        size_t next = 0;
+        runner.run("memory/read_entity_block", count, [&] {
+            EntityLayout::Block block;
+            doNotOptimize(block.read(&memory, game.getEntityAddress(next)));
+            next = (next + 1) % count;
+        });
+
+        std::vector<EntityLayout::HotBlock> blocks(count);
+        Memory::ReadBatch batch(&memory);
+        batch.reserve(count);
+        auto batchRead = [&] {
+            batch.clear();
+            for (size_t i = 0; i < count; ++i) {
+                blocks[i].queue(batch, game.getEntityAddress(i));
+            }
+            doNotOptimize(batch.execute());
+        };
+        runner.run("memory/batch_hot_blocks", count, batchRead, count);
+
+        memory.enablePageCache(true);
+        runner.run("memory/batch_hot_blocks_page_cache", count, [&] {
+            memory.advanceGeneration();
+            batchRead();
+        }, count);
+        memory.enablePageCache(false);
+    }
+
+    void runEntityBenchmarks(BenchmarkRunner& runner, Memory& memory, SimulatedGame& game,
+                             GameState& gameState, EntityManager& entities) {
+        size_t count = game.getEntityCount();
+
+        runner.run("sim/tick", count, [&] { game.tick(); });
+
+        runner.run("gamestate/update", count, [&] {
+            memory.advanceGeneration();
+            doNotOptimize(gameState.update());
+        });
+
+        // Includes sim/tick so the delta scan sees moving entities and churn
+        entities.setDeltaMode(true);
+        runner.run("entities/update_delta", count, [&] {
+            game.tick();
+            memory.advanceGeneration();
+            doNotOptimize(entities.update());
+        });
+
+        entities.setDeltaMode(false);
+        runner.run("entities/update_full", count, [&] {
+            game.tick();
+            memory.advanceGeneration();
+            doNotOptimize(entities.update());
+        });
+        entities.setDeltaMode(true);
+        entities.update();
+
+        // What the reader thread pays to publish the entity table in a snapshot
+        EntityStore copy;
+        runner.run("entities/copy_snapshot", count, [&] {
+            entities.copyEntities(copy);
+            doNotOptimize(copy.size());
+        });
+    }
+
+    void runSpatialBenchmarks(BenchmarkRunner& runner, SimulatedGame& game, const EntityManager& entities) {
+        size_t count = game.getEntityCount();
+
+        runner.run("spatial/any_enemy_25", count, [&] {
+            doNotOptimize(entities.anyOf(EntityManager::ENEMY_TYPES, 0.0f, 0.0f, 25.0f, EntityStore::FLAG_ALIVE));
+        });
+
+        runner.run("spatial/nearest_item", count, [&] {
+            doNotOptimize(entities.nearestOf(entityTypeBit(EntityType::ITEM), 0.0f, 0.0f));
+        });
+
+        runner.run("spatial/for_each_enemy_30", count, [&] {
+            size_t found = 0;
+            entities.forEachInRadius(0.0f, 0.0f, 30.0f, EntityManager::ENEMY_TYPES, [&](EntityView) {
+                ++found;
+                return true;
+            });
+            doNotOptimize(found);
+        });
+
+        runner.run("spatial/copy_targetable_enemies", count, [&] {
+            doNotOptimize(entities.getTargetableEnemies());
+        });
+    }
+
+    void runCombatBenchmarks(BenchmarkRunner& runner, SimulatedGame& game, const EntityManager& entities) {
+        size_t count = game.getEntityCount();
+        const EntityStore& store = entities.getStore();
+
+        TargetScorer scorer;
+        TargetScorer::Query query;
+        query.range = 40.0f;
+        query.typeMask = EntityManager::ENEMY_TYPES;
+        query.requiredFlags = EntityStore::FLAG_ALIVE | EntityStore::FLAG_TARGETABLE;
+        uint64_t current = 0;
+        runner.run("combat/best_target", count, [&] {
+            TargetScorer::Result best = scorer.findBest(store, query, current);
+            current = best.slot != EntityStore::INVALID_SLOT ? store.ids()[best.slot] : 0;
+            doNotOptimize(best.score);
+        });
+    }
+
+    // Entity independent; a 200x200 grid like NavigationSystem's default with
+    // scattered obstacles and a few long walls that force detours
+    void runPathfindingBenchmarks(BenchmarkRunner& runner) {
+        constexpr int32_t SIZE = 200;
+        PathFinder pathFinder(SIZE, SIZE);
+        std::mt19937 random(7);
+        std::uniform_int_distribution<int> percent(0, 99);
+        for (int32_t y = 0; y < SIZE; ++y) {
+            for (int32_t x = 0; x < SIZE; ++x) {
+                if (percent(random) < 20) pathFinder.setWalkable(x, y, false);
+            }
+        }
+        for (int32_t wall = 1; wall <= 4; ++wall) {
+            int32_t y = wall * SIZE / 5;
+            int32_t gap = wall % 2 == 0 ? 2 : SIZE - 3;
+            for (int32_t x = 0; x < SIZE; ++x) {
+                pathFinder.setWalkable(x, y, x == gap);
+            }
+        }
+
+        PathFinder::Cell start(1, 1);
+        PathFinder::Cell goal(SIZE - 2, SIZE - 2);
+        pathFinder.setWalkable(start.x, start.y, true);
+        pathFinder.setWalkable(goal.x, goal.y, true);
+
+        std::vector<PathFinder::Cell> path;
+        for (bool jumpPoints : {false, true}) {
+            std::string prefix = jumpPoints ? "path/jps_200_" : "path/astar_200_";
+            pathFinder.setJumpPointSearch(jumpPoints);
+            pathFinder.setMaxExpansions(0);
+
+            runner.run(prefix + "cross_map", 0, [&] {
+                doNotOptimize(pathFinder.findPath(start, goal, path));
+            });
+
+            runner.run(prefix + "short", 0, [&] {
+                doNotOptimize(pathFinder.findPath(PathFinder::Cell(100, 10), PathFinder::Cell(130, 30), path));
+            });
+
+            pathFinder.setMaxExpansions(2000);
+            runner.run(prefix + "budget_2000", 0, [&] {
+                doNotOptimize(pathFinder.findPath(start, goal, path));
+            });
+        }
+
+        // Repeated trips to the same destination from slightly different spots
+        pathFinder.setMaxExpansions(0);
+        pathFinder.setPathCache(64);
+        size_t trip = 0;
+        runner.run("path/jps_200_cached_cross_map", 0, [&] {
+            PathFinder::Cell from(start.x + static_cast<int32_t>(trip++ % 2), start.y);
+            doNotOptimize(pathFinder.findPath(from, goal, path));
+        });
+    }
+
+    // Entity independent; a 1000x1000 cell map with a winding explored trail
+    void runExplorationBenchmarks(BenchmarkRunner& runner) {
+        constexpr int32_t SIZE = 1000;
+        ExplorationGrid grid(SIZE, SIZE);
+        for (int32_t step = 0; step < 400; ++step) {
+            grid.markDisk(500 + static_cast<int32_t>(300 * std::sin(step * 0.05f)), 100 + step * 2, 10.0f);
+        }
+
+        int32_t probe = 0;
+        runner.run("explore/nearest_frontier_1000", 0, [&] {
+            ExplorationGrid::Cell cell;
+            doNotOptimize(grid.findNearestFrontier(500, 100 + (probe++ % 800), cell));
+        });
+
+        runner.run("explore/area_coverage_r10", 0, [&] {
+            doNotOptimize(grid.getDiskCoverage(500, 100 + (probe++ % 800), 10.0f));
+        });
+
+        ExplorationGrid scratch(SIZE, SIZE);
+        int32_t mark = 0;
+        runner.run("explore/mark_area_r5", 0, [&] {
+            doNotOptimize(scratch.markDisk((mark * 37) % SIZE, (mark * 11) % SIZE, 5.0f));
+            ++mark;
+        });
+
+        runner.run("explore/progress", 0, [&] {
+            doNotOptimize(grid.getProgress());
+        });
+    }
+
+    // Record ticks of the simulated world, then replay them into a second GameState/EntityManager
+    void runReplayBenchmarks(BenchmarkRunner& runner, Memory& memory, SimulatedGame& game,
+                             GameState& gameState, EntityManager& entities) {
+        constexpr const char* PATH = "benchmark_replay.snap";
+        constexpr uint64_t TICKS = 256;
+        size_t count = game.getEntityCount();
+
+        WorldSnapshot snapshot;
+        auto captureTick = [&] {
+            game.tick();
+            memory.advanceGeneration();
+            gameState.update();
+            entities.update();
+            ++snapshot.sequence;
+            snapshot.captureTime = std::chrono::steady_clock::now();
+            snapshot.complete = true;
+            snapshot.player = gameState.getPlayer();
+            snapshot.map = gameState.getCurrentMap();
+            snapshot.season = gameState.getSeason();
+            entities.copyEntities(snapshot.entities);
+        };
+
+        // Restarted every TICKS appends so the file stays small however long the benchmark runs
+        SnapshotRecorder recorder;
+        if (!recorder.open(PATH)) {
+            std::cerr << "Could not create " << PATH << ", skipping replay benchmarks\n";
+            return;
+        }
+        captureTick();
+        runner.run("replay/record_tick", count, [&] {
+            if (recorder.getStatistics().ticks >= TICKS) {
+                recorder.open(PATH);
+            }
+            doNotOptimize(recorder.append(snapshot));
+        });
+
+        recorder.open(PATH);
+        for (uint64_t tick = 0; tick < TICKS; ++tick) {
+            captureTick();
+            recorder.append(snapshot);
+        }
+        recorder.close();
+
+        SnapshotReplay replay;
+        if (replay.open(PATH)) {
+            GameState replayState(nullptr);
+            EntityManager replayEntities(nullptr, &replayState);
+            WorldSnapshot scratch;
+            runner.run("replay/apply_tick", count, [&] {
+                if (!replay.next(scratch, replayState, replayEntities)) {
+                    replay.rewind();
+                    replay.next(scratch, replayState, replayEntities);
+                }
+                doNotOptimize(replayEntities.getStore().size());
+            });
+            replay.close();
+        }
+        std::remove(PATH);
+    }
+
+    // A recording from the bot: every tick is applied and targets are picked, as fast as possible
+    void runRecordingBenchmark(BenchmarkRunner& runner, const std::string& path) {
+        SnapshotReplay replay;
+        if (!replay.open(path) || replay.getTickCount() == 0) {
+            std::cerr << "Could not replay " << path << "\n";
+            return;
+        }
+        if (replay.wasIndexRecovered()) {
+            std::cout << path << " was not closed cleanly, replaying " << replay.getTickCount() << " recovered ticks\n";
+        }
+
+        GameState gameState(nullptr);
+        EntityManager entities(nullptr, &gameState);
+        WorldSnapshot snapshot;
+        TargetScorer scorer;
+        TargetScorer::Query query;
+        query.typeMask = EntityManager::ENEMY_TYPES;
+        query.requiredFlags = EntityStore::FLAG_ALIVE | EntityStore::FLAG_TARGETABLE;
+
+        // Recorded duration, for the speed-up over real time
+        replay.read(0, snapshot);
+        auto firstCapture = snapshot.captureTime;
+        size_t entityTotal = 0;
+        for (size_t tick = 0; tick < replay.getTickCount(); ++tick) {
+            replay.read(tick, snapshot);
+            entityTotal += snapshot.entities.size();
+        }
+        double recordedSeconds = std::chrono::duration<double>(snapshot.captureTime - firstCapture).count();
+
+        runner.run("replay/recording_tick", entityTotal / replay.getTickCount(), [&] {
+            if (!replay.next(snapshot, gameState, entities)) {
+                replay.rewind();
+                replay.next(snapshot, gameState, entities);
+            }
+            const auto& player = gameState.getPlayer();
+            query.x = player.x;
+            query.y = player.y;
+            doNotOptimize(scorer.findBest(entities.getStore(), query).slot);
+            doNotOptimize(entities.nearestOf(entityTypeBit(EntityType::ITEM), player.x, player.y).has_value());
+        });
+
+        const auto& results = runner.getResults();
+        if (!results.empty() && results.back().name == "replay/recording_tick" && recordedSeconds > 0) {
+            double replaySeconds = results.back().meanNs * replay.getTickCount() / 1e9;
+            std::cout << "Replayed " << replay.getTickCount() << " ticks (" << recordedSeconds << " s recorded) in "
+                      << replaySeconds << " s, " << recordedSeconds / replaySeconds << "x real time\n";
+        }
+    }
+
+    // Entity independent; a rotation of eight abilities, one cast per simulated 50 ms tick
+    void runAbilityBenchmarks(BenchmarkRunner& runner) {
+        AbilityScheduler abilities;
+        for (int i = 0; i < 8; ++i) {
+            AbilityScheduler::Ability ability;
+            ability.name = "skill" + std::to_string(i);
+            ability.cooldown = 0.5f + 0.75f * i;
+            ability.range = i % 2 ? 0.0f : 20.0f;
+            ability.roles = i == 7 ? AbilityScheduler::ROLE_DEFENSIVE : AbilityScheduler::ROLE_OFFENSIVE;
+            ability.priority = i * 10;
+            abilities.add(ability);
+        }
+        AbilityScheduler::Context context;
+        context.mana = 100.0f;
+        context.targetDistance = 10.0f;
+        auto clock = AbilityScheduler::Clock::now();
+        runner.run("combat/select_ability", 0, [&] {
+            clock += std::chrono::milliseconds(50);
+            abilities.beginTick(clock);
+            AbilityScheduler::AbilityId id = abilities.select(AbilityScheduler::ROLE_OFFENSIVE, context);
+            if (id != AbilityScheduler::INVALID_ABILITY) {
+                abilities.markUsed(id);
+            }
+            doNotOptimize(id);
+        });
+    }
+
+    // Entity independent; a batch of ground items against the balanced preset plus custom rules
+    void runLootBenchmarks(BenchmarkRunner& runner) {
+        static const char* NAMES[] = {"Ember Shard", "Flame Elixir", "Fate Card", "Rusty Sword", "Frost Core",
+                                      "Netherrealm Key", "Hardened Leather Boots", "Glowing Gem"};
+        static const char* AFFIXES[] = {"+12% Critical Strike Chance", "+1 to All Skills", "+40 Max Life",
+                                        "+18% Cold Resistance", "+6% Movement Speed"};
+
+        LootFilter filter;
+        for (const char* name : {"Rusty Sword", "Broken Shield", "Torn Cloth"}) {
+            filter.addToBlacklist(name);
+        }
+        filter.setItemPriority("Fate Card", 200);
+        filter.setItemPriority("Netherrealm Key", 150);
+
+        LootFilter::FilterRule embers;
+        embers.name = "Embers";
+        embers.conditions = {LootFilter::Condition::nameContains("ember")};
+        embers.priority = 95;
+        filter.addRule(embers);
+
+        LootFilter::FilterRule skills;
+        skills.name = "Skill gear";
+        skills.conditions = {LootFilter::Condition::affixContains("all skills"),
+                             LootFilter::Condition::atLeast(LootFilter::Condition::Field::RARITY, 2)};
+        skills.priority = 70;
+        filter.addRule(skills);
+
+        std::mt19937 rng(7);
+        std::vector<LootFilter::ItemInfo> items(64);
+        for (size_t i = 0; i < items.size(); ++i) {
+            LootFilter::ItemInfo& item = items[i];
+            item.entityId = i + 1;
+            item.name = SymbolTable::global().intern(NAMES[rng() % 8]);
+            item.type = static_cast<LootFilter::ItemType>(rng() % 10);
+            item.rarity = static_cast<LootFilter::ItemRarity>(rng() % 6);
+            item.level = static_cast<int>(rng() % 80);
+            if (rng() % 2) {
+                item.affixes.push_back(SymbolTable::global().intern(AFFIXES[rng() % 5]));
+            }
+        }
+
+        runner.run("loot/filter_batch_64", 0, [&] {
+            doNotOptimize(filter.filterItems(items).size());
+        });
+
+        size_t next = 0;
+        runner.run("loot/should_loot_single", 0, [&] {
+            doNotOptimize(filter.shouldLootItem(items[next++ % items.size()]));
+        });
+
+        // Pickup routes over 24 scattered drops, open ground
+        std::uniform_real_distribution<float> offset(-40.0f, 40.0f);
+        std::vector<LootRoutePlanner::Stop> stops;
+        for (uint64_t id = 1; id <= 24; ++id) {
+            stops.push_back({id, offset(rng), offset(rng), static_cast<int>(rng() % 100)});
+        }
+        auto lineClear = [](float, float, float, float) { return true; };
+
+        LootRoutePlanner planner;
+        planner.setTimeBudget(std::chrono::microseconds(2000));
+        runner.run("loot/route_plan_24", 0, [&] {
+            planner.clear();
+            doNotOptimize(planner.plan(0, 0, stops, lineClear).size());
+        });
+
+        // Steady state: one item picked up and one new drop per plan
+        uint64_t nextId = 25;
+        runner.run("loot/route_replan_24", 0, [&] {
+            stops.erase(stops.begin());
+            stops.push_back({nextId++, offset(rng), offset(rng), static_cast<int>(rng() % 100)});
+            doNotOptimize(planner.plan(0, 0, stops, lineClear).size());
+        });
+    }
+
+    void printResults(const std::vector<BenchmarkRunner::Result>& results) {
+        std::printf("\n%-38s %9s %12s %12s %12s %14s\n", "Benchmark", "Entities", "Mean (ns)", "p50 (ns)", "p99 (ns)", "Ops");
+        std::printf("%s\n", std::string(102, '-').c_str());
+        for (const auto& result : results) {
+            std::printf("%-38s %9zu %12.1f %12.1f %12.1f %14llu\n", result.name.c_str(), result.entities,
+                        result.meanNs, result.p50Ns, result.p99Ns, static_cast<unsigned long long>(result.iterations));
+        }
+    }
+
+    // How much of the snapshot interval one read pass takes at each entity count
+    void printBudget(const std::vector<BenchmarkRunner::Result>& results, int intervalMs) {
+        std::printf("\nRead pass budget (%d ms snapshot interval)\n", intervalMs);
+        for (const auto& result : results) {
+            if (result.name != "entities/update_delta") {
+                continue;
+            }
+            double passMs = result.p99Ns / 1e6;
+            std::printf("  %6zu entities: p99 %.3f ms per pass, %.1f%% of the interval\n",
+                        result.entities, passMs, passMs * 100.0 / intervalMs);
+        }
+    }
+
+    bool writeCsv(const std::string& path, const std::vector<BenchmarkRunner::Result>& results) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << "benchmark,entities,iterations,mean_ns,p50_ns,p99_ns\n";
+        for (const auto& result : results) {
+            file << result.name << "," << result.entities << "," << result.iterations << ","
+                 << result.meanNs << "," << result.p50Ns << "," << result.p99Ns << "\n";
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    // The simulated game lives in this process; reads still go through ReadProcessMemory
+    Process process;
+    if (!process.attachToProcessId(GetCurrentProcessId())) {
+        std::cerr << "Failed to open the benchmark process for reading\n";
+        return 1;
+    }
+
+    BenchmarkRunner runner(options.minTime, options.filter);
+
+    for (size_t entityCount : options.entityCounts) {
+        SimulatedGame::Config config;
+        config.entityCount = entityCount;
+        SimulatedGame game(config);
+
+        Memory memory(&process);
+        memory.refreshRegionMap();
+
+        GameState gameState(&memory);
+        EntityManager entities(&memory, &gameState);
+        game.attach(gameState, entities);
+        gameState.update();
+        entities.update();
+
+        std::cout << "Running with " << entityCount << " entities...\n";
+        runMemoryBenchmarks(runner, memory, game, entityCount == options.entityCounts.front());
+        runEntityBenchmarks(runner, memory, game, gameState, entities);
+        runSpatialBenchmarks(runner, game, entities);
+        runCombatBenchmarks(runner, game, entities);
+        runReplayBenchmarks(runner, memory, game, gameState, entities);
+    }
+
+    runPathfindingBenchmarks(runner);
+    runExplorationBenchmarks(runner);
+    runLootBenchmarks(runner);
+    runAbilityBenchmarks(runner);
+    if (!options.replayFile.empty()) {
+        runRecordingBenchmark(runner, options.replayFile);
+    }
+
+    printResults(runner.getResults());
+    printBudget(runner.getResults(), options.snapshotIntervalMs);
+
+    if (!options.csvFile.empty() && !writeCsv(options.csvFile, runner.getResults())) {
+        std::cerr << "Could not write " << options.csvFile << "\n";
+        return 1;
+    }
+
+    return 0;
+}
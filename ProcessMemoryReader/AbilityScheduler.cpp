@@ -0,0 +1,148 @@
+#include "AbilityScheduler.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    unsigned countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+    }
+
+    // Heap comparator: the earliest readyAt on top
+    struct LaterReady {
+        template<typename Entry>
+        bool operator()(const Entry& a, const Entry& b) const { return a.readyAt > b.readyAt; }
+    };
+}
+
+AbilityScheduler::AbilityId AbilityScheduler::add(const Ability& ability) {
+    if (m_abilities.size() >= MAX_ABILITIES || m_byName.count(ability.name)) {
+        return INVALID_ABILITY;
+    }
+
+    AbilityId id = static_cast<AbilityId>(m_abilities.size());
+    m_abilities.push_back(ability);
+    m_byName.emplace(ability.name, id);
+    m_readyAt.push_back(m_now);
+    rebuildRanks();
+    return id;
+}
+
+void AbilityScheduler::clear() {
+    m_abilities.clear();
+    m_byName.clear();
+    m_readyAt.clear();
+    m_rank.clear();
+    m_byRank.clear();
+    m_cooling.clear();
+    m_ready = 0;
+    std::fill(std::begin(m_roleMasks), std::end(m_roleMasks), 0);
+}
+
+void AbilityScheduler::rebuildRanks() {
+    m_byRank.resize(m_abilities.size());
+    for (AbilityId id = 0; id < m_abilities.size(); ++id) {
+        m_byRank[id] = id;
+    }
+    std::stable_sort(m_byRank.begin(), m_byRank.end(), [this](AbilityId a, AbilityId b) {
+        return m_abilities[a].priority > m_abilities[b].priority;
+    });
+
+    m_rank.resize(m_abilities.size());
+    m_ready = 0;
+    std::fill(std::begin(m_roleMasks), std::end(m_roleMasks), 0);
+    for (size_t rank = 0; rank < m_byRank.size(); ++rank) {
+        AbilityId id = m_byRank[rank];
+        uint64_t bit = uint64_t(1) << rank;
+        m_rank[id] = static_cast<uint8_t>(rank);
+        if (m_readyAt[id] <= m_now) {
+            m_ready |= bit;
+        }
+        for (int role = 0; role < 3; ++role) {
+            if (m_abilities[id].roles & (1u << role)) {
+                m_roleMasks[role] |= bit;
+            }
+        }
+    }
+}
+
+void AbilityScheduler::beginTick(Clock::time_point now) {
+    m_now = now;
+    while (!m_cooling.empty() && m_cooling.front().readyAt <= now) {
+        Cooling entry = m_cooling.front();
+        std::pop_heap(m_cooling.begin(), m_cooling.end(), LaterReady());
+        m_cooling.pop_back();
+
+        // An ability used again before it was ready leaves a stale entry behind
+        if (m_readyAt[entry.id] == entry.readyAt) {
+            m_ready |= uint64_t(1) << m_rank[entry.id];
+        }
+    }
+}
+
+void AbilityScheduler::markUsed(AbilityId id) {
+    if (id >= m_abilities.size()) {
+        return;
+    }
+
+    auto cooldown = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(m_abilities[id].cooldown));
+    if (cooldown <= Clock::duration::zero()) {
+        return;
+    }
+
+    m_readyAt[id] = m_now + cooldown;
+    m_ready &= ~(uint64_t(1) << m_rank[id]);
+    m_cooling.push_back({m_readyAt[id], id});
+    std::push_heap(m_cooling.begin(), m_cooling.end(), LaterReady());
+}
+
+AbilityScheduler::AbilityId AbilityScheduler::select(uint8_t roles, const Context& context) const {
+    uint64_t candidates = 0;
+    for (int role = 0; role < 3; ++role) {
+        if (roles & (1u << role)) {
+            candidates |= m_roleMasks[role];
+        }
+    }
+    candidates &= m_ready;
+
+    // Lowest bit = highest priority
+    while (candidates) {
+        AbilityId id = m_byRank[countTrailingZeros(candidates)];
+        candidates &= candidates - 1;
+
+        const Ability& ability = m_abilities[id];
+        if (ability.manaCost > context.mana || context.healthFraction > ability.maxHealthFraction) {
+            continue;
+        }
+        if (ability.range > 0 && context.targetDistance > ability.range) {
+            continue;
+        }
+        return id;
+    }
+    return INVALID_ABILITY;
+}
+
+float AbilityScheduler::getRemainingCooldown(AbilityId id) const {
+    if (id >= m_abilities.size() || isReady(id)) {
+        return 0.0f;
+    }
+    return std::max(0.0f, std::chrono::duration<float>(m_readyAt[id] - m_now).count());
+}
+
+AbilityScheduler::Clock::time_point AbilityScheduler::nextReadyTime() const {
+    return m_cooling.empty() ? Clock::time_point::max() : m_cooling.front().readyAt;
+}
+
+AbilityScheduler::AbilityId AbilityScheduler::find(const std::string& name) const {
+    auto it = m_byName.find(name);
+    return it != m_byName.end() ? it->second : INVALID_ABILITY;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class AbilityScheduler
+ * @brief Ability cooldowns against a clock read once per tick
+ *
+ * Abilities that are off cooldown form a 64-bit ready mask whose bit order is
+ * the priority order, so a readiness check is one bit test and picking the
+ * best ability walks only the set bits. Abilities on cooldown wait in a
+ * min-heap ordered by the time they become ready; beginTick() pops the ones
+ * whose cooldown has expired, so no tick looks at abilities still cooling.
+ */
+class AbilityScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using AbilityId = uint32_t;   // Registration order, stable
+
+    static constexpr AbilityId INVALID_ABILITY = 0xFFFFFFFFu;
+    static constexpr size_t MAX_ABILITIES = 64;
+
+    enum Role : uint8_t {
+        ROLE_OFFENSIVE = 1,
+        ROLE_DEFENSIVE = 2,
+        ROLE_MOVEMENT = 4
+    };
+
+    struct Ability {
+        std::string name;
+        int keyBinding = 0;              // Virtual key code
+        float cooldown = 0.0f;           // Cooldown in seconds
+        float range = 0.0f;              // Ability range (0 = self cast)
+        float manaCost = 0.0f;
+        uint8_t roles = 0;               // Role bits
+        int priority = 0;                // Usage priority (higher = more important)
+        float maxHealthFraction = 1.0f;  // Only used at or below this health (1 = always)
+    };
+
+    // Caster state for select()
+    struct Context {
+        float mana = std::numeric_limits<float>::infinity();
+        float healthFraction = 1.0f;
+        float targetDistance = 0.0f;
+    };
+
+private:
+    struct Cooling {
+        Clock::time_point readyAt;
+        AbilityId id;
+    };
+
+    std::vector<Ability> m_abilities;
+    std::unordered_map<std::string, AbilityId> m_byName;
+    std::vector<Clock::time_point> m_readyAt;
+    std::vector<uint8_t> m_rank;                 // Bit of each ability in the masks
+    std::vector<AbilityId> m_byRank;             // Highest priority first
+    std::vector<Cooling> m_cooling;              // Min-heap on readyAt
+
+    uint64_t m_ready = 0;
+    uint64_t m_roleMasks[3] = {0, 0, 0};         // By role bit
+    Clock::time_point m_now = Clock::now();
+
+public:
+    /**
+     * @brief Add an ability, ready immediately
+     * @return Its id, or INVALID_ABILITY when the name is taken or MAX_ABILITIES is reached
+     */
+    AbilityId add(const Ability& ability);
+    void clear();
+
+    /**
+     * @brief Cache the tick's time and release abilities whose cooldown expired
+     */
+    void beginTick(Clock::time_point now);
+    Clock::time_point now() const { return m_now; }
+
+    bool isReady(AbilityId id) const { return id < m_rank.size() && ((m_ready >> m_rank[id]) & 1) != 0; }
+
+    /**
+     * @brief Start the cooldown at the cached time
+     */
+    void markUsed(AbilityId id);
+
+    /**
+     * @brief Highest-priority ready ability with one of the roles that the context allows
+     * @return INVALID_ABILITY if none
+     */
+    AbilityId select(uint8_t roles, const Context& context) const;
+
+    float getRemainingCooldown(AbilityId id) const;   // Seconds, 0 when ready
+    Clock::time_point nextReadyTime() const;          // Clock::time_point::max() when none is cooling
+
+    AbilityId find(const std::string& name) const;
+    const Ability* get(AbilityId id) const { return id < m_abilities.size() ? &m_abilities[id] : nullptr; }
+    size_t size() const { return m_abilities.size(); }
+    uint64_t readyMask() const { return m_ready; }
+
+private:
+    void rebuildRanks();
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+/**
+ * Small helpers for the bot's binary cache files
+ * Values are written in native (little-endian x64) layout; files are
+ * machine-local caches, not an exchange format.
+ */
+namespace BinaryIO {
+    template<typename T>
+    void write(std::ostream& stream, const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Type must be trivially copyable");
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool read(std::istream& stream, T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Type must be trivially copyable");
+        return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    // Strings are stored as a 16-bit length followed by the characters
+    inline void writeString(std::ostream& stream, const std::string& value) {
+        uint16_t length = static_cast<uint16_t>(value.size() < 0xFFFF ? value.size() : 0xFFFF);
+        write(stream, length);
+        stream.write(value.data(), length);
+    }
+
+    inline bool readString(std::istream& stream, std::string& value) {
+        uint16_t length = 0;
+        if (!read(stream, length)) {
+            return false;
+        }
+        value.resize(length);
+        return length == 0 || static_cast<bool>(stream.read(&value[0], length));
+    }
+
+    // Bytes left between the read position and the end of the stream (0 if it cannot be told)
+    inline uint64_t remaining(std::istream& stream) {
+        std::streampos position = stream.tellg();
+        if (position < 0 || !stream.seekg(0, std::ios::end)) {
+            stream.clear();
+            return 0;
+        }
+        std::streampos end = stream.tellg();
+        stream.seekg(position);
+        return end > position ? static_cast<uint64_t>(end - position) : 0;
+    }
+
+    // FNV-1a, used to detect edited signatures in cached entries
+    constexpr uint32_t hash(const char* text) {
+        uint32_t value = 2166136261u;
+        for (; *text; ++text) {
+            value = (value ^ static_cast<uint8_t>(*text)) * 16777619u;
+        }
+        return value;
+    }
+}
@@ -0,0 +1,191 @@
+#include "CombatSystem.h"
+#include "GameState.h"
+#include "EntityManager.h"
+#include "InputManager.h"
+#include "NavigationSystem.h"
+#include <algorithm>
+#include <cmath>
+
+CombatSystem::CombatSystem(const GameState* gameState, const EntityManager* entityManager,
+                           InputManager* inputManager, NavigationSystem* navigation)
+    : m_gameState(gameState), m_entityManager(entityManager), m_inputManager(inputManager),
+      m_navigation(navigation) {
+    m_now = std::chrono::steady_clock::now();
+    m_combatStartTime = m_now;
+    m_lastAbilityUse = m_now;
+    m_lastTargetSwitch = m_now;
+}
+
+// ============ CORE ============
+
+void CombatSystem::update() {
+    // Every cooldown check this tick uses the same time; expired cooldowns become ready again here
+    m_now = std::chrono::steady_clock::now();
+    m_abilities.beginTick(m_now);
+}
+
+// ============ TARGETING ============
+
+bool CombatSystem::selectTarget() {
+    TargetScorer::Result best = findBestTarget();
+    if (best.slot == EntityStore::INVALID_SLOT) {
+        clearTarget();
+        return false;
+    }
+
+    uint64_t id = m_entityManager->getStore().ids()[best.slot];
+    if (id != m_primaryTarget) {
+        m_lastTarget = m_primaryTarget;
+        m_primaryTarget = id;
+        m_lastTargetSwitch = m_now;
+    }
+    return true;
+}
+
+bool CombatSystem::hasValidTarget() const {
+    if (m_primaryTarget == 0) {
+        return false;
+    }
+    const EntityStore& store = m_entityManager->getStore();
+    EntityStore::Slot slot = store.find(m_primaryTarget);
+    return slot != EntityStore::INVALID_SLOT &&
+           store.hasFlags(slot, EntityStore::FLAG_ALIVE | EntityStore::FLAG_TARGETABLE);
+}
+
+void CombatSystem::onEntityEvents(const EntityEvents& events) {
+    for (const EntityEvent& event : events.despawned) {
+        if (event.id == m_primaryTarget) {
+            m_lastTarget = m_primaryTarget;
+            clearTarget();
+        }
+        m_targets.erase(std::remove_if(m_targets.begin(), m_targets.end(),
+                                       [&](const CombatTarget& target) { return target.entityId == event.id; }),
+                        m_targets.end());
+    }
+
+    if (events.spawned.empty()) {
+        return;
+    }
+
+    // Score only the newcomers; the full sweep runs on the next selectTarget()
+    const EntityStore& store = m_entityManager->getStore();
+    TargetScorer::Query query = targetQuery();
+    for (const EntityEvent& event : events.spawned) {
+        if ((entityTypeBit(event.type) & query.typeMask) == 0) {
+            continue;
+        }
+        EntityStore::Slot slot = store.find(event.id);
+        if (slot == EntityStore::INVALID_SLOT) {
+            continue;
+        }
+        float priority = m_targetScorer.score(store, slot, query);
+        if (std::isfinite(priority)) {
+            m_targets.push_back({event.id, priority, 0.0f, 0.0f, false});
+        }
+    }
+}
+
+TargetScorer::Query CombatSystem::targetQuery() const {
+    const GameState::PlayerData& player = m_gameState->getPlayer();
+
+    TargetScorer::Query query;
+    query.x = player.x;
+    query.y = player.y;
+    query.range = m_engagementRange;
+    query.typeMask = m_tactics == TacticsMode::BOSS_ONLY ? entityTypeBit(EntityType::BOSS)
+                                                          : EntityManager::ENEMY_TYPES;
+    query.requiredFlags = EntityStore::FLAG_ALIVE | EntityStore::FLAG_TARGETABLE;
+    return query;
+}
+
+EntityRange CombatSystem::getValidTargets() const {
+    TargetScorer::Query query = targetQuery();
+    return m_entityManager->entitiesOfType(query.typeMask, query.requiredFlags);
+}
+
+TargetScorer::Result CombatSystem::findBestTarget() const {
+    return m_targetScorer.findBest(m_entityManager->getStore(), targetQuery(), m_primaryTarget);
+}
+
+// ============ ABILITIES ============
+
+void CombatSystem::registerAbility(const AbilityInfo& ability) {
+    m_abilities.add(ability);
+}
+
+bool CombatSystem::useAbility(const std::string& abilityName) {
+    AbilityId id = m_abilities.find(abilityName);
+    return id != AbilityScheduler::INVALID_ABILITY && m_abilities.isReady(id) && castAbility(id);
+}
+
+bool CombatSystem::useBestOffensiveAbility() {
+    AbilityId id = selectBestAbility(AbilityScheduler::ROLE_OFFENSIVE);
+    return id != AbilityScheduler::INVALID_ABILITY && castAbility(id);
+}
+
+bool CombatSystem::useBestDefensiveAbility() {
+    AbilityId id = selectBestAbility(AbilityScheduler::ROLE_DEFENSIVE);
+    return id != AbilityScheduler::INVALID_ABILITY && castAbility(id);
+}
+
+bool CombatSystem::useMovementAbility() {
+    AbilityId id = selectBestAbility(AbilityScheduler::ROLE_MOVEMENT);
+    return id != AbilityScheduler::INVALID_ABILITY && castAbility(id);
+}
+
+const CombatSystem::AbilityInfo* CombatSystem::getAbility(const std::string& name) const {
+    return m_abilities.get(m_abilities.find(name));
+}
+
+bool CombatSystem::isAbilityReady(const std::string& name) const {
+    AbilityId id = m_abilities.find(name);
+    return id != AbilityScheduler::INVALID_ABILITY && m_abilities.isReady(id);
+}
+
+AbilityScheduler::Context CombatSystem::abilityContext() const {
+    const GameState::PlayerData& player = m_gameState->getPlayer();
+
+    AbilityScheduler::Context context;
+    context.mana = player.mana;
+    context.healthFraction = player.maxHealth > 0 ? player.health / player.maxHealth : 0.0f;
+    context.targetDistance = getDistanceToTarget();
+    return context;
+}
+
+CombatSystem::AbilityId CombatSystem::selectBestAbility(uint8_t roles) const {
+    return m_abilities.select(roles, abilityContext());
+}
+
+bool CombatSystem::castAbility(AbilityId id) {
+    const AbilityInfo* ability = m_abilities.get(id);
+    if (!ability || !m_inputManager) {
+        return false;
+    }
+
+    const EntityStore& store = m_entityManager->getStore();
+    EntityStore::Slot slot = m_primaryTarget != 0 ? store.find(m_primaryTarget) : EntityStore::INVALID_SLOT;
+    if (ability->range > 0 && slot != EntityStore::INVALID_SLOT) {
+        m_inputManager->castAbilityAtTarget(ability->keyBinding, store.xs()[slot], store.ys()[slot]);
+    } else {
+        m_inputManager->useAbility(ability->keyBinding);
+    }
+
+    m_abilities.markUsed(id);
+    m_lastAbilityUse = m_abilities.now();
+    return true;
+}
+
+// ============ UTILITY ============
+
+float CombatSystem::getDistanceToTarget() const {
+    const EntityStore& store = m_entityManager->getStore();
+    EntityStore::Slot slot = m_primaryTarget != 0 ? store.find(m_primaryTarget) : EntityStore::INVALID_SLOT;
+    if (slot == EntityStore::INVALID_SLOT) {
+        return 0.0f;
+    }
+
+    const GameState::PlayerData& player = m_gameState->getPlayer();
+    float dx = store.xs()[slot] - player.x;
+    float dy = store.ys()[slot] - player.y;
+    return std::sqrt(dx * dx + dy * dy);
+}
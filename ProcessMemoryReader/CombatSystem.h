@@ -1,9 +1,11 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
-#include <functional>
+#include <string>
 #include <chrono>
+#include <cstdint>
+#include "TargetScorer.h"
+#include "AbilityScheduler.h"
 
 // Forward declarations
 class GameState;
@@ -11,6 +13,8 @@ class EntityManager;
 class InputManager;
 class NavigationSystem;
 struct Entity;
+class EntityRange;
+struct EntityEvents;
 
 /**
  * @brief Manages combat logic, targeting, and ability usage
@@ -35,25 +39,9 @@ public:
         KITING         // Hit and run tactics
     };
 
-    struct AbilityInfo {
-        std::string name;
-        int keyBinding;            // Virtual key code
-        float cooldown;            // Cooldown in seconds
-        float range;               // Ability range
-        float manaCost;           // Mana cost
-        bool isOffensive;         // True for damage abilities
-        bool isDefensive;         // True for defensive abilities
-        bool isMovement;          // True for movement abilities
-        int priority;             // Usage priority (higher = more important)
-        std::function<bool()> condition; // When to use this ability
-        
-        std::chrono::steady_clock::time_point lastUsed;
-        bool isOnCooldown() const {
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastUsed);
-            return elapsed.count() < (cooldown * 1000);
-        }
-    };
+    // Cooldowns live in the scheduler, timed against the clock read once per update()
+    using AbilityInfo = AbilityScheduler::Ability;
+    using AbilityId = AbilityScheduler::AbilityId;
 
     struct CombatTarget {
         uint64_t entityId;
@@ -73,10 +61,10 @@ private:
     TacticsMode m_tactics = TacticsMode::BALANCED;
     
     // Abilities and combat skills
-    std::vector<AbilityInfo> m_abilities;
-    std::unordered_map<std::string, size_t> m_abilityMap; // Name to index mapping
+    AbilityScheduler m_abilities;
     
-    // Targeting system
+    // Targeting system: one scoring sweep over the entity store per selection
+    TargetScorer m_targetScorer;
     std::vector<CombatTarget> m_targets;
     uint64_t m_primaryTarget = 0;
     uint64_t m_lastTarget = 0;
@@ -95,6 +83,7 @@ private:
     float m_totalCombatTime = 0.0f;
     
     // Timing
+    std::chrono::steady_clock::time_point m_now;   // Read once per update()
     std::chrono::steady_clock::time_point m_combatStartTime;
     std::chrono::steady_clock::time_point m_lastAbilityUse;
     std::chrono::steady_clock::time_point m_lastTargetSwitch;
@@ -104,7 +93,7 @@ public:
                  InputManager* inputManager, NavigationSystem* navigation);
     
     // Core combat methods
-    void update();
+    void update();   // Once per tick before any ability is picked: reads the clock, releases expired cooldowns
     void startCombat();
     void stopCombat();
     void emergencyRetreat();
@@ -121,6 +110,7 @@ public:
     Entity* getCurrentTarget() const;
     void clearTarget() { m_primaryTarget = 0; }
     void switchTarget();
+    void onEntityEvents(const EntityEvents& events);  // Drops despawned targets, scores new enemies
     
     // Ability management
     void registerAbility(const AbilityInfo& ability);
@@ -128,7 +118,8 @@ public:
     bool useBestOffensiveAbility();
     bool useBestDefensiveAbility();
     bool useMovementAbility();
-    AbilityInfo* getAbility(const std::string& name);
+    const AbilityInfo* getAbility(const std::string& name) const;
+    bool isAbilityReady(const std::string& name) const;
     
     // Combat actions
     bool attackTarget();
@@ -144,9 +135,11 @@ public:
     
     // Configuration
     void setEngagementRange(float range) { m_engagementRange = range; }
+    float getEngagementRange() const { return m_engagementRange; }
     void setRetreatHealthPercent(float percent) { m_retreatHealthPercent = percent; }
     void setHealHealthPercent(float percent) { m_healHealthPercent = percent; }
     void setKiteDistance(float distance) { m_kiteDistance = distance; }
+    void setTargetWeights(const TargetScorer::Weights& weights) { m_targetScorer.setWeights(weights); }
     
     // Statistics
     uint64_t getMonstersKilled() const { return m_monstersKilled; }
@@ -166,15 +159,15 @@ private:
     void handleBossFight();
     
     // Targeting logic
-    float calculateTargetPriority(const Entity& entity) const;
+    TargetScorer::Query targetQuery() const;   // Player position, engagement range, enemy types
     bool shouldSwitchTarget() const;
-    std::vector<Entity> getValidTargets() const;
-    Entity* findBestTarget() const;
+    EntityRange getValidTargets() const;  // Lazy view, no copies
+    TargetScorer::Result findBestTarget() const;  // Current target gets the stickiness bonus
     
     // Ability logic
-    bool canUseAbility(const AbilityInfo& ability) const;
-    AbilityInfo* selectBestAbility(bool offensive = true) const;
-    void updateAbilityCooldowns();
+    AbilityScheduler::Context abilityContext() const;  // Mana, health and target distance
+    AbilityId selectBestAbility(uint8_t roles = AbilityScheduler::ROLE_OFFENSIVE) const;
+    bool castAbility(AbilityId id);  // Presses the key and starts the cooldown
     
     // Combat decision making
     bool shouldRetreat() const;
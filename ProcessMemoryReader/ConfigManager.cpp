@@ -1,13 +1,37 @@
 #include "ConfigManager.h"
 #include <fstream>
 #include <iostream>
+#include <utility>
 
 // Define nlohmann::json since we forward declared it
 #include <nlohmann/json.hpp>
 
+namespace {
+    // Millisecond settings that pace a loop; zero or less would make it spin
+    struct IntervalSetting {
+        const char* name;
+        int ConfigManager::BotConfig::* field;
+    };
+
+    constexpr IntervalSetting INTERVAL_SETTINGS[] = {
+        {"tickRate", &ConfigManager::BotConfig::tickRate},
+        {"combatTickRate", &ConfigManager::BotConfig::combatTickRate},
+        {"navigationTickRate", &ConfigManager::BotConfig::navigationTickRate},
+        {"idleTickRate", &ConfigManager::BotConfig::idleTickRate},
+        {"snapshotIntervalMs", &ConfigManager::BotConfig::snapshotIntervalMs},
+        {"processScanIntervalMs", &ConfigManager::BotConfig::processScanIntervalMs},
+        {"logFlushIntervalMs", &ConfigManager::BotConfig::logFlushIntervalMs},
+    };
+}
+
 ConfigManager::ConfigManager(const std::string& configFile) : m_configFile(configFile) {
     initializeDefaults();
     createDefaultPresets();
+    publishConfig();
+}
+
+ConfigManager::~ConfigManager() {
+    stopWatching();
 }
 
 bool ConfigManager::loadConfig() {
@@ -15,11 +39,19 @@ bool ConfigManager::loadConfig() {
         std::ifstream file(m_configFile);
         if (!file.is_open()) {
             // Create default config if file doesn't exist
+            publishConfig();
             return saveConfig();
         }
         
         file >> m_jsonConfig;
-        jsonToConfig(m_jsonConfig);
+        
+        // Unlike a reload there is nothing running to fall back on, so bad fields keep
+        // their defaults (or the last good load) instead of rejecting the whole file
+        BotConfig config = m_config;
+        readConfig(m_jsonConfig, config);
+        keepValidSettings(config, m_config);
+        m_config = std::move(config);
+        publishConfig();
         return true;
     }
     catch (const std::exception& e) {
@@ -84,46 +116,219 @@ std::vector<std::string> ConfigManager::getAvailablePresets() const {
 }
 
 bool ConfigManager::validateConfig() const {
-    return isValidFarmMode(m_config.farmMode) &&
-           isValidCombatTactics(m_config.combatTactics) &&
-           isValidLootFilter(m_config.lootFilter) &&
-           isValidRarity(m_config.minimumRarity) &&
-           isValidLogLevel(m_config.logLevel);
+    return validateConfig(m_config);
+}
+
+bool ConfigManager::validateConfig(const BotConfig& config) const {
+    for (const IntervalSetting& setting : INTERVAL_SETTINGS) {
+        if (!isValidInterval(config.*setting.field)) {
+            return false;
+        }
+    }
+    
+    return isValidFarmMode(config.farmMode) &&
+           isValidCombatTactics(config.combatTactics) &&
+           isValidLootFilter(config.lootFilter) &&
+           isValidRarity(config.minimumRarity) &&
+           isValidLogLevel(config.logLevel);
 }
 
 std::vector<std::string> ConfigManager::getConfigErrors() const {
+    return getConfigErrors(m_config);
+}
+
+std::vector<std::string> ConfigManager::getConfigErrors(const BotConfig& config) const {
     std::vector<std::string> errors;
     
-    if (!isValidFarmMode(m_config.farmMode)) {
-        errors.push_back("Invalid farm mode: " + m_config.farmMode);
+    if (!isValidFarmMode(config.farmMode)) {
+        errors.push_back("Invalid farm mode: " + config.farmMode);
     }
     
-    if (!isValidCombatTactics(m_config.combatTactics)) {
-        errors.push_back("Invalid combat tactics: " + m_config.combatTactics);
+    if (!isValidCombatTactics(config.combatTactics)) {
+        errors.push_back("Invalid combat tactics: " + config.combatTactics);
     }
     
-    if (!isValidLootFilter(m_config.lootFilter)) {
-        errors.push_back("Invalid loot filter: " + m_config.lootFilter);
+    if (!isValidLootFilter(config.lootFilter)) {
+        errors.push_back("Invalid loot filter: " + config.lootFilter);
     }
     
-    if (!isValidRarity(m_config.minimumRarity)) {
-        errors.push_back("Invalid minimum rarity: " + m_config.minimumRarity);
+    if (!isValidRarity(config.minimumRarity)) {
+        errors.push_back("Invalid minimum rarity: " + config.minimumRarity);
     }
     
-    if (!isValidLogLevel(m_config.logLevel)) {
-        errors.push_back("Invalid log level: " + m_config.logLevel);
+    if (!isValidLogLevel(config.logLevel)) {
+        errors.push_back("Invalid log level: " + config.logLevel);
+    }
+    
+    for (const IntervalSetting& setting : INTERVAL_SETTINGS) {
+        if (!isValidInterval(config.*setting.field)) {
+            errors.push_back(std::string("Invalid ") + setting.name + ": " +
+                             std::to_string(config.*setting.field) + " (must be positive)");
+        }
     }
     
     return errors;
 }
 
+void ConfigManager::keepValidSettings(BotConfig& config, const BotConfig& fallback) const {
+    auto keep = [&](const char* name, auto BotConfig::* field, bool valid) {
+        if (!valid) {
+            std::cerr << "Ignoring invalid " << name << " in config, keeping the previous value" << std::endl;
+            config.*field = fallback.*field;
+        }
+    };
+    
+    for (const IntervalSetting& setting : INTERVAL_SETTINGS) {
+        keep(setting.name, setting.field, isValidInterval(config.*setting.field));
+    }
+    keep("farmMode", &BotConfig::farmMode, isValidFarmMode(config.farmMode));
+    keep("combatTactics", &BotConfig::combatTactics, isValidCombatTactics(config.combatTactics));
+    keep("lootFilter", &BotConfig::lootFilter, isValidLootFilter(config.lootFilter));
+    keep("minimumRarity", &BotConfig::minimumRarity, isValidRarity(config.minimumRarity));
+    keep("logLevel", &BotConfig::logLevel, isValidLogLevel(config.logLevel));
+}
+
+std::shared_ptr<const ConfigManager::BotConfig> ConfigManager::getSnapshot() const {
+    return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+}
+
+void ConfigManager::publishConfig() {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    std::atomic_store_explicit(&m_snapshot, std::make_shared<const BotConfig>(m_config), std::memory_order_release);
+    m_version.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool ConfigManager::reloadConfig() {
+    return reloadFrom(m_configFile);
+}
+
+bool ConfigManager::reloadFrom(const std::string& filename) {
+    nlohmann::json json;
+    try {
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            m_reloadFailures.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        file >> json;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to reload config: " << e.what() << std::endl;
+        m_reloadFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    // The file is read outside the lock; the merge onto the published values is not,
+    // so a publishConfig() landing meanwhile is either the base or waits for us
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    
+    // Settings missing from the file keep their published values, as loadConfig() keeps the working copy's
+    BotConfig config = *getSnapshot();
+    try {
+        readConfig(json, config);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Failed to reload config: " << e.what() << std::endl;
+        m_reloadFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    std::vector<std::string> errors = getConfigErrors(config);
+    if (!errors.empty()) {
+        for (const auto& error : errors) {
+            std::cerr << "Config reload rejected: " << error << std::endl;
+        }
+        m_reloadFailures.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    std::atomic_store_explicit(&m_snapshot, std::make_shared<const BotConfig>(std::move(config)),
+                               std::memory_order_release);
+    m_version.fetch_add(1, std::memory_order_acq_rel);
+    return true;
+}
+
+namespace {
+    uint64_t lastWriteTime(const std::string& filename) {
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &attributes)) {
+            return 0;
+        }
+        return (static_cast<uint64_t>(attributes.ftLastWriteTime.dwHighDateTime) << 32) |
+               attributes.ftLastWriteTime.dwLowDateTime;
+    }
+}
+
+bool ConfigManager::startWatching() {
+    stopWatching();
+    
+    // Change notifications are per directory; the write time tells our file's changes apart
+    size_t separator = m_configFile.find_last_of("\\/");
+    std::string directory = separator == std::string::npos ? "." : m_configFile.substr(0, separator + 1);
+    HANDLE change = FindFirstChangeNotificationA(directory.c_str(), FALSE, 
+                                                 FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+    if (change == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    m_stopWatching = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!m_stopWatching) {
+        FindCloseChangeNotification(change);
+        return false;
+    }
+    
+    m_watchThread = std::thread(&ConfigManager::watchLoop, this, m_configFile, change);
+    return true;
+}
+
+void ConfigManager::stopWatching() {
+    if (m_watchThread.joinable()) {
+        SetEvent(m_stopWatching);
+        m_watchThread.join();
+    }
+    if (m_stopWatching) {
+        CloseHandle(m_stopWatching);
+        m_stopWatching = nullptr;
+    }
+}
+
+void ConfigManager::watchLoop(std::string filename, HANDLE change) {
+    uint64_t lastWrite = lastWriteTime(filename);
+    HANDLE handles[2] = {m_stopWatching, change};
+    
+    while (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1) {
+        // Let the writer finish, then re-arm before reading so a later save is not missed
+        if (WaitForSingleObject(m_stopWatching, RELOAD_SETTLE_MS) == WAIT_OBJECT_0 ||
+            !FindNextChangeNotification(change)) {
+            break;
+        }
+        
+        // Other files in the directory (logs, caches) change far more often than the config
+        uint64_t writeTime = lastWriteTime(filename);
+        if (writeTime != 0 && writeTime != lastWrite) {
+            lastWrite = writeTime;
+            reloadFrom(filename);
+        }
+    }
+    
+    FindCloseChangeNotification(change);
+}
+
 nlohmann::json ConfigManager::configToJson() const {
     nlohmann::json j;
     
     j["general"]["tickRate"] = m_config.tickRate;
+    j["general"]["combatTickRate"] = m_config.combatTickRate;
+    j["general"]["navigationTickRate"] = m_config.navigationTickRate;
+    j["general"]["idleTickRate"] = m_config.idleTickRate;
+    j["general"]["snapshotIntervalMs"] = m_config.snapshotIntervalMs;
+    j["general"]["processScanIntervalMs"] = m_config.processScanIntervalMs;
     j["general"]["farmMode"] = m_config.farmMode;
     j["general"]["enableLogging"] = m_config.enableLogging;
     j["general"]["logLevel"] = m_config.logLevel;
+    j["general"]["logOverflowPolicy"] = m_config.logOverflowPolicy;
+    j["general"]["logFlushIntervalMs"] = m_config.logFlushIntervalMs;
     
     j["combat"]["engagementRange"] = m_config.engagementRange;
     j["combat"]["retreatHealthPercent"] = m_config.retreatHealthPercent;
@@ -134,12 +339,16 @@ nlohmann::json ConfigManager::configToJson() const {
     j["navigation"]["stuckThreshold"] = m_config.stuckThreshold;
     j["navigation"]["enablePathfinding"] = m_config.enablePathfinding;
     j["navigation"]["explorationRadius"] = m_config.explorationRadius;
+    j["navigation"]["maxPathExpansions"] = m_config.maxPathExpansions;
+    j["navigation"]["pathCacheSize"] = m_config.pathCacheSize;
     
     j["loot"]["lootFilter"] = m_config.lootFilter;
     j["loot"]["minimumRarity"] = m_config.minimumRarity;
     j["loot"]["minimumLevel"] = m_config.minimumLevel;
     j["loot"]["minimumValue"] = m_config.minimumValue;
     j["loot"]["enableSeasonalLoot"] = m_config.enableSeasonalLoot;
+    j["loot"]["lootRouteBudgetUs"] = m_config.lootRouteBudgetUs;
+    j["loot"]["lootRoutePriorityWeight"] = m_config.lootRoutePriorityWeight;
     
     j["seasonal"]["enableSeasonalContent"] = m_config.enableSeasonalContent;
     j["seasonal"]["currentSeason"] = m_config.currentSeason;
@@ -153,25 +362,76 @@ nlohmann::json ConfigManager::configToJson() const {
     j["performance"]["optimizeMemoryUsage"] = m_config.optimizeMemoryUsage;
     j["performance"]["maxEntityCount"] = m_config.maxEntityCount;
     j["performance"]["updateRadius"] = m_config.updateRadius;
+    j["performance"]["enablePageCache"] = m_config.enablePageCache;
+    j["performance"]["signatureCacheFile"] = m_config.signatureCacheFile;
+    j["performance"]["offsetCacheFile"] = m_config.offsetCacheFile;
+    j["performance"]["profileDumpIntervalSec"] = m_config.profileDumpIntervalSec;
+    j["performance"]["chromeTraceFile"] = m_config.chromeTraceFile;
+    j["performance"]["snapshotRecordFile"] = m_config.snapshotRecordFile;
     
     return j;
 }
 
 void ConfigManager::jsonToConfig(const nlohmann::json& json) {
+    readConfig(json, m_config);
+}
+
+void ConfigManager::readConfig(const nlohmann::json& json, BotConfig& config) {
     if (json.contains("general")) {
         const auto& general = json["general"];
-        if (general.contains("tickRate")) m_config.tickRate = general["tickRate"];
-        if (general.contains("farmMode")) m_config.farmMode = general["farmMode"];
-        if (general.contains("enableLogging")) m_config.enableLogging = general["enableLogging"];
-        if (general.contains("logLevel")) m_config.logLevel = general["logLevel"];
+        if (general.contains("tickRate")) config.tickRate = general["tickRate"];
+        if (general.contains("combatTickRate")) config.combatTickRate = general["combatTickRate"];
+        if (general.contains("navigationTickRate")) config.navigationTickRate = general["navigationTickRate"];
+        if (general.contains("idleTickRate")) config.idleTickRate = general["idleTickRate"];
+        if (general.contains("snapshotIntervalMs")) config.snapshotIntervalMs = general["snapshotIntervalMs"];
+        if (general.contains("processScanIntervalMs")) config.processScanIntervalMs = general["processScanIntervalMs"];
+        if (general.contains("farmMode")) config.farmMode = general["farmMode"];
+        if (general.contains("enableLogging")) config.enableLogging = general["enableLogging"];
+        if (general.contains("logLevel")) config.logLevel = general["logLevel"];
+        if (general.contains("logOverflowPolicy")) config.logOverflowPolicy = general["logOverflowPolicy"];
+        if (general.contains("logFlushIntervalMs")) config.logFlushIntervalMs = general["logFlushIntervalMs"];
     }
     
     if (json.contains("combat")) {
         const auto& combat = json["combat"];
-        if (combat.contains("engagementRange")) m_config.engagementRange = combat["engagementRange"];
-        if (combat.contains("retreatHealthPercent")) m_config.retreatHealthPercent = combat["retreatHealthPercent"];
-        if (combat.contains("healHealthPercent")) m_config.healHealthPercent = combat["healHealthPercent"];
-        if (combat.contains("combatTactics")) m_config.combatTactics = combat["combatTactics"];
+        if (combat.contains("engagementRange")) config.engagementRange = combat["engagementRange"];
+        if (combat.contains("retreatHealthPercent")) config.retreatHealthPercent = combat["retreatHealthPercent"];
+        if (combat.contains("healHealthPercent")) config.healHealthPercent = combat["healHealthPercent"];
+        if (combat.contains("combatTactics")) config.combatTactics = combat["combatTactics"];
+    }
+    
+    if (json.contains("navigation")) {
+        const auto& navigation = json["navigation"];
+        if (navigation.contains("movementSpeed")) config.movementSpeed = navigation["movementSpeed"];
+        if (navigation.contains("stuckThreshold")) config.stuckThreshold = navigation["stuckThreshold"];
+        if (navigation.contains("enablePathfinding")) config.enablePathfinding = navigation["enablePathfinding"];
+        if (navigation.contains("explorationRadius")) config.explorationRadius = navigation["explorationRadius"];
+        if (navigation.contains("maxPathExpansions")) config.maxPathExpansions = navigation["maxPathExpansions"];
+        if (navigation.contains("pathCacheSize")) config.pathCacheSize = navigation["pathCacheSize"];
+    }
+    
+    if (json.contains("loot")) {
+        const auto& loot = json["loot"];
+        if (loot.contains("lootFilter")) config.lootFilter = loot["lootFilter"];
+        if (loot.contains("minimumRarity")) config.minimumRarity = loot["minimumRarity"];
+        if (loot.contains("minimumLevel")) config.minimumLevel = loot["minimumLevel"];
+        if (loot.contains("minimumValue")) config.minimumValue = loot["minimumValue"];
+        if (loot.contains("enableSeasonalLoot")) config.enableSeasonalLoot = loot["enableSeasonalLoot"];
+        if (loot.contains("lootRouteBudgetUs")) config.lootRouteBudgetUs = loot["lootRouteBudgetUs"];
+        if (loot.contains("lootRoutePriorityWeight")) config.lootRoutePriorityWeight = loot["lootRoutePriorityWeight"];
+    }
+    
+    if (json.contains("performance")) {
+        const auto& performance = json["performance"];
+        if (performance.contains("optimizeMemoryUsage")) config.optimizeMemoryUsage = performance["optimizeMemoryUsage"];
+        if (performance.contains("maxEntityCount")) config.maxEntityCount = performance["maxEntityCount"];
+        if (performance.contains("updateRadius")) config.updateRadius = performance["updateRadius"];
+        if (performance.contains("enablePageCache")) config.enablePageCache = performance["enablePageCache"];
+        if (performance.contains("signatureCacheFile")) config.signatureCacheFile = performance["signatureCacheFile"];
+        if (performance.contains("offsetCacheFile")) config.offsetCacheFile = performance["offsetCacheFile"];
+        if (performance.contains("profileDumpIntervalSec")) config.profileDumpIntervalSec = performance["profileDumpIntervalSec"];
+        if (performance.contains("chromeTraceFile")) config.chromeTraceFile = performance["chromeTraceFile"];
+        if (performance.contains("snapshotRecordFile")) config.snapshotRecordFile = performance["snapshotRecordFile"];
     }
     
     // Continue for other sections...
@@ -253,3 +513,7 @@ bool ConfigManager::isValidLogLevel(const std::string& level) const {
     return level == "debug" || level == "info" || level == "warning" || 
            level == "error" || level == "critical";
 }
+
+bool ConfigManager::isValidInterval(int milliseconds) const {
+    return milliseconds > 0;
+}
@@ -3,6 +3,11 @@
 #include <string>
 #include <unordered_map>
 #include <vector>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <cstdint>
 #include <Windows.h>
 
 // Forward declare nlohmann::json to avoid including the header
@@ -12,15 +17,29 @@ namespace nlohmann {
 
 /**
  * @brief Manages bot configuration and settings
+ *
+ * getConfig() is the working copy that loading, presets and setters edit.
+ * Running subsystems read published snapshots instead: each one is an
+ * immutable BotConfig shared between threads, replaced atomically when the
+ * settings change. With startWatching() every valid edit of the config file
+ * is parsed on a background thread and published, so no reader ever waits
+ * on file I/O or parsing.
  */
 class ConfigManager {
 public:
     struct BotConfig {
         // General settings
         int tickRate = 50;             // Bot update rate in ms
+        int combatTickRate = 25;       // Update rate in COMBAT/BOSS_FIGHT in ms
+        int navigationTickRate = 100;  // Update rate while NAVIGATING in ms
+        int idleTickRate = 250;        // Update rate while IDLE in ms
+        int snapshotIntervalMs = 16;   // Memory read rate of the snapshot reader thread in ms
+        int processScanIntervalMs = 250; // How often to look for a restarted game client in ms
         std::string farmMode = "balanced"; // aggressive, safe, balanced
         bool enableLogging = true;
         std::string logLevel = "info";
+        std::string logOverflowPolicy = "drop"; // drop (count and discard) or block when the log ring is full
+        int logFlushIntervalMs = 1000; // Log file flush interval in ms (errors flush immediately)
         
         // Combat settings
         float engagementRange = 25.0f;
@@ -33,6 +52,8 @@ public:
         float stuckThreshold = 1.0f;
         bool enablePathfinding = true;
         float explorationRadius = 20.0f;
+        int maxPathExpansions = 20000; // Jump points expanded per path request before returning a partial path (0 = unlimited)
+        int pathCacheSize = 64;        // Recently computed paths kept until the grid changes (0 = off)
         
         // Loot settings
         std::string lootFilter = "balanced";
@@ -40,6 +61,8 @@ public:
         int minimumLevel = 1;
         int minimumValue = 100;
         bool enableSeasonalLoot = true;
+        int lootRouteBudgetUs = 500;   // Time allowed for improving the pickup route per plan
+        float lootRoutePriorityWeight = 1.0f; // 0 = shortest route, higher = valuable items earlier
         
         // Seasonal settings
         bool enableSeasonalContent = true;
@@ -56,6 +79,12 @@ public:
         bool optimizeMemoryUsage = true;
         int maxEntityCount = 1000;
         float updateRadius = 50.0f;
+        bool enablePageCache = false;  // Serve repeated reads within a tick from cached pages
+        std::string signatureCacheFile = "signature_cache.bin"; // Resolved signatures per game build ("" = off)
+        std::string offsetCacheFile = "offsets.bin";             // Offset table per game build ("" = off)
+        int profileDumpIntervalSec = 60;   // Log profiler percentiles and counters this often (0 = off)
+        std::string chromeTraceFile = "";  // Chrome trace JSON of every profiled scope ("" = off)
+        std::string snapshotRecordFile = "";  // Record every world snapshot for replay ("" = off)
     };
 
     struct KeyBindings {
@@ -92,9 +121,24 @@ private:
     
     // Default configurations
     std::unordered_map<std::string, BotConfig> m_presets;
+    
+    // Published settings; only accessed through std::atomic_load/atomic_store
+    std::shared_ptr<const BotConfig> m_snapshot;
+    std::mutex m_publishMutex;   // Serializes publishers, so a reload cannot overwrite a newer publishConfig()
+    std::atomic<uint64_t> m_version{0};
+    std::atomic<uint64_t> m_reloadFailures{0};
+    
+    // File watching
+    std::thread m_watchThread;
+    HANDLE m_stopWatching = nullptr;
+    static constexpr DWORD RELOAD_SETTLE_MS = 100;  // Editors save in several writes
 
 public:
     ConfigManager(const std::string& configFile = "config.json");
+    ~ConfigManager();
+    
+    ConfigManager(const ConfigManager&) = delete;
+    ConfigManager& operator=(const ConfigManager&) = delete;
     
     // Configuration loading/saving
     bool loadConfig();
@@ -103,11 +147,44 @@ public:
     bool saveToFile(const std::string& filename);
     
     // Configuration access
+    const std::string& getConfigFile() const { return m_configFile; }
     const BotConfig& getConfig() const { return m_config; }
     const KeyBindings& getKeyBindings() const { return m_keyBindings; }
     void setConfig(const BotConfig& config) { m_config = config; }
     void setKeyBindings(const KeyBindings& bindings) { m_keyBindings = bindings; }
     
+    // Published snapshots
+    /**
+     * @brief Latest published settings (never null); safe from any thread
+     */
+    std::shared_ptr<const BotConfig> getSnapshot() const;
+    
+    /**
+     * @brief Bumped on every publish: compare it once per tick and only take the snapshot when it moved
+     */
+    uint64_t getVersion() const { return m_version.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Publish the working copy (getConfig()) to running subsystems
+     */
+    void publishConfig();
+    
+    // Hot reload
+    /**
+     * @brief Re-read the config file and publish it if it passes validation
+     * @return false if the file could not be parsed or is invalid; the current snapshot stays
+     */
+    bool reloadConfig();
+    
+    /**
+     * @brief Reload the config file in the background whenever it is written
+     * @return false if the file's directory cannot be watched
+     */
+    bool startWatching();
+    void stopWatching();
+    bool isWatching() const { return m_watchThread.joinable(); }
+    uint64_t getReloadFailures() const { return m_reloadFailures.load(std::memory_order_relaxed); }
+    
     // Individual setting methods
     void setTickRate(int rate) { m_config.tickRate = rate; }
     void setFarmMode(const std::string& mode) { m_config.farmMode = mode; }
@@ -122,7 +199,9 @@ public:
     
     // Validation
     bool validateConfig() const;
+    bool validateConfig(const BotConfig& config) const;
     std::vector<std::string> getConfigErrors() const;
+    std::vector<std::string> getConfigErrors(const BotConfig& config) const;
     
     // JSON utilities
     nlohmann::json configToJson() const;
@@ -130,6 +209,10 @@ public:
 
 private:
     void initializeDefaults();
+    static void readConfig(const nlohmann::json& json, BotConfig& config);
+    void keepValidSettings(BotConfig& config, const BotConfig& fallback) const;  // Invalid fields take fallback's value
+    bool reloadFrom(const std::string& filename);
+    void watchLoop(std::string filename, HANDLE change);
     void createDefaultPresets();
     BotConfig createAggressivePreset() const;
     BotConfig createSafePreset() const;
@@ -143,4 +226,5 @@ private:
     bool isValidLootFilter(const std::string& filter) const;
     bool isValidRarity(const std::string& rarity) const;
     bool isValidLogLevel(const std::string& level) const;
+    bool isValidInterval(int milliseconds) const;
 };
@@ -1,9 +1,16 @@
 #include "EntityManager.h"
 #include "Memory.h"
 #include "GameState.h"
+#include "PatternScanner.h"
+#include "Signatures.h"
+#include "WorldSnapshot.h"
+#include <algorithm>
 
 EntityManager::EntityManager(const Memory* memory, const GameState* gameState) 
     : m_memory(memory), m_gameState(gameState) {
+    using namespace std::chrono_literals;
+    m_hotGroup = m_schedule.addGroup("entity_hot", 0ms);
+    m_statsGroup = m_schedule.addGroup("entity_stats", 1000ms);
 }
 
 bool EntityManager::update() {
@@ -11,64 +18,104 @@ bool EntityManager::update() {
         return false;
     }
     
-    // Clear stale entities
-    removeStaleEntities();
+    m_events.clear();
     
-    // Scan for new entities
-    return scanEntityList();
+    // Despawns come from the pointer diff; ageing out by timestamp is only
+    // needed when the list itself could not be read
+    bool complete = scanEntityList();
+    if (!complete) {
+        removeStaleEntities();
+    }
+    
+    publishEvents();
+    return complete;
 }
 
-std::vector<EntityManager::Entity> EntityManager::getAllEntities() const {
+void EntityManager::copyEntities(EntityStore& entities) const {
+    entities = m_entities;
+}
+
+void EntityManager::applySnapshot(const WorldSnapshot& snapshot) {
+    // Diff by id rather than forwarding the reader's events: snapshots can be
+    // skipped, and this way nothing that happened in between is lost
+    const EntityStore& next = snapshot.entities;
+    m_events.clear();
+    
+    for (EntityStore::Slot slot = 0; slot < m_entities.size(); ++slot) {
+        if (!next.contains(m_entities.ids()[slot])) {
+            m_events.despawned.push_back({m_entities.ids()[slot], m_entities.types()[slot]});
+        }
+    }
+    for (EntityStore::Slot slot = 0; slot < next.size(); ++slot) {
+        if (!m_entities.contains(next.ids()[slot])) {
+            m_events.spawned.push_back({next.ids()[slot], next.types()[slot]});
+        }
+    }
+    
+    m_entities = next;
+    publishEvents();
+}
+
+uint32_t EntityManager::subscribe(std::function<void(const EntityEvents&)> callback) {
+    SubscriptionId id = m_nextSubscription++;
+    m_subscribers.emplace_back(id, std::move(callback));
+    return id;
+}
+
+void EntityManager::unsubscribe(uint32_t subscription) {
+    m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+                                       [&](const auto& entry) { return entry.first == subscription; }),
+                        m_subscribers.end());
+}
+
+void EntityManager::publishEvents() {
+    if (m_events.empty()) {
+        return;
+    }
+    
+    for (const auto& subscriber : m_subscribers) {
+        subscriber.second(m_events);
+    }
+}
+
+std::vector<EntityManager::Entity> EntityManager::materialize(const EntityRange& range) const {
     std::vector<Entity> entities;
-    entities.reserve(m_entities.size());
     
-    for (const auto& [id, entity] : m_entities) {
-        entities.push_back(entity);
+    for (EntityView view : range) {
+        entities.push_back(view.materialize());
     }
     
     return entities;
 }
 
-std::vector<EntityManager::Entity> EntityManager::getEntitiesByType(EntityType type) const {
+std::vector<EntityManager::Entity> EntityManager::getAllEntities() const {
     std::vector<Entity> entities;
+    entities.reserve(m_entities.size());
     
-    for (const auto& [id, entity] : m_entities) {
-        if (entity.type == type) {
-            entities.push_back(entity);
-        }
+    for (EntityView view : this->entities()) {
+        entities.push_back(view.materialize());
     }
     
     return entities;
 }
 
+std::vector<EntityManager::Entity> EntityManager::getEntitiesByType(EntityType type) const {
+    return materialize(entitiesOfType(entityTypeBit(type)));
+}
+
 std::vector<EntityManager::Entity> EntityManager::getNearbyEntities(float x, float y, float radius) const {
     std::vector<Entity> entities;
-    float radiusSquared = radius * radius;
     
-    for (const auto& [id, entity] : m_entities) {
-        float dx = entity.x - x;
-        float dy = entity.y - y;
-        float distanceSquared = dx * dx + dy * dy;
-        
-        if (distanceSquared <= radiusSquared) {
-            entities.push_back(entity);
-        }
-    }
+    m_entities.forEachInRadius(x, y, radius, [&](EntityStore::Slot slot) {
+        entities.push_back(m_entities.get(slot));
+        return true;
+    });
     
     return entities;
 }
 
 std::vector<EntityManager::Entity> EntityManager::getTargetableEnemies() const {
-    std::vector<Entity> enemies;
-    
-    for (const auto& [id, entity] : m_entities) {
-        if ((entity.type == EntityType::MONSTER || entity.type == EntityType::BOSS) &&
-            entity.isAlive && entity.isTargetable) {
-            enemies.push_back(entity);
-        }
-    }
-    
-    return enemies;
+    return materialize(targetableEnemies());
 }
 
 std::vector<EntityManager::Entity> EntityManager::getLootableItems() const {
@@ -76,115 +123,94 @@ std::vector<EntityManager::Entity> EntityManager::getLootableItems() const {
 }
 
 std::vector<EntityManager::Entity> EntityManager::getInteractableObjects() const {
-    std::vector<Entity> objects;
-    
-    for (const auto& [id, entity] : m_entities) {
-        if (entity.type == EntityType::CHEST || 
-            entity.type == EntityType::PORTAL ||
-            entity.type == EntityType::WAYPOINT ||
-            entity.type == EntityType::SEASONAL_OBJECT) {
-            objects.push_back(entity);
-        }
+    return materialize(interactableObjects());
+}
+
+std::optional<EntityManager::Entity> EntityManager::findNearestEnemy(float playerX, float playerY) const {
+    EntityStore::Slot slot = m_entities.findNearest(playerX, playerY, ENEMY_TYPES, 
+                                                    EntityStore::FLAG_ALIVE | EntityStore::FLAG_TARGETABLE);
+    if (slot == EntityStore::INVALID_SLOT) {
+        return std::nullopt;
     }
-    
-    return objects;
+    return m_entities.get(slot);
 }
 
-EntityManager::Entity* EntityManager::findNearestEnemy(float playerX, float playerY) {
-    Entity* nearest = nullptr;
-    float nearestDistance = std::numeric_limits<float>::max();
-    
-    for (auto& [id, entity] : m_entities) {
-        if ((entity.type == EntityType::MONSTER || entity.type == EntityType::BOSS) &&
-            entity.isAlive && entity.isTargetable) {
-            
-            float dx = entity.x - playerX;
-            float dy = entity.y - playerY;
-            float distance = dx * dx + dy * dy;
-            
-            if (distance < nearestDistance) {
-                nearestDistance = distance;
-                nearest = &entity;
-            }
-        }
+std::optional<EntityManager::Entity> EntityManager::findNearestItem(float playerX, float playerY) const {
+    EntityStore::Slot slot = m_entities.findNearest(playerX, playerY, entityTypeBit(EntityType::ITEM));
+    if (slot == EntityStore::INVALID_SLOT) {
+        return std::nullopt;
     }
-    
-    return nearest;
+    return m_entities.get(slot);
+}
+
+std::optional<EntityManager::Entity> EntityManager::findBoss() const {
+    auto boss = entitiesOfType(entityTypeBit(EntityType::BOSS), EntityStore::FLAG_ALIVE).front();
+    if (!boss) {
+        return std::nullopt;
+    }
+    return boss->materialize();
+}
+
+std::vector<EntityManager::Entity> EntityManager::findSeasonalObjects() const {
+    return getEntitiesByType(EntityType::SEASONAL_OBJECT);
 }
 
-EntityManager::Entity* EntityManager::findNearestItem(float playerX, float playerY) {
-    Entity* nearest = nullptr;
-    float nearestDistance = std::numeric_limits<float>::max();
+std::vector<EntityManager::Entity> EntityManager::findNearestEnemies(float x, float y, size_t count) const {
+    std::vector<EntityStore::Slot> slots;
+    m_entities.findKNearest(x, y, count, ENEMY_TYPES, 
+                            EntityStore::FLAG_ALIVE | EntityStore::FLAG_TARGETABLE, slots);
     
-    for (auto& [id, entity] : m_entities) {
-        if (entity.type == EntityType::ITEM) {
-            float dx = entity.x - playerX;
-            float dy = entity.y - playerY;
-            float distance = dx * dx + dy * dy;
-            
-            if (distance < nearestDistance) {
-                nearestDistance = distance;
-                nearest = &entity;
-            }
-        }
+    std::vector<Entity> enemies;
+    enemies.reserve(slots.size());
+    for (EntityStore::Slot slot : slots) {
+        enemies.push_back(m_entities.get(slot));
     }
     
-    return nearest;
+    return enemies;
 }
 
-EntityManager::Entity* EntityManager::findBoss() {
-    for (auto& [id, entity] : m_entities) {
-        if (entity.type == EntityType::BOSS && entity.isAlive) {
-            return &entity;
-        }
+bool EntityManager::anyOf(uint32_t typeMask, float x, float y, float radius, uint8_t requiredFlags) const {
+    return m_entities.anyInRadius(x, y, radius, typeMask, requiredFlags);
+}
+
+bool EntityManager::anyOf(uint32_t typeMask, float radius, uint8_t requiredFlags) const {
+    if (!m_gameState) {
+        return false;
     }
     
-    return nullptr;
+    const auto& player = m_gameState->getPlayer();
+    return m_entities.anyInRadius(player.x, player.y, radius, typeMask, requiredFlags);
 }
 
-std::vector<EntityManager::Entity> EntityManager::findSeasonalObjects() {
-    return getEntitiesByType(EntityType::SEASONAL_OBJECT);
+std::optional<EntityView> EntityManager::nearestOf(uint32_t typeMask, float x, float y, uint8_t requiredFlags,
+                                                   float maxRadius) const {
+    EntityStore::Slot slot = m_entities.findNearest(x, y, typeMask, requiredFlags, maxRadius);
+    if (slot == EntityStore::INVALID_SLOT) {
+        return std::nullopt;
+    }
+    return EntityView(&m_entities, slot);
 }
 
 bool EntityManager::hasNearbyEnemies(float x, float y, float radius) const {
-    return !getNearbyEntities(x, y, radius).empty();
+    return m_entities.anyInRadius(x, y, radius, ENEMY_TYPES, EntityStore::FLAG_ALIVE);
 }
 
 bool EntityManager::hasLootableItems(float x, float y, float radius) const {
-    auto nearby = getNearbyEntities(x, y, radius);
-    
-    for (const auto& entity : nearby) {
-        if (entity.type == EntityType::ITEM) {
-            return true;
-        }
-    }
-    
-    return false;
+    return m_entities.anyInRadius(x, y, radius, entityTypeBit(EntityType::ITEM));
+}
+
+void EntityManager::setUpdateRadius(float updateRadius) {
+    // Queries use radii of roughly 10-25 units; a quarter of the scan radius keeps
+    // them to a handful of cells with only a few entities per cell
+    m_entities.setCellSize(std::max(4.0f, updateRadius / 4.0f));
 }
 
 int EntityManager::getEnemyCount() const {
-    int count = 0;
-    
-    for (const auto& [id, entity] : m_entities) {
-        if (entity.type == EntityType::MONSTER || entity.type == EntityType::BOSS) {
-            count++;
-        }
-    }
-    
-    return count;
+    return static_cast<int>(entitiesOfType(ENEMY_TYPES).count());
 }
 
 int EntityManager::getAliveEnemyCount() const {
-    int count = 0;
-    
-    for (const auto& [id, entity] : m_entities) {
-        if ((entity.type == EntityType::MONSTER || entity.type == EntityType::BOSS) && 
-            entity.isAlive) {
-            count++;
-        }
-    }
-    
-    return count;
+    return static_cast<int>(entitiesOfType(ENEMY_TYPES, EntityStore::FLAG_ALIVE).count());
 }
 
 void EntityManager::setMonsterFilter(std::function<bool(const Entity&)> filter) {
@@ -200,10 +226,15 @@ void EntityManager::setInteractableFilter(std::function<bool(const Entity&)> fil
 }
 
 bool EntityManager::findEntityList() {
-    // Placeholder for finding entity list in memory
-    // This would require reverse engineering the game
-    m_entityListBase = 0x4000000; // Placeholder address
-    m_entityListSize = 0x1000;    // Placeholder size
+    if (m_scanner) {
+        m_entityListBase = m_scanner->resolveSignatures({Signatures::ENTITY_LIST}).front();
+    }
+    
+    // Placeholder until the signature matches the current game build
+    if (m_entityListBase == 0) {
+        m_entityListBase = 0x4000000; // Placeholder address
+    }
+    m_entityListSize = EntityListLayout::defaultSize;
     
     return m_entityListBase != 0;
 }
@@ -211,19 +242,30 @@ bool EntityManager::findEntityList() {
 void EntityManager::clearEntities() {
     m_entities.clear();
     m_recentlyRemoved.clear();
+    m_tracked.clear();
+    m_nameCache.clear();
+}
+
+void EntityManager::despawn(uint64_t id) {
+    EntityStore::Slot slot = m_entities.find(id);
+    if (slot == EntityStore::INVALID_SLOT) {
+        return;
+    }
+    
+    m_events.despawned.push_back({id, m_entities.types()[slot]});
+    m_recentlyRemoved.push_back(id);
+    m_entities.removeAt(slot);
 }
 
 void EntityManager::removeStaleEntities() {
     auto now = std::chrono::steady_clock::now();
     auto staleThreshold = std::chrono::seconds(5);
     
-    auto it = m_entities.begin();
-    while (it != m_entities.end()) {
-        if (now - it->second.lastSeen > staleThreshold) {
-            m_recentlyRemoved.push_back(it->first);
-            it = m_entities.erase(it);
-        } else {
-            ++it;
+    // Walk backwards: removal moves the last slot into the freed one
+    for (size_t i = m_entities.size(); i-- > 0;) {
+        EntityStore::Slot slot = static_cast<EntityStore::Slot>(i);
+        if (now - m_entities.lastSeen(slot) > staleThreshold) {
+            despawn(m_entities.ids()[slot]);
         }
     }
     
@@ -235,44 +277,157 @@ void EntityManager::removeStaleEntities() {
 }
 
 bool EntityManager::scanEntityList() {
-    // Placeholder for entity list scanning
-    // This would involve reading from the game's entity list in memory
+    if (m_entityListBase == 0 || !readListEntries()) {
+        return false;
+    }
+    
+    // Merge this tick's addresses with last tick's: addresses only in the list
+    // are new, addresses only in m_tracked have despawned
+    m_parseQueue.clear();
+    m_hotTargets.clear();
+    
+    size_t i = 0;
+    size_t j = 0;
+    while (i < m_listEntries.size() || j < m_tracked.size()) {
+        if (j == m_tracked.size() || (i < m_listEntries.size() && m_listEntries[i] < m_tracked[j].address)) {
+            m_parseQueue.push_back({m_listEntries[i++], 0});
+        } else if (i == m_listEntries.size() || m_tracked[j].address < m_listEntries[i]) {
+            despawn(m_tracked[j++].id);
+        } else {
+            m_hotTargets.push_back(m_tracked[j++]);
+            ++i;
+        }
+    }
+    
+    m_nextTracked.clear();
+    bool complete = refreshKnownEntities();
+    
+    // Full parse (including the name string) only for entities we have not seen yet
+    for (const TrackedEntity& pending : m_parseQueue) {
+        Entity entity;
+        bool parsed = parseEntity(pending.address, entity) && isEntityValid(entity);
+        if (pending.id != 0 && (!parsed || entity.id != pending.id)) {
+            despawn(pending.id);   // The address now holds a different entity (or none)
+        }
+        if (!parsed) {
+            continue;   // Not tracked, so it is retried next tick
+        }
+        
+        updateEntityVisibility(entity);
+        if (!m_entities.contains(entity.id)) {
+            m_events.spawned.push_back({entity.id, entity.type});
+        }
+        m_entities.upsert(entity);
+        m_nextTracked.push_back({pending.address, entity.id});
+    }
+    
+    std::sort(m_nextTracked.begin(), m_nextTracked.end(),
+              [](const TrackedEntity& a, const TrackedEntity& b) { return a.address < b.address; });
+    m_tracked.swap(m_nextTracked);
+    
+    return complete;
+}
+
+bool EntityManager::readListEntries() {
+    size_t count = m_entityListSize / sizeof(EntityListLayout::Entry);
+    m_listEntries.resize(count);
+    
+    if (count == 0 || !m_memory->readMemory(m_entityListBase, m_listEntries.data(),
+                                            count * sizeof(EntityListLayout::Entry))) {
+        m_listEntries.clear();
+        return false;
+    }
+    
+    // Drop free slots; sorting makes the diff a linear merge
+    m_listEntries.erase(std::remove(m_listEntries.begin(), m_listEntries.end(), uintptr_t{0}), 
+                        m_listEntries.end());
+    std::sort(m_listEntries.begin(), m_listEntries.end());
+    m_listEntries.erase(std::unique(m_listEntries.begin(), m_listEntries.end()), m_listEntries.end());
     
-    // For now, return true to indicate scanning was attempted
     return true;
 }
 
+bool EntityManager::refreshKnownEntities() {
+    if (!m_deltaMode) {
+        // Full mode: re-parse every known entity
+        m_parseQueue.insert(m_parseQueue.end(), m_hotTargets.begin(), m_hotTargets.end());
+        return true;
+    }
+    
+    // Hot fields every pass; max health and level on the slower stats schedule
+    m_schedule.beginPass(std::chrono::steady_clock::now());
+    if (m_schedule.shouldRead(m_statsGroup)) {
+        bool complete = refreshKnown(m_statBlocks);
+        m_schedule.complete(m_statsGroup, complete);
+        return complete;
+    }
+    
+    bool complete = refreshKnown(m_hotBlocks);
+    m_schedule.complete(m_hotGroup, complete);
+    return complete;
+}
+
+template<typename Block>
+bool EntityManager::refreshKnown(std::vector<Block>& blocks) {
+    // One batched read for every known entity. Blocks are zeroed first, so a
+    // failed read shows up as an id mismatch below.
+    blocks.assign(m_hotTargets.size(), Block{});
+    
+    Memory::ReadBatch batch(m_memory);
+    batch.reserve(m_hotTargets.size());
+    for (size_t k = 0; k < m_hotTargets.size(); ++k) {
+        blocks[k].queue(batch, m_hotTargets[k].address);
+    }
+    bool complete = m_hotTargets.empty() || batch.execute();
+    
+    auto now = std::chrono::steady_clock::now();
+    for (size_t k = 0; k < m_hotTargets.size(); ++k) {
+        const TrackedEntity& target = m_hotTargets[k];
+        const Block& block = blocks[k];
+        
+        EntityStore::Slot slot = m_entities.find(target.id);
+        if (slot == EntityStore::INVALID_SLOT || block.template get<EntityLayout::Id>() != target.id ||
+            !isPositionValid(block.template get<EntityLayout::PositionX>(),
+                             block.template get<EntityLayout::PositionY>())) {
+            // Freed and reused by another entity, torn or unreadable: parse it from scratch
+            m_parseQueue.push_back(target);
+            continue;
+        }
+        
+        m_entities.refresh(slot,
+                           block.template get<EntityLayout::PositionX>(),
+                           block.template get<EntityLayout::PositionY>(),
+                           block.template get<EntityLayout::PositionZ>(),
+                           block.template get<EntityLayout::Health>(),
+                           block.template get<EntityLayout::IsAlive>(),
+                           block.template get<EntityLayout::IsTargetable>(),
+                           now);
+        if constexpr (std::is_same_v<Block, EntityLayout::Block>) {
+            m_entities.refreshStats(slot, block.template get<EntityLayout::MaxHealth>(),
+                                    block.template get<EntityLayout::Level>());
+        }
+        m_nextTracked.push_back(target);
+    }
+    
+    return complete;
+}
+
 bool EntityManager::parseEntity(uintptr_t entityAddress, Entity& entity) {
     if (!m_memory || !m_memory->isValidAddress(entityAddress)) {
         return false;
     }
     
     try {
-        // Read entity data from memory
-        entity.id = m_memory->read<uint64_t>(entityAddress + m_offsets.id);
-        
-        // Read position
-        auto position = m_memory->readArray<float>(entityAddress + m_offsets.position, 3);
-        entity.x = position[0];
-        entity.y = position[1];
-        entity.z = position[2];
-        
-        // Read other properties
-        entity.health = m_memory->read<float>(entityAddress + m_offsets.health);
-        entity.maxHealth = m_memory->read<float>(entityAddress + m_offsets.maxHealth);
-        entity.isAlive = m_memory->read<bool>(entityAddress + m_offsets.isAlive);
-        entity.isTargetable = m_memory->read<bool>(entityAddress + m_offsets.isTargetable);
-        entity.level = m_memory->read<int>(entityAddress + m_offsets.level);
+        // Read the fixed part of the entity with one read into a stack buffer
+        EntityLayout::Block block;
+        if (!block.read(m_memory, entityAddress)) {
+            return false;
+        }
         
-        // Determine entity type
-        uint32_t typeValue = m_memory->read<uint32_t>(entityAddress + m_offsets.type);
-        entity.type = determineEntityType(typeValue);
+        decodeEntity(block, entity);
         
         // Read name
-        entity.name = readEntityName(entityAddress + m_offsets.name);
-        
-        // Update timing
-        entity.lastSeen = std::chrono::steady_clock::now();
+        entity.name = readEntityName(entityAddress + EntityLayout::nameOffset);
         
         // Calculate threat level for monsters
         if (entity.type == EntityType::MONSTER || entity.type == EntityType::BOSS) {
@@ -286,6 +441,24 @@ bool EntityManager::parseEntity(uintptr_t entityAddress, Entity& entity) {
     }
 }
 
+void EntityManager::decodeEntity(const EntityLayout::Block& block, Entity& entity) const {
+    entity.id = block.get<EntityLayout::Id>();
+    entity.type = determineEntityType(block.get<EntityLayout::Type>());
+    
+    entity.x = block.get<EntityLayout::PositionX>();
+    entity.y = block.get<EntityLayout::PositionY>();
+    entity.z = block.get<EntityLayout::PositionZ>();
+    
+    entity.health = block.get<EntityLayout::Health>();
+    entity.maxHealth = block.get<EntityLayout::MaxHealth>();
+    entity.isAlive = block.get<EntityLayout::IsAlive>();
+    entity.isTargetable = block.get<EntityLayout::IsTargetable>();
+    entity.level = block.get<EntityLayout::Level>();
+    
+    // Update timing
+    entity.lastSeen = std::chrono::steady_clock::now();
+}
+
 EntityManager::EntityType EntityManager::determineEntityType(uintptr_t typeValue) const {
     // Placeholder type determination
     // This would need to be reverse engineered from the game
@@ -326,8 +499,13 @@ bool EntityManager::isEntityValid(const Entity& entity) const {
     // Basic validation
     return entity.id != 0 && 
            entity.type != EntityType::UNKNOWN &&
-           entity.x >= -10000 && entity.x <= 10000 &&
-           entity.y >= -10000 && entity.y <= 10000;
+           isPositionValid(entity.x, entity.y);
+}
+
+bool EntityManager::isPositionValid(float x, float y) {
+    // Also false for NaN
+    return x >= -10000 && x <= 10000 &&
+           y >= -10000 && y <= 10000;
 }
 
 void EntityManager::updateEntityVisibility(Entity& entity) {
@@ -336,15 +514,38 @@ void EntityManager::updateEntityVisibility(Entity& entity) {
     entity.isVisible = true;
 }
 
-std::string EntityManager::readEntityName(uintptr_t nameAddress) const {
+SymbolId EntityManager::readEntityName(uintptr_t nameAddress) {
+    static const SymbolId UNKNOWN = SymbolTable::global().intern("Unknown");
+    constexpr size_t MAX_CACHED_NAMES = 8192;
+    
     if (!m_memory || !m_memory->isValidAddress(nameAddress)) {
-        return "Unknown";
+        return UNKNOWN;
     }
     
+    // Read into a stack buffer; the name only becomes a std::string the first
+    // time the table sees it
+    char buffer[EntityLayout::maxNameLength];
+    size_t length = std::min(sizeof(buffer), m_memory->getReadableSize(nameAddress));
     try {
-        return m_memory->readString(nameAddress, 64);
+        if (length == 0 || !m_memory->readMemory(nameAddress, buffer, length)) {
+            return UNKNOWN;
+        }
     }
     catch (const std::exception&) {
-        return "Unknown";
+        return UNKNOWN;
+    }
+    length = static_cast<size_t>(std::find(buffer, buffer + length, '\0') - buffer);
+    
+    uint64_t hash = SymbolTable::hash(buffer, length);
+    auto it = m_nameCache.find(nameAddress);
+    if (it != m_nameCache.end() && it->second.hash == hash) {
+        return it->second.symbol;
+    }
+    
+    SymbolId symbol = SymbolTable::global().intern(std::string_view(buffer, length));
+    if (m_nameCache.size() >= MAX_CACHED_NAMES) {
+        m_nameCache.clear();
     }
+    m_nameCache[nameAddress] = {hash, symbol};
+    return symbol;
 }
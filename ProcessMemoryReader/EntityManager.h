@@ -1,94 +1,108 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
 #include <memory>
 #include <functional>
 #include <chrono>
 #include <limits>
+#include <optional>
+#include <unordered_map>
 #include <string>
+#include "GameLayouts.h"
+#include "EntityStore.h"
+#include "EntityView.h"
+#include "ReadScheduler.h"
 
 // Forward declarations
 class Memory;
 class GameState;
+class PatternScanner;
+struct WorldSnapshot;
+
+/**
+ * @brief Entity appearance/disappearance, reported once per change
+ */
+struct EntityEvent {
+    uint64_t id;
+    EntityType type;
+};
+
+/**
+ * @brief Entities that spawned or despawned since the previous update
+ *
+ * Spawned ids are present in the store when subscribers are called; despawned
+ * ids have already been removed.
+ */
+struct EntityEvents {
+    std::vector<EntityEvent> spawned;
+    std::vector<EntityEvent> despawned;
+    
+    bool empty() const { return spawned.empty() && despawned.empty(); }
+    void clear() { spawned.clear(); despawned.clear(); }
+};
 
 /**
  * @brief Manages entity detection and tracking in the game world
  */
 class EntityManager {
 public:
-    enum class EntityType {
-        UNKNOWN,
-        PLAYER,
-        MONSTER,
-        BOSS,
-        NPC,
-        ITEM,
-        CHEST,
-        PORTAL,
-        WAYPOINT,
-        SEASONAL_OBJECT
-    };
+    // Entity types live in EntityStore.h; aliases keep the EntityManager:: names
+    using EntityType = ::EntityType;
+    using Entity = ::Entity;
 
-    struct Entity {
-        uint64_t id;                   // Unique entity identifier
-        EntityType type;               // Type of entity
-        float x, y, z;                 // World position
-        float health, maxHealth;       // Health values (for living entities)
-        bool isAlive;                  // Alive status
-        bool isTargetable;             // Can be targeted
-        bool isVisible;                // Visible on screen
-        std::string name;              // Entity name/identifier
-        int level;                     // Entity level (for monsters/NPCs)
-        float threatLevel;             // Calculated threat (for monsters)
-        std::chrono::time_point<std::chrono::steady_clock> lastSeen; // Last detection time
-        
-        // Type-specific data
-        union {
-            struct { // For monsters
-                bool isElite;
-                bool isBoss;
-                float attackRange;
-                float movementSpeed;
-            } monster;
-            
-            struct { // For items
-                int rarity;            // Item rarity level
-                std::string itemType;  // Type of item
-                bool isFiltered;       // Matches loot filter
-            } item;
-            
-            struct { // For seasonal objects
-                std::string eventType;
-                bool isInteractable;
-                float interactionRange;
-            } seasonal;
-        } data;
-    };
+    // Type masks for the column-wise filters
+    static constexpr uint32_t ALL_TYPES = 0xFFFFFFFFu;
+    static constexpr uint32_t ENEMY_TYPES = entityTypeBit(EntityType::MONSTER) | entityTypeBit(EntityType::BOSS);
+    static constexpr uint32_t INTERACTABLE_TYPES = entityTypeBit(EntityType::CHEST) | entityTypeBit(EntityType::PORTAL) |
+                                                   entityTypeBit(EntityType::WAYPOINT) | 
+                                                   entityTypeBit(EntityType::SEASONAL_OBJECT);
 
 private:
     const Memory* m_memory;
     const GameState* m_gameState;
+    PatternScanner* m_scanner = nullptr;
     
-    std::unordered_map<uint64_t, Entity> m_entities;
+    EntityStore m_entities;
     std::vector<uint64_t> m_recentlyRemoved; // Recently removed entities
     
     // Entity list scanning
     uintptr_t m_entityListBase = 0;
     uintptr_t m_entityListSize = 0;
     
-    // Entity structure offsets (need to be found via reverse engineering)
-    struct EntityOffsets {
-        uintptr_t id = 0x8;
-        uintptr_t type = 0x10;
-        uintptr_t position = 0x20;     // X, Y, Z
-        uintptr_t health = 0x40;
-        uintptr_t maxHealth = 0x44;
-        uintptr_t isAlive = 0x48;
-        uintptr_t isTargetable = 0x4C;
-        uintptr_t name = 0x50;
-        uintptr_t level = 0x60;
-    } m_offsets;
+    // Delta scan state: entity addresses seen last tick, sorted by address
+    struct TrackedEntity {
+        uintptr_t address;
+        uint64_t id;
+    };
+    bool m_deltaMode = true;
+    std::vector<TrackedEntity> m_tracked;
+    std::vector<TrackedEntity> m_nextTracked;   // Scratch, swapped with m_tracked
+    std::vector<uintptr_t> m_listEntries;       // Raw pointer array of this tick
+    std::vector<TrackedEntity> m_parseQueue;    // Full parse needed; id = previous occupant (0 = new)
+    std::vector<TrackedEntity> m_hotTargets;    // Known entities refreshed this tick
+    std::vector<EntityLayout::HotBlock> m_hotBlocks;
+    std::vector<EntityLayout::Block> m_statBlocks;
+    
+    // Name last seen at each remote name address, so a new entity at a known
+    // address costs one small read and a hash instead of an intern lookup
+    struct RemoteName {
+        uint64_t hash;
+        SymbolId symbol;
+    };
+    std::unordered_map<uintptr_t, RemoteName> m_nameCache;
+    
+    // Refresh rates of known entities (new ones are always parsed in full)
+    ReadScheduler m_schedule;
+    ReadScheduler::GroupId m_hotGroup;
+    ReadScheduler::GroupId m_statsGroup;
+    
+    // Spawn/despawn notification
+    using SubscriptionId = uint32_t;
+    std::vector<std::pair<SubscriptionId, std::function<void(const EntityEvents&)>>> m_subscribers;
+    SubscriptionId m_nextSubscription = 1;
+    EntityEvents m_events;
+    
+    // Entity structure layout lives in GameLayouts.h (EntityLayout)
     
     // Filtering functions
     std::function<bool(const Entity&)> m_monsterFilter;
@@ -101,7 +115,63 @@ public:
     // Core update method
     bool update();
     
-    // Entity retrieval
+    // Snapshot exchange with the reader thread
+    void copyEntities(EntityStore& entities) const;  // Reuses the target's column capacity
+    void applySnapshot(const WorldSnapshot& snapshot);  // Diffs ids against the previous snapshot
+    
+    /**
+     * @brief Receive spawn/despawn events after every update()/applySnapshot() that changed the set
+     * @return Id for unsubscribe()
+     * @note Callbacks run on the thread calling update()/applySnapshot()
+     */
+    uint32_t subscribe(std::function<void(const EntityEvents&)> callback);
+    void unsubscribe(uint32_t subscription);
+    const EntityEvents& getLastEvents() const { return m_events; }
+    
+    /**
+     * @brief Delta scanning (default): only the pointer array is read every tick,
+     * new entities are fully parsed and known ones only get their hot fields refreshed.
+     * Disabled, every entity in the list is re-parsed each tick.
+     */
+    void setDeltaMode(bool enabled) { m_deltaMode = enabled; }
+    bool isDeltaMode() const { return m_deltaMode; }
+    
+    // Refresh intervals of known entities ("entity_hot", "entity_stats")
+    ReadScheduler& getReadScheduler() { return m_schedule; }
+    const ReadScheduler& getReadScheduler() const { return m_schedule; }
+    
+    // Zero-copy queries: lazy views into the entity store, valid until the next
+    // update()/applySnapshot(). Prefer these on the hot path.
+    EntityRange entities() const { return EntityRange(&m_entities, ALL_TYPES); }
+    EntityRange entitiesOfType(uint32_t typeMask, uint8_t requiredFlags = 0) const {
+        return EntityRange(&m_entities, typeMask, requiredFlags);
+    }
+    EntityRange targetableEnemies() const {
+        return entitiesOfType(ENEMY_TYPES, EntityStore::FLAG_ALIVE | EntityStore::FLAG_TARGETABLE);
+    }
+    EntityRange lootableItems() const { return entitiesOfType(entityTypeBit(EntityType::ITEM)); }
+    EntityRange interactableObjects() const { return entitiesOfType(INTERACTABLE_TYPES); }
+    EntityRange seasonalObjects() const { return entitiesOfType(entityTypeBit(EntityType::SEASONAL_OBJECT)); }
+    
+    /**
+     * @brief Call fn(EntityView) for matching entities within radius (grid-accelerated)
+     * @param fn Returns false to stop early
+     */
+    template<typename Fn>
+    void forEachInRadius(float x, float y, float radius, uint32_t typeMask, Fn&& fn) const {
+        m_entities.forEachInRadius(x, y, radius, [&](EntityStore::Slot slot) {
+            return !m_entities.matchesType(slot, typeMask) || fn(EntityView(&m_entities, slot));
+        });
+    }
+    
+    // Early-exit predicates; the second form is centred on the player
+    bool anyOf(uint32_t typeMask, float x, float y, float radius, uint8_t requiredFlags = 0) const;
+    bool anyOf(uint32_t typeMask, float radius, uint8_t requiredFlags = 0) const;
+    
+    std::optional<EntityView> nearestOf(uint32_t typeMask, float x, float y, uint8_t requiredFlags = 0,
+                                        float maxRadius = std::numeric_limits<float>::infinity()) const;
+    
+    // Entity retrieval (copies; use the views above on the hot path)
     std::vector<Entity> getAllEntities() const;
     std::vector<Entity> getEntitiesByType(EntityType type) const;
     std::vector<Entity> getNearbyEntities(float x, float y, float radius) const;
@@ -109,11 +179,15 @@ public:
     std::vector<Entity> getLootableItems() const;
     std::vector<Entity> getInteractableObjects() const;
     
-    // Specific entity searches
-    Entity* findNearestEnemy(float playerX, float playerY);
-    Entity* findNearestItem(float playerX, float playerY);
-    Entity* findBoss();
-    std::vector<Entity> findSeasonalObjects();
+    // Specific entity searches (results are copies)
+    std::optional<Entity> findNearestEnemy(float playerX, float playerY) const;
+    std::optional<Entity> findNearestItem(float playerX, float playerY) const;
+    std::optional<Entity> findBoss() const;
+    std::vector<Entity> findNearestEnemies(float x, float y, size_t count) const;  // Closest first
+    std::vector<Entity> findSeasonalObjects() const;
+    
+    // Direct column access for hot-path consumers
+    const EntityStore& getStore() const { return m_entities; }
     
     // Entity state queries
     bool hasNearbyEnemies(float x, float y, float radius = 20.0f) const;
@@ -126,17 +200,31 @@ public:
     void setItemFilter(std::function<bool(const Entity&)> filter);
     void setInteractableFilter(std::function<bool(const Entity&)> filter);
     
+    // Spatial index cell size is derived from the entity scan radius
+    void setUpdateRadius(float updateRadius);
+    
     // Memory management
     bool findEntityList();
+    void setEntityList(uintptr_t base, size_t sizeBytes) { m_entityListBase = base; m_entityListSize = sizeBytes; }
+    void setPatternScanner(PatternScanner* scanner) { m_scanner = scanner; }
     void clearEntities();
     void removeStaleEntities();
 
 private:
+    std::vector<Entity> materialize(const EntityRange& range) const;
+    
     bool scanEntityList();
+    bool readListEntries();
+    bool refreshKnownEntities();
+    template<typename Block> bool refreshKnown(std::vector<Block>& blocks);
+    void despawn(uint64_t id);
+    void publishEvents();
     bool parseEntity(uintptr_t entityAddress, Entity& entity);
+    void decodeEntity(const EntityLayout::Block& block, Entity& entity) const;
     EntityType determineEntityType(uintptr_t typeValue) const;
     float calculateThreatLevel(const Entity& entity) const;
     bool isEntityValid(const Entity& entity) const;
+    static bool isPositionValid(float x, float y);
     void updateEntityVisibility(Entity& entity);
-    std::string readEntityName(uintptr_t nameAddress) const;
+    SymbolId readEntityName(uintptr_t nameAddress);
 };
@@ -0,0 +1,303 @@
+#include "EntityStore.h"
+#include <algorithm>
+
+EntityStore::EntityStore() = default;
+
+EntityStore::Slot EntityStore::upsert(const Entity& entity) {
+    Slot existing = m_slotById.find(entity.id);
+    if (existing != INVALID_SLOT) {
+        write(existing, entity);
+        m_grid.move(existing, entity.x, entity.y);
+        return existing;
+    }
+    
+    Slot slot = static_cast<Slot>(m_ids.size());
+    m_ids.push_back(entity.id);
+    m_x.emplace_back();
+    m_y.emplace_back();
+    m_z.emplace_back();
+    m_health.emplace_back();
+    m_maxHealth.emplace_back();
+    m_types.emplace_back();
+    m_flags.emplace_back();
+    m_levels.emplace_back();
+    m_threat.emplace_back();
+    m_nameIds.emplace_back();
+    m_lastSeen.emplace_back();
+    m_typeData.emplace_back();
+    
+    m_slotById.assign(entity.id, slot);
+    write(slot, entity);
+    m_grid.insert(slot, entity.x, entity.y);
+    return slot;
+}
+
+bool EntityStore::remove(uint64_t id) {
+    Slot slot = find(id);
+    if (slot == INVALID_SLOT) {
+        return false;
+    }
+    
+    removeAt(slot);
+    return true;
+}
+
+void EntityStore::removeAt(Slot slot) {
+    Slot last = static_cast<Slot>(m_ids.size() - 1);
+    m_slotById.erase(m_ids[slot]);
+    m_grid.remove(slot);
+    
+    if (slot != last) {
+        // Move the last entity into the hole so the columns stay packed
+        m_ids[slot] = m_ids[last];
+        m_x[slot] = m_x[last];
+        m_y[slot] = m_y[last];
+        m_z[slot] = m_z[last];
+        m_health[slot] = m_health[last];
+        m_maxHealth[slot] = m_maxHealth[last];
+        m_types[slot] = m_types[last];
+        m_flags[slot] = m_flags[last];
+        m_levels[slot] = m_levels[last];
+        m_threat[slot] = m_threat[last];
+        m_nameIds[slot] = m_nameIds[last];
+        m_lastSeen[slot] = m_lastSeen[last];
+        m_typeData[slot] = std::move(m_typeData[last]);
+        m_slotById.assign(m_ids[slot], slot);
+        m_grid.relocate(last, slot);
+    }
+    
+    m_ids.pop_back();
+    m_x.pop_back();
+    m_y.pop_back();
+    m_z.pop_back();
+    m_health.pop_back();
+    m_maxHealth.pop_back();
+    m_types.pop_back();
+    m_flags.pop_back();
+    m_levels.pop_back();
+    m_threat.pop_back();
+    m_nameIds.pop_back();
+    m_lastSeen.pop_back();
+    m_typeData.pop_back();
+}
+
+void EntityStore::clear() {
+    // Columns keep their capacity; interned names are kept so name ids stay valid
+    m_ids.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_health.clear();
+    m_maxHealth.clear();
+    m_types.clear();
+    m_flags.clear();
+    m_levels.clear();
+    m_threat.clear();
+    m_nameIds.clear();
+    m_lastSeen.clear();
+    m_typeData.clear();
+    m_slotById.clear();
+    m_grid.clear();
+}
+
+void EntityStore::reserve(size_t count) {
+    m_ids.reserve(count);
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_z.reserve(count);
+    m_health.reserve(count);
+    m_maxHealth.reserve(count);
+    m_types.reserve(count);
+    m_flags.reserve(count);
+    m_levels.reserve(count);
+    m_threat.reserve(count);
+    m_nameIds.reserve(count);
+    m_lastSeen.reserve(count);
+    m_typeData.reserve(count);
+    m_slotById.reserve(count);
+}
+
+EntityStore::Slot EntityStore::find(uint64_t id) const {
+    return m_slotById.find(id);
+}
+
+Entity EntityStore::get(Slot slot) const {
+    Entity entity;
+    entity.id = m_ids[slot];
+    entity.type = m_types[slot];
+    entity.x = m_x[slot];
+    entity.y = m_y[slot];
+    entity.z = m_z[slot];
+    entity.health = m_health[slot];
+    entity.maxHealth = m_maxHealth[slot];
+    entity.isAlive = (m_flags[slot] & FLAG_ALIVE) != 0;
+    entity.isTargetable = (m_flags[slot] & FLAG_TARGETABLE) != 0;
+    entity.isVisible = (m_flags[slot] & FLAG_VISIBLE) != 0;
+    entity.name = m_nameIds[slot];
+    entity.level = m_levels[slot];
+    entity.threatLevel = m_threat[slot];
+    entity.lastSeen = m_lastSeen[slot];
+    entity.data = m_typeData[slot];
+    return entity;
+}
+
+void EntityStore::refresh(Slot slot, float x, float y, float z, float health, bool isAlive, bool isTargetable,
+                          std::chrono::steady_clock::time_point seen) {
+    m_x[slot] = x;
+    m_y[slot] = y;
+    m_z[slot] = z;
+    m_health[slot] = health;
+    m_flags[slot] = static_cast<uint8_t>((m_flags[slot] & ~(FLAG_ALIVE | FLAG_TARGETABLE)) |
+                                         (isAlive ? FLAG_ALIVE : 0) |
+                                         (isTargetable ? FLAG_TARGETABLE : 0));
+    m_lastSeen[slot] = seen;
+    m_grid.move(slot, x, y);
+}
+
+void EntityStore::refreshStats(Slot slot, float maxHealth, int32_t level) {
+    m_maxHealth[slot] = maxHealth;
+    m_levels[slot] = level;
+}
+
+void EntityStore::write(Slot slot, const Entity& entity) {
+    m_x[slot] = entity.x;
+    m_y[slot] = entity.y;
+    m_z[slot] = entity.z;
+    m_health[slot] = entity.health;
+    m_maxHealth[slot] = entity.maxHealth;
+    m_types[slot] = entity.type;
+    m_flags[slot] = static_cast<uint8_t>((entity.isAlive ? FLAG_ALIVE : 0) |
+                                         (entity.isTargetable ? FLAG_TARGETABLE : 0) |
+                                         (entity.isVisible ? FLAG_VISIBLE : 0) |
+                                         (entity.data.monster.isElite ? FLAG_ELITE : 0));
+    m_levels[slot] = entity.level;
+    m_threat[slot] = entity.threatLevel;
+    m_nameIds[slot] = entity.name;
+    m_lastSeen[slot] = entity.lastSeen;
+    m_typeData[slot] = entity.data;
+}
+
+void EntityStore::setCellSize(float cellSize) {
+    m_grid.setCellSize(cellSize);
+    
+    for (Slot slot = 0; slot < m_ids.size(); ++slot) {
+        m_grid.insert(slot, m_x[slot], m_y[slot]);
+    }
+}
+
+bool EntityStore::anyInRadius(float x, float y, float radius, uint32_t typeMask, uint8_t requiredFlags) const {
+    bool found = false;
+    
+    // Type and flag bytes are checked before touching the position columns
+    float radiusSquared = radius * radius;
+    m_grid.forEachCandidate(x, y, radius, [&](Slot slot) {
+        if (!matchesType(slot, typeMask) || !hasFlags(slot, requiredFlags)) {
+            return true;
+        }
+        float dx = m_x[slot] - x;
+        float dy = m_y[slot] - y;
+        found = dx * dx + dy * dy <= radiusSquared;
+        return !found;
+    });
+    
+    return found;
+}
+
+template<typename Consider, typename Worst>
+void EntityStore::searchNearest(float x, float y, uint32_t typeMask, uint8_t requiredFlags, float maxRadius,
+                                Consider&& consider, Worst&& worstDistance) const {
+    float maxRadiusSquared = maxRadius * maxRadius;
+    
+    auto visit = [&](Slot slot) {
+        if (matchesType(slot, typeMask) && hasFlags(slot, requiredFlags)) {
+            float dx = m_x[slot] - x;
+            float dy = m_y[slot] - y;
+            float distanceSquared = dx * dx + dy * dy;
+            if (distanceSquared <= maxRadiusSquared) {
+                consider(slot, distanceSquared);
+            }
+        }
+        return true;
+    };
+    
+    int32_t centerX = m_grid.cellCoord(x);
+    int32_t centerY = m_grid.cellCoord(y);
+    float cellSize = m_grid.getCellSize();
+    
+    // Walking empty rings far from every entity costs more than a plain scan;
+    // give up on the grid once we've looked at more cells than there are entities
+    size_t cellBudget = m_ids.size() + 64;
+    size_t cellsVisited = 0;
+    
+    for (int32_t ring = 0; m_grid.ringInBounds(centerX, centerY, ring); ++ring) {
+        // Nothing in this ring can be closer than (ring - 1) cells
+        float ringDistance = ring > 0 ? (ring - 1) * cellSize : 0.0f;
+        if (ringDistance > maxRadius || ringDistance * ringDistance > worstDistance()) {
+            return;
+        }
+        
+        cellsVisited += ring > 0 ? static_cast<size_t>(ring) * 8 : 1;
+        if (cellsVisited > cellBudget) {
+            // Linear fallback over the columns; candidates already seen are offered
+            // again, which the callers handle by only keeping strictly better ones
+            for (Slot slot = 0; slot < m_ids.size(); ++slot) {
+                visit(slot);
+            }
+            return;
+        }
+        
+        m_grid.forEachInRing(centerX, centerY, ring, visit);
+    }
+}
+
+EntityStore::Slot EntityStore::findNearest(float x, float y, uint32_t typeMask, uint8_t requiredFlags,
+                                           float maxRadius) const {
+    Slot nearest = INVALID_SLOT;
+    float nearestDistance = std::numeric_limits<float>::infinity();
+    
+    searchNearest(x, y, typeMask, requiredFlags, maxRadius,
+        [&](Slot slot, float distanceSquared) {
+            if (distanceSquared < nearestDistance) {
+                nearestDistance = distanceSquared;
+                nearest = slot;
+            }
+        },
+        [&]() { return nearestDistance; });
+    
+    return nearest;
+}
+
+void EntityStore::findKNearest(float x, float y, size_t k, uint32_t typeMask, uint8_t requiredFlags,
+                               std::vector<Slot>& result, float maxRadius) const {
+    result.clear();
+    if (k == 0 || m_ids.empty()) {
+        return;
+    }
+    
+    // Max-heap on distance holding the best k so far
+    std::vector<std::pair<float, Slot>> best;
+    best.reserve(std::min(k, m_ids.size()) + 1);
+    
+    auto contains = [&](Slot slot) {
+        return std::any_of(best.begin(), best.end(), [slot](const auto& entry) { return entry.second == slot; });
+    };
+    
+    searchNearest(x, y, typeMask, requiredFlags, maxRadius,
+        [&](Slot slot, float distanceSquared) {
+            if (best.size() < k) {
+                if (contains(slot)) return;
+                best.emplace_back(distanceSquared, slot);
+                std::push_heap(best.begin(), best.end());
+            } else if (distanceSquared < best.front().first && !contains(slot)) {
+                std::pop_heap(best.begin(), best.end());
+                best.back() = {distanceSquared, slot};
+                std::push_heap(best.begin(), best.end());
+            }
+        },
+        [&]() { return best.size() < k ? std::numeric_limits<float>::infinity() : best.front().first; });
+    
+    std::sort_heap(best.begin(), best.end());
+    for (const auto& entry : best) {
+        result.push_back(entry.second);
+    }
+}
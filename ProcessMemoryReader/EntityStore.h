@@ -0,0 +1,236 @@
+#pragma once
+
+#include <vector>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+#include "FlatIndex.h"
+#include "SpatialGrid.h"
+#include "SymbolTable.h"
+
+enum class EntityType : uint8_t {
+    UNKNOWN,
+    PLAYER,
+    MONSTER,
+    BOSS,
+    NPC,
+    ITEM,
+    CHEST,
+    PORTAL,
+    WAYPOINT,
+    SEASONAL_OBJECT
+};
+
+/**
+ * @brief Bit for an entity type in a type mask
+ */
+constexpr uint32_t entityTypeBit(EntityType type) {
+    return 1u << static_cast<uint32_t>(type);
+}
+
+/**
+ * @brief Self-contained copy of one entity, as returned by EntityManager queries
+ */
+struct Entity {
+    uint64_t id = 0;                   // Unique entity identifier
+    EntityType type = EntityType::UNKNOWN; // Type of entity
+    float x = 0, y = 0, z = 0;         // World position
+    float health = 0, maxHealth = 0;   // Health values (for living entities)
+    bool isAlive = false;              // Alive status
+    bool isTargetable = false;         // Can be targeted
+    bool isVisible = false;            // Visible on screen
+    SymbolId name = SymbolTable::EMPTY; // Entity name/identifier (SymbolTable::global())
+    int level = 0;                     // Entity level (for monsters/NPCs)
+    float threatLevel = 0;             // Calculated threat (for monsters)
+    std::chrono::time_point<std::chrono::steady_clock> lastSeen; // Last detection time
+    
+    // Type-specific data; strings are interned, so the whole struct is
+    // trivially copyable and snapshot copies never allocate
+    struct TypeData {
+        struct { // For monsters
+            bool isElite = false;
+            bool isBoss = false;
+            float attackRange = 0;
+            float movementSpeed = 0;
+        } monster;
+        
+        struct { // For items
+            int rarity = 0;            // Item rarity level
+            SymbolId itemType = SymbolTable::EMPTY; // Type of item
+            bool isFiltered = false;   // Matches loot filter
+        } item;
+        
+        struct { // For seasonal objects
+            SymbolId eventType = SymbolTable::EMPTY;
+            bool isInteractable = false;
+            float interactionRange = 0;
+        } seasonal;
+    } data;
+};
+
+/**
+ * @class EntityStore
+ * @brief Structure-of-arrays entity table
+ *
+ * Every field the per-tick queries touch (position, health, type, flags) lives
+ * in its own contiguous column indexed by slot, so distance and type filters
+ * stream over packed arrays instead of chasing hash-map nodes. An open-addressing
+ * id->slot index (FlatIndex) gives O(1) lookup; removal swaps the last slot into
+ * the hole, so slots are only stable until the next removal. Names are stored
+ * per slot as a SymbolId; the rarely used type-specific data is kept in a
+ * separate cold column. No column holds a string and the index and grid are
+ * flat arrays too, so copying the store (as every snapshot does) is a sequence
+ * of flat vector copies.
+ *
+ * A uniform SpatialGrid is kept in sync on every upsert/remove, so radius,
+ * nearest and k-nearest queries only visit cells overlapping the query.
+ */
+class EntityStore {
+public:
+    using Slot = uint32_t;
+    static constexpr Slot INVALID_SLOT = std::numeric_limits<Slot>::max();
+    static_assert(INVALID_SLOT == FlatIndex::NONE, "find() returns the index's NONE as INVALID_SLOT");
+
+    enum Flags : uint8_t {
+        FLAG_ALIVE      = 1 << 0,
+        FLAG_TARGETABLE = 1 << 1,
+        FLAG_VISIBLE    = 1 << 2,
+        FLAG_ELITE      = 1 << 3
+    };
+
+private:
+    // Hot columns
+    std::vector<uint64_t> m_ids;
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_z;
+    std::vector<float> m_health;
+    std::vector<float> m_maxHealth;
+    std::vector<EntityType> m_types;
+    std::vector<uint8_t> m_flags;
+    std::vector<int32_t> m_levels;
+    std::vector<float> m_threat;
+
+    // Cold columns
+    std::vector<SymbolId> m_nameIds;
+    std::vector<std::chrono::steady_clock::time_point> m_lastSeen;
+    std::vector<Entity::TypeData> m_typeData;
+
+    FlatIndex m_slotById;   // id -> slot, open addressing
+    SpatialGrid m_grid;
+
+public:
+    EntityStore();
+
+    /**
+     * @brief Insert an entity, or overwrite the one with the same id
+     * @return The slot holding the entity
+     */
+    Slot upsert(const Entity& entity);
+
+    /**
+     * @brief Remove an entity by id
+     * @return true if it was present
+     * @note The last slot is moved into the freed one
+     */
+    bool remove(uint64_t id);
+    void removeAt(Slot slot);
+
+    void clear();
+    void reserve(size_t count);
+    
+    /**
+     * @brief Overwrite only the per-tick fields of an existing slot
+     *
+     * Used by the delta scan for entities that were already parsed: name, type,
+     * level and type data are left untouched.
+     */
+    void refresh(Slot slot, float x, float y, float z, float health, bool isAlive, bool isTargetable,
+                 std::chrono::steady_clock::time_point seen);
+    void refreshStats(Slot slot, float maxHealth, int32_t level);
+
+    Slot find(uint64_t id) const;
+    bool contains(uint64_t id) const { return find(id) != INVALID_SLOT; }
+    size_t size() const { return m_ids.size(); }
+    bool empty() const { return m_ids.empty(); }
+
+    /**
+     * @brief Materialize a slot into a standalone Entity
+     */
+    Entity get(Slot slot) const;
+
+    // Column access (valid for slots [0, size()))
+    const uint64_t* ids() const { return m_ids.data(); }
+    const float* xs() const { return m_x.data(); }
+    const float* ys() const { return m_y.data(); }
+    const float* zs() const { return m_z.data(); }
+    const float* healths() const { return m_health.data(); }
+    const float* maxHealths() const { return m_maxHealth.data(); }
+    const EntityType* types() const { return m_types.data(); }
+    const uint8_t* flags() const { return m_flags.data(); }
+    const int32_t* levels() const { return m_levels.data(); }
+    const float* threatLevels() const { return m_threat.data(); }
+    std::chrono::steady_clock::time_point lastSeen(Slot slot) const { return m_lastSeen[slot]; }
+    const Entity::TypeData& typeData(Slot slot) const { return m_typeData[slot]; }
+
+    bool hasFlags(Slot slot, uint8_t flags) const { return (m_flags[slot] & flags) == flags; }
+    bool matchesType(Slot slot, uint32_t typeMask) const { return (entityTypeBit(m_types[slot]) & typeMask) != 0; }
+
+    // Names
+    const std::string& nameOf(Slot slot) const { return SymbolTable::global().name(m_nameIds[slot]); }
+    SymbolId nameIdOf(Slot slot) const { return m_nameIds[slot]; }
+
+    // ============ SPATIAL QUERIES ============
+
+    /**
+     * @brief Set the grid cell size (re-indexes all entities)
+     * A cell roughly the size of the typical query radius keeps queries to a few cells.
+     */
+    void setCellSize(float cellSize);
+    float getCellSize() const { return m_grid.getCellSize(); }
+
+    /**
+     * @brief Call fn(slot) for every entity within radius of (x, y)
+     * @param fn Returns false to stop the walk early
+     */
+    template<typename Fn>
+    void forEachInRadius(float x, float y, float radius, Fn&& fn) const {
+        float radiusSquared = radius * radius;
+        m_grid.forEachCandidate(x, y, radius, [&](Slot slot) {
+            float dx = m_x[slot] - x;
+            float dy = m_y[slot] - y;
+            return dx * dx + dy * dy > radiusSquared || fn(slot);
+        });
+    }
+
+    /**
+     * @brief Whether any entity of the given types (and with all requiredFlags) is within radius
+     */
+    bool anyInRadius(float x, float y, float radius, uint32_t typeMask, uint8_t requiredFlags = 0) const;
+
+    /**
+     * @brief Nearest entity of the given types (and with all requiredFlags)
+     * @return INVALID_SLOT if none is within maxRadius
+     */
+    Slot findNearest(float x, float y, uint32_t typeMask, uint8_t requiredFlags = 0,
+                     float maxRadius = std::numeric_limits<float>::infinity()) const;
+
+    /**
+     * @brief Up to k nearest entities of the given types, closest first
+     * @param result Receives the slots (cleared first; its capacity is reused)
+     */
+    void findKNearest(float x, float y, size_t k, uint32_t typeMask, uint8_t requiredFlags,
+                      std::vector<Slot>& result, float maxRadius = std::numeric_limits<float>::infinity()) const;
+
+private:
+    void write(Slot slot, const Entity& entity);
+
+    /**
+     * @brief Ring-by-ring nearest neighbour walk shared by findNearest/findKNearest
+     * @param consider Called with (slot, distanceSquared) for matching entities inside maxRadius
+     * @param worstDistance Returns the squared distance a new candidate must beat (infinity while not full)
+     */
+    template<typename Consider, typename Worst>
+    void searchNearest(float x, float y, uint32_t typeMask, uint8_t requiredFlags, float maxRadius,
+                       Consider&& consider, Worst&& worstDistance) const;
+};
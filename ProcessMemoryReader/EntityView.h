@@ -0,0 +1,141 @@
+#pragma once
+
+#include "EntityStore.h"
+#include <iterator>
+#include <optional>
+
+/**
+ * @class EntityView
+ * @brief Non-owning handle to one entity inside an EntityStore
+ *
+ * Reads go straight to the store's columns; nothing is copied until
+ * materialize() is called. A view is valid until the store is modified
+ * (for the decision loop: until the next snapshot is applied).
+ */
+class EntityView {
+public:
+    using Slot = EntityStore::Slot;
+
+private:
+    const EntityStore* m_store;
+    Slot m_slot;
+
+public:
+    EntityView(const EntityStore* store, Slot slot) : m_store(store), m_slot(slot) {}
+
+    Slot slot() const { return m_slot; }
+    uint64_t id() const { return m_store->ids()[m_slot]; }
+    EntityType type() const { return m_store->types()[m_slot]; }
+    float x() const { return m_store->xs()[m_slot]; }
+    float y() const { return m_store->ys()[m_slot]; }
+    float z() const { return m_store->zs()[m_slot]; }
+    float health() const { return m_store->healths()[m_slot]; }
+    float maxHealth() const { return m_store->maxHealths()[m_slot]; }
+    int level() const { return m_store->levels()[m_slot]; }
+    float threatLevel() const { return m_store->threatLevels()[m_slot]; }
+    bool isAlive() const { return m_store->hasFlags(m_slot, EntityStore::FLAG_ALIVE); }
+    bool isTargetable() const { return m_store->hasFlags(m_slot, EntityStore::FLAG_TARGETABLE); }
+    bool isVisible() const { return m_store->hasFlags(m_slot, EntityStore::FLAG_VISIBLE); }
+    const std::string& name() const { return m_store->nameOf(m_slot); }
+    SymbolId nameId() const { return m_store->nameIdOf(m_slot); }
+    const Entity::TypeData& data() const { return m_store->typeData(m_slot); }
+
+    float distanceSquaredTo(float px, float py) const {
+        float dx = x() - px;
+        float dy = y() - py;
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     * @brief Copy the entity out of the store
+     */
+    Entity materialize() const { return m_store->get(m_slot); }
+};
+
+/**
+ * @class EntityRange
+ * @brief Lazy, allocation-free range over the entities matching a type mask and flags
+ *
+ * Usage:
+ *   for (EntityView enemy : entityManager->targetableEnemies()) { ... }
+ *
+ * Matching is evaluated while iterating, on the packed type/flag columns.
+ */
+class EntityRange {
+public:
+    using Slot = EntityStore::Slot;
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = EntityView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = EntityView;
+
+        iterator(const EntityStore* store, uint32_t typeMask, uint8_t requiredFlags, Slot slot, Slot end)
+            : m_store(store), m_typeMask(typeMask), m_requiredFlags(requiredFlags), m_slot(slot), m_end(end) {
+            skip();
+        }
+
+        EntityView operator*() const { return EntityView(m_store, m_slot); }
+        iterator& operator++() { ++m_slot; skip(); return *this; }
+        iterator operator++(int) { iterator previous = *this; ++*this; return previous; }
+        bool operator==(const iterator& other) const { return m_slot == other.m_slot; }
+        bool operator!=(const iterator& other) const { return m_slot != other.m_slot; }
+
+    private:
+        void skip() {
+            while (m_slot < m_end && 
+                   !(m_store->matchesType(m_slot, m_typeMask) && m_store->hasFlags(m_slot, m_requiredFlags))) {
+                ++m_slot;
+            }
+        }
+
+        // Copied from the range so iterators stay usable after a temporary range is gone
+        const EntityStore* m_store;
+        uint32_t m_typeMask;
+        uint8_t m_requiredFlags;
+        Slot m_slot;
+        Slot m_end;
+    };
+
+private:
+    const EntityStore* m_store;
+    uint32_t m_typeMask;
+    uint8_t m_requiredFlags;
+    Slot m_end;
+
+public:
+    EntityRange(const EntityStore* store, uint32_t typeMask, uint8_t requiredFlags = 0)
+        : m_store(store), m_typeMask(typeMask), m_requiredFlags(requiredFlags),
+          m_end(static_cast<Slot>(store->size())) {}
+
+    iterator begin() const { return iterator(m_store, m_typeMask, m_requiredFlags, 0, m_end); }
+    iterator end() const { return iterator(m_store, m_typeMask, m_requiredFlags, m_end, m_end); }
+
+    bool matches(Slot slot) const {
+        return m_store->matchesType(slot, m_typeMask) && m_store->hasFlags(slot, m_requiredFlags);
+    }
+
+    bool empty() const { return begin() == end(); }
+
+    size_t count() const {
+        size_t total = 0;
+        for (Slot slot = 0; slot < m_end; ++slot) {
+            total += matches(slot) ? 1 : 0;
+        }
+        return total;
+    }
+
+    /**
+     * @brief First match, if any (no allocation)
+     */
+    std::optional<EntityView> front() const {
+        iterator it = begin();
+        if (it == end()) {
+            return std::nullopt;
+        }
+        return *it;
+    }
+};
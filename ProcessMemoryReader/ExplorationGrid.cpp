@@ -0,0 +1,175 @@
+#include "ExplorationGrid.h"
+#include <cmath>
+
+namespace {
+    inline int popcount(uint64_t value) {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(value));
+#else
+        return __builtin_popcountll(value);
+#endif
+    }
+
+    // Bits [from, to] of a word, both in 0..63
+    inline uint64_t spanMask(int32_t from, int32_t to) {
+        uint64_t high = to == 63 ? ~uint64_t{0} : (uint64_t{1} << (to + 1)) - 1;
+        return high & (~uint64_t{0} << from);
+    }
+
+    constexpr uint64_t BLOCK_LANE = (uint64_t{1} << ExplorationGrid::BLOCK_SIZE) - 1;
+}
+
+ExplorationGrid::ExplorationGrid(int32_t width, int32_t height) {
+    resize(width, height);
+}
+
+void ExplorationGrid::resize(int32_t width, int32_t height) {
+    m_width = std::max(width, 0);
+    m_height = std::max(height, 0);
+    m_wordsPerRow = (static_cast<size_t>(m_width) + 63) / 64;
+    m_blocksX = (m_width + BLOCK_SIZE - 1) >> BLOCK_SHIFT;
+    m_blocksY = (m_height + BLOCK_SIZE - 1) >> BLOCK_SHIFT;
+
+    m_explored.assign(m_wordsPerRow * m_height, 0);
+    m_frontier.assign(m_wordsPerRow * m_height, 0);
+    m_blockFrontier.assign(static_cast<size_t>(m_blocksX) * m_blocksY, 0);
+    m_exploredCount = 0;
+    m_frontierCount = 0;
+}
+
+void ExplorationGrid::clear() {
+    std::fill(m_explored.begin(), m_explored.end(), 0);
+    std::fill(m_frontier.begin(), m_frontier.end(), 0);
+    std::fill(m_blockFrontier.begin(), m_blockFrontier.end(), 0);
+    m_exploredCount = 0;
+    m_frontierCount = 0;
+}
+
+int32_t ExplorationGrid::rowHalfWidth(int32_t dy, float radius) const {
+    float remaining = radius * radius - static_cast<float>(dy) * dy;
+    return remaining < 0 ? -1 : static_cast<int32_t>(std::sqrt(remaining));
+}
+
+size_t ExplorationGrid::markDisk(int32_t centerX, int32_t centerY, float radius) {
+    if (m_width == 0 || m_height == 0 || radius < 0) {
+        return 0;
+    }
+
+    int32_t reach = static_cast<int32_t>(radius);
+    int32_t minY = std::max(centerY - reach, 0);
+    int32_t maxY = std::min(centerY + reach, m_height - 1);
+    int32_t minX = std::max(centerX - reach, 0);
+    int32_t maxX = std::min(centerX + reach, m_width - 1);
+    if (minY > maxY || minX > maxX) {
+        return 0;
+    }
+
+    size_t added = 0;
+    for (int32_t y = minY; y <= maxY; ++y) {
+        int32_t halfWidth = rowHalfWidth(y - centerY, radius);
+        int32_t from = std::max(centerX - halfWidth, 0);
+        int32_t to = std::min(centerX + halfWidth, m_width - 1);
+        if (halfWidth < 0 || from > to) {
+            continue;
+        }
+
+        uint64_t* row = &m_explored[static_cast<size_t>(y) * m_wordsPerRow];
+        for (int32_t word = from >> 6; word <= (to >> 6); ++word) {
+            uint64_t mask = spanMask(word == (from >> 6) ? from & 63 : 0, word == (to >> 6) ? to & 63 : 63);
+            added += popcount(mask & ~row[word]);
+            row[word] |= mask;
+        }
+    }
+    m_exploredCount += added;
+
+    if (added != 0) {
+        // Only cells next to a changed cell can change frontier state
+        updateFrontier(std::max(minY - 1, 0), std::min(maxY + 1, m_height - 1),
+                       static_cast<size_t>(std::max(minX - 1, 0)) / 64,
+                       static_cast<size_t>(std::min(maxX + 1, m_width - 1)) / 64);
+    }
+    return added;
+}
+
+float ExplorationGrid::getDiskCoverage(int32_t centerX, int32_t centerY, float radius) const {
+    if (m_width == 0 || m_height == 0 || radius < 0) {
+        return 0.0f;
+    }
+
+    int32_t reach = static_cast<int32_t>(radius);
+    size_t total = 0;
+    size_t explored = 0;
+    for (int32_t y = std::max(centerY - reach, 0); y <= std::min(centerY + reach, m_height - 1); ++y) {
+        int32_t halfWidth = rowHalfWidth(y - centerY, radius);
+        int32_t from = std::max(centerX - halfWidth, 0);
+        int32_t to = std::min(centerX + halfWidth, m_width - 1);
+        if (halfWidth < 0 || from > to) {
+            continue;
+        }
+
+        const uint64_t* row = &m_explored[static_cast<size_t>(y) * m_wordsPerRow];
+        for (int32_t word = from >> 6; word <= (to >> 6); ++word) {
+            uint64_t mask = spanMask(word == (from >> 6) ? from & 63 : 0, word == (to >> 6) ? to & 63 : 63);
+            explored += popcount(mask & row[word]);
+        }
+        total += static_cast<size_t>(to - from + 1);
+    }
+    return total == 0 ? 0.0f : static_cast<float>(explored) / total;
+}
+
+size_t ExplorationGrid::recount() {
+    m_exploredCount = 0;
+    for (uint64_t word : m_explored) {
+        m_exploredCount += popcount(word);
+    }
+    if (m_height > 0 && m_wordsPerRow > 0) {
+        updateFrontier(0, m_height - 1, 0, m_wordsPerRow - 1);
+    }
+    return m_exploredCount;
+}
+
+void ExplorationGrid::updateFrontier(int32_t minY, int32_t maxY, size_t firstWord, size_t lastWord) {
+    // Padding bits past the last column never count as cells
+    uint64_t lastWordMask = (m_width & 63) == 0 ? ~uint64_t{0} : (uint64_t{1} << (m_width & 63)) - 1;
+
+    for (int32_t y = minY; y <= maxY; ++y) {
+        const uint64_t* row = &m_explored[static_cast<size_t>(y) * m_wordsPerRow];
+        const uint64_t* above = y > 0 ? row - m_wordsPerRow : nullptr;
+        const uint64_t* below = y + 1 < m_height ? row + m_wordsPerRow : nullptr;
+        uint64_t* frontierRow = &m_frontier[static_cast<size_t>(y) * m_wordsPerRow];
+
+        for (size_t word = firstWord; word <= lastWord; ++word) {
+            uint64_t explored = row[word];
+            uint64_t previous = word > 0 ? row[word - 1] : 0;
+            uint64_t next = word + 1 < m_wordsPerRow ? row[word + 1] : 0;
+
+            // An explored neighbour on the left, right, above or below
+            uint64_t neighbours = (explored << 1) | (previous >> 63) | (explored >> 1) | (next << 63);
+            if (above) neighbours |= above[word];
+            if (below) neighbours |= below[word];
+
+            uint64_t frontier = ~explored & neighbours;
+            if (word + 1 == m_wordsPerRow) {
+                frontier &= lastWordMask;
+            }
+
+            uint64_t old = frontierRow[word];
+            if (frontier == old) {
+                continue;
+            }
+            frontierRow[word] = frontier;
+
+            // Keep the per-block counts in step, one 16-bit lane per block
+            size_t blockRow = static_cast<size_t>(y >> BLOCK_SHIFT) * m_blocksX;
+            for (int32_t lane = 0; lane < 64 / BLOCK_SIZE; ++lane) {
+                int32_t shift = lane * BLOCK_SIZE;
+                int delta = popcount((frontier >> shift) & BLOCK_LANE) - popcount((old >> shift) & BLOCK_LANE);
+                if (delta != 0) {
+                    size_t block = blockRow + (word * 64 + shift) / BLOCK_SIZE;
+                    m_blockFrontier[block] = static_cast<uint16_t>(m_blockFrontier[block] + delta);
+                    m_frontierCount = static_cast<size_t>(static_cast<ptrdiff_t>(m_frontierCount) + delta);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @class ExplorationGrid
+ * @brief Explored-cell bitset with a maintained frontier for exploration targets
+ *
+ * Cells are bits in 64-bit words, each row padded to whole words. Marking a
+ * disk sets one row span per row with word masks, and the explored count is
+ * kept up to date from the popcount of the newly set bits, so progress is
+ * O(1) and area coverage is a handful of popcounts per row.
+ *
+ * The frontier is every unexplored cell with an explored 4-neighbour - where
+ * the explored region can grow. It is a second bitset, updated only around
+ * the marked disk, plus a frontier count per 16x16 block. Finding the nearest
+ * frontier cell walks rings of blocks outward from the query and stops once
+ * the ring is farther than the best cell found, so the cost depends on the
+ * distance to the frontier, not on the map size.
+ */
+class ExplorationGrid {
+public:
+    struct Cell {
+        int32_t x = 0, y = 0;
+    };
+
+    static constexpr int32_t BLOCK_SHIFT = 4;
+    static constexpr int32_t BLOCK_SIZE = 1 << BLOCK_SHIFT;   // Cells per block side; divides 64
+
+private:
+    int32_t m_width = 0;
+    int32_t m_height = 0;
+    size_t m_wordsPerRow = 0;
+    std::vector<uint64_t> m_explored;
+    std::vector<uint64_t> m_frontier;
+    size_t m_exploredCount = 0;
+
+    int32_t m_blocksX = 0;
+    int32_t m_blocksY = 0;
+    std::vector<uint16_t> m_blockFrontier;    // Frontier cells per block
+    size_t m_frontierCount = 0;
+
+public:
+    ExplorationGrid() = default;
+    ExplorationGrid(int32_t width, int32_t height);
+
+    /**
+     * @brief Resize and forget everything explored
+     */
+    void resize(int32_t width, int32_t height);
+    void clear();
+
+    int32_t getWidth() const { return m_width; }
+    int32_t getHeight() const { return m_height; }
+    bool isValid(int32_t x, int32_t y) const { return x >= 0 && y >= 0 && x < m_width && y < m_height; }
+
+    bool isExplored(int32_t x, int32_t y) const {
+        return isValid(x, y) && (m_explored[wordIndex(x, y)] >> (x & 63) & 1) != 0;
+    }
+    bool isFrontier(int32_t x, int32_t y) const {
+        return isValid(x, y) && (m_frontier[wordIndex(x, y)] >> (x & 63) & 1) != 0;
+    }
+
+    /**
+     * @brief Mark every cell within radius (in cells) of the centre as explored
+     * @return Number of cells that were newly explored
+     */
+    size_t markDisk(int32_t centerX, int32_t centerY, float radius);
+
+    /**
+     * @brief Explored share of the cells within radius of the centre (0 if none are on the grid)
+     */
+    float getDiskCoverage(int32_t centerX, int32_t centerY, float radius) const;
+
+    size_t getExploredCount() const { return m_exploredCount; }
+    size_t getFrontierCount() const { return m_frontierCount; }
+    float getProgress() const {
+        size_t total = static_cast<size_t>(m_width) * m_height;
+        return total == 0 ? 0.0f : static_cast<float>(m_exploredCount) / total;
+    }
+
+    /**
+     * @brief Nearest frontier cell to (x, y) that accept(cell) allows
+     * @param accept Filter for cells the caller cannot use (e.g. not walkable)
+     * @return false if there is no acceptable frontier cell
+     */
+    template<typename Accept>
+    bool findNearestFrontier(int32_t x, int32_t y, Cell& result, Accept&& accept) const;
+
+    bool findNearestFrontier(int32_t x, int32_t y, Cell& result) const {
+        return findNearestFrontier(x, y, result, [](const Cell&) { return true; });
+    }
+
+    /**
+     * @brief Recount explored cells from the bitset (after bulk edits)
+     */
+    size_t recount();
+
+private:
+    size_t wordIndex(int32_t x, int32_t y) const { return static_cast<size_t>(y) * m_wordsPerRow + (x >> 6); }
+    int32_t rowHalfWidth(int32_t dy, float radius) const;
+
+    // Recompute the frontier words [firstWord, lastWord] of rows [minY, maxY] from the explored bits
+    void updateFrontier(int32_t minY, int32_t maxY, size_t firstWord, size_t lastWord);
+
+    // Frontier bits of one block row as a 16-bit mask (bit i = cell blockX*16+i)
+    uint32_t blockRowBits(int32_t blockX, int32_t y) const {
+        uint64_t word = m_frontier[static_cast<size_t>(y) * m_wordsPerRow + ((blockX << BLOCK_SHIFT) >> 6)];
+        return static_cast<uint32_t>(word >> ((blockX << BLOCK_SHIFT) & 63)) & ((1u << BLOCK_SIZE) - 1);
+    }
+
+    static int32_t countTrailingZeros(uint32_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return static_cast<int32_t>(index);
+#else
+        return __builtin_ctz(value);
+#endif
+    }
+};
+
+template<typename Accept>
+bool ExplorationGrid::findNearestFrontier(int32_t x, int32_t y, Cell& result, Accept&& accept) const {
+    if (m_frontierCount == 0) {
+        return false;
+    }
+
+    int32_t centerBlockX = (x < 0 ? 0 : x >= m_width ? m_width - 1 : x) >> BLOCK_SHIFT;
+    int32_t centerBlockY = (y < 0 ? 0 : y >= m_height ? m_height - 1 : y) >> BLOCK_SHIFT;
+    int32_t maxRing = std::max(std::max(centerBlockX, m_blocksX - 1 - centerBlockX),
+                               std::max(centerBlockY, m_blocksY - 1 - centerBlockY));
+
+    int64_t bestDistance = std::numeric_limits<int64_t>::max();
+    bool found = false;
+
+    auto visitBlock = [&](int32_t blockX, int32_t blockY) {
+        if (blockX < 0 || blockY < 0 || blockX >= m_blocksX || blockY >= m_blocksY ||
+            m_blockFrontier[static_cast<size_t>(blockY) * m_blocksX + blockX] == 0) {
+            return;
+        }
+        int32_t rowEnd = std::min((blockY + 1) << BLOCK_SHIFT, m_height);
+        for (int32_t cy = blockY << BLOCK_SHIFT; cy < rowEnd; ++cy) {
+            for (uint32_t bits = blockRowBits(blockX, cy); bits != 0; bits &= bits - 1) {
+                Cell cell{(blockX << BLOCK_SHIFT) + countTrailingZeros(bits), cy};
+                int64_t dx = cell.x - x;
+                int64_t dy = cell.y - y;
+                int64_t distance = dx * dx + dy * dy;
+                if (distance < bestDistance && accept(cell)) {
+                    bestDistance = distance;
+                    result = cell;
+                    found = true;
+                }
+            }
+        }
+    };
+
+    for (int32_t ring = 0; ring <= maxRing; ++ring) {
+        // Every cell in this ring is at least (ring - 1) blocks away from the query
+        if (found && ring > 0) {
+            int64_t nearest = static_cast<int64_t>(ring - 1) * BLOCK_SIZE;
+            if (nearest * nearest >= bestDistance) {
+                break;
+            }
+        }
+
+        if (ring == 0) {
+            visitBlock(centerBlockX, centerBlockY);
+            continue;
+        }
+        for (int32_t bx = centerBlockX - ring; bx <= centerBlockX + ring; ++bx) {
+            visitBlock(bx, centerBlockY - ring);
+            visitBlock(bx, centerBlockY + ring);
+        }
+        for (int32_t by = centerBlockY - ring + 1; by <= centerBlockY + ring - 1; ++by) {
+            visitBlock(centerBlockX - ring, by);
+            visitBlock(centerBlockX + ring, by);
+        }
+    }
+
+    return found;
+}
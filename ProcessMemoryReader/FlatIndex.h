@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class FlatIndex
+ * @brief Open-addressing map from 64-bit keys to 32-bit values in one flat array
+ *
+ * Linear probing over a power-of-two table that is kept at most half full.
+ * Erasing shifts the rest of the probe run back instead of leaving
+ * tombstones, so lookups never slow down with churn. A key and its value share
+ * a bucket, so a probe touches one cache line. The table is a plain vector:
+ * copy-assigning an index into one that already has the capacity (as every
+ * snapshot copy does after the first) does not allocate.
+ */
+class FlatIndex {
+public:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;   // Marks an empty bucket; cannot be stored as a value
+
+private:
+    struct Bucket {
+        uint64_t key = 0;
+        uint32_t value = NONE;
+    };
+
+    std::vector<Bucket> m_buckets;
+    size_t m_size = 0;
+    size_t m_mask = 0;
+    int m_shift = 64;
+
+public:
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /**
+     * @return The value stored for key, or NONE
+     */
+    uint32_t find(uint64_t key) const {
+        if (m_size == 0) {
+            return NONE;
+        }
+        for (size_t i = bucket(key);; i = (i + 1) & m_mask) {
+            const Bucket& entry = m_buckets[i];
+            if (entry.value == NONE || entry.key == key) {
+                return entry.value;
+            }
+        }
+    }
+
+    void assign(uint64_t key, uint32_t value) {
+        if ((m_size + 1) * 2 > m_buckets.size()) {
+            rehash((m_size + 1) * 2);
+        }
+        for (size_t i = bucket(key);; i = (i + 1) & m_mask) {
+            Bucket& entry = m_buckets[i];
+            if (entry.value == NONE) {
+                entry.key = key;
+                entry.value = value;
+                ++m_size;
+                return;
+            }
+            if (entry.key == key) {
+                entry.value = value;
+                return;
+            }
+        }
+    }
+
+    bool erase(uint64_t key) {
+        if (m_size == 0) {
+            return false;
+        }
+        size_t hole = bucket(key);
+        while (m_buckets[hole].key != key || m_buckets[hole].value == NONE) {
+            if (m_buckets[hole].value == NONE) {
+                return false;
+            }
+            hole = (hole + 1) & m_mask;
+        }
+
+        // Pull back every later entry whose home bucket does not lie between the hole and itself
+        for (size_t i = (hole + 1) & m_mask; m_buckets[i].value != NONE; i = (i + 1) & m_mask) {
+            if (((i - bucket(m_buckets[i].key)) & m_mask) >= ((i - hole) & m_mask)) {
+                m_buckets[hole] = m_buckets[i];
+                hole = i;
+            }
+        }
+        m_buckets[hole].value = NONE;
+        --m_size;
+        return true;
+    }
+
+    // Keeps the table size
+    void clear() {
+        for (Bucket& entry : m_buckets) {
+            entry.value = NONE;
+        }
+        m_size = 0;
+    }
+
+    void reserve(size_t count) {
+        if (count * 2 > m_buckets.size()) {
+            rehash(count * 2);
+        }
+    }
+
+private:
+    size_t bucket(uint64_t key) const {
+        // Fibonacci hashing: the top bits of the product are well mixed even for sequential ids
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    void rehash(size_t minBuckets) {
+        size_t buckets = 16;
+        int shift = 60;
+        while (buckets < minBuckets) {
+            buckets <<= 1;
+            --shift;
+        }
+
+        std::vector<Bucket> previous(buckets);
+        previous.swap(m_buckets);
+        m_mask = buckets - 1;
+        m_shift = shift;
+        m_size = 0;
+
+        for (const Bucket& entry : previous) {
+            if (entry.value != NONE) {
+                assign(entry.key, entry.value);
+            }
+        }
+    }
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "RemoteStruct.h"
+#include <cstdint>
+
+/**
+ * Compile-time memory layouts of the game structures we read
+ * These need to be updated via reverse engineering after game patches
+ */
+
+// Player object layout (relative to the player base address)
+// Defaults only: GameState reads these fields at the OffsetManager's PLAYER_* offsets
+struct PlayerLayout {
+    using PositionX      = RemoteField<float, 0x00>;
+    using PositionY      = RemoteField<float, 0x04>;
+    using PositionZ      = RemoteField<float, 0x08>;
+    using Health         = RemoteField<float, 0x10>;
+    using MaxHealth      = RemoteField<float, 0x14>;
+    using Mana           = RemoteField<float, 0x18>;
+    using MaxMana        = RemoteField<float, 0x1C>;
+    using Level          = RemoteField<int, 0x20>;
+    using InCombat       = RemoteField<bool, 0x24>;
+    using IsDead         = RemoteField<bool, 0x28>;
+    using MovementSpeed  = RemoteField<float, 0x2C>;
+    using CharacterClass = RemoteField<int, 0x30>;
+
+    using Block = RemoteStruct<PositionX, PositionY, PositionZ, Health, MaxHealth,
+                               Mana, MaxMana, Level, InCombat, IsDead,
+                               MovementSpeed, CharacterClass>;
+
+    // Per-pass fields; Level doubles as the key that triggers a full Block re-read
+    using HotBlock = RemoteStruct<PositionX, PositionY, PositionZ, Health, Mana,
+                                  Level, InCombat, IsDead, MovementSpeed>;
+};
+
+// Map data layout (relative to the map data address)
+struct MapLayout {
+    using MapId             = RemoteField<uint32_t, 0x00>;
+    using Tier              = RemoteField<int, 0x04>;
+    using IsCompleted       = RemoteField<bool, 0x08>;
+    using CompletionPercent = RemoteField<float, 0x0C>;
+    using HasBoss           = RemoteField<bool, 0x10>;
+    using BossDefeated      = RemoteField<bool, 0x11>;
+
+    static constexpr uintptr_t nameOffset = 0x20;   // Inline name string, read when MapId changes
+    static constexpr size_t maxNameLength = 64;
+
+    using StatusBlock = RemoteStruct<MapId, Tier, IsCompleted, CompletionPercent, HasBoss, BossDefeated>;
+};
+
+// Season data layout (relative to the season data address)
+struct SeasonLayout {
+    using SeasonLevel    = RemoteField<int, 0x00>;
+    using HasActiveEvent = RemoteField<bool, 0x04>;
+    using EventId        = RemoteField<uint32_t, 0x08>;
+
+    static constexpr uintptr_t seasonNameOffset = 0x20;  // Strings are read when EventId changes
+    static constexpr uintptr_t eventTypeOffset = 0x60;
+    static constexpr size_t maxNameLength = 64;
+
+    using StatusBlock = RemoteStruct<SeasonLevel, HasActiveEvent, EventId>;
+};
+
+// Entity object layout (relative to the entity address)
+struct EntityLayout {
+    using Id           = RemoteField<uint64_t, 0x08>;
+    using Type         = RemoteField<uint32_t, 0x10>;
+    using PositionX    = RemoteField<float, 0x20>;
+    using PositionY    = RemoteField<float, 0x24>;
+    using PositionZ    = RemoteField<float, 0x28>;
+    using Health       = RemoteField<float, 0x40>;
+    using MaxHealth    = RemoteField<float, 0x44>;
+    using IsAlive      = RemoteField<bool, 0x48>;
+    using IsTargetable = RemoteField<bool, 0x4C>;
+    using Level        = RemoteField<int, 0x60>;
+
+    static constexpr uintptr_t nameOffset = 0x50;   // Inline name string, read separately
+    static constexpr size_t maxNameLength = 64;
+
+    using Block = RemoteStruct<Id, Type, PositionX, PositionY, PositionZ, Health,
+                               MaxHealth, IsAlive, IsTargetable, Level>;
+
+    // Fields refreshed every tick for already known entities (Id detects a reused address)
+    using HotBlock = RemoteStruct<Id, PositionX, PositionY, PositionZ, Health, IsAlive, IsTargetable>;
+};
+
+// Entity list: a flat array of entity pointers, null entries are free slots
+struct EntityListLayout {
+    using Entry = uintptr_t;
+    static constexpr size_t defaultSize = 0x1000;   // Bytes read per tick (placeholder)
+};
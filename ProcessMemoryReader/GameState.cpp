@@ -1,7 +1,27 @@
 #include "GameState.h"
 #include "Memory.h"
 #include "OffsetManager.h"
+#include "PatternScanner.h"
+#include "Signatures.h"
+#include "WorldSnapshot.h"
 #include <cmath>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+    template<typename T>
+    T decodeField(const uint8_t* data, uintptr_t offset) {
+        T value;
+        std::memcpy(&value, data + offset, sizeof(value));
+        return value;
+    }
+    
+    // Booleans from the raw byte so non 0/1 values stay well defined
+    template<>
+    bool decodeField<bool>(const uint8_t* data, uintptr_t offset) {
+        return data[offset] != 0;
+    }
+}
 
 GameState::GameState(const Memory* memory) : m_memory(memory) {
     // Initialize offset manager
@@ -11,65 +31,118 @@ GameState::GameState(const Memory* memory) : m_memory(memory) {
     m_player = {};
     m_currentMap = {};
     m_season = {};
+    
+    // Position/health change every frame; the rest is re-read on a slow timer or
+    // as soon as its key field (level, map id, event id) changes
+    using namespace std::chrono_literals;
+    m_playerHotGroup = m_schedule.addGroup("player_hot", 0ms);
+    m_playerStatsGroup = m_schedule.addGroup("player_stats", 2000ms);
+    m_mapStatusGroup = m_schedule.addGroup("map_status", 250ms);
+    m_mapNameGroup = m_schedule.addGroup("map_name", 10000ms);
+    m_seasonStatusGroup = m_schedule.addGroup("season_status", 1000ms);
+    m_seasonNameGroup = m_schedule.addGroup("season_name", 10000ms);
+    
+    m_schedule.setKeyGroup(m_playerStatsGroup, m_playerHotGroup);
+    m_schedule.setKeyGroup(m_mapNameGroup, m_mapStatusGroup);
+    m_schedule.setKeyGroup(m_seasonNameGroup, m_seasonStatusGroup);
 }
 
+GameState::~GameState() = default;
+
 bool GameState::update() {
-    bool success = true;
+    if (!m_memory || !followPlayerBase() || m_mapDataAddress == 0 || m_seasonDataAddress == 0) {
+        return false;
+    }
     
-    success &= updatePlayerData();
-    success &= updateMapData();
-    success &= updateSeasonData();
+    m_schedule.beginPass(ReadScheduler::Clock::now());
+    resolvePlayerOffsets();
     
-    return success;
+    // The full player span includes the hot fields, so only one of them is queued
+    bool readPlayerStats = m_schedule.shouldRead(m_playerStatsGroup);
+    bool readMapStatus = m_schedule.shouldRead(m_mapStatusGroup);
+    bool readSeasonStatus = m_schedule.shouldRead(m_seasonStatusGroup);
+    
+    PlayerBuffer playerData;
+    MapLayout::StatusBlock mapStatus;
+    SeasonLayout::StatusBlock seasonStatus;
+    
+    Memory::ReadBatch batch(m_memory);
+    batch.add(m_playerBaseAddress, playerData.data(),
+              readPlayerStats ? m_playerOffsets.fullSize : m_playerOffsets.hotSize);
+    if (readMapStatus) {
+        mapStatus.queue(batch, m_mapDataAddress);
+    }
+    if (readSeasonStatus) {
+        seasonStatus.queue(batch, m_seasonDataAddress);
+    }
+    
+    if (!batch.execute()) {
+        // Keep the previous values; everything queued stays due for the next pass
+        m_schedule.complete(m_playerHotGroup, false);
+        if (readPlayerStats) {
+            m_schedule.complete(m_playerStatsGroup, false);
+        }
+        if (readMapStatus) {
+            m_schedule.complete(m_mapStatusGroup, false);
+        }
+        if (readSeasonStatus) {
+            m_schedule.complete(m_seasonStatusGroup, false);
+        }
+        return false;
+    }
+    
+    if (readPlayerStats) {
+        decodePlayerStats(playerData.data());
+        m_schedule.complete(m_playerStatsGroup, true);
+    } else {
+        decodePlayer(playerData.data());
+    }
+    m_schedule.complete(m_playerHotGroup, true);
+    m_schedule.reportKey(m_playerHotGroup, static_cast<uint64_t>(m_player.level));
+    
+    if (readMapStatus) {
+        decodeMapStatus(mapStatus);
+        m_schedule.complete(m_mapStatusGroup, true);
+        m_schedule.reportKey(m_mapStatusGroup, mapStatus.get<MapLayout::MapId>());
+    }
+    if (readSeasonStatus) {
+        decodeSeasonStatus(seasonStatus);
+        m_schedule.complete(m_seasonStatusGroup, true);
+        m_schedule.reportKey(m_seasonStatusGroup, seasonStatus.get<SeasonLayout::EventId>());
+    }
+    
+    // Strings last, so a key change seen above is picked up in the same pass
+    // A failed string keeps its previous value and stays due, without costing the rest of the pass
+    if (m_schedule.shouldRead(m_mapNameGroup)) {
+        m_schedule.complete(m_mapNameGroup, readMapName());
+    }
+    if (m_schedule.shouldRead(m_seasonNameGroup)) {
+        m_schedule.complete(m_seasonNameGroup, readSeasonNames());
+    }
+    
+    return true;
+}
+
+void GameState::applySnapshot(const WorldSnapshot& snapshot) {
+    m_player = snapshot.player;
+    m_currentMap = snapshot.map;
+    m_season = snapshot.season;
 }
 
 bool GameState::updatePlayerData() {
-    if (!m_memory || m_playerBaseAddress == 0) {
+    if (!m_memory || !followPlayerBase()) {
         return false;
     }
     
     try {
-        // === EXAMPLE: Using Dynamic Offset System ===
-        
-        // Method 1: Using OffsetManager (recommended)
-        auto positionAddress = m_offsetManager->calculateAddress(m_playerBaseAddress, "player_position");
-        auto position = m_memory->readArray<float>(positionAddress, 3);
-        m_player.x = position[0];
-        m_player.y = position[1];
-        m_player.z = position[2];
-        
-        // Method 2: Manual calculation (what you asked about!)
-        // Formula: new_address = base_address + offset
-        uintptr_t healthOffset = m_offsetManager->getOffset("player_health");
-        uintptr_t healthAddress = m_playerBaseAddress + healthOffset;  // <- This is your formula!
-        m_player.health = m_memory->read<float>(healthAddress);
-        
-        // Method 3: Direct offset values (old way)
-        m_player.maxHealth = m_memory->read<float>(m_playerBaseAddress + 0x14);
-        
-        // Using OffsetManager for remaining data
-        m_player.mana = m_memory->read<float>(
-            m_offsetManager->calculateAddress(m_playerBaseAddress, "player_mana")
-        );
-        m_player.maxMana = m_memory->read<float>(
-            m_offsetManager->calculateAddress(m_playerBaseAddress, "player_max_mana")
-        );
-        m_player.level = m_memory->read<int>(
-            m_offsetManager->calculateAddress(m_playerBaseAddress, "player_level")
-        );
-        m_player.inCombat = m_memory->read<bool>(
-            m_offsetManager->calculateAddress(m_playerBaseAddress, "player_in_combat")
-        );
-        m_player.isDead = m_memory->read<bool>(
-            m_offsetManager->calculateAddress(m_playerBaseAddress, "player_is_dead")
-        );
-        m_player.movementSpeed = m_memory->read<float>(
-            m_offsetManager->calculateAddress(m_playerBaseAddress, "player_movement_speed")
-        );
-        m_player.characterClass = m_memory->read<int>(
-            m_offsetManager->calculateAddress(m_playerBaseAddress, "player_class")
-        );
+        // The whole player span is pulled in with a single read and decoded locally
+        resolvePlayerOffsets();
+        PlayerBuffer data;
+        if (!m_memory->readMemory(m_playerBaseAddress, data.data(), m_playerOffsets.fullSize)) {
+            return false;
+        }
         
+        decodePlayerStats(data.data());
         return true;
     }
     catch (const std::exception&) {
@@ -83,8 +156,13 @@ bool GameState::updateMapData() {
     }
     
     try {
-        // This is a placeholder - actual implementation would depend on game's memory structure
-        // For now, return basic success
+        MapLayout::StatusBlock block;
+        if (!block.read(m_memory, m_mapDataAddress)) {
+            return false;
+        }
+        
+        decodeMapStatus(block);
+        readMapName();
         return true;
     }
     catch (const std::exception&) {
@@ -98,7 +176,107 @@ bool GameState::updateSeasonData() {
     }
     
     try {
-        // This is a placeholder - actual implementation would depend on game's memory structure
+        SeasonLayout::StatusBlock block;
+        if (!block.read(m_memory, m_seasonDataAddress)) {
+            return false;
+        }
+        
+        decodeSeasonStatus(block);
+        readSeasonNames();
+        return true;
+    }
+    catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool GameState::followPlayerBase() {
+    static_assert(NO_CHAIN == OffsetManager::INVALID_CHAIN, "NO_CHAIN must match OffsetManager::INVALID_CHAIN");
+    
+    if (m_playerBaseChain != NO_CHAIN) {
+        // One pointer read per memory generation; the full walk only if it moved
+        uintptr_t address = m_offsetManager->resolvePointerChain(m_playerBaseChain);
+        if (address != m_playerBaseAddress) {
+            m_playerBaseAddress = address;
+            m_schedule.invalidateAll();   // A new player object: re-read everything once
+        }
+    }
+    return m_playerBaseAddress != 0;
+}
+
+void GameState::resolvePlayerOffsets() {
+    uint64_t revision = m_offsetManager->getRevision();
+    if (m_playerOffsetsResolved && revision == m_playerOffsetRevision) {
+        return;
+    }
+    m_playerOffsetRevision = revision;
+    m_playerOffsetsResolved = true;
+    
+    using Builtin = OffsetManager::BuiltinOffset;
+    auto resolve = [this](Builtin id, uintptr_t fallback, size_t size) {
+        if (!m_offsetManager->hasOffset(id)) {
+            return fallback;
+        }
+        uintptr_t offset = m_offsetManager->getOffset(id);
+        return offset <= MAX_PLAYER_BLOCK - size ? offset : fallback;
+    };
+    
+    PlayerOffsets& o = m_playerOffsets;
+    o.position = resolve(Builtin::PLAYER_POSITION, PlayerLayout::PositionX::offset, 3 * sizeof(float));
+    o.health = resolve(Builtin::PLAYER_HEALTH, PlayerLayout::Health::offset, sizeof(float));
+    o.maxHealth = resolve(Builtin::PLAYER_MAX_HEALTH, PlayerLayout::MaxHealth::offset, sizeof(float));
+    o.mana = resolve(Builtin::PLAYER_MANA, PlayerLayout::Mana::offset, sizeof(float));
+    o.maxMana = resolve(Builtin::PLAYER_MAX_MANA, PlayerLayout::MaxMana::offset, sizeof(float));
+    o.level = resolve(Builtin::PLAYER_LEVEL, PlayerLayout::Level::offset, sizeof(int));
+    o.inCombat = resolve(Builtin::PLAYER_IN_COMBAT, PlayerLayout::InCombat::offset, sizeof(bool));
+    o.isDead = resolve(Builtin::PLAYER_IS_DEAD, PlayerLayout::IsDead::offset, sizeof(bool));
+    o.movementSpeed = resolve(Builtin::PLAYER_MOVEMENT_SPEED, PlayerLayout::MovementSpeed::offset, sizeof(float));
+    o.characterClass = resolve(Builtin::PLAYER_CLASS, PlayerLayout::CharacterClass::offset, sizeof(int));
+    
+    o.hotSize = std::max({o.position + 3 * sizeof(float), o.health + sizeof(float), o.mana + sizeof(float),
+                          o.level + sizeof(int), o.inCombat + sizeof(bool), o.isDead + sizeof(bool),
+                          o.movementSpeed + sizeof(float)});
+    o.fullSize = std::max({o.hotSize, o.maxHealth + sizeof(float), o.maxMana + sizeof(float),
+                           o.characterClass + sizeof(int)});
+}
+
+void GameState::decodePlayer(const uint8_t* data) {
+    const PlayerOffsets& o = m_playerOffsets;
+    m_player.x = decodeField<float>(data, o.position);
+    m_player.y = decodeField<float>(data, o.position + sizeof(float));
+    m_player.z = decodeField<float>(data, o.position + 2 * sizeof(float));
+    m_player.health = decodeField<float>(data, o.health);
+    m_player.mana = decodeField<float>(data, o.mana);
+    m_player.level = decodeField<int>(data, o.level);
+    m_player.inCombat = decodeField<bool>(data, o.inCombat);
+    m_player.isDead = decodeField<bool>(data, o.isDead);
+    m_player.movementSpeed = decodeField<float>(data, o.movementSpeed);
+}
+
+void GameState::decodePlayerStats(const uint8_t* data) {
+    decodePlayer(data);
+    m_player.maxHealth = decodeField<float>(data, m_playerOffsets.maxHealth);
+    m_player.maxMana = decodeField<float>(data, m_playerOffsets.maxMana);
+    m_player.characterClass = decodeField<int>(data, m_playerOffsets.characterClass);
+}
+
+void GameState::decodeMapStatus(const MapLayout::StatusBlock& block) {
+    m_currentMap.mapTier = block.get<MapLayout::Tier>();
+    m_currentMap.isCompleted = block.get<MapLayout::IsCompleted>();
+    m_currentMap.completionPercent = block.get<MapLayout::CompletionPercent>();
+    m_currentMap.hasBoss = block.get<MapLayout::HasBoss>();
+    m_currentMap.bossDefeated = block.get<MapLayout::BossDefeated>();
+}
+
+void GameState::decodeSeasonStatus(const SeasonLayout::StatusBlock& block) {
+    m_season.seasonLevel = block.get<SeasonLayout::SeasonLevel>();
+    m_season.hasActiveEvent = block.get<SeasonLayout::HasActiveEvent>();
+}
+
+bool GameState::readMapName() {
+    try {
+        m_currentMap.mapName = m_memory->readString(m_mapDataAddress + MapLayout::nameOffset, 
+                                                    MapLayout::maxNameLength);
         return true;
     }
     catch (const std::exception&) {
@@ -106,6 +284,25 @@ bool GameState::updateSeasonData() {
     }
 }
 
+bool GameState::readSeasonNames() {
+    bool success = true;
+    try {
+        m_season.seasonName = m_memory->readString(m_seasonDataAddress + SeasonLayout::seasonNameOffset,
+                                                   SeasonLayout::maxNameLength);
+    }
+    catch (const std::exception&) {
+        success = false;
+    }
+    try {
+        m_season.eventType = m_memory->readString(m_seasonDataAddress + SeasonLayout::eventTypeOffset,
+                                                  SeasonLayout::maxNameLength);
+    }
+    catch (const std::exception&) {
+        success = false;
+    }
+    return success;
+}
+
 float GameState::getDistanceToPoint(float x, float y) const {
     float dx = m_player.x - x;
     float dy = m_player.y - y;
@@ -117,14 +314,34 @@ bool GameState::isPlayerNearPosition(float x, float y, float threshold) const {
 }
 
 bool GameState::findGameAddresses() {
-    // This is a critical function that would need reverse engineering
-    // For now, return false to indicate addresses need to be found
+    // Resolve all signatures at once (cached or in a single pass over the module)
+    if (m_scanner) {
+        // The player pointer slot itself, so the pointer can be followed per pass
+        PatternScanner::Signature playerSlot = Signatures::PLAYER_BASE;
+        playerSlot.dereference = false;
+        
+        auto addresses = m_scanner->resolveSignatures({
+            playerSlot, Signatures::MAP_DATA, Signatures::SEASON_DATA
+        });
+        
+        m_playerBaseChain = NO_CHAIN;
+        m_playerBaseAddress = 0;
+        if (addresses[0] != 0) {
+            m_playerBaseChain = m_offsetManager->compilePointerChain(addresses[0], std::vector<uintptr_t>{0, 0});
+            m_playerBaseAddress = m_offsetManager->resolvePointerChain(m_playerBaseChain);
+        }
+        m_mapDataAddress = addresses[1];
+        m_seasonDataAddress = addresses[2];
+    }
+    
+    // Anything the scanner could not resolve falls back to the placeholders
     return scanForPlayerBase() && scanForMapData() && scanForSeasonData();
 }
 
 bool GameState::scanForPlayerBase() {
-    // Placeholder for pattern scanning to find player base address
-    // This would involve signature scanning or other reverse engineering techniques
+    if (m_playerBaseAddress != 0) {
+        return true; // Already resolved by signature
+    }
     
     // For development purposes, set a dummy address
     m_playerBaseAddress = 0x1000000; // This would be found via scanning
@@ -132,12 +349,20 @@ bool GameState::scanForPlayerBase() {
 }
 
 bool GameState::scanForMapData() {
+    if (m_mapDataAddress != 0) {
+        return true;
+    }
+    
     // Placeholder for finding map data structures
     m_mapDataAddress = 0x2000000; // This would be found via scanning
     return m_mapDataAddress != 0;
 }
 
 bool GameState::scanForSeasonData() {
+    if (m_seasonDataAddress != 0) {
+        return true;
+    }
+    
     // Placeholder for finding seasonal data
     m_seasonDataAddress = 0x3000000; // This would be found via scanning
     return m_seasonDataAddress != 0;
@@ -4,10 +4,17 @@
 #include <unordered_map>
 #include <string>
 #include <chrono>
+#include <memory>
+#include <array>
+#include <cstdint>
+#include "ReadScheduler.h"
+#include "GameLayouts.h"
 
 // Forward declarations
 class Memory;
 class OffsetManager;
+class PatternScanner;
+struct WorldSnapshot;
 
 /**
  * @brief Represents the current state of the game world
@@ -46,6 +53,7 @@ public:
 private:
     const Memory* m_memory;
     std::unique_ptr<OffsetManager> m_offsetManager;
+    PatternScanner* m_scanner = nullptr;
     
     // Game state data
     PlayerData m_player;
@@ -56,16 +64,53 @@ private:
     uintptr_t m_playerBaseAddress = 0;
     uintptr_t m_mapDataAddress = 0;
     uintptr_t m_seasonDataAddress = 0;
+    
+    // The game reallocates the player object (map changes, respawns); when its pointer
+    // slot is known, the base is followed through this compiled chain every pass
+    static constexpr size_t NO_CHAIN = static_cast<size_t>(-1);   // OffsetManager::INVALID_CHAIN
+    size_t m_playerBaseChain = NO_CHAIN;                            // OffsetManager::ChainHandle
+    
+    // Player field offsets from the OffsetManager's PLAYER_* entries (PlayerLayout
+    // supplies the defaults); re-resolved whenever the registry's revision changes
+    struct PlayerOffsets {
+        uintptr_t position = 0, health = 0, maxHealth = 0, mana = 0, maxMana = 0, level = 0;
+        uintptr_t inCombat = 0, isDead = 0, movementSpeed = 0, characterClass = 0;
+        size_t hotSize = 0;    // Bytes from the player base covering the per-pass fields
+        size_t fullSize = 0;   // Bytes covering every field
+    };
+    static constexpr size_t MAX_PLAYER_BLOCK = 0x400;   // Offsets reaching past this fall back to PlayerLayout
+    using PlayerBuffer = std::array<uint8_t, MAX_PLAYER_BLOCK>;
+    PlayerOffsets m_playerOffsets;
+    uint64_t m_playerOffsetRevision = 0;
+    bool m_playerOffsetsResolved = false;
+    
+    // Per-group refresh rates for update()
+    ReadScheduler m_schedule;
+    ReadScheduler::GroupId m_playerHotGroup;
+    ReadScheduler::GroupId m_playerStatsGroup;
+    ReadScheduler::GroupId m_mapStatusGroup;
+    ReadScheduler::GroupId m_mapNameGroup;
+    ReadScheduler::GroupId m_seasonStatusGroup;
+    ReadScheduler::GroupId m_seasonNameGroup;
 
 public:
     explicit GameState(const Memory* memory);
+    ~GameState(); // Defined where OffsetManager is complete
     
     // Update methods
-    bool update();
-    bool updatePlayerData();
+    bool update();             // Scheduled: only groups that are due, in one batch
+    bool updatePlayerData();   // Unconditional reads
     bool updateMapData();
     bool updateSeasonData();
     
+    // Refresh intervals ("player_hot", "player_stats", "map_status", "map_name",
+    // "season_status", "season_name"); invalidateAll() after re-attaching
+    ReadScheduler& getReadScheduler() { return m_schedule; }
+    const ReadScheduler& getReadScheduler() const { return m_schedule; }
+    
+    // Take player/map/season data from a snapshot instead of reading memory
+    void applySnapshot(const WorldSnapshot& snapshot);
+    
     // Getter methods
     const PlayerData& getPlayer() const { return m_player; }
     const MapData& getCurrentMap() const { return m_currentMap; }
@@ -83,7 +128,9 @@ public:
     
     // Memory address management
     bool findGameAddresses();
-    void setPlayerBaseAddress(uintptr_t address) { m_playerBaseAddress = address; }
+    void setPatternScanner(PatternScanner* scanner) { m_scanner = scanner; }
+    OffsetManager* getOffsetManager() const { return m_offsetManager.get(); }
+    void setPlayerBaseAddress(uintptr_t address) { m_playerBaseAddress = address; m_playerBaseChain = NO_CHAIN; }
     void setMapDataAddress(uintptr_t address) { m_mapDataAddress = address; }
     void setSeasonDataAddress(uintptr_t address) { m_seasonDataAddress = address; }
 
@@ -92,4 +139,13 @@ private:
     bool scanForMapData();
     bool scanForSeasonData();
     bool validateAddress(uintptr_t address) const;
+    
+    bool followPlayerBase();       // Re-resolve the player pointer; false if it is null
+    void resolvePlayerOffsets();   // No-op unless the OffsetManager changed since the last call
+    void decodePlayer(const uint8_t* data);
+    void decodePlayerStats(const uint8_t* data);
+    void decodeMapStatus(const MapLayout::StatusBlock& block);
+    void decodeSeasonStatus(const SeasonLayout::StatusBlock& block);
+    bool readMapName();          // false if the string could not be read; the previous value stays
+    bool readSeasonNames();
 };
@@ -1,13 +1,18 @@
 #include "InputManager.h"
+#include <algorithm>
 #include <random>
-#include <thread>
 
-InputManager::InputManager() : m_gameWindow(nullptr), m_currentMousePos(0, 0) {
+InputManager::InputManager() 
+    : m_gameWindow(nullptr), m_currentMousePos(0, 0),
+      m_queue([this](const InputAction& action) { execute(action); }) {
     updateWindowRect();
+    m_queue.start();
 }
 
 InputManager::~InputManager() {
-    // Release any held keys
+    // Pending releases are still sent; presses that never got one are released here
+    m_queue.stop();
+    
     for (const auto& [key, pressed] : m_keyStates) {
         if (pressed) {
             sendKeyUp(key);
@@ -40,22 +45,105 @@ bool InputManager::findGameWindow() {
     return false;
 }
 
+InputManager::MovementScope::MovementScope(InputManager& input) 
+    : m_input(input), m_owner(input.m_activeToken == 0) {
+    if (!m_owner) {
+        return;   // Nested call, already part of a movement
+    }
+    
+    // A new movement target makes the remaining steps of the previous one pointless
+    if (m_input.m_movementToken != 0) {
+        m_input.m_queue.cancel(m_input.m_movementToken);
+    }
+    
+    m_input.m_movementToken = m_input.m_nextToken++;
+    if (m_input.m_nextToken == 0) {
+        m_input.m_nextToken = 1;
+    }
+    m_input.m_activeToken = m_input.m_movementToken;
+}
+
+InputManager::MovementScope::~MovementScope() {
+    if (m_owner) {
+        m_input.m_activeToken = 0;
+    }
+}
+
+std::chrono::steady_clock::time_point InputManager::queue(InputAction::Type type, int a, int b,
+                                                          std::chrono::steady_clock::duration delay) {
+    InputAction action;
+    action.type = type;
+    action.a = a;
+    action.b = b;
+    action.token = m_activeToken;
+    
+    delay += m_pendingGap;
+    m_pendingGap = std::chrono::steady_clock::duration::zero();
+    return m_queue.push(action, delay);
+}
+
+void InputManager::execute(const InputAction& action) {
+    switch (action.type) {
+        case InputAction::Type::KEY_DOWN:
+            sendKeyDown(action.a);
+            break;
+        case InputAction::Type::KEY_UP:
+            sendKeyUp(action.a);
+            break;
+        case InputAction::Type::MOUSE_DOWN:
+            sendMouseDown(static_cast<ClickType>(action.a));
+            break;
+        case InputAction::Type::MOUSE_UP:
+            sendMouseUp(static_cast<ClickType>(action.a));
+            break;
+        case InputAction::Type::MOUSE_MOVE:
+            sendMouseMove(action.a, action.b);
+            break;
+    }
+}
+
+void InputManager::cancelMovement() {
+    if (m_movementToken != 0) {
+        m_queue.cancel(m_movementToken);
+    }
+}
+
+void InputManager::cancelPendingInput() {
+    m_queue.cancel(0);
+    m_pendingGap = std::chrono::steady_clock::duration::zero();
+}
+
+bool InputManager::waitForInputIdle(int timeoutMs) {
+    return m_queue.waitIdle(std::chrono::milliseconds(timeoutMs));
+}
+
+InputManager::MousePosition InputManager::currentPointer() const {
+    // While moves are queued the cursor is still on its way; continue from their end point
+    if (!m_queue.isIdle()) {
+        return m_currentMousePos;
+    }
+    
+    POINT pos;
+    GetCursorPos(&pos);
+    return MousePosition(pos.x, pos.y);
+}
+
 void InputManager::pressKey(int virtualKey) {
-    waitForKeyDelay();
-    sendKeyDown(virtualKey);
+    auto due = queue(InputAction::Type::KEY_DOWN, virtualKey, 0, nextKeyDelay());
+    m_lastKeyPress = due;
     m_keyStates[virtualKey] = true;
-    m_keyPressTimes[virtualKey] = std::chrono::steady_clock::now();
+    m_keyPressTimes[virtualKey] = due;
 }
 
 void InputManager::releaseKey(int virtualKey) {
-    sendKeyUp(virtualKey);
+    queue(InputAction::Type::KEY_UP, virtualKey);
     m_keyStates[virtualKey] = false;
 }
 
 void InputManager::holdKey(int virtualKey, int durationMs) {
     pressKey(virtualKey);
-    std::this_thread::sleep_for(std::chrono::milliseconds(durationMs));
-    releaseKey(virtualKey);
+    queue(InputAction::Type::KEY_UP, virtualKey, 0, std::chrono::milliseconds(durationMs));
+    m_keyStates[virtualKey] = false;
 }
 
 void InputManager::typeKey(int virtualKey) {
@@ -70,41 +158,42 @@ bool InputManager::isKeyPressed(int virtualKey) const {
 }
 
 void InputManager::moveMouse(int x, int y, bool relative) {
-    waitForMouseDelay();
-    
     if (relative) {
-        POINT currentPos;
-        GetCursorPos(&currentPos);
-        x += currentPos.x;
-        y += currentPos.y;
+        MousePosition current = currentPointer();
+        x += current.x;
+        y += current.y;
     }
     
-    sendMouseMove(x, y);
+    queue(InputAction::Type::MOUSE_MOVE, x, y, nextMouseDelay());
     m_currentMousePos = MousePosition(x, y);
 }
 
 void InputManager::moveMouseSmooth(int x, int y, int durationMs) {
-    POINT start;
-    GetCursorPos(&start);
-    
-    MousePosition startPos(start.x, start.y);
+    MovementScope movement(*this);
+    queueSmoothPath(x, y, durationMs);
+}
+
+void InputManager::queueSmoothPath(int x, int y, int durationMs) {
+    MousePosition startPos = currentPointer();
     MousePosition endPos(x, y);
     
-    auto path = generateSmoothPath(startPos, endPos, durationMs / 50);
+    auto path = generateSmoothPath(startPos, endPos, std::max(1, durationMs / 50));
     
+    // One step every 50 ms, scheduled up front instead of slept through
+    bool first = true;
     for (const auto& point : path) {
-        sendMouseMove(point.x, point.y);
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue(InputAction::Type::MOUSE_MOVE, point.x, point.y, 
+              first ? std::chrono::milliseconds(0) : std::chrono::milliseconds(50));
+        first = false;
     }
     
     m_currentMousePos = endPos;
 }
 
 void InputManager::clickMouse(ClickType type) {
-    waitForMouseDelay();
-    sendMouseDown(type);
+    m_lastMouseClick = queue(InputAction::Type::MOUSE_DOWN, static_cast<int>(type), 0, nextMouseDelay());
     addRandomDelay(50, 25);
-    sendMouseUp(type);
+    queue(InputAction::Type::MOUSE_UP, static_cast<int>(type));
 }
 
 void InputManager::clickAt(int x, int y, ClickType type) {
@@ -115,20 +204,22 @@ void InputManager::clickAt(int x, int y, ClickType type) {
 
 void InputManager::dragMouse(int fromX, int fromY, int toX, int toY, int durationMs) {
     moveMouse(fromX, fromY);
-    sendMouseDown(ClickType::LEFT_CLICK);
+    queue(InputAction::Type::MOUSE_DOWN, static_cast<int>(ClickType::LEFT_CLICK));
     
     addRandomDelay(100, 50);
-    moveMouseSmooth(toX, toY, durationMs);
+    queueSmoothPath(toX, toY, durationMs);
     
-    sendMouseUp(ClickType::LEFT_CLICK);
+    queue(InputAction::Type::MOUSE_UP, static_cast<int>(ClickType::LEFT_CLICK));
 }
 
 void InputManager::moveToPosition(float worldX, float worldY) {
+    MovementScope movement(*this);
     auto screenPos = worldToScreen(worldX, worldY);
     clickAt(screenPos.x, screenPos.y, ClickType::RIGHT_CLICK);
 }
 
 void InputManager::attackMove(float worldX, float worldY) {
+    MovementScope movement(*this);
     auto screenPos = worldToScreen(worldX, worldY);
     
     // Hold shift for force move, then right click
@@ -223,7 +314,7 @@ void InputManager::setMouseDelayRange(int minMs, int maxMs) {
 
 void InputManager::addRandomDelay(int baseMs, int variationMs) {
     int delay = getRandomDelay(baseMs - variationMs, baseMs + variationMs);
-    std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+    m_pendingGap += std::chrono::milliseconds(std::max(0, delay));
 }
 
 bool InputManager::isValidScreenPosition(int x, int y) const {
@@ -245,7 +336,6 @@ void InputManager::sendKeyDown(int virtualKey) {
     input.ki.dwFlags = 0;
     
     SendInput(1, &input, sizeof(INPUT));
-    m_lastKeyPress = std::chrono::steady_clock::now();
 }
 
 void InputManager::sendKeyUp(int virtualKey) {
@@ -279,7 +369,6 @@ void InputManager::sendMouseDown(ClickType type) {
     }
     
     SendInput(1, &input, sizeof(INPUT));
-    m_lastMouseClick = std::chrono::steady_clock::now();
 }
 
 void InputManager::sendMouseUp(ClickType type) {
@@ -309,24 +398,17 @@ void InputManager::sendMouseMove(int x, int y) {
     m_lastMouseMove = std::chrono::steady_clock::now();
 }
 
-void InputManager::waitForKeyDelay() {
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastKeyPress);
-    int minDelay = getRandomDelay(m_minKeyDelay, m_maxKeyDelay);
-    
-    if (elapsed.count() < minDelay) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(minDelay - elapsed.count()));
-    }
+std::chrono::steady_clock::duration InputManager::nextKeyDelay() const {
+    // Gap needed after the end of the timeline to keep a random distance from the last key press
+    auto start = m_queue.tail() + m_pendingGap;
+    auto earliest = m_lastKeyPress + std::chrono::milliseconds(getRandomDelay(m_minKeyDelay, m_maxKeyDelay));
+    return earliest > start ? earliest - start : std::chrono::steady_clock::duration::zero();
 }
 
-void InputManager::waitForMouseDelay() {
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_lastMouseClick);
-    int minDelay = getRandomDelay(m_minMouseDelay, m_maxMouseDelay);
-    
-    if (elapsed.count() < minDelay) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(minDelay - elapsed.count()));
-    }
+std::chrono::steady_clock::duration InputManager::nextMouseDelay() const {
+    auto start = m_queue.tail() + m_pendingGap;
+    auto earliest = m_lastMouseClick + std::chrono::milliseconds(getRandomDelay(m_minMouseDelay, m_maxMouseDelay));
+    return earliest > start ? earliest - start : std::chrono::steady_clock::duration::zero();
 }
 
 int InputManager::getRandomDelay(int min, int max) const {
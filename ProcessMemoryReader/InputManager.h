@@ -4,9 +4,17 @@
 #include <vector>
 #include <chrono>
 #include <unordered_map>
+#include "InputQueue.h"
 
 /**
  * @brief Handles input simulation and mouse/keyboard control
+ *
+ * Input methods never block: each call turns into timestamped actions on an
+ * InputQueue whose executor thread sends them when due, so humanization delays
+ * and smooth mouse paths no longer stall the caller. Movement commands
+ * (moveToPosition, attackMove, moveMouseSmooth) supersede the pending steps of
+ * the previous movement. Public methods are meant to be called from one thread
+ * (the bot thread); the send* helpers run on the executor thread.
  */
 class InputManager {
 public:
@@ -25,10 +33,11 @@ private:
     HWND m_gameWindow;
     RECT m_windowRect;
     
-    // Input timing and humanization
+    // Input timing and humanization (scheduled times on the input timeline)
     std::chrono::steady_clock::time_point m_lastKeyPress;
     std::chrono::steady_clock::time_point m_lastMouseClick;
-    std::chrono::steady_clock::time_point m_lastMouseMove;
+    std::chrono::steady_clock::time_point m_lastMouseMove;   // Executor thread
+    std::chrono::steady_clock::duration m_pendingGap{0};     // Added before the next queued action
     
     // Humanization parameters
     int m_minKeyDelay = 50;        // Minimum delay between key presses (ms)
@@ -41,8 +50,16 @@ private:
     std::unordered_map<int, std::chrono::steady_clock::time_point> m_keyPressTimes;
     
     // Mouse state
-    MousePosition m_currentMousePos;
-    bool m_mouseButtonsPressed[3] = {false}; // Left, Right, Middle
+    MousePosition m_currentMousePos;          // Where the last queued move ends
+    bool m_mouseButtonsPressed[3] = {false}; // Left, Right, Middle (executor thread)
+    
+    // Movement superseding
+    uint32_t m_movementToken = 0;  // Token of the latest movement command
+    uint32_t m_activeToken = 0;    // Tag for actions queued right now (0 = not a movement)
+    uint32_t m_nextToken = 1;
+    
+    // Declared last: the executor thread is stopped before the state above is destroyed
+    InputQueue m_queue;
 
 public:
     InputManager();
@@ -91,13 +108,38 @@ public:
     // Humanization
     void setKeyDelayRange(int minMs, int maxMs);
     void setMouseDelayRange(int minMs, int maxMs);
-    void addRandomDelay(int baseMs, int variationMs = 50);
+    void addRandomDelay(int baseMs, int variationMs = 50);  // Gap on the input timeline, does not block
+    
+    // Asynchronous execution
+    void cancelMovement();                  // Drop pending steps of the current movement
+    void cancelPendingInput();              // Drop everything pending (releases of sent presses are kept)
+    bool isInputPending() const { return !m_queue.isIdle(); }
+    bool waitForInputIdle(int timeoutMs);   // Block until the queue drained
+    InputQueue::Statistics getInputStatistics() const { return m_queue.getStatistics(); }
     
     // Input validation
     bool isValidScreenPosition(int x, int y) const;
     bool isValidWorldPosition(float x, float y) const;
 
 private:
+    /**
+     * @brief Tags the actions queued in its lifetime as one movement, superseding the previous one
+     */
+    class MovementScope {
+        InputManager& m_input;
+        bool m_owner;
+    public:
+        explicit MovementScope(InputManager& input);
+        ~MovementScope();
+    };
+    
+    // Queueing
+    std::chrono::steady_clock::time_point queue(InputAction::Type type, int a, int b = 0,
+                                                std::chrono::steady_clock::duration delay = {});
+    void execute(const InputAction& action);   // Executor thread
+    void queueSmoothPath(int x, int y, int durationMs);
+    MousePosition currentPointer() const;
+    
     // Core input methods
     void sendKeyDown(int virtualKey);
     void sendKeyUp(int virtualKey);
@@ -106,8 +148,8 @@ private:
     void sendMouseMove(int x, int y);
     
     // Timing and delays
-    void waitForKeyDelay();
-    void waitForMouseDelay();
+    std::chrono::steady_clock::duration nextKeyDelay() const;
+    std::chrono::steady_clock::duration nextMouseDelay() const;
     int getRandomDelay(int min, int max) const;
     
     // Window management
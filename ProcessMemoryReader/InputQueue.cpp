@@ -0,0 +1,165 @@
+#include "InputQueue.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+InputQueue::InputQueue(std::function<void(const InputAction&)> execute)
+    : m_execute(std::move(execute)), m_tail(Clock::now()) {
+}
+
+InputQueue::~InputQueue() {
+    stop();
+}
+
+void InputQueue::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) {
+        return;
+    }
+
+    m_stopping = false;
+    m_running = true;
+    m_thread = std::thread(&InputQueue::executorLoop, this);
+}
+
+void InputQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running) {
+            return;
+        }
+
+        // Releases are kept (and sent immediately) so nothing stays held down
+        auto firstRemoved = std::stable_partition(m_pending.begin(), m_pending.end(),
+                                                  [](const InputAction& action) { return action.isRelease(); });
+        m_cancelled.fetch_add(static_cast<uint64_t>(m_pending.end() - firstRemoved), std::memory_order_relaxed);
+        m_pending.erase(firstRemoved, m_pending.end());
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = false;
+}
+
+InputQueue::Clock::time_point InputQueue::push(InputAction action, Clock::duration delay) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Clock::time_point start = std::max(Clock::now(), m_tail);
+        action.due = start + delay;
+        m_tail = action.due;
+        m_pending.push_back(action);
+    }
+    m_wake.notify_one();
+    return action.due;
+}
+
+size_t InputQueue::cancel(uint32_t token) {
+    size_t removed = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        // Presses dropped by this cancel; their releases go too. Any other
+        // release belongs to a press that was already sent and must stay.
+        std::vector<std::pair<InputAction::Type, int32_t>> droppedPresses;
+
+        auto keep = std::remove_if(m_pending.begin(), m_pending.end(), [&](const InputAction& action) {
+            if (token != 0 && action.token != token) {
+                return false;
+            }
+            if (action.isPress()) {
+                droppedPresses.emplace_back(action.type, action.a);
+                return true;
+            }
+            if (action.isRelease()) {
+                auto pressType = action.type == InputAction::Type::KEY_UP ? InputAction::Type::KEY_DOWN
+                                                                          : InputAction::Type::MOUSE_DOWN;
+                auto press = std::find(droppedPresses.begin(), droppedPresses.end(), std::make_pair(pressType, action.a));
+                if (press == droppedPresses.end()) {
+                    return false;
+                }
+                droppedPresses.erase(press);
+                return true;
+            }
+            return true;
+        });
+
+        removed = static_cast<size_t>(m_pending.end() - keep);
+        m_pending.erase(keep, m_pending.end());
+
+        // New actions start after what is left instead of after the cancelled gap
+        Clock::time_point now = Clock::now();
+        m_tail = m_pending.empty() ? now : std::max(now, m_pending.back().due);
+    }
+
+    if (removed > 0) {
+        m_cancelled.fetch_add(removed, std::memory_order_relaxed);
+        m_wake.notify_one();
+        m_drained.notify_all();
+    }
+    return removed;
+}
+
+InputQueue::Clock::time_point InputQueue::tail() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::max(Clock::now(), m_tail);
+}
+
+size_t InputQueue::pendingCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.size();
+}
+
+bool InputQueue::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_drained.wait_for(lock, timeout, [this] { return m_pending.empty(); });
+}
+
+InputQueue::Statistics InputQueue::getStatistics() const {
+    Statistics stats;
+    stats.executed = m_executed.load(std::memory_order_relaxed);
+    stats.cancelled = m_cancelled.load(std::memory_order_relaxed);
+    stats.maxLatenessMs = m_maxLatenessUs.load(std::memory_order_relaxed) / 1000.0;
+    return stats;
+}
+
+void InputQueue::executorLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        if (m_pending.empty()) {
+            m_drained.notify_all();
+            if (m_stopping) {
+                break;
+            }
+            m_wake.wait(lock);
+            continue;
+        }
+
+        // Re-evaluated after every wake-up: the front may have been cancelled or replaced
+        Clock::time_point due = m_pending.front().due;
+        if (!m_stopping && Clock::now() < due) {
+            m_wake.wait_until(lock, due);
+            continue;
+        }
+
+        InputAction action = m_pending.front();
+        m_pending.pop_front();
+        bool draining = m_stopping;   // Written under the mutex, so read it before unlocking
+        lock.unlock();
+
+        auto latenessUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - action.due).count();
+        if (!draining && latenessUs > m_maxLatenessUs.load(std::memory_order_relaxed)) {
+            m_maxLatenessUs.store(latenessUs, std::memory_order_relaxed);
+        }
+
+        m_execute(action);
+        m_executed.fetch_add(1, std::memory_order_relaxed);
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief One primitive input event with the time it may be sent
+ */
+struct InputAction {
+    enum class Type : uint8_t {
+        KEY_DOWN,
+        KEY_UP,
+        MOUSE_DOWN,
+        MOUSE_UP,
+        MOUSE_MOVE
+    };
+
+    Type type;
+    int32_t a = 0;      // Virtual key or button for key/mouse actions, x for moves
+    int32_t b = 0;      // y for moves
+    std::chrono::steady_clock::time_point due;
+    uint32_t token = 0; // Movement the action belongs to (0 = never superseded)
+
+    bool isRelease() const { return type == Type::KEY_UP || type == Type::MOUSE_UP; }
+    bool isPress() const { return type == Type::KEY_DOWN || type == Type::MOUSE_DOWN; }
+};
+
+/**
+ * @class InputQueue
+ * @brief Timeline of input actions executed on a dedicated thread
+ *
+ * Producers append actions with a delay relative to the end of the timeline
+ * and return immediately; the executor thread sleeps until each action is due
+ * and dispatches it. Timestamps are assigned on push, so humanization delays
+ * no longer block the caller. Actions tagged with a movement token can be
+ * cancelled as a whole when a newer movement supersedes them; a release whose
+ * press was already sent is never dropped, so keys and buttons cannot stick.
+ */
+class InputQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Statistics {
+        uint64_t executed = 0;
+        uint64_t cancelled = 0;
+        double maxLatenessMs = 0.0;    // Worst delay between due time and dispatch
+    };
+
+private:
+    std::function<void(const InputAction&)> m_execute;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;    // New work, cancellation or stop
+    std::condition_variable m_drained; // Queue became empty
+    std::deque<InputAction> m_pending; // Sorted by due time
+    Clock::time_point m_tail;          // Due time of the last pushed action
+    bool m_stopping = false;
+    bool m_running = false;
+    std::thread m_thread;
+
+    std::atomic<uint64_t> m_executed{0};
+    std::atomic<uint64_t> m_cancelled{0};
+    std::atomic<int64_t> m_maxLatenessUs{0};
+
+public:
+    /**
+     * @param execute Called on the executor thread for every action when it is due
+     */
+    explicit InputQueue(std::function<void(const InputAction&)> execute);
+    ~InputQueue();
+
+    InputQueue(const InputQueue&) = delete;
+    InputQueue& operator=(const InputQueue&) = delete;
+
+    void start();
+
+    /**
+     * @brief Stop the executor: pending presses are dropped, pending releases are sent right away
+     */
+    void stop();
+
+    /**
+     * @brief Append an action delay after the end of the timeline (or after now if idle)
+     * @return The due time assigned to the action
+     */
+    Clock::time_point push(InputAction action, Clock::duration delay = Clock::duration::zero());
+
+    /**
+     * @brief Drop pending actions of a movement (token 0 = every pending action)
+     * @return Number of actions removed
+     */
+    size_t cancel(uint32_t token);
+
+    /**
+     * @brief Earliest time a newly pushed action with no delay would run
+     */
+    Clock::time_point tail() const;
+
+    size_t pendingCount() const;
+    bool isIdle() const { return pendingCount() == 0; }
+
+    /**
+     * @brief Block until every pending action was executed
+     * @return false on timeout
+     */
+    bool waitIdle(std::chrono::milliseconds timeout);
+
+    Statistics getStatistics() const;
+
+private:
+    void executorLoop();
+};
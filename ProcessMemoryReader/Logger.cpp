@@ -3,8 +3,20 @@
 #include <filesystem>
 #include <iomanip>
 #include <sstream>
+#include <cctype>
+#include <cmath>
 
-Logger::Logger(const std::string& logDirectory) : m_logDirectory(logDirectory) {
+namespace {
+    // Formats of deferred records, indexed by id (0 is reserved for plain text).
+    // Call sites register once and records are published after registration,
+    // so the writer always sees the pointer for any id it decodes.
+    constexpr uint32_t MAX_DEFERRED_FORMATS = 4096;
+    std::atomic<const char*> g_deferredFormats[MAX_DEFERRED_FORMATS];
+    std::atomic<uint32_t> g_deferredFormatCount{1};
+}
+
+Logger::Logger(const std::string& logDirectory, size_t capacity) 
+    : m_logDirectory(logDirectory), m_ring(capacity) {
     // Create logs directory if it doesn't exist
     std::filesystem::create_directories(m_logDirectory);
     
@@ -23,7 +35,12 @@ Logger::Logger(const std::string& logDirectory) : m_logDirectory(logDirectory) {
 
 Logger::~Logger() {
     if (m_running) {
+        // The writer drains whatever is still in the ring before it exits
         m_running = false;
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+        }
+        m_wake.notify_one();
         if (m_logThread.joinable()) {
             m_logThread.join();
         }
@@ -55,41 +72,50 @@ void Logger::critical(const std::string& message) {
 }
 
 void Logger::logBotAction(const std::string& action, const std::string& details) {
-    std::string message = "BOT_ACTION: " + action;
-    if (!details.empty()) {
-        message += " - " + details;
+    if (details.empty()) {
+        TL_LOG_INFO(*this, "BOT_ACTION: %s", action);
+    } else {
+        TL_LOG_INFO(*this, "BOT_ACTION: %s - %s", action, details);
     }
-    info(message);
 }
 
 void Logger::logCombat(const std::string& target, const std::string& result) {
-    info("COMBAT: Target=" + target + ", Result=" + result);
+    TL_LOG_INFO(*this, "COMBAT: Target=%s, Result=%s", target, result);
 }
 
 void Logger::logLoot(const std::string& itemName, const std::string& rarity) {
-    info("LOOT: Item=" + itemName + ", Rarity=" + rarity);
+    TL_LOG_INFO(*this, "LOOT: Item=%s, Rarity=%s", itemName, rarity);
 }
 
 void Logger::logNavigation(float x, float y, const std::string& action) {
-    info("NAVIGATION: Action=" + action + ", Position=(" + 
-         std::to_string(x) + "," + std::to_string(y) + ")");
+    TL_LOG_INFO(*this, "NAVIGATION: Action=%s, Position=(%f,%f)", action, x, y);
 }
 
 void Logger::logError(const std::string& system, const std::string& error) {
-    this->error("SYSTEM_ERROR: " + system + " - " + error);
+    TL_LOG_ERROR(*this, "SYSTEM_ERROR: %s - %s", system, error);
 }
 
 void Logger::logPerformance(const std::string& metric, double value) {
-    info("PERFORMANCE: " + metric + "=" + std::to_string(value));
+    TL_LOG_INFO(*this, "PERFORMANCE: %s=%f", metric, value);
 }
 
-void Logger::rotateLogs() {
-    if (m_logStream.is_open()) {
-        m_logStream.close();
+uint16_t Logger::registerFormat(const char* format) {
+    uint32_t id = g_deferredFormatCount.fetch_add(1, std::memory_order_relaxed);
+    if (id >= MAX_DEFERRED_FORMATS) {
+        return static_cast<uint16_t>(MAX_DEFERRED_FORMATS);   // Decoded as an unknown format
     }
-    
-    m_currentLogFile = generateLogFileName();
-    m_logStream.open(m_currentLogFile, std::ios::app);
+    g_deferredFormats[id].store(format, std::memory_order_release);
+    return static_cast<uint16_t>(id);
+}
+
+void Logger::rotateLogs() {
+    m_rotateRequested = true;
+    wakeWriter();
+}
+
+std::string Logger::getCurrentLogFile() const {
+    std::lock_guard<std::mutex> lock(m_logFileMutex);
+    return m_currentLogFile;
 }
 
 void Logger::clearOldLogs(int daysToKeep) {
@@ -115,87 +141,281 @@ void Logger::clearOldLogs(int daysToKeep) {
 }
 
 void Logger::log(LogLevel level, const std::string& message) {
-    if (level < m_minLogLevel) {
+    if (!isEnabled(level)) {
         return;
     }
     
-    std::string formattedMessage = formatMessage(level, message);
-    
-    // Add to queue for async processing
-    {
-        std::lock_guard<std::mutex> lock(m_queueMutex);
-        m_logQueue.push(formattedMessage);
+    enqueue(level, [&](char* text, size_t capacity) {
+        size_t length = std::min(message.size(), capacity - 1);
+        std::memcpy(text, message.data(), length);
+        return length;
+    });
+}
+
+std::unordered_map<Logger::LogLevel, uint64_t> Logger::getLogCounts() const {
+    std::unordered_map<LogLevel, uint64_t> counts;
+    for (int level = 0; level <= static_cast<int>(LogLevel::CRITICAL); ++level) {
+        counts[static_cast<LogLevel>(level)] = m_levelCounts[level].load(std::memory_order_relaxed);
     }
-    
-    // Update statistics
-    m_totalLogs++;
-    m_logCounts[level]++;
-    
-    // Also output to console if enabled
-    if (m_consoleOutput) {
-        writeToConsole(formattedMessage, level);
+    return counts;
+}
+
+void Logger::wakeWriter() {
+    // Pairs with the fence in processLogQueue(): either the writer sees the new
+    // record before sleeping, or we see it sleeping and notify it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_writerSleeping.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeMutex);
+        }
+        m_wake.notify_one();
     }
 }
 
 void Logger::processLogQueue() {
-    while (m_running) {
-        std::string message;
+    std::string fileBatch;
+    std::string consoleBatch;
+    fileBatch.reserve(WRITE_BATCH * 128);
+    consoleBatch.reserve(WRITE_BATCH * 128);
+    
+    auto lastFlush = std::chrono::steady_clock::now();
+    
+    for (;;) {
+        bool urgent = false;
+        size_t drained = 0;
+        while (drained < WRITE_BATCH && m_ring.tryPop([&](const Record& record) {
+                   appendRecord(record, fileBatch, consoleBatch);
+                   urgent |= record.level >= LogLevel::ERROR;
+               })) {
+            ++drained;
+        }
         
-        {
-            std::lock_guard<std::mutex> lock(m_queueMutex);
-            if (!m_logQueue.empty()) {
-                message = m_logQueue.front();
-                m_logQueue.pop();
+        uint64_t dropped = m_droppedPending.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            Record notice{};   // formatId 0: plain text
+            notice.time = std::chrono::system_clock::now();
+            notice.level = LogLevel::WARNING;
+            int length = snprintf(notice.text, RECORD_TEXT_SIZE, "Log ring full, %llu messages dropped",
+                                  static_cast<unsigned long long>(dropped));
+            notice.length = static_cast<uint16_t>(std::max(0, length));
+            appendRecord(notice, fileBatch, consoleBatch);
+        }
+        
+        writeBatch(fileBatch, consoleBatch);
+        fileBatch.clear();
+        consoleBatch.clear();
+        
+        if (m_rotateRequested.exchange(false)) {
+            if (m_logStream.is_open()) {
+                m_logStream.close();
+            }
+            std::string logFile = generateLogFileName();
+            m_logStream.open(logFile, std::ios::app);
+            
+            std::lock_guard<std::mutex> lock(m_logFileMutex);
+            m_currentLogFile = std::move(logFile);
+        }
+        
+        // Flush on a timer rather than per line; errors go out immediately
+        auto now = std::chrono::steady_clock::now();
+        auto flushInterval = std::chrono::milliseconds(m_flushIntervalMs.load(std::memory_order_relaxed));
+        if (urgent || now - lastFlush >= flushInterval) {
+            if (m_logStream.is_open()) {
+                m_logStream.flush();
             }
+            std::cout.flush();
+            lastFlush = now;
         }
         
-        if (!message.empty() && m_fileOutput) {
-            writeToFile(message);
+        if (drained == WRITE_BATCH) {
+            continue;   // More records are waiting
+        }
+        if (!m_running) {
+            if (m_ring.empty()) {
+                break;
+            }
+            continue;
         }
         
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        // Sleep until a producer signals or the next flush is due
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_writerSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_ring.empty() && m_running && !m_rotateRequested && m_droppedPending.load() == 0) {
+            m_wake.wait_for(lock, flushInterval);
+        }
+        m_writerSleeping.store(false, std::memory_order_relaxed);
     }
-}
-
-void Logger::writeToFile(const std::string& formattedMessage) {
+    
     if (m_logStream.is_open()) {
-        m_logStream << formattedMessage << std::endl;
         m_logStream.flush();
     }
+    std::cout.flush();
 }
 
-void Logger::writeToConsole(const std::string& formattedMessage, LogLevel level) {
-    // Use different colors for different log levels
-    switch (level) {
-        case LogLevel::DEBUG:
-            std::cout << "\033[37m" << formattedMessage << "\033[0m" << std::endl; // White
-            break;
-        case LogLevel::INFO:
-            std::cout << "\033[32m" << formattedMessage << "\033[0m" << std::endl; // Green
-            break;
-        case LogLevel::WARNING:
-            std::cout << "\033[33m" << formattedMessage << "\033[0m" << std::endl; // Yellow
-            break;
-        case LogLevel::ERROR:
-        case LogLevel::CRITICAL:
-            std::cout << "\033[31m" << formattedMessage << "\033[0m" << std::endl; // Red
+void Logger::appendRecord(const Record& record, std::string& fileBatch, std::string& consoleBatch) {
+    std::string line = "[" + formatTimestamp(record.time) + "] [" + logLevelToString(record.level) + "] ";
+    if (record.formatId == 0) {
+        line.append(record.text, record.length);
+    } else {
+        formatDeferred(record, line);
+    }
+    
+    if (m_fileOutput) {
+        fileBatch += line;
+        fileBatch += '\n';
+    }
+    
+    if (m_consoleOutput) {
+        // Use different colors for different log levels
+        switch (record.level) {
+            case LogLevel::DEBUG:   consoleBatch += "\033[37m"; break; // White
+            case LogLevel::INFO:    consoleBatch += "\033[32m"; break; // Green
+            case LogLevel::WARNING: consoleBatch += "\033[33m"; break; // Yellow
+            case LogLevel::ERROR:
+            case LogLevel::CRITICAL:
+                consoleBatch += "\033[31m"; break;                      // Red
+        }
+        consoleBatch += line;
+        consoleBatch += "\033[0m\n";
+    }
+}
+
+void Logger::formatDeferred(const Record& record, std::string& line) {
+    const char* format = record.formatId < MAX_DEFERRED_FORMATS
+        ? g_deferredFormats[record.formatId].load(std::memory_order_acquire) : nullptr;
+    if (!format) {
+        line += "<unregistered log format " + std::to_string(record.formatId) + ">";
+        return;
+    }
+    
+    struct Argument {
+        ArgumentTag tag;
+        int64_t i = 0;
+        uint64_t u = 0;
+        double d = 0.0;
+        std::string s;
+    };
+    
+    size_t offset = 0;
+    auto nextArgument = [&](Argument& argument) {
+        if (offset >= record.length) {
+            return false;
+        }
+        argument.tag = static_cast<ArgumentTag>(record.text[offset++]);
+        switch (argument.tag) {
+            case ArgumentTag::INT:
+                std::memcpy(&argument.i, record.text + offset, sizeof(int64_t));
+                argument.u = static_cast<uint64_t>(argument.i);
+                argument.d = static_cast<double>(argument.i);
+                offset += sizeof(int64_t);
+                break;
+            case ArgumentTag::UINT:
+                std::memcpy(&argument.u, record.text + offset, sizeof(uint64_t));
+                argument.i = static_cast<int64_t>(argument.u);
+                argument.d = static_cast<double>(argument.u);
+                offset += sizeof(uint64_t);
+                break;
+            case ArgumentTag::DOUBLE:
+                std::memcpy(&argument.d, record.text + offset, sizeof(double));
+                // Only an integer conversion of a double uses these; NaN, inf and huge values stay 0
+                if (std::isfinite(argument.d) && std::fabs(argument.d) < 9.2e18) {
+                    argument.i = static_cast<int64_t>(argument.d);
+                }
+                argument.u = static_cast<uint64_t>(argument.i);
+                offset += sizeof(double);
+                break;
+            case ArgumentTag::STRING: {
+                size_t count = static_cast<unsigned char>(record.text[offset++]);
+                argument.s.assign(record.text + offset, count);
+                offset += count;
+                break;
+            }
+        }
+        return true;
+    };
+    
+    // Walk the printf format; each conversion takes the next argument and is
+    // re-issued with the length modifier that matches the decoded type
+    char buffer[RECORD_TEXT_SIZE + 64];
+    for (const char* p = format; *p; ++p) {
+        if (*p != '%') {
+            line += *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            line += '%';
+            ++p;
+            continue;
+        }
+        
+        const char* start = p++;
+        while (*p && std::strchr("-+ #0", *p)) ++p;
+        while (std::isdigit(static_cast<unsigned char>(*p)) || *p == '.') ++p;
+        std::string spec(start, p);
+        while (*p && std::strchr("hljztL", *p)) ++p;
+        char conversion = *p;
+        if (!conversion) {
             break;
+        }
+        
+        Argument argument;
+        if (!nextArgument(argument)) {
+            line += "<?>";
+            continue;
+        }
+        
+        int written = 0;
+        switch (conversion) {
+            case 'd': case 'i':
+                written = snprintf(buffer, sizeof(buffer), (spec + "lld").c_str(), static_cast<long long>(argument.i));
+                break;
+            case 'u': case 'o': case 'x': case 'X':
+                written = snprintf(buffer, sizeof(buffer), (spec + "ll" + conversion).c_str(),
+                                   static_cast<unsigned long long>(argument.u));
+                break;
+            case 'c':
+                written = snprintf(buffer, sizeof(buffer), (spec + "c").c_str(), static_cast<int>(argument.i));
+                break;
+            case 'p':
+                written = snprintf(buffer, sizeof(buffer), (spec + "p").c_str(),
+                                   reinterpret_cast<void*>(static_cast<uintptr_t>(argument.u)));
+                break;
+            case 's':
+                if (argument.tag != ArgumentTag::STRING) {
+                    argument.s = argument.tag == ArgumentTag::DOUBLE ? std::to_string(argument.d)
+                               : argument.tag == ArgumentTag::INT ? std::to_string(argument.i)
+                               : std::to_string(argument.u);
+                }
+                if (spec == "%") {
+                    line += argument.s;
+                    continue;
+                }
+                written = snprintf(buffer, sizeof(buffer), (spec + "s").c_str(), argument.s.c_str());
+                break;
+            default:    // f F e E g G a A
+                written = snprintf(buffer, sizeof(buffer), (spec + conversion).c_str(), argument.d);
+                break;
+        }
+        if (written > 0) {
+            line.append(buffer, std::min(static_cast<size_t>(written), sizeof(buffer) - 1));
+        }
     }
 }
 
-std::string Logger::formatMessage(LogLevel level, const std::string& message) {
-    std::ostringstream oss;
-    oss << "[" << getCurrentTimestamp() << "] "
-        << "[" << logLevelToString(level) << "] "
-        << message;
-    return oss.str();
+void Logger::writeBatch(const std::string& fileBatch, const std::string& consoleBatch) {
+    if (!fileBatch.empty() && m_logStream.is_open()) {
+        m_logStream.write(fileBatch.data(), static_cast<std::streamsize>(fileBatch.size()));
+    }
+    if (!consoleBatch.empty()) {
+        std::cout.write(consoleBatch.data(), static_cast<std::streamsize>(consoleBatch.size()));
+    }
 }
 
-std::string Logger::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
+std::string Logger::formatTimestamp(std::chrono::system_clock::time_point time) {
+    auto time_t = std::chrono::system_clock::to_time_t(time);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
+        time.time_since_epoch()) % 1000;
     
     std::ostringstream oss;
     oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
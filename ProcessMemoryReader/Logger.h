@@ -5,14 +5,32 @@
 #include <sstream>
 #include <chrono>
 #include <mutex>
-#include <queue>
+#include <condition_variable>
 #include <thread>
 #include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+#include "MpscRing.h"
 
 /**
  * @brief Comprehensive logging system for bot activities
+ *
+ * Callers format straight into a fixed-size record of a lock-free MPSC ring and
+ * return; timestamps are rendered, console output is written and the log file
+ * is appended by a writer thread that sleeps until a producer signals it. The
+ * writer drains records in batches and flushes the file on a timer (and right
+ * away for errors), so busy loops never wait for disk I/O. Messages longer than
+ * a record are truncated.
+ *
+ * Hot paths can skip formatting entirely: logDeferred() (normally through the
+ * TL_LOG_* macros) stores a registered format id plus the raw arguments, and
+ * the writer thread renders the text. The macros check the level before any
+ * argument is evaluated.
  */
 class Logger {
 public:
@@ -24,27 +42,117 @@ public:
         CRITICAL = 4
     };
 
+    enum class OverflowPolicy {
+        DROP,   // Discard the message and count it (default, never stalls the caller)
+        BLOCK   // Wait for the writer to free a record
+    };
+
+    static constexpr size_t DEFAULT_CAPACITY = 4096;   // Records in the ring
+
 private:
     std::string m_logDirectory;
-    std::string m_currentLogFile;
+    std::string m_currentLogFile;        // Renamed by the writer on rotation, read from any thread
+    mutable std::mutex m_logFileMutex;   // Guards m_currentLogFile
     std::ofstream m_logStream;
     
-    LogLevel m_minLogLevel = LogLevel::INFO;
-    bool m_consoleOutput = true;
-    bool m_fileOutput = true;
+    std::atomic<LogLevel> m_minLogLevel{LogLevel::INFO};
+    std::atomic<bool> m_consoleOutput{true};
+    std::atomic<bool> m_fileOutput{true};
+    std::atomic<OverflowPolicy> m_overflowPolicy{OverflowPolicy::DROP};
+    std::atomic<int64_t> m_flushIntervalMs{1000};
     
     // Async logging
-    std::queue<std::string> m_logQueue;
-    std::mutex m_queueMutex;
+    static constexpr size_t RECORD_TEXT_SIZE = 232;   // Keeps a record at 256 bytes
+    static constexpr size_t WRITE_BATCH = 256;        // Records per file write
+    
+    struct Record {
+        std::chrono::system_clock::time_point time;
+        LogLevel level;
+        uint16_t length;
+        uint16_t formatId;              // 0 = text holds the message, otherwise encoded arguments
+        char text[RECORD_TEXT_SIZE];
+    };
+    
+    // Deferred argument encoding: tag byte followed by the value (strings: length byte + chars)
+    enum class ArgumentTag : uint8_t {
+        INT,
+        UINT,
+        DOUBLE,
+        STRING
+    };
+    
+    struct ArgumentEncoder {
+        char* data;
+        size_t capacity;
+        size_t length = 0;
+        bool full = false;              // Later arguments are dropped so positions stay aligned
+        
+        template<typename V>
+        void putScalar(ArgumentTag tag, V value) {
+            if (full || length + 1 + sizeof(V) > capacity) {
+                full = true;
+                return;
+            }
+            data[length++] = static_cast<char>(tag);
+            std::memcpy(data + length, &value, sizeof(V));
+            length += sizeof(V);
+        }
+        
+        void putString(std::string_view value) {
+            if (full || length + 2 > capacity) {
+                full = true;
+                return;
+            }
+            size_t count = std::min({value.size(), capacity - length - 2, size_t{255}});
+            data[length++] = static_cast<char>(ArgumentTag::STRING);
+            data[length++] = static_cast<char>(count);
+            std::memcpy(data + length, value.data(), count);
+            length += count;
+            full = count < value.size();
+        }
+        
+        template<typename T>
+        void put(const T& value) {
+            if constexpr (std::is_same_v<T, bool>) {
+                putScalar(ArgumentTag::UINT, static_cast<uint64_t>(value));
+            } else if constexpr (std::is_floating_point_v<T>) {
+                putScalar(ArgumentTag::DOUBLE, static_cast<double>(value));
+            } else if constexpr (std::is_enum_v<T>) {
+                put(static_cast<std::underlying_type_t<T>>(value));
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                putScalar(ArgumentTag::INT, static_cast<int64_t>(value));
+            } else if constexpr (std::is_integral_v<T>) {
+                putScalar(ArgumentTag::UINT, static_cast<uint64_t>(value));
+            } else if constexpr (std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>) {
+                putString(value ? std::string_view(value) : std::string_view("(null)"));
+            } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+                putString(std::string_view(value));
+            } else if constexpr (std::is_pointer_v<T>) {
+                putScalar(ArgumentTag::UINT, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+            } else {
+                static_assert(std::is_pointer_v<T>, "Unsupported deferred log argument type");
+            }
+        }
+    };
+    
+    MpscRing<Record> m_ring;
     std::thread m_logThread;
     std::atomic<bool> m_running{false};
+    std::atomic<bool> m_rotateRequested{false};
+    
+    // Writer wake-up: producers only touch the mutex while the writer sleeps
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::atomic<bool> m_writerSleeping{false};
     
     // Statistics
-    uint64_t m_totalLogs = 0;
-    std::unordered_map<LogLevel, uint64_t> m_logCounts;
+    std::atomic<uint64_t> m_totalLogs{0};
+    std::atomic<uint64_t> m_levelCounts[5] = {};
+    std::atomic<uint64_t> m_dropped{0};         // Lifetime total
+    std::atomic<uint64_t> m_droppedPending{0};  // Not yet reported in the log
 
 public:
-    Logger(const std::string& logDirectory = "logs");
+    Logger(const std::string& logDirectory = "logs", size_t capacity = DEFAULT_CAPACITY);
     ~Logger();
     
     // Core logging methods
@@ -57,27 +165,52 @@ public:
     // Formatted logging
     template<typename... Args>
     void debug(const std::string& format, Args... args) {
-        log(LogLevel::DEBUG, formatString(format, args...));
+        logFormatted(LogLevel::DEBUG, format.c_str(), args...);
     }
     
     template<typename... Args>
     void info(const std::string& format, Args... args) {
-        log(LogLevel::INFO, formatString(format, args...));
+        logFormatted(LogLevel::INFO, format.c_str(), args...);
     }
     
     template<typename... Args>
     void warning(const std::string& format, Args... args) {
-        log(LogLevel::WARNING, formatString(format, args...));
+        logFormatted(LogLevel::WARNING, format.c_str(), args...);
     }
     
     template<typename... Args>
     void error(const std::string& format, Args... args) {
-        log(LogLevel::ERROR, formatString(format, args...));
+        logFormatted(LogLevel::ERROR, format.c_str(), args...);
     }
     
     template<typename... Args>
     void critical(const std::string& format, Args... args) {
-        log(LogLevel::CRITICAL, formatString(format, args...));
+        logFormatted(LogLevel::CRITICAL, format.c_str(), args...);
+    }
+    
+    /**
+     * @brief Register a printf-style format for deferred logging
+     * @param format Must stay valid for the lifetime of the process (a string literal)
+     * @return Id stored in records in place of the formatted text
+     */
+    static uint16_t registerFormat(const char* format);
+    
+    /**
+     * @brief Record a format id and raw arguments; the writer thread formats them
+     * Integers, floating point values, enums and strings are supported; strings are copied.
+     * Arguments that do not fit in a record are dropped. Use the TL_LOG_* macros so
+     * disabled levels skip argument evaluation as well.
+     */
+    template<typename... Args>
+    void logDeferred(LogLevel level, uint16_t formatId, const Args&... args) {
+        if (!isEnabled(level)) {
+            return;
+        }
+        enqueue(level, [&](char* text, size_t capacity) {
+            ArgumentEncoder encoder{text, capacity};
+            (encoder.put(args), ...);
+            return encoder.length;
+        }, formatId);
     }
     
     // Specialized logging methods
@@ -92,32 +225,92 @@ public:
     void setMinLogLevel(LogLevel level) { m_minLogLevel = level; }
     void setConsoleOutput(bool enabled) { m_consoleOutput = enabled; }
     void setFileOutput(bool enabled) { m_fileOutput = enabled; }
+    void setOverflowPolicy(OverflowPolicy policy) { m_overflowPolicy = policy; }
+    void setFlushInterval(std::chrono::milliseconds interval) { m_flushIntervalMs = interval.count(); }
+    bool isEnabled(LogLevel level) const { return level >= m_minLogLevel.load(std::memory_order_relaxed); }
     
     // File management
-    void rotateLogs();
+    void rotateLogs();   // Performed by the writer thread
     void clearOldLogs(int daysToKeep = 7);
-    std::string getCurrentLogFile() const { return m_currentLogFile; }
+    std::string getCurrentLogFile() const;
     
     // Statistics
     uint64_t getTotalLogs() const { return m_totalLogs; }
-    std::unordered_map<LogLevel, uint64_t> getLogCounts() const { return m_logCounts; }
+    uint64_t getDroppedLogs() const { return m_dropped; }
+    std::unordered_map<LogLevel, uint64_t> getLogCounts() const;
 
 private:
     void log(LogLevel level, const std::string& message);
     void processLogQueue();
-    void writeToFile(const std::string& formattedMessage);
-    void writeToConsole(const std::string& formattedMessage, LogLevel level);
+    void writeBatch(const std::string& fileBatch, const std::string& consoleBatch);
+    void appendRecord(const Record& record, std::string& fileBatch, std::string& consoleBatch);
+    void formatDeferred(const Record& record, std::string& line);
+    void wakeWriter();
     
-    std::string formatMessage(LogLevel level, const std::string& message);
-    std::string getCurrentTimestamp();
+    std::string formatTimestamp(std::chrono::system_clock::time_point time);
     std::string logLevelToString(LogLevel level);
     std::string generateLogFileName();
     
     template<typename... Args>
-    std::string formatString(const std::string& format, Args... args) {
-        size_t size = snprintf(nullptr, 0, format.c_str(), args...) + 1;
-        std::unique_ptr<char[]> buf(new char[size]);
-        snprintf(buf.get(), size, format.c_str(), args...);
-        return std::string(buf.get(), buf.get() + size - 1);
+    void logFormatted(LogLevel level, const char* format, Args... args) {
+        if (!isEnabled(level)) {
+            return;
+        }
+        enqueue(level, [&](char* text, size_t capacity) {
+            int written = snprintf(text, capacity, format, args...);
+            return written < 0 ? size_t{0} : std::min(static_cast<size_t>(written), capacity - 1);
+        });
+    }
+    
+    /**
+     * @brief Claim a record and let fill(text, capacity) write the message into it
+     * @param fill Returns the number of characters written
+     */
+    template<typename Fill>
+    void enqueue(LogLevel level, Fill&& fill, uint16_t formatId = 0) {
+        auto now = std::chrono::system_clock::now();
+        auto push = [&] {
+            return m_ring.tryPush([&](Record& record) {
+                record.time = now;
+                record.level = level;
+                record.formatId = formatId;
+                record.length = static_cast<uint16_t>(fill(record.text, RECORD_TEXT_SIZE));
+            });
+        };
+        
+        if (!push()) {
+            if (m_overflowPolicy.load(std::memory_order_relaxed) == OverflowPolicy::DROP) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                m_droppedPending.fetch_add(1, std::memory_order_relaxed);
+                wakeWriter();
+                return;
+            }
+            do {
+                wakeWriter();
+                std::this_thread::yield();
+            } while (!push());
+        }
+        
+        m_totalLogs.fetch_add(1, std::memory_order_relaxed);
+        m_levelCounts[static_cast<int>(level)].fetch_add(1, std::memory_order_relaxed);
+        wakeWriter();
     }
 };
+
+/**
+ * Deferred logging at a call site: the format is registered once, and neither the
+ * arguments nor the format are touched when the level is disabled.
+ *     TL_LOG_DEBUG(*m_logger, "Target %u at %.1f m", id, distance);
+ */
+#define TL_LOG_DEFERRED(logger, level, format, ...)                            \
+    do {                                                                       \
+        if ((logger).isEnabled(level)) {                                       \
+            static const uint16_t tlLogFormatId = Logger::registerFormat(format); \
+            (logger).logDeferred(level, tlLogFormatId, ##__VA_ARGS__);         \
+        }                                                                      \
+    } while (0)
+
+#define TL_LOG_DEBUG(logger, format, ...)   TL_LOG_DEFERRED(logger, Logger::LogLevel::DEBUG, format, ##__VA_ARGS__)
+#define TL_LOG_INFO(logger, format, ...)    TL_LOG_DEFERRED(logger, Logger::LogLevel::INFO, format, ##__VA_ARGS__)
+#define TL_LOG_WARNING(logger, format, ...) TL_LOG_DEFERRED(logger, Logger::LogLevel::WARNING, format, ##__VA_ARGS__)
+#define TL_LOG_ERROR(logger, format, ...)   TL_LOG_DEFERRED(logger, Logger::LogLevel::ERROR, format, ##__VA_ARGS__)
@@ -0,0 +1,406 @@
+#include "LootFilter.h"
+#include "LootRuleProgram.h"
+#include "NameMatcher.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    using Condition = LootFilter::Condition;
+    using Field = LootFilter::Condition::Field;
+    using ItemRarity = LootFilter::ItemRarity;
+    using ItemType = LootFilter::ItemType;
+
+    LootFilter::FilterRule makeRule(const std::string& name, std::vector<Condition> conditions, int priority,
+                                    const std::string& description,
+                                    LootFilter::RuleAction action = LootFilter::RuleAction::LOOT) {
+        LootFilter::FilterRule rule;
+        rule.name = name;
+        rule.conditions = std::move(conditions);
+        rule.action = action;
+        rule.priority = priority;
+        rule.description = description;
+        return rule;
+    }
+
+    int rarityValue(int rarity) {
+        static const int values[] = {5, 20, 80, 400, 1500, 1000};
+        return rarity >= 0 && rarity < 6 ? values[rarity] : 0;
+    }
+
+    std::string toLower(const std::string& text) {
+        std::string lower(text);
+        for (char& c : lower) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return lower;
+    }
+
+    const NameMatcher& valuableAffixMatcher() {
+        static const NameMatcher matcher({
+            "critical", "attack speed", "cast speed", "movement speed", "all skills",
+            "+1 to", "+2 to", "life steal", "max life", "resistance"
+        });
+        return matcher;
+    }
+}
+
+LootFilter::LootFilter() : m_program(std::make_unique<LootRuleProgram>()) {
+    initializeDefaultRules();
+    initializeItemPriorities();
+}
+
+LootFilter::~LootFilter() = default;
+
+bool LootFilter::shouldLootItem(const ItemInfo& item) {
+    ItemInfo copy = item;
+    if (copy.value <= 0) {
+        copy.value = calculateItemValue(copy);
+    }
+
+    compiledProgram().evaluate(&copy, 1);
+    updateStatistics(copy, copy.shouldLoot);
+    return copy.shouldLoot;
+}
+
+std::vector<LootFilter::ItemInfo> LootFilter::filterItems(const std::vector<LootFilter::ItemInfo>& items) {
+    std::vector<ItemInfo> evaluated(items);
+    for (ItemInfo& item : evaluated) {
+        if (item.value <= 0) {
+            item.value = calculateItemValue(item);
+        }
+    }
+
+    compiledProgram().evaluate(evaluated.data(), evaluated.size());
+
+    std::vector<ItemInfo> result;
+    result.reserve(evaluated.size());
+    for (ItemInfo& item : evaluated) {
+        updateStatistics(item, item.shouldLoot);
+        if (item.shouldLoot) {
+            result.push_back(std::move(item));
+        }
+    }
+    return result;
+}
+
+std::vector<LootFilter::ItemInfo> LootFilter::prioritizeItems(const std::vector<LootFilter::ItemInfo>& items) {
+    std::vector<ItemInfo> sorted(items);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const ItemInfo& a, const ItemInfo& b) {
+        return a.priority > b.priority;
+    });
+    return sorted;
+}
+
+void LootFilter::addRule(const FilterRule& rule) {
+    removeRule(rule.name);
+    m_rules.push_back(rule);
+    m_programDirty = true;
+}
+
+void LootFilter::removeRule(const std::string& ruleName) {
+    auto it = std::remove_if(m_rules.begin(), m_rules.end(), [&](const FilterRule& rule) {
+        return rule.name == ruleName;
+    });
+    if (it != m_rules.end()) {
+        m_rules.erase(it, m_rules.end());
+        m_programDirty = true;
+    }
+}
+
+void LootFilter::enableRule(const std::string& ruleName, bool enabled) {
+    for (FilterRule& rule : m_rules) {
+        if (rule.name == ruleName && rule.enabled != enabled) {
+            rule.enabled = enabled;
+            m_programDirty = true;
+        }
+    }
+}
+
+void LootFilter::addToBlacklist(const std::string& itemName) {
+    m_itemBlacklist[toLower(itemName)] = true;
+    m_programDirty = true;
+}
+
+void LootFilter::removeFromBlacklist(const std::string& itemName) {
+    if (m_itemBlacklist.erase(toLower(itemName)) != 0) {
+        m_programDirty = true;
+    }
+}
+
+bool LootFilter::isBlacklisted(const std::string& itemName) const {
+    return m_itemBlacklist.count(toLower(itemName)) != 0;
+}
+
+void LootFilter::setItemPriority(const std::string& itemName, int priority) {
+    m_itemPriorities[toLower(itemName)] = priority;
+    m_programDirty = true;
+}
+
+int LootFilter::getItemPriority(const std::string& itemName) const {
+    auto it = m_itemPriorities.find(toLower(itemName));
+    return it != m_itemPriorities.end() ? it->second : 0;
+}
+
+void LootFilter::loadAggressiveFilter() {
+    m_rules = {
+        makeRule("Currency", {Condition::oneOf(Field::TYPE, typeBit(ItemType::CURRENCY))}, 90, "All currency"),
+        makeRule("Gems", {Condition::oneOf(Field::TYPE, typeBit(ItemType::GEM))}, 70, "All gems"),
+        makeRule("Quest items", {Condition::oneOf(Field::TYPE, typeBit(ItemType::QUEST_ITEM))}, 100, "Quest items"),
+        makeRule("Seasonal", {Condition::oneOf(Field::TYPE, typeBit(ItemType::SEASONAL_ITEM))}, 80, "Seasonal items"),
+        makeRule("Magic or better", {Condition::atLeast(Field::RARITY, static_cast<int>(ItemRarity::MAGIC))}, 40,
+                 "Any magic, rare or better item"),
+        makeRule("Materials", {Condition::oneOf(Field::TYPE, typeBit(ItemType::MATERIAL))}, 30, "Crafting materials"),
+    };
+    m_minRarity = ItemRarity::NORMAL;
+    m_minValue = 50;
+    m_programDirty = true;
+}
+
+void LootFilter::loadSafeFilter() {
+    m_rules = {
+        makeRule("Quest items", {Condition::oneOf(Field::TYPE, typeBit(ItemType::QUEST_ITEM))}, 100, "Quest items"),
+        makeRule("Legendary or better", {Condition::atLeast(Field::RARITY, static_cast<int>(ItemRarity::LEGENDARY))}, 90,
+                 "Legendary, mythic and unique items"),
+        makeRule("Valuable currency", {Condition::oneOf(Field::TYPE, typeBit(ItemType::CURRENCY)),
+                                       Condition::atLeast(Field::VALUE, 200)}, 80, "Currency worth 200+"),
+    };
+    m_minRarity = ItemRarity::LEGENDARY;
+    m_minValue = 500;
+    m_programDirty = true;
+}
+
+void LootFilter::loadBalancedFilter() {
+    m_rules = {
+        makeRule("Quest items", {Condition::oneOf(Field::TYPE, typeBit(ItemType::QUEST_ITEM))}, 100, "Quest items"),
+        makeRule("Currency", {Condition::oneOf(Field::TYPE, typeBit(ItemType::CURRENCY))}, 90, "All currency"),
+        makeRule("Legendary or better", {Condition::atLeast(Field::RARITY, static_cast<int>(ItemRarity::LEGENDARY))}, 85,
+                 "Legendary, mythic and unique items"),
+        makeRule("Seasonal", {Condition::oneOf(Field::TYPE, typeBit(ItemType::SEASONAL_ITEM))}, 75, "Seasonal items"),
+        makeRule("Rare gear", {Condition::oneOf(Field::TYPE, typeBit(ItemType::WEAPON) | typeBit(ItemType::ARMOR) |
+                                                             typeBit(ItemType::ACCESSORY)),
+                               Condition::atLeast(Field::RARITY, static_cast<int>(ItemRarity::RARE))}, 60,
+                 "Rare weapons, armour and accessories"),
+        makeRule("Gems", {Condition::oneOf(Field::TYPE, typeBit(ItemType::GEM))}, 55, "All gems"),
+    };
+    m_minRarity = ItemRarity::MAGIC;
+    m_minValue = 100;
+    m_programDirty = true;
+}
+
+void LootFilter::loadSeasonalFilter() {
+    loadBalancedFilter();
+    m_rules.push_back(makeRule("Seasonal priority", {Condition::oneOf(Field::TYPE, typeBit(ItemType::SEASONAL_ITEM))},
+                               120, "Seasonal items before everything else"));
+    m_enableSeasonalFilter = true;
+}
+
+void LootFilter::loadBossFilter() {
+    m_rules = {
+        makeRule("Quest items", {Condition::oneOf(Field::TYPE, typeBit(ItemType::QUEST_ITEM))}, 100, "Quest items"),
+        makeRule("Mythic and unique", {Condition::oneOf(Field::RARITY, rarityBit(ItemRarity::MYTHIC) |
+                                                                       rarityBit(ItemRarity::UNIQUE))}, 95,
+                 "Boss-exclusive drops"),
+        makeRule("Legendary", {Condition::equals(Field::RARITY, static_cast<int>(ItemRarity::LEGENDARY))}, 85,
+                 "Legendary items"),
+        makeRule("Currency", {Condition::oneOf(Field::TYPE, typeBit(ItemType::CURRENCY))}, 80, "All currency"),
+        makeRule("Valuable affixes", {Condition::atLeast(Field::RARITY, static_cast<int>(ItemRarity::RARE)),
+                                      Condition::affixContains("all skills")}, 70, "Rares with +skills"),
+    };
+    m_minRarity = ItemRarity::RARE;
+    m_programDirty = true;
+}
+
+LootFilter::ItemRarity LootFilter::parseRarity(const std::string& rarityStr) {
+    std::string rarity = toLower(rarityStr);
+    if (rarity == "magic") return ItemRarity::MAGIC;
+    if (rarity == "rare") return ItemRarity::RARE;
+    if (rarity == "legendary") return ItemRarity::LEGENDARY;
+    if (rarity == "mythic") return ItemRarity::MYTHIC;
+    if (rarity == "unique") return ItemRarity::UNIQUE;
+    return ItemRarity::NORMAL;
+}
+
+LootFilter::ItemType LootFilter::parseItemType(const std::string& typeStr) {
+    std::string type = toLower(typeStr);
+    if (type == "weapon") return ItemType::WEAPON;
+    if (type == "armor" || type == "armour") return ItemType::ARMOR;
+    if (type == "accessory") return ItemType::ACCESSORY;
+    if (type == "consumable") return ItemType::CONSUMABLE;
+    if (type == "currency") return ItemType::CURRENCY;
+    if (type == "gem") return ItemType::GEM;
+    if (type == "material") return ItemType::MATERIAL;
+    if (type == "quest" || type == "quest_item") return ItemType::QUEST_ITEM;
+    if (type == "seasonal" || type == "seasonal_item") return ItemType::SEASONAL_ITEM;
+    return ItemType::UNKNOWN;
+}
+
+std::string LootFilter::rarityToString(ItemRarity rarity) {
+    switch (rarity) {
+        case ItemRarity::NORMAL: return "normal";
+        case ItemRarity::MAGIC: return "magic";
+        case ItemRarity::RARE: return "rare";
+        case ItemRarity::LEGENDARY: return "legendary";
+        case ItemRarity::MYTHIC: return "mythic";
+        case ItemRarity::UNIQUE: return "unique";
+        default: return "unknown";
+    }
+}
+
+std::string LootFilter::itemTypeToString(ItemType type) {
+    switch (type) {
+        case ItemType::WEAPON: return "weapon";
+        case ItemType::ARMOR: return "armor";
+        case ItemType::ACCESSORY: return "accessory";
+        case ItemType::CONSUMABLE: return "consumable";
+        case ItemType::CURRENCY: return "currency";
+        case ItemType::GEM: return "gem";
+        case ItemType::MATERIAL: return "material";
+        case ItemType::QUEST_ITEM: return "quest_item";
+        case ItemType::SEASONAL_ITEM: return "seasonal_item";
+        default: return "unknown";
+    }
+}
+
+int LootFilter::calculateItemValue(const ItemInfo& item) {
+    int value = rarityValue(static_cast<int>(item.rarity)) * (10 + std::max(item.level, 0)) / 10;
+    if (isCurrencyItem(item)) {
+        value = std::max(value, 150);
+    }
+    if (hasValuableAffixes(item)) {
+        value *= 2;
+    }
+    return value;
+}
+
+bool LootFilter::hasValuableAffixes(const ItemInfo& item) {
+    const NameMatcher& matcher = valuableAffixMatcher();
+    return std::any_of(item.affixes.begin(), item.affixes.end(), [&](SymbolId affix) {
+        return matcher.containsAny(SymbolTable::global().name(affix));
+    });
+}
+
+bool LootFilter::isSeasonalItem(const ItemInfo& item) {
+    return item.type == ItemType::SEASONAL_ITEM;
+}
+
+bool LootFilter::isCurrencyItem(const ItemInfo& item) {
+    return item.type == ItemType::CURRENCY;
+}
+
+void LootFilter::initializeDefaultRules() {
+    loadBalancedFilter();
+}
+
+void LootFilter::initializeItemPriorities() {
+    m_itemPriorities.clear();
+    m_programDirty = true;
+}
+
+LootRuleProgram& LootFilter::compiledProgram() {
+    if (m_programDirty) {
+        std::vector<FilterRule> rules = m_rules;
+        std::vector<FilterRule> settings = buildSettingRules();
+        rules.insert(rules.end(), settings.begin(), settings.end());
+
+        std::vector<std::string> blacklist;
+        blacklist.reserve(m_itemBlacklist.size());
+        for (const auto& [name, listed] : m_itemBlacklist) {
+            if (listed) blacklist.push_back(name);
+        }
+
+        std::vector<std::pair<std::string, int>> priorities(m_itemPriorities.begin(), m_itemPriorities.end());
+
+        m_program->compile(rules, blacklist, priorities);
+        m_programDirty = false;
+    }
+    return *m_program;
+}
+
+std::vector<LootFilter::FilterRule> LootFilter::buildSettingRules() const {
+    // The threshold settings become ordinary rules so they run through the same program
+    std::vector<FilterRule> rules;
+    if (m_minLevel > 1) {
+        rules.push_back(makeRule("Below minimum level",
+                                 {Condition::atMost(Field::LEVEL, m_minLevel - 1),
+                                  Condition::oneOf(Field::TYPE, typeBit(ItemType::WEAPON) | typeBit(ItemType::ARMOR) |
+                                                                typeBit(ItemType::ACCESSORY))},
+                                 0, "Gear below the minimum level", RuleAction::REJECT));
+    }
+    if (m_enableCurrencyFilter) {
+        rules.push_back(makeRule("Currency filter", {Condition::oneOf(Field::TYPE, typeBit(ItemType::CURRENCY))}, 50,
+                                 "Currency is always worth picking up"));
+    }
+    if (m_enableSeasonalFilter) {
+        rules.push_back(makeRule("Seasonal filter", {Condition::oneOf(Field::TYPE, typeBit(ItemType::SEASONAL_ITEM))},
+                                 45, "Seasonal items"));
+    }
+    if (m_enableRarityFilter) {
+        rules.push_back(makeRule("Minimum rarity", {Condition::atLeast(Field::RARITY, static_cast<int>(m_minRarity))}, 20,
+                                 "At least the configured rarity"));
+    }
+    if (m_enableValueFilter) {
+        rules.push_back(makeRule("Minimum value", {Condition::atLeast(Field::VALUE, m_minValue)}, 10,
+                                 "Estimated value above the configured minimum"));
+    }
+    return rules;
+}
+
+bool LootFilter::evaluateRule(const FilterRule& rule, const ItemInfo& item) {
+    // Interpreted single-rule check for tools and debugging; filtering uses the compiled program
+    const SymbolTable& symbols = SymbolTable::global();
+    std::string name = toLower(symbols.name(item.name));
+    for (const Condition& condition : rule.conditions) {
+        int field = 0;
+        switch (condition.field) {
+            case Field::RARITY: field = static_cast<int>(item.rarity); break;
+            case Field::TYPE: field = static_cast<int>(item.type); break;
+            case Field::LEVEL: field = item.level; break;
+            case Field::VALUE: field = item.value; break;
+            case Field::IDENTIFIED: field = item.isIdentified ? 1 : 0; break;
+            default: break;
+        }
+
+        bool holds = false;
+        switch (condition.op) {
+            case Condition::Op::AT_LEAST: holds = field >= condition.value; break;
+            case Condition::Op::AT_MOST: holds = field <= condition.value; break;
+            case Condition::Op::EQUAL: holds = field == condition.value; break;
+            case Condition::Op::NOT_EQUAL: holds = field != condition.value; break;
+            case Condition::Op::ONE_OF: holds = field >= 0 && field < 32 && ((condition.mask >> field) & 1) != 0; break;
+            case Condition::Op::CONTAINS:
+                if (condition.field == Field::NAME) {
+                    holds = name.find(toLower(condition.text)) != std::string::npos;
+                } else if (condition.field == Field::AFFIX) {
+                    std::string text = toLower(condition.text);
+                    holds = std::any_of(item.affixes.begin(), item.affixes.end(), [&](SymbolId affix) {
+                        return toLower(symbols.name(affix)).find(text) != std::string::npos;
+                    });
+                }
+                break;
+            case Condition::Op::IS:
+                holds = condition.field == Field::NAME && name == toLower(condition.text);
+                break;
+        }
+        if (!holds) {
+            return false;
+        }
+    }
+    return !rule.conditions.empty();
+}
+
+int LootFilter::calculateBasePriority(const ItemInfo& item) {
+    return static_cast<int>(item.rarity) * 10 + item.value / 100 + getItemPriority(SymbolTable::global().name(item.name));
+}
+
+void LootFilter::updateStatistics(const ItemInfo& item, bool looted) {
+    // Accepted items are filtered again every tick until picked up; count each one once
+    if (item.entityId != 0 && !m_countedItems.insert(item.entityId).second) {
+        return;
+    }
+    
+    ++m_itemsFiltered;
+    if (looted) {
+        ++m_itemsLooted;
+        ++m_lootedByRarity[item.rarity];
+    }
+}
@@ -2,12 +2,22 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <cstdint>
 #include <unordered_map>
-#include <functional>
-#include <regex>
+#include <unordered_set>
+#include "SymbolTable.h"
+
+class LootRuleProgram;
 
 /**
  * @brief Manages item filtering and loot prioritization
+ *
+ * Rules are declarative (conditions over item fields and names) and are
+ * compiled, together with the blacklist, name priorities and threshold
+ * settings, into a LootRuleProgram the first time items are filtered after a
+ * change. Items carry interned names, so filtering never calls through
+ * std::function, copies a string or hashes a name.
  */
 class LootFilter {
 public:
@@ -34,13 +44,14 @@ public:
     };
 
     struct ItemInfo {
-        std::string name;
-        ItemType type;
-        ItemRarity rarity;
-        int level;
-        int value;                     // Estimated value
-        bool isIdentified;
-        std::vector<std::string> affixes; // Item modifiers
+        uint64_t entityId = 0;         // Source entity (0 = not from the world)
+        SymbolId name = SymbolTable::EMPTY;
+        ItemType type = ItemType::UNKNOWN;
+        ItemRarity rarity = ItemRarity::NORMAL;
+        int level = 0;
+        int value = 0;                 // Estimated value (0 = estimate when filtering)
+        bool isIdentified = false;
+        std::vector<SymbolId> affixes; // Item modifiers
         
         // Position in world
         float x, y, z;
@@ -51,18 +62,72 @@ public:
         std::string filterReason;      // Why it was included/excluded
     };
 
+    /**
+     * @brief One test of a rule; all conditions of a rule must hold
+     */
+    struct Condition {
+        enum class Field : uint8_t {
+            RARITY,
+            TYPE,
+            LEVEL,
+            VALUE,
+            IDENTIFIED,
+            NAME,          // Item name, case-insensitive
+            AFFIX          // Any affix, case-insensitive
+        };
+
+        enum class Op : uint8_t {
+            AT_LEAST,      // field >= value
+            AT_MOST,       // field <= value
+            EQUAL,         // field == value
+            NOT_EQUAL,     // field != value
+            ONE_OF,        // bit (1 << field) set in mask
+            CONTAINS,      // NAME / AFFIX contains text
+            IS             // NAME equals text
+        };
+
+        Field field = Field::RARITY;
+        Op op = Op::AT_LEAST;
+        int value = 0;
+        uint32_t mask = 0;
+        std::string text;
+
+        static Condition atLeast(Field field, int value) { return {field, Op::AT_LEAST, value, 0, {}}; }
+        static Condition atMost(Field field, int value) { return {field, Op::AT_MOST, value, 0, {}}; }
+        static Condition equals(Field field, int value) { return {field, Op::EQUAL, value, 0, {}}; }
+        static Condition oneOf(Field field, uint32_t mask) { return {field, Op::ONE_OF, 0, mask, {}}; }
+        static Condition nameContains(const std::string& text) { return {Field::NAME, Op::CONTAINS, 0, 0, text}; }
+        static Condition nameIs(const std::string& text) { return {Field::NAME, Op::IS, 0, 0, text}; }
+        static Condition affixContains(const std::string& text) { return {Field::AFFIX, Op::CONTAINS, 0, 0, text}; }
+    };
+
+    enum class RuleAction {
+        LOOT,              // Loot matching items with the rule's priority
+        REJECT             // Never loot matching items; checked before every LOOT rule
+    };
+
     struct FilterRule {
         std::string name;
-        std::function<bool(const ItemInfo&)> condition;
-        int priority;
-        bool enabled;
+        std::vector<Condition> conditions;
+        RuleAction action = RuleAction::LOOT;
+        int priority = 0;
+        bool enabled = true;
         std::string description;
     };
 
+    static constexpr uint32_t typeBit(ItemType type) { return 1u << static_cast<uint32_t>(type); }
+    static constexpr uint32_t rarityBit(ItemRarity rarity) { return 1u << static_cast<uint32_t>(rarity); }
+
 private:
     std::vector<FilterRule> m_rules;
     std::unordered_map<std::string, bool> m_itemBlacklist;
     std::unordered_map<std::string, int> m_itemPriorities;
+    std::unordered_set<uint64_t> m_rejectedItems;   // Entity ids judged not worth looting
+    std::unordered_set<uint64_t> m_countedItems;    // Entity ids already in the statistics
+    
+    // Compiled form of everything above; rebuilt lazily once m_programDirty is set
+    std::unique_ptr<LootRuleProgram> m_program;
+    bool m_programDirty = true;
     
     // Configuration
     bool m_enableCurrencyFilter = true;
@@ -81,12 +146,27 @@ private:
 
 public:
     LootFilter();
+    ~LootFilter();
     
     // Core filtering
     bool shouldLootItem(const ItemInfo& item);
+    
+    /**
+     * @brief Evaluate every item in one pass over the compiled rules
+     * @return The items to loot, with priority and filterReason set
+     */
     std::vector<ItemInfo> filterItems(const std::vector<ItemInfo>& items);
     std::vector<ItemInfo> prioritizeItems(const std::vector<ItemInfo>& items);
     
+    // Per-entity decisions, kept until the item despawns
+    bool isRejected(uint64_t entityId) const { return m_rejectedItems.count(entityId) != 0; }
+    void rejectItem(uint64_t entityId) { m_rejectedItems.insert(entityId); }
+    void forgetItem(uint64_t entityId) {
+        m_rejectedItems.erase(entityId);
+        m_countedItems.erase(entityId);
+    }
+    void clearRejectedItems() { m_rejectedItems.clear(); }
+    
     // Rule management
     void addRule(const FilterRule& rule);
     void removeRule(const std::string& ruleName);
@@ -94,14 +174,14 @@ public:
     std::vector<FilterRule> getRules() const { return m_rules; }
     
     // Configuration methods
-    void setMinimumRarity(ItemRarity rarity) { m_minRarity = rarity; }
-    void setMinimumLevel(int level) { m_minLevel = level; }
-    void setMinimumValue(int value) { m_minValue = value; }
+    void setMinimumRarity(ItemRarity rarity) { m_minRarity = rarity; m_programDirty = true; }
+    void setMinimumLevel(int level) { m_minLevel = level; m_programDirty = true; }
+    void setMinimumValue(int value) { m_minValue = value; m_programDirty = true; }
     
-    void enableCurrencyFilter(bool enable) { m_enableCurrencyFilter = enable; }
-    void enableRarityFilter(bool enable) { m_enableRarityFilter = enable; }
-    void enableValueFilter(bool enable) { m_enableValueFilter = enable; }
-    void enableSeasonalFilter(bool enable) { m_enableSeasonalFilter = enable; }
+    void enableCurrencyFilter(bool enable) { m_enableCurrencyFilter = enable; m_programDirty = true; }
+    void enableRarityFilter(bool enable) { m_enableRarityFilter = enable; m_programDirty = true; }
+    void enableValueFilter(bool enable) { m_enableValueFilter = enable; m_programDirty = true; }
+    void enableSeasonalFilter(bool enable) { m_enableSeasonalFilter = enable; m_programDirty = true; }
     
     // Blacklist management
     void addToBlacklist(const std::string& itemName);
@@ -139,14 +219,9 @@ public:
 private:
     void initializeDefaultRules();
     void initializeItemPriorities();
+    LootRuleProgram& compiledProgram();
+    std::vector<FilterRule> buildSettingRules() const;
     bool evaluateRule(const FilterRule& rule, const ItemInfo& item);
     int calculateBasePriority(const ItemInfo& item);
-    void updateStatistics(const ItemInfo& item, bool looted);
-    
-    // Predefined rule functions
-    bool isHighValueCurrency(const ItemInfo& item);
-    bool isUpgradeCandidate(const ItemInfo& item);
-    bool hasGoodAffixes(const ItemInfo& item);
-    bool isRareBase(const ItemInfo& item);
-    bool isSeasonalReward(const ItemInfo& item);
+    void updateStatistics(const ItemInfo& item, bool looted);   // Once per entity id, on its first decision
 };
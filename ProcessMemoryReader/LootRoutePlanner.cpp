@@ -0,0 +1,296 @@
+#include "LootRoutePlanner.h"
+#include <algorithm>
+#include <limits>
+
+void LootRoutePlanner::markCollected(uint64_t id) {
+    m_route.erase(std::remove_if(m_route.begin(), m_route.end(), [id](const Stop& stop) { return stop.id == id; }),
+                  m_route.end());
+}
+
+void LootRoutePlanner::mergeItems(float startX, float startY, const std::vector<Stop>& items) {
+    m_nodes.clear();
+    m_weights.clear();
+    m_nodeById.clear();
+    m_order.clear();
+    m_pending.clear();
+
+    m_nodes.push_back({0, startX, startY, 0});
+    m_weights.push_back(0.0f);
+
+    // Too many items: plan the most important ones now, the rest on a later pass
+    const std::vector<Stop>* source = &items;
+    if (items.size() > m_maxStops) {
+        m_selected.assign(items.begin(), items.end());
+        std::nth_element(m_selected.begin(), m_selected.begin() + m_maxStops, m_selected.end(),
+                         [](const Stop& a, const Stop& b) { return a.priority > b.priority; });
+        m_selected.resize(m_maxStops);
+        source = &m_selected;
+    }
+
+    for (const Stop& stop : *source) {
+        uint32_t node = static_cast<uint32_t>(m_nodes.size());
+        if (!m_nodeById.emplace(stop.id, node).second) {
+            continue;
+        }
+        m_nodes.push_back(stop);
+        m_weights.push_back(1.0f + static_cast<float>(std::max(stop.priority, 0)) / PRIORITY_SCALE);
+    }
+
+    // Stops of the previous route that are still on the ground keep their order
+    m_placed.assign(m_nodes.size(), 0);
+    for (const Stop& stop : m_route) {
+        auto it = m_nodeById.find(stop.id);
+        if (it != m_nodeById.end() && !m_placed[it->second]) {
+            m_order.push_back(it->second);
+            m_placed[it->second] = 1;
+        }
+    }
+    for (uint32_t node = 1; node < m_nodes.size(); ++node) {
+        if (!m_placed[node]) {
+            m_pending.push_back(node);
+        }
+    }
+}
+
+void LootRoutePlanner::optimize() {
+    ++m_stats.plans;
+    auto deadline = std::chrono::steady_clock::now() + m_budget;
+
+    if (m_order.empty()) {
+        if (!m_pending.empty()) {
+            ++m_stats.rebuilds;
+        }
+        buildNearestNeighbour();
+    } else {
+        insertPending();
+    }
+
+    // 2-opt to a local optimum, then move single stops until neither helps
+    bool timedOut = false;
+    do {
+        timedOut = !improveTwoOpt(deadline);
+    } while (!timedOut && relocateOnce(deadline, timedOut));
+    if (timedOut) {
+        ++m_stats.budgetExhausted;
+    }
+
+    m_route.clear();
+    float length = 0;
+    uint32_t previous = 0;
+    for (uint32_t node : m_order) {
+        m_route.push_back(m_nodes[node]);
+        length += distance(previous, node);
+        previous = node;
+    }
+    m_stats.lastLength = length;
+    m_stats.lastCost = routeCost(m_order);
+}
+
+void LootRoutePlanner::buildNearestNeighbour() {
+    // Closest stop next, with distances shrunk for heavier stops
+    uint32_t current = 0;
+    while (!m_pending.empty()) {
+        size_t best = 0;
+        float bestScore = std::numeric_limits<float>::infinity();
+        for (size_t k = 0; k < m_pending.size(); ++k) {
+            uint32_t node = m_pending[k];
+            float score = distance(current, node) / (1.0f + m_priorityWeight * (m_weights[node] - 1.0f));
+            if (score < bestScore) {
+                bestScore = score;
+                best = k;
+            }
+        }
+
+        current = m_pending[best];
+        m_order.push_back(current);
+        m_pending[best] = m_pending.back();
+        m_pending.pop_back();
+    }
+}
+
+void LootRoutePlanner::insertPending() {
+    // Heaviest first, so they get the pick of the positions
+    std::sort(m_pending.begin(), m_pending.end(), [this](uint32_t a, uint32_t b) {
+        return m_weights[a] > m_weights[b];
+    });
+
+    for (uint32_t node : m_pending) {
+        size_t bestPosition = m_order.size();
+        float bestCost = std::numeric_limits<float>::infinity();
+        for (size_t position = 0; position <= m_order.size(); ++position) {
+            m_candidate.assign(m_order.begin(), m_order.end());
+            m_candidate.insert(m_candidate.begin() + position, node);
+            float cost = routeCost(m_candidate);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestPosition = position;
+            }
+        }
+        m_order.insert(m_order.begin() + bestPosition, node);
+        ++m_stats.insertions;
+    }
+    m_pending.clear();
+}
+
+void LootRoutePlanner::prepareSums() {
+    // Leg into position p costs distance * factor(W - P[p]), P[p] being the weight picked up
+    // before p. The factor is linear in P, which is what makes every move O(1) to evaluate.
+    size_t count = m_order.size();
+    m_prefixWeight.resize(count + 1);
+    m_legCost.resize(count + 1);
+    m_legLength.resize(count + 1);
+    m_linkSum.resize(count);
+    m_linkWeightSum.resize(count);
+
+    m_prefixWeight[0] = 0;
+    for (size_t p = 0; p < count; ++p) {
+        m_prefixWeight[p + 1] = m_prefixWeight[p] + m_weights[m_order[p]];
+    }
+    m_totalWeight = m_prefixWeight[count];
+    m_scale = m_totalWeight > 0 ? m_priorityWeight / m_totalWeight : 0;
+
+    m_legCost[0] = 0;
+    m_legLength[0] = 0;
+    for (size_t p = 0; p < count; ++p) {
+        double length = distance(p == 0 ? 0 : m_order[p - 1], m_order[p]);
+        m_legLength[p + 1] = m_legLength[p] + length;
+        m_legCost[p + 1] = m_legCost[p] + length * factor(m_totalWeight - m_prefixWeight[p]);
+    }
+
+    // Links order[k] - order[k+1], for legs that get walked in reverse
+    m_linkSum[0] = 0;
+    m_linkWeightSum[0] = 0;
+    for (size_t k = 0; k + 1 < count; ++k) {
+        double link = distance(m_order[k], m_order[k + 1]);
+        m_linkSum[k + 1] = m_linkSum[k] + link;
+        m_linkWeightSum[k + 1] = m_linkWeightSum[k] + link * m_prefixWeight[k + 1];
+    }
+}
+
+bool LootRoutePlanner::improveTwoOpt(std::chrono::steady_clock::time_point deadline) {
+    // The start is fixed at the player, so every segment (including the first stop) may be
+    // reversed. Reversing i..j replaces the legs into i..j+1; a reversed link
+    // order[k+1] -> order[k] sees W - P[i] - P[j+1] + P[k+1] still on the ground.
+    size_t count = m_order.size();
+    if (count < 2) {
+        return true;
+    }
+
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        prepareSums();
+        double total = m_totalWeight;
+
+        for (size_t i = 0; i + 1 < count && !improved; ++i) {
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+
+            uint32_t entry = i == 0 ? 0 : m_order[i - 1];
+            double entryFactor = factor(total - m_prefixWeight[i]);
+            for (size_t j = i + 1; j < count; ++j) {
+                double before = m_legCost[j + 1] - m_legCost[i];
+                double after = distance(entry, m_order[j]) * entryFactor +
+                               (m_linkSum[j] - m_linkSum[i]) * factor(total - m_prefixWeight[i] - m_prefixWeight[j + 1]) +
+                               m_scale * (m_linkWeightSum[j] - m_linkWeightSum[i]);
+                if (j + 1 < count) {
+                    double exitFactor = factor(total - m_prefixWeight[j + 1]);
+                    before += leg(j + 1);
+                    after += distance(m_order[i], m_order[j + 1]) * exitFactor;
+                }
+
+                if (after < before - 1e-4) {
+                    std::reverse(m_order.begin() + i, m_order.begin() + j + 1);
+                    ++m_stats.improvements;
+                    improved = true;
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool LootRoutePlanner::relocateOnce(std::chrono::steady_clock::time_point deadline, bool& timedOut) {
+    // Move one stop v from position f to t. The legs next to both ends change, and every leg
+    // in between gains (moving v later) or loses (moving v earlier) v's weight on the ground.
+    size_t count = m_order.size();
+    if (count < 3) {
+        return false;
+    }
+
+    prepareSums();
+    double total = m_totalWeight;
+    for (size_t f = 0; f < count; ++f) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            timedOut = true;
+            return false;
+        }
+
+        uint32_t v = m_order[f];
+        double weight = m_weights[v];
+        uint32_t before = f == 0 ? 0 : m_order[f - 1];
+        bool hasAfter = f + 1 < count;
+
+        // Cost change of taking v out, before the legs in between are adjusted
+        double removed = -leg(f);
+        if (hasAfter) {
+            removed += distance(before, m_order[f + 1]) * factor(total - m_prefixWeight[f]) - leg(f + 1);
+        }
+
+        for (size_t t = 0; t < count; ++t) {
+            if (t == f) {
+                continue;
+            }
+
+            double delta;
+            if (t > f) {
+                // ..., o[f-1], o[f+1], ..., o[t], v, o[t+1], ...
+                delta = removed + m_scale * weight * (m_legLength[t + 1] - m_legLength[std::min(f + 2, t + 1)]) +
+                        distance(m_order[t], v) * factor(total - m_prefixWeight[t + 1] + weight);
+                if (t + 1 < count) {
+                    delta += distance(v, m_order[t + 1]) * factor(total - m_prefixWeight[t + 1]) - leg(t + 1);
+                }
+            } else {
+                // ..., o[t-1], v, o[t], ..., o[f-1], o[f+1], ...
+                uint32_t entry = t == 0 ? 0 : m_order[t - 1];
+                delta = distance(entry, v) * factor(total - m_prefixWeight[t]) +
+                        distance(v, m_order[t]) * factor(total - m_prefixWeight[t] - weight) - leg(t) -
+                        m_scale * weight * (m_legLength[f] - m_legLength[t + 1]) - leg(f);
+                if (hasAfter) {
+                    delta += distance(m_order[f - 1], m_order[f + 1]) * factor(total - m_prefixWeight[f + 1]) -
+                             leg(f + 1);
+                }
+            }
+
+            if (delta < -1e-4) {
+                m_order.erase(m_order.begin() + f);
+                m_order.insert(m_order.begin() + t, v);
+                ++m_stats.improvements;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+float LootRoutePlanner::routeCost(const std::vector<uint32_t>& order) const {
+    float total = 0;
+    for (uint32_t node : order) {
+        total += m_weights[node];
+    }
+    if (total <= 0) {
+        return 0;
+    }
+
+    float cost = 0;
+    float remaining = total;
+    uint32_t previous = 0;
+    for (uint32_t node : order) {
+        cost += distance(previous, node) * (1.0f + m_priorityWeight * remaining / total);
+        remaining -= m_weights[node];
+        previous = node;
+    }
+    return cost;
+}
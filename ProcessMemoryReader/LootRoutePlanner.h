@@ -0,0 +1,134 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class LootRoutePlanner
+ * @brief Short, priority-weighted pickup order for the items on the ground
+ *
+ * A route is an open path from the player through every stop. Its cost is
+ * the sum of leg lengths, each scaled by 1 + priorityWeight * (share of the
+ * total item weight still on the ground), so long detours are expensive and
+ * high-priority items drift towards the front. Leg lengths are straight-line
+ * distances, multiplied by a detour factor when the line is not walkable.
+ *
+ * Planning is incremental: stops of the previous route that are still
+ * present keep their order, newly dropped items are inserted at their
+ * cheapest position, and only a fresh route is built by priority-weighted
+ * nearest neighbour. 2-opt and single-stop relocation then improve the route
+ * until no move helps or the time budget runs out.
+ */
+class LootRoutePlanner {
+public:
+    struct Stop {
+        uint64_t id = 0;
+        float x = 0, y = 0;
+        int priority = 0;
+    };
+
+    struct Statistics {
+        uint64_t plans = 0;
+        uint64_t rebuilds = 0;          // Routes built from scratch
+        uint64_t insertions = 0;        // New stops inserted into an existing route
+        uint64_t improvements = 0;      // Accepted 2-opt and relocation moves
+        uint64_t budgetExhausted = 0;   // Plans whose improvement was cut short
+        float lastLength = 0;           // World units, detours included
+        float lastCost = 0;
+    };
+
+private:
+    static constexpr float PRIORITY_SCALE = 50.0f;   // Priority that doubles a stop's weight
+
+    std::vector<Stop> m_route;
+
+    // Per plan: node 0 is the player, nodes 1..n the stops
+    std::vector<Stop> m_nodes;
+    std::vector<float> m_weights;
+    std::vector<float> m_distances;                  // Node x node
+    std::vector<uint32_t> m_order;                   // Route as node indices
+    std::vector<uint32_t> m_pending;                 // Nodes not in the previous route
+    std::vector<uint32_t> m_candidate;               // Scratch for move evaluation
+    std::vector<uint8_t> m_placed;
+
+    // Prefix sums over m_order for O(1) move evaluation (see prepareSums)
+    std::vector<double> m_prefixWeight;
+    std::vector<double> m_legCost;
+    std::vector<double> m_legLength;
+    std::vector<double> m_linkSum;
+    std::vector<double> m_linkWeightSum;
+    double m_totalWeight = 0;
+    double m_scale = 0;
+    std::vector<Stop> m_selected;                    // Items kept when over m_maxStops
+    std::unordered_map<uint64_t, uint32_t> m_nodeById;
+
+    float m_priorityWeight = 1.0f;
+    float m_detourFactor = 1.6f;
+    size_t m_maxStops = 32;
+    std::chrono::microseconds m_budget{500};
+    Statistics m_stats;
+
+public:
+    /**
+     * @brief Plan the pickup order for items, starting at (startX, startY)
+     * @param isLineClear Called as isLineClear(ax, ay, bx, by) for each pair of points
+     * @return The route, first stop first (valid until the next call)
+     * @note Above getMaxStops() items only the highest priorities are planned
+     */
+    template<typename LineClear>
+    const std::vector<Stop>& plan(float startX, float startY, const std::vector<Stop>& items, LineClear&& isLineClear) {
+        mergeItems(startX, startY, items);
+
+        size_t count = m_nodes.size();
+        m_distances.assign(count * count, 0.0f);
+        for (size_t a = 0; a < count; ++a) {
+            for (size_t b = a + 1; b < count; ++b) {
+                float dx = m_nodes[b].x - m_nodes[a].x;
+                float dy = m_nodes[b].y - m_nodes[a].y;
+                float distance = std::sqrt(dx * dx + dy * dy);
+                if (!isLineClear(m_nodes[a].x, m_nodes[a].y, m_nodes[b].x, m_nodes[b].y)) {
+                    distance *= m_detourFactor;
+                }
+                m_distances[a * count + b] = distance;
+                m_distances[b * count + a] = distance;
+            }
+        }
+
+        optimize();
+        return m_route;
+    }
+
+    const std::vector<Stop>& getRoute() const { return m_route; }
+
+    /**
+     * @brief Drop a stop once its item was picked up
+     */
+    void markCollected(uint64_t id);
+    void clear() { m_route.clear(); }
+
+    // Configuration
+    void setPriorityWeight(float weight) { m_priorityWeight = weight < 0 ? 0 : weight; }
+    void setDetourFactor(float factor) { m_detourFactor = factor < 1 ? 1 : factor; }
+    void setMaxStops(size_t stops) { m_maxStops = stops == 0 ? 1 : stops; }
+    void setTimeBudget(std::chrono::microseconds budget) { m_budget = budget; }
+    size_t getMaxStops() const { return m_maxStops; }
+
+    const Statistics& getStatistics() const { return m_stats; }
+
+private:
+    void mergeItems(float startX, float startY, const std::vector<Stop>& items);
+    void optimize();
+    void buildNearestNeighbour();
+    void insertPending();
+    void prepareSums();
+    bool improveTwoOpt(std::chrono::steady_clock::time_point deadline);
+    bool relocateOnce(std::chrono::steady_clock::time_point deadline, bool& timedOut);
+    double factor(double remaining) const { return 1.0 + m_scale * remaining; }
+    double leg(size_t position) const { return m_legCost[position + 1] - m_legCost[position]; }
+    float routeCost(const std::vector<uint32_t>& order) const;
+    float distance(uint32_t a, uint32_t b) const { return m_distances[a * m_nodes.size() + b]; }
+};
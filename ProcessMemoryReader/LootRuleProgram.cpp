@@ -0,0 +1,254 @@
+#include "LootRuleProgram.h"
+#include <algorithm>
+
+namespace {
+    using Condition = LootFilter::Condition;
+
+    const std::string REASON_BLACKLISTED = "Blacklisted";
+    const std::string REASON_NO_RULE = "No matching rule";
+
+    bool anyCommonBit(const uint64_t* a, const std::vector<uint64_t>& b) {
+        for (size_t i = 0; i < b.size(); ++i) {
+            if (a[i] & b[i]) return true;
+        }
+        return false;
+    }
+
+    bool testBit(const uint64_t* words, uint32_t bit) {
+        return (words[bit >> 6] >> (bit & 63) & 1) != 0;
+    }
+}
+
+void LootRuleProgram::compile(const std::vector<FilterRule>& rules,
+                              const std::vector<std::string>& blacklist,
+                              const std::vector<std::pair<std::string, int>>& namePriorities) {
+    m_code.clear();
+    m_rules.clear();
+    m_bonuses.clear();
+
+    // REJECT rules first, then LOOT rules from the highest priority down
+    std::vector<const FilterRule*> ordered;
+    for (const FilterRule& rule : rules) {
+        if (rule.enabled && !rule.conditions.empty()) {
+            ordered.push_back(&rule);
+        }
+    }
+    std::stable_sort(ordered.begin(), ordered.end(), [](const FilterRule* a, const FilterRule* b) {
+        bool rejectA = a->action == LootFilter::RuleAction::REJECT;
+        bool rejectB = b->action == LootFilter::RuleAction::REJECT;
+        if (rejectA != rejectB) return rejectA;
+        return a->priority > b->priority;
+    });
+
+    // Texts are collected first; operands hold the input index until the matchers are built
+    std::vector<std::string> namePatterns;
+    std::vector<std::string> affixPatterns;
+
+    for (const FilterRule* rule : ordered) {
+        CompiledRule compiled;
+        compiled.begin = static_cast<uint32_t>(m_code.size());
+        compiled.reject = rule->action == LootFilter::RuleAction::REJECT;
+        compiled.priority = rule->priority;
+        compiled.reason = rule->name;
+
+        for (const Condition& condition : rule->conditions) {
+            Instruction instruction{Opcode::ONE_OF, SLOT_RARITY, 0, condition.value};
+            bool valid = true;
+
+            switch (condition.field) {
+                case Condition::Field::RARITY: instruction.slot = SLOT_RARITY; break;
+                case Condition::Field::TYPE: instruction.slot = SLOT_TYPE; break;
+                case Condition::Field::LEVEL: instruction.slot = SLOT_LEVEL; break;
+                case Condition::Field::VALUE: instruction.slot = SLOT_VALUE; break;
+                case Condition::Field::IDENTIFIED: instruction.slot = SLOT_IDENTIFIED; break;
+                default: break;
+            }
+
+            bool textField = condition.field == Condition::Field::NAME || condition.field == Condition::Field::AFFIX;
+            switch (condition.op) {
+                case Condition::Op::AT_LEAST: instruction.opcode = Opcode::AT_LEAST; valid = !textField; break;
+                case Condition::Op::AT_MOST: instruction.opcode = Opcode::AT_MOST; valid = !textField; break;
+                case Condition::Op::EQUAL: instruction.opcode = Opcode::EQUAL; valid = !textField; break;
+                case Condition::Op::NOT_EQUAL: instruction.opcode = Opcode::NOT_EQUAL; valid = !textField; break;
+                case Condition::Op::ONE_OF:
+                    instruction.opcode = Opcode::ONE_OF;
+                    instruction.operand = condition.mask;
+                    valid = !textField;
+                    break;
+                case Condition::Op::CONTAINS:
+                    if (condition.field == Condition::Field::NAME) {
+                        instruction.opcode = Opcode::NAME_CONTAINS;
+                        instruction.operand = static_cast<uint32_t>(namePatterns.size());
+                        namePatterns.push_back(condition.text);
+                    } else if (condition.field == Condition::Field::AFFIX) {
+                        instruction.opcode = Opcode::AFFIX_CONTAINS;
+                        instruction.operand = static_cast<uint32_t>(affixPatterns.size());
+                        affixPatterns.push_back(condition.text);
+                    } else {
+                        valid = false;
+                    }
+                    break;
+                case Condition::Op::IS:
+                    if (condition.field == Condition::Field::NAME) {
+                        instruction.opcode = Opcode::NAME_IS;
+                        instruction.operand = static_cast<uint32_t>(namePatterns.size());
+                        namePatterns.push_back(condition.text);
+                    } else {
+                        valid = false;
+                    }
+                    break;
+            }
+
+            if (!valid) {
+                // A condition that makes no sense can never hold
+                instruction = Instruction{Opcode::ONE_OF, SLOT_RARITY, 0, 0};
+            }
+            m_code.push_back(instruction);
+        }
+
+        compiled.end = static_cast<uint32_t>(m_code.size());
+        m_rules.push_back(std::move(compiled));
+    }
+
+    size_t blacklistBegin = namePatterns.size();
+    namePatterns.insert(namePatterns.end(), blacklist.begin(), blacklist.end());
+    size_t bonusBegin = namePatterns.size();
+    for (const auto& [name, priority] : namePriorities) {
+        namePatterns.push_back(name);
+    }
+
+    m_names.build(namePatterns);
+    m_affixes.build(affixPatterns);
+
+    for (Instruction& instruction : m_code) {
+        if (instruction.opcode == Opcode::NAME_CONTAINS || instruction.opcode == Opcode::NAME_IS) {
+            instruction.operand = m_names.getPatternId(instruction.operand);
+        } else if (instruction.opcode == Opcode::AFFIX_CONTAINS) {
+            instruction.operand = m_affixes.getPatternId(instruction.operand);
+        }
+    }
+
+    m_blacklistMask.assign((m_names.getPatternCount() + 63) / 64, 0);
+    for (size_t i = blacklistBegin; i < bonusBegin; ++i) {
+        uint32_t id = m_names.getPatternId(i);
+        m_blacklistMask[id >> 6] |= uint64_t{1} << (id & 63);
+    }
+    for (size_t i = 0; i < namePriorities.size(); ++i) {
+        m_bonuses.push_back({m_names.getPatternId(bonusBegin + i), namePriorities[i].second});
+    }
+
+    // Pattern ids changed, so every cached symbol result is stale
+    m_nameBits.words = (m_names.getPatternCount() + 63) / 64;
+    m_nameBits.bits.clear();
+    m_nameBits.known.clear();
+    m_affixBits.words = (m_affixes.getPatternCount() + 63) / 64;
+    m_affixBits.bits.clear();
+    m_affixBits.known.clear();
+    m_itemAffixes.assign(m_affixBits.words, 0);
+}
+
+void LootRuleProgram::evaluate(ItemInfo* items, size_t count) {
+    bool usesAffixes = !m_affixes.empty();
+
+    for (size_t i = 0; i < count; ++i) {
+        ItemInfo& item = items[i];
+
+        int32_t slots[SLOT_COUNT];
+        slots[SLOT_RARITY] = static_cast<int32_t>(item.rarity);
+        slots[SLOT_TYPE] = static_cast<int32_t>(item.type);
+        slots[SLOT_LEVEL] = item.level;
+        slots[SLOT_VALUE] = item.value;
+        slots[SLOT_IDENTIFIED] = item.isIdentified ? 1 : 0;
+
+        const uint64_t* name = lookup(m_names, m_nameBits, item.name);
+        if (usesAffixes) {
+            std::fill(m_itemAffixes.begin(), m_itemAffixes.end(), 0);
+            for (SymbolId affix : item.affixes) {
+                const uint64_t* affixBits = lookup(m_affixes, m_affixBits, affix);
+                for (size_t w = 0; w < m_itemAffixes.size(); ++w) {
+                    m_itemAffixes[w] |= affixBits[w];
+                }
+            }
+        }
+        ItemBits bits{name, name + m_nameBits.words, m_itemAffixes.data()};
+
+        item.shouldLoot = false;
+        item.priority = 0;
+
+        if (anyCommonBit(bits.nameExact, m_blacklistMask)) {
+            item.filterReason = REASON_BLACKLISTED;
+            continue;
+        }
+
+        const CompiledRule* decided = nullptr;
+        for (const CompiledRule& rule : m_rules) {
+            if (runRule(rule, slots, bits)) {
+                decided = &rule;
+                break;
+            }
+        }
+
+        if (!decided) {
+            item.filterReason = REASON_NO_RULE;
+            continue;
+        }
+
+        item.filterReason = decided->reason;
+        if (decided->reject) {
+            continue;
+        }
+
+        int bonus = 0;
+        for (const NameBonus& entry : m_bonuses) {
+            if (testBit(bits.nameExact, entry.pattern)) {
+                bonus += entry.priority;
+            }
+        }
+        item.shouldLoot = true;
+        item.priority = decided->priority + bonus;
+    }
+}
+
+const uint64_t* LootRuleProgram::lookup(const NameMatcher& matcher, SymbolMatches& cache, SymbolId symbol) {
+    size_t stride = cache.words * 2;
+    if (symbol >= cache.known.size()) {
+        size_t symbols = std::max<size_t>(symbol + 1, SymbolTable::global().size());
+        cache.known.resize(symbols, 0);
+        cache.bits.resize(symbols * stride, 0);
+    }
+
+    uint64_t* bits = cache.bits.data() + symbol * stride;
+    if (!cache.known[symbol]) {
+        matcher.prepare(m_scratch);
+        matcher.match(SymbolTable::global().name(symbol), m_scratch);
+        std::copy(m_scratch.contains.begin(), m_scratch.contains.end(), bits);
+        std::copy(m_scratch.exact.begin(), m_scratch.exact.end(), bits + cache.words);
+        cache.known[symbol] = 1;
+    }
+    return bits;
+}
+
+bool LootRuleProgram::runRule(const CompiledRule& rule, const int32_t* slots, const ItemBits& bits) const {
+    for (uint32_t pc = rule.begin; pc < rule.end; ++pc) {
+        const Instruction& instruction = m_code[pc];
+        int32_t field = slots[instruction.slot];
+
+        bool holds;
+        switch (instruction.opcode) {
+            case Opcode::AT_LEAST: holds = field >= instruction.value; break;
+            case Opcode::AT_MOST: holds = field <= instruction.value; break;
+            case Opcode::EQUAL: holds = field == instruction.value; break;
+            case Opcode::NOT_EQUAL: holds = field != instruction.value; break;
+            case Opcode::ONE_OF: holds = field >= 0 && field < 32 && ((instruction.operand >> field) & 1) != 0; break;
+            case Opcode::NAME_CONTAINS: holds = testBit(bits.nameContains, instruction.operand); break;
+            case Opcode::NAME_IS: holds = testBit(bits.nameExact, instruction.operand); break;
+            case Opcode::AFFIX_CONTAINS: holds = testBit(bits.affixContains, instruction.operand); break;
+            default: holds = false; break;
+        }
+
+        if (!holds) {
+            return false;
+        }
+    }
+    return true;
+}
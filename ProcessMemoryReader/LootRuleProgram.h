@@ -0,0 +1,119 @@
+#pragma once
+
+#include "LootFilter.h"
+#include "NameMatcher.h"
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @class LootRuleProgram
+ * @brief LootFilter rules compiled into a flat predicate program
+ *
+ * Every condition becomes one instruction over an integer slot (rarity, type,
+ * level, value, identified) or over a name/affix match bit. Distinct texts
+ * are interned into pattern ids and matched by one Aho-Corasick pass per
+ * distinct name or affix symbol; the result is kept per SymbolId until the
+ * next compile, so an item whose name was seen before costs no scan at all
+ * and the rule loop only compares integers and tests bits.
+ *
+ * Rules are ordered REJECT first, then LOOT by descending priority; the first
+ * LOOT rule that matches decides. Blacklisted names are a bit mask over the
+ * exact-match bits and name priorities are added to the matching rule's.
+ */
+class LootRuleProgram {
+public:
+    using ItemInfo = LootFilter::ItemInfo;
+    using FilterRule = LootFilter::FilterRule;
+
+    /**
+     * @brief Compile rules, blacklist and per-name priority bonuses
+     * @note Disabled rules and rules with no conditions are dropped
+     */
+    void compile(const std::vector<FilterRule>& rules,
+                 const std::vector<std::string>& blacklist,
+                 const std::vector<std::pair<std::string, int>>& namePriorities);
+
+    /**
+     * @brief Set shouldLoot, priority and filterReason on each item
+     */
+    void evaluate(ItemInfo* items, size_t count);
+
+    size_t getRuleCount() const { return m_rules.size(); }
+    size_t getInstructionCount() const { return m_code.size(); }
+    size_t getPatternCount() const { return m_names.getPatternCount() + m_affixes.getPatternCount(); }
+
+private:
+    enum Slot : uint8_t {
+        SLOT_RARITY,
+        SLOT_TYPE,
+        SLOT_LEVEL,
+        SLOT_VALUE,
+        SLOT_IDENTIFIED,
+        SLOT_COUNT
+    };
+
+    enum class Opcode : uint8_t {
+        AT_LEAST,
+        AT_MOST,
+        EQUAL,
+        NOT_EQUAL,
+        ONE_OF,
+        NAME_CONTAINS,
+        NAME_IS,
+        AFFIX_CONTAINS
+    };
+
+    struct Instruction {
+        Opcode opcode;
+        uint8_t slot;
+        uint32_t operand;          // ONE_OF mask or pattern id
+        int32_t value;
+    };
+
+    struct CompiledRule {
+        uint32_t begin, end;       // Instruction range
+        bool reject;
+        int priority;
+        std::string reason;
+    };
+
+    struct NameBonus {
+        uint32_t pattern;
+        int priority;
+    };
+
+    std::vector<Instruction> m_code;
+    std::vector<CompiledRule> m_rules;
+    std::vector<NameBonus> m_bonuses;
+    std::vector<uint64_t> m_blacklistMask;     // Over name pattern ids
+
+    /**
+     * @brief Match bits per symbol against one automaton, filled on first use
+     */
+    struct SymbolMatches {
+        size_t words = 0;                      // Words per bit set
+        std::vector<uint64_t> bits;            // Per symbol: contains words, then exact words
+        std::vector<uint8_t> known;
+    };
+
+    /**
+     * @brief Bit sets an item's rules are tested against
+     */
+    struct ItemBits {
+        const uint64_t* nameContains;
+        const uint64_t* nameExact;
+        const uint64_t* affixContains;
+    };
+
+    NameMatcher m_names;
+    NameMatcher m_affixes;
+    SymbolMatches m_nameBits;
+    SymbolMatches m_affixBits;
+    NameMatcher::Matches m_scratch;
+    std::vector<uint64_t> m_itemAffixes;       // OR of the current item's affix bits
+
+    const uint64_t* lookup(const NameMatcher& matcher, SymbolMatches& cache, SymbolId symbol);
+    bool runRule(const CompiledRule& rule, const int32_t* slots, const ItemBits& bits) const;
+};
@@ -0,0 +1,118 @@
+#include "MappedFile.h"
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::openRead(const std::string& path) {
+    close();
+
+    m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size) || size.QuadPart <= 0) {
+        close();
+        return false;
+    }
+
+    m_writable = false;
+    if (!map(static_cast<size_t>(size.QuadPart))) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::create(const std::string& path, size_t capacity) {
+    close();
+
+    m_file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                         FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    m_writable = true;
+    if (!map(capacity)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::grow(size_t capacity) {
+    if (!m_writable || !m_view) {
+        return false;
+    }
+    if (capacity <= m_capacity) {
+        return true;
+    }
+
+    // Mapping a writable file beyond its end extends the file
+    size_t previous = m_capacity;
+    unmap();
+    if (map(capacity)) {
+        return true;
+    }
+    map(previous);  // Keep the old view usable
+    return false;
+}
+
+void MappedFile::close(size_t size) {
+    unmap();
+
+    if (m_file != INVALID_HANDLE_VALUE) {
+        if (m_writable && size != SIZE_MAX) {
+            LARGE_INTEGER end;
+            end.QuadPart = static_cast<LONGLONG>(size);
+            if (SetFilePointerEx(m_file, end, nullptr, FILE_BEGIN)) {
+                SetEndOfFile(m_file);
+            }
+        }
+        CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_writable = false;
+}
+
+bool MappedFile::flush(size_t offset, size_t length) const {
+    if (!m_view || offset + length > m_capacity) {
+        return false;
+    }
+    return FlushViewOfFile(m_view + offset, length) != FALSE;
+}
+
+bool MappedFile::map(size_t capacity) {
+    uint64_t size = capacity;
+    m_mapping = CreateFileMappingA(m_file, nullptr, m_writable ? PAGE_READWRITE : PAGE_READONLY,
+                                   static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xFFFFFFFF), nullptr);
+    if (!m_mapping) {
+        return false;
+    }
+
+    m_view = static_cast<uint8_t*>(MapViewOfFile(m_mapping, m_writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, capacity));
+    if (!m_view) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        return false;
+    }
+
+    m_capacity = capacity;
+    return true;
+}
+
+void MappedFile::unmap() {
+    if (m_view) {
+        UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping) {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    m_capacity = 0;
+}
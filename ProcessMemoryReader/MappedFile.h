@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class MappedFile
+ * @brief A file mapped into the address space, read-only or growable for appending
+ *
+ * A writable file is mapped with spare capacity beyond what has been written;
+ * grow() remaps it larger (the view may move) and close() trims the file to
+ * the bytes actually used.
+ */
+class MappedFile {
+private:
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+    uint8_t* m_view = nullptr;
+    size_t m_capacity = 0;
+    bool m_writable = false;
+
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map an existing file read-only
+     */
+    bool openRead(const std::string& path);
+
+    /**
+     * @brief Create (or truncate) a file and map capacity bytes of it read-write
+     */
+    bool create(const std::string& path, size_t capacity);
+
+    /**
+     * @brief Remap a writable file with at least capacity bytes; pointers into the old view are invalid
+     */
+    bool grow(size_t capacity);
+
+    /**
+     * @brief Unmap and close; a writable file is trimmed to size bytes first
+     */
+    void close(size_t size = SIZE_MAX);
+
+    bool flush(size_t offset, size_t length) const;
+
+    bool isOpen() const { return m_view != nullptr; }
+    uint8_t* data() { return m_view; }
+    const uint8_t* data() const { return m_view; }
+    size_t capacity() const { return m_capacity; }
+
+private:
+    bool map(size_t capacity);
+    void unmap();
+};
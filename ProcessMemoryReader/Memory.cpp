@@ -2,6 +2,8 @@
 #include "Process.h"
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
+#include <cstring>
 
 Memory::Memory(const Process* process) : m_process(process) {
     if (!process) {
@@ -16,6 +18,14 @@ Memory::Memory(const Process* process) : m_process(process) {
 std::string Memory::readString(uintptr_t address, size_t maxLength) const {
     validateProcess();
     
+    // Never read past the end of the region, strings near a region end are still valid
+    size_t readable = getReadableSize(address);
+    if (readable == 0) {
+        throw std::runtime_error("Failed to read string from address: 0x" + 
+                                std::to_string(address));
+    }
+    maxLength = std::min(maxLength, readable);
+    
     std::vector<char> buffer(maxLength + 1, 0);
     if (!readMemory(address, buffer.data(), maxLength)) {
         throw std::runtime_error("Failed to read string from address: 0x" + 
@@ -31,6 +41,14 @@ std::string Memory::readString(uintptr_t address, size_t maxLength) const {
 bool Memory::readMemory(uintptr_t address, void* buffer, size_t size) const {
     validateProcess();
     
+    if (m_pageCacheEnabled && readCached(address, buffer, size)) {
+        return true;
+    }
+    
+    return readRemote(address, buffer, size);
+}
+
+bool Memory::readRemote(uintptr_t address, void* buffer, size_t size) const {
     SIZE_T bytesRead = 0;
     BOOL result = ReadProcessMemory(
         m_process->getHandle(),
@@ -40,31 +58,99 @@ bool Memory::readMemory(uintptr_t address, void* buffer, size_t size) const {
         &bytesRead
     );
     
-    return result && (bytesRead == size);
+    bool success = result && (bytesRead == size);
+    m_readStats.calls++;
+    m_readStats.bytes += size;
+    if (!success) {
+        m_readStats.failures++;
+    }
+    return success;
 }
 
 bool Memory::isValidAddress(uintptr_t address, size_t size) const {
     validateProcess();
     
-    MEMORY_BASIC_INFORMATION mbi;
-    if (VirtualQueryEx(m_process->getHandle(), 
-                       reinterpret_cast<LPCVOID>(address), 
-                       &mbi, sizeof(mbi)) != sizeof(mbi)) {
+    const MemoryRegion* region = findRegion(address);
+    if (!region) {
         return false;
     }
     
-    // Check if the memory region is committed and readable
-    if (mbi.State != MEM_COMMIT) {
-        return false;
+    // Check if the entire requested range is within the same readable region
+    return size <= region->end - address;
+}
+
+size_t Memory::getReadableSize(uintptr_t address) const {
+    validateProcess();
+    
+    const MemoryRegion* region = findRegion(address);
+    return region ? static_cast<size_t>(region->end - address) : 0;
+}
+
+void Memory::refreshRegionMap() {
+    validateProcess();
+    rebuildRegionMap();
+}
+
+void Memory::rebuildRegionMap() const {
+    m_regions.clear();
+    
+    MEMORY_BASIC_INFORMATION mbi;
+    uintptr_t address = 0;
+    
+    while (VirtualQueryEx(m_process->getHandle(), 
+                          reinterpret_cast<LPCVOID>(address), 
+                          &mbi, sizeof(mbi)) == sizeof(mbi)) {
+        uintptr_t regionStart = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+        uintptr_t regionEnd = regionStart + mbi.RegionSize;
+        
+        // Committed, readable and not a guard page
+        bool readable = mbi.State == MEM_COMMIT &&
+                        (mbi.Protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE)) &&
+                        !(mbi.Protect & PAGE_GUARD);
+        
+        if (readable) {
+            // Merge with the previous region when they are contiguous
+            if (!m_regions.empty() && m_regions.back().end == regionStart) {
+                m_regions.back().end = regionEnd;
+            } else {
+                m_regions.push_back({regionStart, regionEnd});
+            }
+        }
+        
+        if (regionEnd <= address) {
+            break; // Wrapped around the end of the address space
+        }
+        address = regionEnd;
     }
     
-    if (!(mbi.Protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE))) {
-        return false;
+    m_regionMapBuilt = true;
+    m_regionsRefreshedAt = std::chrono::steady_clock::now();
+}
+
+const Memory::MemoryRegion* Memory::findRegion(uintptr_t address, bool allowRefresh) const {
+    auto now = std::chrono::steady_clock::now();
+    if (!m_regionMapBuilt || now - m_regionsRefreshedAt > m_regionRefreshInterval) {
+        rebuildRegionMap();
+        allowRefresh = false;
+    }
+    
+    // Last region starting at or before the address
+    auto it = std::upper_bound(m_regions.begin(), m_regions.end(), address,
+                               [](uintptr_t value, const MemoryRegion& region) { return value < region.start; });
+    if (it != m_regions.begin()) {
+        --it;
+        if (address < it->end) {
+            return &*it;
+        }
+    }
+    
+    // The target may have allocated new memory since the last walk
+    if (allowRefresh && now - m_regionsRefreshedAt > m_regionMissRefreshDelay) {
+        rebuildRegionMap();
+        return findRegion(address, false);
     }
     
-    // Check if the entire requested range is within the same memory region
-    uintptr_t regionEnd = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
-    return (address + size) <= regionEnd;
+    return nullptr;
 }
 
 void Memory::validateProcess() const {
@@ -72,3 +158,220 @@ void Memory::validateProcess() const {
         throw std::runtime_error("Process is not attached or invalid");
     }
 }
+
+// ============ PAGE CACHE ============
+
+void Memory::enablePageCache(bool enable) {
+    m_pageCacheEnabled = enable;
+    if (!enable) {
+        m_pageCache.clear();
+    }
+}
+
+void Memory::addStableRegion(uintptr_t address, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    
+    m_stableRegions.emplace_back(address, address + size);
+    
+    // Pages already cached inside the region become stable from now on
+    for (auto& [pageBase, page] : m_pageCache) {
+        if (isInStableRegion(pageBase)) {
+            page.stable = true;
+        }
+    }
+}
+
+void Memory::clearStableRegions() {
+    m_stableRegions.clear();
+    for (auto& [pageBase, page] : m_pageCache) {
+        page.stable = false;
+    }
+}
+
+void Memory::invalidatePageCache() {
+    m_pageCache.clear();
+}
+
+Memory::PageCacheStats Memory::getPageCacheStats() const {
+    PageCacheStats stats = m_pageCacheStats;
+    stats.cachedPages = m_pageCache.size();
+    return stats;
+}
+
+void Memory::resetPageCacheStats() {
+    m_pageCacheStats = PageCacheStats{};
+}
+
+bool Memory::readCached(uintptr_t address, void* buffer, size_t size) const {
+    // Large reads (e.g. batched spans, module scans) gain nothing from the cache
+    if (size == 0 || size > PAGE_SIZE * 2) {
+        m_pageCacheStats.bypassed++;
+        return false;
+    }
+    
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    uintptr_t current = address;
+    uintptr_t end = address + size;
+    
+    while (current < end) {
+        uintptr_t pageBase = current & ~(static_cast<uintptr_t>(PAGE_SIZE) - 1);
+        const uint8_t* page = getCachedPage(pageBase);
+        if (!page) {
+            m_pageCacheStats.bypassed++;
+            return false;
+        }
+        
+        size_t pageOffset = current - pageBase;
+        size_t chunk = std::min<size_t>(PAGE_SIZE - pageOffset, end - current);
+        std::memcpy(out, page + pageOffset, chunk);
+        
+        out += chunk;
+        current += chunk;
+    }
+    
+    return true;
+}
+
+const uint8_t* Memory::getCachedPage(uintptr_t pageBase) const {
+    auto it = m_pageCache.find(pageBase);
+    if (it != m_pageCache.end() && 
+        (it->second.generation == m_generation || it->second.stable)) {
+        m_pageCacheStats.hits++;
+        return it->second.data.data();
+    }
+    
+    if (it == m_pageCache.end()) {
+        if (m_pageCache.size() >= m_maxCachedPages) {
+            // Evict everything that is already stale before giving up
+            for (auto stale = m_pageCache.begin(); stale != m_pageCache.end();) {
+                if (stale->second.generation != m_generation && !stale->second.stable) {
+                    stale = m_pageCache.erase(stale);
+                } else {
+                    ++stale;
+                }
+            }
+            
+            if (m_pageCache.size() >= m_maxCachedPages) {
+                return nullptr;
+            }
+        }
+        
+        it = m_pageCache.emplace(pageBase, CachedPage{}).first;
+        it->second.data.resize(PAGE_SIZE);
+        it->second.stable = isInStableRegion(pageBase);
+    }
+    
+    m_pageCacheStats.misses++;
+    if (!readRemote(pageBase, it->second.data.data(), PAGE_SIZE)) {
+        m_pageCache.erase(it);
+        return nullptr;
+    }
+    
+    it->second.generation = m_generation;
+    return it->second.data.data();
+}
+
+bool Memory::isInStableRegion(uintptr_t pageBase) const {
+    // A page is only stable if it lies entirely inside a stable region;
+    // partially covered pages also hold data that may change every tick
+    uintptr_t pageEnd = pageBase + PAGE_SIZE;
+    
+    for (const auto& [start, end] : m_stableRegions) {
+        if (start <= pageBase && pageEnd <= end) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+// ============ READ BATCH ============
+
+Memory::ReadBatch::ReadBatch(const Memory* memory, size_t maxGap)
+    : m_memory(memory), m_maxGap(maxGap) {
+    if (!memory) {
+        throw std::invalid_argument("Memory pointer cannot be null");
+    }
+}
+
+void Memory::ReadBatch::add(uintptr_t address, void* destination, size_t size) {
+    if (!destination || size == 0) {
+        return;
+    }
+    
+    if (!m_requests.empty() && address < m_requests.back().address) {
+        m_sorted = false;
+    }
+    
+    m_requests.push_back({address, destination, size});
+}
+
+bool Memory::ReadBatch::execute() {
+    m_spanCount = 0;
+    m_failedCount = 0;
+    
+    if (m_requests.empty()) {
+        return true;
+    }
+    
+    if (!m_sorted) {
+        std::sort(m_requests.begin(), m_requests.end(),
+                  [](const Request& a, const Request& b) { return a.address < b.address; });
+        m_sorted = true;
+    }
+    
+    size_t first = 0;
+    while (first < m_requests.size()) {
+        uintptr_t spanStart = m_requests[first].address;
+        uintptr_t spanEnd = spanStart + m_requests[first].size;
+        
+        // Extend the span while the next request overlaps or sits within the allowed gap
+        size_t last = first + 1;
+        while (last < m_requests.size()) {
+            const Request& next = m_requests[last];
+            uintptr_t nextEnd = std::max(spanEnd, next.address + next.size);
+            
+            if (next.address > spanEnd + m_maxGap || nextEnd - spanStart > m_maxSpanSize) {
+                break;
+            }
+            
+            spanEnd = nextEnd;
+            ++last;
+        }
+        
+        size_t spanSize = spanEnd - spanStart;
+        m_spanBuffer.resize(spanSize);
+        m_spanCount++;
+        
+        if (m_memory->readMemory(spanStart, m_spanBuffer.data(), spanSize)) {
+            // Scatter the span back into the individual destinations
+            for (size_t i = first; i < last; ++i) {
+                const Request& request = m_requests[i];
+                std::memcpy(request.destination, 
+                            m_spanBuffer.data() + (request.address - spanStart), 
+                            request.size);
+            }
+        } else {
+            // The merged range may include unreadable bytes; fall back to individual reads
+            for (size_t i = first; i < last; ++i) {
+                const Request& request = m_requests[i];
+                if (!m_memory->readMemory(request.address, request.destination, request.size)) {
+                    m_failedCount++;
+                }
+            }
+        }
+        
+        first = last;
+    }
+    
+    return m_failedCount == 0;
+}
+
+void Memory::ReadBatch::clear() {
+    m_requests.clear();
+    m_sorted = true;
+    m_spanCount = 0;
+    m_failedCount = 0;
+}
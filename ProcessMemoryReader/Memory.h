@@ -3,7 +3,11 @@
 #include <Windows.h>
 #include <memory>
 #include <vector>
+#include <string>
+#include <unordered_map>
+#include <chrono>
 #include <stdexcept>
+#include <cstdint>
 
 // Forward declaration
 class Process;
@@ -17,9 +21,58 @@ class Process;
  * It includes bounds checking and error handling for robust operation.
  */
 class Memory {
+public:
+    static constexpr size_t PAGE_SIZE = 0x1000;  ///< Granularity of the page cache
+
+    /**
+     * @brief Counters exposed by the page cache for tuning
+     */
+    struct PageCacheStats {
+        uint64_t hits = 0;         ///< Page lookups served from the local copy
+        uint64_t misses = 0;       ///< Page lookups that fetched from the target process
+        uint64_t bypassed = 0;     ///< Reads that skipped the cache (too large / cache full / failed page)
+        size_t cachedPages = 0;    ///< Pages currently held
+    };
+
+    /**
+     * @brief Counters of the reads that actually reached the target process
+     */
+    struct ReadStats {
+        uint64_t calls = 0;        ///< ReadProcessMemory calls
+        uint64_t bytes = 0;        ///< Bytes requested by those calls
+        uint64_t failures = 0;     ///< Calls that failed or returned a short read
+    };
+
 private:
     const Process* m_process;  ///< Pointer to the associated process
 
+    struct CachedPage {
+        uint64_t generation = 0;   ///< Generation the page was fetched in
+        bool stable = false;       ///< Survives generation bumps
+        std::vector<uint8_t> data; ///< PAGE_SIZE bytes of remote memory
+    };
+
+    // Page cache (opt-in). Mutable because reads are logically const.
+    bool m_pageCacheEnabled = false;
+    size_t m_maxCachedPages = 512;
+    uint64_t m_generation = 1;
+    mutable std::unordered_map<uintptr_t, CachedPage> m_pageCache;
+    mutable PageCacheStats m_pageCacheStats;
+    mutable ReadStats m_readStats;
+    std::vector<std::pair<uintptr_t, uintptr_t>> m_stableRegions;  ///< [start, end) ranges
+
+    // Readable region map built from VirtualQueryEx, sorted by start address
+    struct MemoryRegion {
+        uintptr_t start;
+        uintptr_t end;
+    };
+
+    mutable std::vector<MemoryRegion> m_regions;
+    mutable bool m_regionMapBuilt = false;
+    mutable std::chrono::steady_clock::time_point m_regionsRefreshedAt;
+    std::chrono::milliseconds m_regionRefreshInterval{5000};   ///< Periodic rebuild interval
+    std::chrono::milliseconds m_regionMissRefreshDelay{250};   ///< Minimum delay between rebuilds on a miss
+
 public:
     /**
      * @brief Constructor that associates this Memory instance with a Process
@@ -51,6 +104,7 @@ public:
      * @brief Read a null-terminated string from the specified address
      * @param address The memory address to read from
      * @param maxLength Maximum length to read to prevent infinite loops
+     *                  (clamped to the end of the containing readable region)
      * @return The string read from memory
      * @throws std::runtime_error if the read operation fails
      */
@@ -112,16 +166,193 @@ public:
 
     /**
      * @brief Check if a memory address is readable
+     *
+     * Uses the cached region map (binary search, no kernel transition). The map is
+     * rebuilt periodically and lazily on a miss, so newly allocated memory is found.
+     *
      * @param address The address to check
      * @param size The size of the memory region to check
      * @return true if the memory region is readable, false otherwise
      */
     bool isValidAddress(uintptr_t address, size_t size = sizeof(void*)) const;
 
+    /**
+     * @brief Get the number of readable bytes from address to the end of its region
+     * @param address The address to check
+     * @return Bytes until the region end, or 0 if the address is not readable
+     */
+    size_t getReadableSize(uintptr_t address) const;
+
+    /**
+     * @brief Rebuild the readable region map by walking the target's address space
+     */
+    void refreshRegionMap();
+
+    void setRegionRefreshInterval(std::chrono::milliseconds interval) { m_regionRefreshInterval = interval; }
+    size_t getRegionCount() const { return m_regions.size(); }
+
+    // ============ PAGE CACHE ============
+
+    /**
+     * @brief Enable or disable the page cache under readMemory()
+     * @param enable true to serve reads from whole cached pages
+     * @note Disabling the cache drops every cached page
+     */
+    void enablePageCache(bool enable);
+    bool isPageCacheEnabled() const { return m_pageCacheEnabled; }
+
+    /**
+     * @brief Limit the number of pages held by the cache
+     */
+    void setMaxCachedPages(size_t maxPages) { m_maxCachedPages = maxPages; }
+
+    /**
+     * @brief Start a new cache generation (call once per tick)
+     *
+     * Pages fetched in earlier generations are refetched on their next use,
+     * except pages inside regions marked as stable.
+     */
+    void advanceGeneration() { m_generation++; }
+    uint64_t getGeneration() const { return m_generation; }
+
+    /**
+     * @brief Mark a region whose contents do not change between ticks (e.g. static module data)
+     * @note Only pages lying entirely inside the region are kept across generations
+     * @param address Start of the region
+     * @param size Size of the region in bytes
+     */
+    void addStableRegion(uintptr_t address, size_t size);
+    void clearStableRegions();
+
+    /**
+     * @brief Drop every cached page, including stable ones
+     */
+    void invalidatePageCache();
+
+    PageCacheStats getPageCacheStats() const;
+    void resetPageCacheStats();
+    ReadStats getReadStats() const { return m_readStats; }
+
+    /**
+     * @class ReadBatch
+     * @brief Coalesces many small reads into as few ReadProcessMemory calls as possible
+     *
+     * Callers register (address, size, destination) tuples and then call execute().
+     * Requests are sorted by address, merged when they overlap or are separated by
+     * no more than the configured gap, read with one call per merged span and
+     * scattered back into their destinations. If a merged span cannot be read
+     * (e.g. the gap crosses an unmapped page) its requests are retried one by one.
+     */
+    class ReadBatch {
+    public:
+        static constexpr size_t DEFAULT_MAX_GAP = 64;              ///< Default merge gap in bytes
+        static constexpr size_t DEFAULT_MAX_SPAN_SIZE = 64 * 1024; ///< Upper bound for a single merged read
+
+        /**
+         * @brief Create an empty batch bound to a Memory instance
+         * @param memory The Memory instance used to perform the reads
+         * @param maxGap Maximum number of unrequested bytes allowed between two merged requests
+         * @throws std::invalid_argument if memory is null
+         */
+        explicit ReadBatch(const Memory* memory, size_t maxGap = DEFAULT_MAX_GAP);
+
+        /**
+         * @brief Register a raw read request
+         * @param address The remote address to read from
+         * @param destination Local buffer receiving the bytes (must stay valid until execute())
+         * @param size Number of bytes to read
+         */
+        void add(uintptr_t address, void* destination, size_t size);
+
+        /**
+         * @brief Register a typed read request
+         * @tparam T The type of data to read (must be trivially copyable)
+         * @param address The remote address to read from
+         * @param destination Local object receiving the value
+         */
+        template<typename T>
+        void add(uintptr_t address, T* destination) {
+            static_assert(std::is_trivially_copyable_v<T>, "Type must be trivially copyable");
+            add(address, destination, sizeof(T));
+        }
+
+        /**
+         * @brief Perform all registered reads
+         * @return true if every request was read successfully, false otherwise
+         * @note The request list is kept so the same batch can be executed again;
+         *       call clear() before registering a new set of requests.
+         */
+        bool execute();
+
+        /**
+         * @brief Remove all registered requests (keeps allocated capacity)
+         */
+        void clear();
+
+        /**
+         * @brief Reserve capacity for an expected number of requests
+         */
+        void reserve(size_t count) { m_requests.reserve(count); }
+
+        void setMaxGap(size_t gap) { m_maxGap = gap; }
+        void setMaxSpanSize(size_t size) { m_maxSpanSize = size; }
+
+        size_t getRequestCount() const { return m_requests.size(); }
+        size_t getSpanCount() const { return m_spanCount; }       ///< Merged spans in the last execute()
+        size_t getFailedCount() const { return m_failedCount; }   ///< Failed requests in the last execute()
+
+    private:
+        struct Request {
+            uintptr_t address;
+            void* destination;
+            size_t size;
+        };
+
+        const Memory* m_memory;
+        size_t m_maxGap;
+        size_t m_maxSpanSize = DEFAULT_MAX_SPAN_SIZE;
+        std::vector<Request> m_requests;
+        std::vector<uint8_t> m_spanBuffer;  ///< Scratch buffer reused across spans
+        bool m_sorted = true;
+        size_t m_spanCount = 0;
+        size_t m_failedCount = 0;
+    };
+
 private:
     /**
      * @brief Validate that the associated process is valid and attached
      * @throws std::runtime_error if the process is invalid
      */
     void validateProcess() const;
+
+    /**
+     * @brief Read directly from the target process, bypassing the page cache
+     */
+    bool readRemote(uintptr_t address, void* buffer, size_t size) const;
+
+    /**
+     * @brief Serve a read from cached pages, fetching missing or stale pages
+     * @return true if the read was fully served, false if the caller should read directly
+     */
+    bool readCached(uintptr_t address, void* buffer, size_t size) const;
+
+    /**
+     * @brief Find or fetch the cached copy of a page
+     * @return Pointer to the page data, or nullptr if the page could not be cached
+     */
+    const uint8_t* getCachedPage(uintptr_t pageBase) const;
+
+    bool isInStableRegion(uintptr_t pageBase) const;
+
+    /**
+     * @brief Walk the target's address space with VirtualQueryEx and store readable regions
+     */
+    void rebuildRegionMap() const;
+
+    /**
+     * @brief Find the readable region containing an address
+     * @param allowRefresh Rebuild the map and retry once on a miss
+     * @return Pointer to the region, or nullptr if the address is not readable
+     */
+    const MemoryRegion* findRegion(uintptr_t address, bool allowRefresh = true) const;
 };
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Identifies a specific build of a module from its PE header
+ *
+ * Used to key on-disk caches: anything derived from the game binary
+ * (signature matches, offsets) stays valid while the build id is unchanged.
+ */
+struct ModuleBuildId {
+    uint32_t timeDateStamp = 0;  ///< IMAGE_FILE_HEADER::TimeDateStamp
+    uint32_t sizeOfImage = 0;    ///< IMAGE_OPTIONAL_HEADER::SizeOfImage
+    uint32_t checksum = 0;       ///< IMAGE_OPTIONAL_HEADER::CheckSum (often 0 for game builds)
+
+    bool isValid() const { return timeDateStamp != 0 && sizeOfImage != 0; }
+
+    bool operator==(const ModuleBuildId& other) const {
+        return timeDateStamp == other.timeDateStamp && sizeOfImage == other.sizeOfImage && 
+               checksum == other.checksum;
+    }
+    bool operator!=(const ModuleBuildId& other) const { return !(*this == other); }
+};
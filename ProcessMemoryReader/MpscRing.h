@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @class MpscRing
+ * @brief Bounded lock-free ring for many producers and a single consumer
+ *
+ * Every cell carries a sequence number (Vyukov's bounded queue): a producer
+ * claims a position with one CAS on the enqueue counter, fills the cell in
+ * place and publishes it by bumping the cell's sequence. The consumer owns the
+ * dequeue position, so popping needs no atomic read-modify-write at all. When
+ * the ring is full tryPush() fails immediately instead of waiting, leaving the
+ * overflow policy to the caller.
+ *
+ * @tparam T Cell payload; filled and consumed in place, never copied by the ring
+ */
+template<typename T>
+class MpscRing {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+
+    alignas(64) std::atomic<size_t> m_enqueuePos{0};
+    alignas(64) size_t m_dequeuePos = 0;  // Consumer only
+
+public:
+    /**
+     * @param capacity Number of cells, rounded up to a power of two
+     */
+    explicit MpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+
+        m_cells.reset(new Cell[size]);
+        m_mask = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    /**
+     * @brief Claim a cell and fill it (any thread)
+     * @param fill Called as fill(T&) on the claimed cell
+     * @return false if the ring is full (fill is not called)
+     */
+    template<typename Fill>
+    bool tryPush(Fill&& fill) {
+        Cell* cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            cell = &m_cells[pos & m_mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;   // The consumer has not freed this cell yet
+            } else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(cell->value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consume the oldest cell (consumer thread only)
+     * @param consume Called as consume(const T&) before the cell is handed back
+     * @return false if no published cell is available
+     */
+    template<typename Consume>
+    bool tryPop(Consume&& consume) {
+        Cell& cell = m_cells[m_dequeuePos & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != m_dequeuePos + 1) {
+            return false;
+        }
+
+        consume(static_cast<const T&>(cell.value));
+        cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+        ++m_dequeuePos;
+        return true;
+    }
+
+    /**
+     * @brief Whether the next cell is unpublished (consumer thread only)
+     */
+    bool empty() const {
+        const Cell& cell = m_cells[m_dequeuePos & m_mask];
+        return cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1;
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+};
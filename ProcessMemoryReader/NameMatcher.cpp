@@ -0,0 +1,169 @@
+#include "NameMatcher.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+    constexpr uint32_t NO_STATE = 0xFFFFFFFFu;
+}
+
+void NameMatcher::build(const std::vector<std::string>& patterns) {
+    m_byteClass.assign(256, 0);
+    m_classCount = 1;
+    m_transitions.clear();
+    m_outputBegin.clear();
+    m_outputs.clear();
+    m_patternLength.clear();
+    m_patternIds.clear();
+    m_patternCount = 0;
+
+    // Deduplicate case-insensitively and give every byte that occurs a class
+    std::vector<std::string> unique;
+    std::unordered_map<std::string, uint32_t> seen;
+    for (const std::string& pattern : patterns) {
+        std::string folded(pattern);
+        for (char& c : folded) {
+            c = static_cast<char>(foldCase(static_cast<uint8_t>(c)));
+        }
+
+        auto it = seen.find(folded);
+        if (it != seen.end()) {
+            m_patternIds.push_back(it->second);
+            continue;
+        }
+
+        uint32_t id = static_cast<uint32_t>(unique.size());
+        seen.emplace(folded, id);
+        m_patternIds.push_back(id);
+        for (char c : folded) {
+            uint8_t byte = static_cast<uint8_t>(c);
+            if (m_byteClass[byte] == 0) {
+                m_byteClass[byte] = static_cast<uint8_t>(std::min<size_t>(m_classCount++, 255));
+            }
+        }
+        unique.push_back(std::move(folded));
+    }
+    for (int c = 'A'; c <= 'Z'; ++c) {
+        m_byteClass[c] = m_byteClass[c + 32];
+    }
+    m_patternCount = unique.size();
+
+    // Trie
+    std::vector<std::vector<uint32_t>> stateOutputs(1);
+    m_transitions.assign(m_classCount, NO_STATE);
+    for (uint32_t id = 0; id < unique.size(); ++id) {
+        const std::string& pattern = unique[id];
+        m_patternLength.push_back(static_cast<uint32_t>(pattern.size()));
+        if (pattern.empty()) {
+            continue;
+        }
+
+        uint32_t state = 0;
+        for (char c : pattern) {
+            uint32_t& next = m_transitions[state * m_classCount + m_byteClass[static_cast<uint8_t>(c)]];
+            if (next == NO_STATE) {
+                next = static_cast<uint32_t>(stateOutputs.size());
+                stateOutputs.emplace_back();
+                m_transitions.resize(m_transitions.size() + m_classCount, NO_STATE);
+            }
+            state = m_transitions[state * m_classCount + m_byteClass[static_cast<uint8_t>(c)]];
+        }
+        stateOutputs[state].push_back(id);
+    }
+
+    // Breadth-first fail links, folded straight into a complete DFA
+    size_t stateCount = stateOutputs.size();
+    std::vector<uint32_t> fail(stateCount, 0);
+    std::vector<uint32_t> queue;
+    queue.reserve(stateCount);
+
+    for (size_t c = 0; c < m_classCount; ++c) {
+        uint32_t& next = m_transitions[c];
+        if (next == NO_STATE) {
+            next = 0;
+        } else {
+            fail[next] = 0;
+            queue.push_back(next);
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        uint32_t state = queue[head];
+        const std::vector<uint32_t>& inherited = stateOutputs[fail[state]];
+        stateOutputs[state].insert(stateOutputs[state].end(), inherited.begin(), inherited.end());
+
+        for (size_t c = 0; c < m_classCount; ++c) {
+            uint32_t& next = m_transitions[state * m_classCount + c];
+            uint32_t fallback = m_transitions[fail[state] * m_classCount + c];
+            if (next == NO_STATE) {
+                next = fallback;
+            } else {
+                fail[next] = fallback;
+                queue.push_back(next);
+            }
+        }
+    }
+
+    m_outputBegin.reserve(stateCount + 1);
+    for (const auto& outputs : stateOutputs) {
+        m_outputBegin.push_back(static_cast<uint32_t>(m_outputs.size()));
+        m_outputs.insert(m_outputs.end(), outputs.begin(), outputs.end());
+    }
+    m_outputBegin.push_back(static_cast<uint32_t>(m_outputs.size()));
+}
+
+void NameMatcher::prepare(Matches& matches) const {
+    size_t words = (m_patternCount + 63) / 64;
+    matches.contains.assign(words, 0);
+    matches.exact.assign(words, 0);
+}
+
+void NameMatcher::match(const std::string& text, Matches& matches) const {
+    std::fill(matches.contains.begin(), matches.contains.end(), 0);
+    std::fill(matches.exact.begin(), matches.exact.end(), 0);
+    if (m_transitions.empty()) {
+        return;
+    }
+
+    uint32_t state = 0;
+    size_t length = text.size();
+    for (size_t i = 0; i < length; ++i) {
+        state = step(state, static_cast<uint8_t>(text[i]));
+        for (uint32_t o = m_outputBegin[state]; o < m_outputBegin[state + 1]; ++o) {
+            uint32_t pattern = m_outputs[o];
+            matches.contains[pattern >> 6] |= uint64_t{1} << (pattern & 63);
+            if (i + 1 == length && m_patternLength[pattern] == length) {
+                matches.exact[pattern >> 6] |= uint64_t{1} << (pattern & 63);
+            }
+        }
+    }
+}
+
+void NameMatcher::accumulate(const std::string& text, Matches& matches) const {
+    if (m_transitions.empty()) {
+        return;
+    }
+
+    uint32_t state = 0;
+    for (char c : text) {
+        state = step(state, static_cast<uint8_t>(c));
+        for (uint32_t o = m_outputBegin[state]; o < m_outputBegin[state + 1]; ++o) {
+            uint32_t pattern = m_outputs[o];
+            matches.contains[pattern >> 6] |= uint64_t{1} << (pattern & 63);
+        }
+    }
+}
+
+bool NameMatcher::containsAny(const std::string& text) const {
+    if (m_transitions.empty()) {
+        return false;
+    }
+
+    uint32_t state = 0;
+    for (char c : text) {
+        state = step(state, static_cast<uint8_t>(c));
+        if (m_outputBegin[state] != m_outputBegin[state + 1]) {
+            return true;
+        }
+    }
+    return false;
+}
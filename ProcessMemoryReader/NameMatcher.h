@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @class NameMatcher
+ * @brief Aho-Corasick automaton matching a fixed set of names in one pass
+ *
+ * Patterns are matched case-insensitively (ASCII) anywhere in the text; a
+ * pattern that covers the whole text also counts as an exact match. The
+ * automaton is a dense DFA over byte classes - only the bytes that occur in
+ * some pattern get a column, everything else shares one - so scanning is one
+ * table lookup per character regardless of the number of patterns.
+ *
+ * Pattern ids are the indices passed to build(); duplicates share the id of
+ * their first occurrence.
+ */
+class NameMatcher {
+public:
+    /**
+     * @brief Per-text match result: bit i set if pattern i matched
+     */
+    struct Matches {
+        std::vector<uint64_t> contains;
+        std::vector<uint64_t> exact;
+
+        bool hasContains(uint32_t pattern) const { return (contains[pattern >> 6] >> (pattern & 63) & 1) != 0; }
+        bool hasExact(uint32_t pattern) const { return (exact[pattern >> 6] >> (pattern & 63) & 1) != 0; }
+        bool anyContains() const {
+            for (uint64_t word : contains) if (word) return true;
+            return false;
+        }
+    };
+
+private:
+    std::vector<uint8_t> m_byteClass;          // 256 entries, 0 = not in any pattern
+    size_t m_classCount = 1;
+    std::vector<uint32_t> m_transitions;       // state * m_classCount + class
+    std::vector<uint32_t> m_outputBegin;       // Per state, into m_outputs (size = states + 1)
+    std::vector<uint32_t> m_outputs;           // Pattern ids ending in each state, fail chain included
+    std::vector<uint32_t> m_patternLength;
+    std::vector<uint32_t> m_patternIds;        // Input index -> id after deduplication
+    size_t m_patternCount = 0;
+
+public:
+    NameMatcher() = default;
+    explicit NameMatcher(const std::vector<std::string>& patterns) { build(patterns); }
+
+    /**
+     * @brief Build the automaton; empty patterns never match
+     */
+    void build(const std::vector<std::string>& patterns);
+
+    size_t getPatternCount() const { return m_patternCount; }
+    uint32_t getPatternId(size_t inputIndex) const { return m_patternIds[inputIndex]; }
+    bool empty() const { return m_patternCount == 0; }
+
+    /**
+     * @brief Size a Matches for this automaton (capacity is reused by match())
+     */
+    void prepare(Matches& matches) const;
+
+    /**
+     * @brief Clear matches and set the bits of every pattern found in text
+     */
+    void match(const std::string& text, Matches& matches) const;
+
+    /**
+     * @brief OR the contains bits of every pattern found in text into matches
+     */
+    void accumulate(const std::string& text, Matches& matches) const;
+
+    /**
+     * @brief Whether any pattern occurs in text
+     */
+    bool containsAny(const std::string& text) const;
+
+private:
+    static uint8_t foldCase(uint8_t c) { return c >= 'A' && c <= 'Z' ? static_cast<uint8_t>(c + 32) : c; }
+    uint32_t step(uint32_t state, uint8_t c) const {
+        return m_transitions[state * m_classCount + m_byteClass[c]];
+    }
+};
@@ -0,0 +1,132 @@
+#include "NavigationSystem.h"
+#include "GameState.h"
+#include "EntityManager.h"
+#include "InputManager.h"
+#include <cmath>
+
+namespace {
+    // Out-of-range positions (and NaN) land just outside the grid, where every lookup fails
+    int32_t toCell(float value, float resolution, int32_t size) {
+        float cell = std::floor(value / resolution);
+        if (!(cell >= 0.0f)) {
+            return -1;
+        }
+        return cell < static_cast<float>(size) ? static_cast<int32_t>(cell) : size;
+    }
+}
+
+NavigationSystem::NavigationSystem(const GameState* gameState, const EntityManager* entityManager,
+                                   InputManager* inputManager)
+    : m_gameState(gameState), m_entityManager(entityManager), m_inputManager(inputManager) {
+    auto now = std::chrono::steady_clock::now();
+    m_lastMovementTime = now;
+    m_stuckStartTime = now;
+    initializeGrid();
+}
+
+// ============ PATHFINDING ============
+
+std::vector<NavigationSystem::Point> NavigationSystem::findPath(const Point& start, const Point& goal) {
+    std::vector<Point> waypoints;
+
+    Point startCell = worldToGrid(start);
+    Point goalCell = worldToGrid(goal);
+    PathFinder::Result result;
+    {
+        ProfileScope scope(m_profiler, m_findPathZone);
+        result = m_pathFinder.findPath(
+            {static_cast<int32_t>(startCell.x), static_cast<int32_t>(startCell.y)},
+            {static_cast<int32_t>(goalCell.x), static_cast<int32_t>(goalCell.y)}, m_pathCells);
+    }
+    if (result != PathFinder::Result::FOUND && result != PathFinder::Result::PARTIAL) {
+        return waypoints;
+    }
+
+    waypoints.reserve(m_pathCells.size());
+    for (const PathFinder::Cell& cell : m_pathCells) {
+        waypoints.push_back(gridToWorld(cell.x, cell.y));
+    }
+    return waypoints;
+}
+
+bool NavigationSystem::isPathClear(const Point& start, const Point& end) {
+    Point a = worldToGrid(start);
+    Point b = worldToGrid(end);
+    return m_pathFinder.isLineClear({static_cast<int32_t>(a.x), static_cast<int32_t>(a.y)},
+                                    {static_cast<int32_t>(b.x), static_cast<int32_t>(b.y)});
+}
+
+bool NavigationSystem::isPositionWalkable(const Point& position) {
+    Point cell = worldToGrid(position);
+    return m_pathFinder.isWalkable(static_cast<int32_t>(cell.x), static_cast<int32_t>(cell.y));
+}
+
+// ============ EXPLORATION ============
+
+NavigationSystem::Point NavigationSystem::getNextExplorationTarget() {
+    Point player = getPlayerPosition();
+    Point cell = worldToGrid(player);
+
+    ExplorationGrid::Cell target;
+    bool found = m_explorationGrid.findNearestFrontier(
+        static_cast<int32_t>(cell.x), static_cast<int32_t>(cell.y), target,
+        [this](const ExplorationGrid::Cell& candidate) {
+            return m_pathFinder.isWalkable(candidate.x, candidate.y);
+        });
+
+    // Nothing left to grow into (or nothing explored yet): stay where we are
+    return found ? gridToWorld(target.x, target.y) : player;
+}
+
+bool NavigationSystem::isAreaExplored(const Point& center, float radius) {
+    Point cell = worldToGrid(center);
+    float coverage = m_explorationGrid.getDiskCoverage(static_cast<int32_t>(cell.x), static_cast<int32_t>(cell.y),
+                                                       radius / m_gridResolution);
+    return coverage >= 0.9f;
+}
+
+void NavigationSystem::markAreaAsExplored(const Point& center, float radius) {
+    Point cell = worldToGrid(center);
+    m_explorationGrid.markDisk(static_cast<int32_t>(cell.x), static_cast<int32_t>(cell.y),
+                               radius / m_gridResolution);
+}
+
+// ============ GRID MANAGEMENT ============
+
+void NavigationSystem::setGridResolution(float resolution) {
+    if (resolution <= 0.0f || resolution == m_gridResolution) {
+        return;
+    }
+    m_gridResolution = resolution;
+    initializeGrid();
+}
+
+void NavigationSystem::initializeGrid() {
+    m_pathFinder.resize(m_gridWidth, m_gridHeight);
+    m_explorationGrid.resize(m_gridWidth, m_gridHeight);
+}
+
+NavigationSystem::Point NavigationSystem::worldToGrid(const Point& worldPos) {
+    return Point(static_cast<float>(toCell(worldPos.x, m_gridResolution, m_gridWidth)),
+                 static_cast<float>(toCell(worldPos.y, m_gridResolution, m_gridHeight)));
+}
+
+NavigationSystem::Point NavigationSystem::gridToWorld(int gridX, int gridY) {
+    return Point((gridX + 0.5f) * m_gridResolution, (gridY + 0.5f) * m_gridResolution);
+}
+
+void NavigationSystem::setProfiler(Profiler* profiler) {
+    m_profiler = profiler;
+    m_findPathZone = m_profiler ? m_profiler->addZone("PathFinder::findPath") : Profiler::INVALID_ZONE;
+}
+
+bool NavigationSystem::isGridPositionValid(int x, int y) {
+    return m_pathFinder.isValid(x, y);
+}
+
+// ============ UTILITY ============
+
+NavigationSystem::Point NavigationSystem::getPlayerPosition() const {
+    const GameState::PlayerData& player = m_gameState->getPlayer();
+    return Point(player.x, player.y);
+}
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <vector>
-#include <queue>
-#include <unordered_set>
 #include <functional>
 #include <chrono>
+#include <cmath>
+#include "PathFinder.h"
+#include "ExplorationGrid.h"
+#include "Profiler.h"
 
 // Forward declarations
 class GameState;
@@ -32,18 +34,6 @@ public:
         }
     };
     
-    struct NavigationNode {
-        Point position;
-        float gCost;        // Cost from start
-        float hCost;        // Heuristic cost to goal
-        float fCost() const { return gCost + hCost; }
-        NavigationNode* parent;
-        bool isWalkable;
-        
-        NavigationNode(Point pos = Point(), float g = 0, float h = 0, NavigationNode* p = nullptr)
-            : position(pos), gCost(g), hCost(h), parent(p), isWalkable(true) {}
-    };
-
     enum class NavigationState {
         IDLE,
         PATHFINDING,
@@ -63,13 +53,20 @@ private:
     size_t m_currentPathIndex = 0;
     Point m_currentGoal;
     
-    // Map exploration
-    std::vector<std::vector<bool>> m_explorationGrid;
-    std::unordered_set<uint64_t> m_exploredAreas;
+    // Map exploration; explored cells, coverage and the frontier in one bitset grid
+    ExplorationGrid m_explorationGrid;
     int m_gridWidth = 200;
     int m_gridHeight = 200;
     float m_gridResolution = 2.0f; // Units per grid cell
     
+    // Pathfinding; the walkability grid lives in the path finder, one byte per cell
+    PathFinder m_pathFinder;
+    std::vector<PathFinder::Cell> m_pathCells;  // Reused search output
+    
+    // Each search is timed on its own so replanning spikes show up in the histogram
+    Profiler* m_profiler = nullptr;
+    Profiler::ZoneId m_findPathZone = Profiler::INVALID_ZONE;
+    
     // Pathfinding parameters
     float m_maxPathfindingTime = 1000.0f; // Max time in ms
     float m_nodeDistance = 2.0f;
@@ -83,7 +80,6 @@ private:
     bool m_isStuck = false;
     
     // Area exploration
-    std::queue<Point> m_explorationQueue;
     std::vector<Point> m_interestingPoints; // Chests, doors, etc.
 
 public:
@@ -96,16 +92,23 @@ public:
     void update();
     
     // Pathfinding
+    /**
+     * @brief Jump Point Search from start to goal in world coordinates
+     * @return Waypoints at cell centres; up to the closest reachable cell if the
+     *         expansion budget ran out, empty if there is no path
+     * @note Repeated trips between the same areas (portals, waypoints) are served
+     *       from the path finder's cache until the walkability grid changes
+     */
     std::vector<Point> findPath(const Point& start, const Point& goal);
-    bool isPathClear(const Point& start, const Point& end);
+    bool isPathClear(const Point& start, const Point& end);  // Grid line walk via PathFinder::isLineClear()
     bool isPositionWalkable(const Point& position);
     
     // Exploration
     void startMapExploration();
-    Point getNextExplorationTarget();
+    Point getNextExplorationTarget();      // Nearest walkable frontier cell, no map scan
     bool isAreaExplored(const Point& center, float radius = 10.0f);
     void markAreaAsExplored(const Point& center, float radius = 5.0f);
-    float getExplorationProgress() const;
+    float getExplorationProgress() const { return m_explorationGrid.getProgress(); }
     
     // State queries
     NavigationState getState() const { return m_state; }
@@ -124,21 +127,20 @@ public:
     void setMaxPathfindingTime(float timeMs) { m_maxPathfindingTime = timeMs; }
     void setStuckThreshold(float threshold) { m_stuckThreshold = threshold; }
     void setGridResolution(float resolution);
+    void setMaxPathExpansions(size_t maxExpansions) { m_pathFinder.setMaxExpansions(maxExpansions); }
+    void setPathCacheSize(size_t entries) { m_pathFinder.setPathCache(entries); }
+    const PathFinder::Statistics& getPathStatistics() const { return m_pathFinder.getStatistics(); }
+    void setProfiler(Profiler* profiler);   // Adds the "PathFinder::findPath" zone
 
 private:
-    // Pathfinding implementation
-    std::vector<Point> aStar(const Point& start, const Point& goal);
-    std::vector<NavigationNode*> getNeighbors(NavigationNode* node, const std::vector<std::vector<NavigationNode>>& grid);
-    float heuristic(const Point& a, const Point& b);
-    
     // Movement execution
     bool moveToNextPathPoint();
     void handleStuckState();
     void attemptUnstuck();
     
     // Grid management
-    void initializeGrid();
-    void updateObstacles();
+    void initializeGrid();     // Sizes m_pathFinder and m_explorationGrid to m_gridWidth x m_gridHeight
+    void updateObstacles();    // Not implemented: no collision data is read yet; blocked cells would go to m_pathFinder
     Point worldToGrid(const Point& worldPos);
     Point gridToWorld(int gridX, int gridY);
     bool isGridPositionValid(int x, int y);
@@ -17,6 +17,7 @@ private:
     uintptr_t m_playerBaseAddress;
     uintptr_t m_inventoryBaseAddress;
     uintptr_t m_gameBaseAddress;
+    OffsetManager::ChainHandle m_healthChain = OffsetManager::INVALID_CHAIN;
 
 public:
     OffsetExamples(const Memory* memory) : m_memory(memory) {
@@ -47,7 +48,12 @@ public:
         uintptr_t healthAddressStatic = OffsetManager::calculateAddress(m_playerBaseAddress, 0x10);
         std::cout << "Player Health Address (Method 3): 0x" << std::hex << healthAddressStatic << std::endl;
         
-        // All three methods should give the same result!
+        // Method 4: Handle lookup (hot path - indexed load, no string hashing)
+        OffsetManager::OffsetId healthId = OffsetManager::BuiltinOffset::PLAYER_HEALTH;
+        uintptr_t healthAddressHandle = m_offsetManager->calculateAddress(m_playerBaseAddress, healthId);
+        std::cout << "Player Health Address (Method 4): 0x" << std::hex << healthAddressHandle << std::endl;
+        
+        // All four methods should give the same result!
         std::cout << std::dec; // Reset to decimal
     }
 
@@ -136,6 +142,14 @@ public:
         uintptr_t finalManual = statsPtr + 0x10;              // Stats + detailed health offset
         */
         
+        // For chains used every tick: compile once, keep the handle, then resolve through the cache
+        if (m_healthChain == OffsetManager::INVALID_CHAIN) {
+            m_healthChain = m_offsetManager->compilePointerChain(m_gameBaseAddress, pointerChain);
+        }
+        uintptr_t cachedAddress = m_offsetManager->resolvePointerChain(m_healthChain);
+        
+        std::cout << "Final address through compiled chain: 0x" << std::hex << cachedAddress << std::endl;
+        
         std::cout << std::dec;
     }
 
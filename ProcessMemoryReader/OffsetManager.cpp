@@ -1,9 +1,64 @@
 #include "OffsetManager.h"
 #include "Memory.h"
+#include "GameLayouts.h"
+#include "BinaryIO.h"
 #include <iostream>
 #include <fstream>
 #include <algorithm>
 
+namespace {
+    // Built-in offsets, listed in BuiltinOffset order so their handles are compile-time constants
+    struct BuiltinOffsetDefinition {
+        OffsetManager::BuiltinOffset id;
+        const char* name;
+        uintptr_t value;
+        OffsetManager::OffsetType type;
+        bool isDynamic;
+    };
+    
+    using Builtin = OffsetManager::BuiltinOffset;
+    using Type = OffsetManager::OffsetType;
+    
+    constexpr BuiltinOffsetDefinition kBuiltinOffsets[] = {
+        // Player offsets (defaults come from the compile-time PlayerLayout)
+        { Builtin::PLAYER_POSITION,        "player_position",        PlayerLayout::PositionX::offset,      Type::PLAYER,    false },
+        { Builtin::PLAYER_HEALTH,          "player_health",          PlayerLayout::Health::offset,         Type::PLAYER,    false },
+        { Builtin::PLAYER_MAX_HEALTH,      "player_max_health",      PlayerLayout::MaxHealth::offset,      Type::PLAYER,    false },
+        { Builtin::PLAYER_MANA,            "player_mana",            PlayerLayout::Mana::offset,           Type::PLAYER,    false },
+        { Builtin::PLAYER_MAX_MANA,        "player_max_mana",        PlayerLayout::MaxMana::offset,        Type::PLAYER,    false },
+        { Builtin::PLAYER_LEVEL,           "player_level",           PlayerLayout::Level::offset,          Type::PLAYER,    false },
+        { Builtin::PLAYER_IN_COMBAT,       "player_in_combat",       PlayerLayout::InCombat::offset,       Type::PLAYER,    false },
+        { Builtin::PLAYER_IS_DEAD,         "player_is_dead",         PlayerLayout::IsDead::offset,         Type::PLAYER,    false },
+        { Builtin::PLAYER_MOVEMENT_SPEED,  "player_movement_speed",  PlayerLayout::MovementSpeed::offset,  Type::PLAYER,    false },
+        { Builtin::PLAYER_CLASS,           "player_class",           PlayerLayout::CharacterClass::offset, Type::PLAYER,    false },
+        
+        // Inventory offsets (dynamic - depend on slot index)
+        { Builtin::INVENTORY_SLOT,         "inventory_slot",         0x100,                                Type::INVENTORY, true  },
+        { Builtin::INVENTORY_ITEM_COUNT,   "inventory_item_count",   0x8,                                  Type::INVENTORY, false },
+        { Builtin::INVENTORY_ITEM_QUALITY, "inventory_item_quality", 0xC,                                  Type::INVENTORY, false },
+        
+        // Monster/Entity offsets
+        { Builtin::ENTITY_POSITION,        "entity_position",        0x0,                                  Type::MONSTER,   false },
+        { Builtin::ENTITY_HEALTH,          "entity_health",          0x20,                                 Type::MONSTER,   false },
+        { Builtin::ENTITY_TYPE,            "entity_type",            0x40,                                 Type::MONSTER,   false },
+        { Builtin::ENTITY_IS_ALIVE,        "entity_is_alive",        0x44,                                 Type::MONSTER,   false },
+    };
+    
+    static_assert(sizeof(kBuiltinOffsets) / sizeof(kBuiltinOffsets[0]) == static_cast<size_t>(Builtin::COUNT),
+                  "Every BuiltinOffset needs a definition");
+    
+    constexpr bool builtinOffsetsInOrder() {
+        for (size_t i = 0; i < static_cast<size_t>(Builtin::COUNT); ++i) {
+            if (static_cast<size_t>(kBuiltinOffsets[i].id) != i) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    static_assert(builtinOffsetsInOrder(), "kBuiltinOffsets must be listed in BuiltinOffset order");
+}
+
 OffsetManager::OffsetManager(const Memory* memory) 
     : m_memory(memory), m_gameBaseAddress(0) {
     // Initialize with default offsets
@@ -11,53 +66,63 @@ OffsetManager::OffsetManager(const Memory* memory)
 }
 
 void OffsetManager::initializeDefaultOffsets() {
-    // Player offsets
-    registerOffset("player_position", 0x0, OffsetType::PLAYER);
-    registerOffset("player_health", 0x10, OffsetType::PLAYER);
-    registerOffset("player_max_health", 0x14, OffsetType::PLAYER);
-    registerOffset("player_mana", 0x18, OffsetType::PLAYER);
-    registerOffset("player_max_mana", 0x1C, OffsetType::PLAYER);
-    registerOffset("player_level", 0x20, OffsetType::PLAYER);
-    registerOffset("player_in_combat", 0x24, OffsetType::PLAYER);
-    registerOffset("player_is_dead", 0x28, OffsetType::PLAYER);
-    registerOffset("player_movement_speed", 0x2C, OffsetType::PLAYER);
-    registerOffset("player_class", 0x30, OffsetType::PLAYER);
-    
-    // Inventory offsets (dynamic - depend on slot index)
-    registerDynamicOffset("inventory_slot", 0x100, OffsetType::INVENTORY);
-    registerOffset("inventory_item_count", 0x8, OffsetType::INVENTORY);
-    registerOffset("inventory_item_quality", 0xC, OffsetType::INVENTORY);
-    
-    // Monster/Entity offsets
-    registerOffset("entity_position", 0x0, OffsetType::MONSTER);
-    registerOffset("entity_health", 0x20, OffsetType::MONSTER);
-    registerOffset("entity_type", 0x40, OffsetType::MONSTER);
-    registerOffset("entity_is_alive", 0x44, OffsetType::MONSTER);
+    // Registered first and in enum order, so handle index == BuiltinOffset value
+    m_offsets.reserve(static_cast<size_t>(BuiltinOffset::COUNT));
+    
+    for (const auto& definition : kBuiltinOffsets) {
+        registerEntry(definition.name, definition.value, definition.type, definition.isDynamic);
+    }
 }
 
 // ============ BASIC OFFSET OPERATIONS ============
 
-void OffsetManager::registerOffset(const std::string& name, uintptr_t offset, OffsetType type) {
-    m_offsets[name] = OffsetEntry(name, offset, type, false);
+OffsetManager::OffsetId OffsetManager::registerEntry(const std::string& name, uintptr_t offset, OffsetType type, bool isDynamic) {
+    ++m_revision;
+    auto it = m_offsetIds.find(name);
+    if (it != m_offsetIds.end()) {
+        // Keep the existing handle so cached OffsetIds stay valid
+        m_offsets[it->second.index] = OffsetEntry(name, offset, type, isDynamic);
+        return it->second;
+    }
+    
+    OffsetId id(static_cast<uint32_t>(m_offsets.size()));
+    m_offsets.emplace_back(name, offset, type, isDynamic);
+    m_offsetIds.emplace(name, id);
+    return id;
 }
 
-void OffsetManager::registerDynamicOffset(const std::string& name, uintptr_t baseOffset, OffsetType type) {
-    m_offsets[name] = OffsetEntry(name, baseOffset, type, true);
+OffsetManager::OffsetId OffsetManager::registerOffset(const std::string& name, uintptr_t offset, OffsetType type) {
+    return registerEntry(name, offset, type, false);
 }
 
-uintptr_t OffsetManager::getOffset(const std::string& name) const {
-    auto it = m_offsets.find(name);
-    if (it != m_offsets.end()) {
-        // Formula: final_offset = static_value + dynamic_adjustment
-        return it->second.staticValue + it->second.dynamicAdjustment;
+OffsetManager::OffsetId OffsetManager::registerDynamicOffset(const std::string& name, uintptr_t baseOffset, OffsetType type) {
+    return registerEntry(name, baseOffset, type, true);
+}
+
+OffsetManager::OffsetId OffsetManager::getOffsetId(const std::string& name) const {
+    auto it = m_offsetIds.find(name);
+    if (it != m_offsetIds.end() && m_offsets[it->second.index].isRegistered) {
+        return it->second;
     }
-    return 0;
+    return OffsetId();
+}
+
+uintptr_t OffsetManager::getOffset(const std::string& name) const {
+    // Formula: final_offset = static_value + dynamic_adjustment
+    return getOffset(getOffsetId(name));
 }
 
 void OffsetManager::updateDynamicOffset(const std::string& name, uintptr_t adjustment) {
-    auto it = m_offsets.find(name);
-    if (it != m_offsets.end() && it->second.isDynamic) {
-        it->second.dynamicAdjustment = adjustment;
+    updateDynamicOffset(getOffsetId(name), adjustment);
+}
+
+void OffsetManager::updateDynamicOffset(OffsetId id, uintptr_t adjustment) {
+    if (id.index < m_offsets.size()) {
+        OffsetEntry& entry = m_offsets[id.index];
+        if (entry.isRegistered && entry.isDynamic && entry.dynamicAdjustment != adjustment) {
+            entry.dynamicAdjustment = adjustment;
+            ++m_revision;
+        }
     }
 }
 
@@ -75,9 +140,8 @@ uintptr_t OffsetManager::calculateAddress(uintptr_t baseAddress, uintptr_t offse
 }
 
 uintptr_t OffsetManager::calculateArrayAddress(uintptr_t baseAddress, size_t index, size_t elementSize, const std::string& offsetName) const {
-    uintptr_t offset = getOffset(offsetName);
     // Formula: final_address = base_address + (index * element_size) + offset
-    return baseAddress + (index * elementSize) + offset;
+    return calculateArrayAddress(baseAddress, index, elementSize, getOffsetId(offsetName));
 }
 
 // ============ MULTI-LEVEL POINTER CHAINS ============
@@ -109,28 +173,137 @@ uintptr_t OffsetManager::calculatePointerChain(uintptr_t startAddress, const std
     return currentAddress;
 }
 
+OffsetManager::ChainHandle OffsetManager::compilePointerChain(uintptr_t startAddress, const std::vector<std::string>& offsetChain) {
+    std::vector<uintptr_t> offsets;
+    offsets.reserve(offsetChain.size());
+    
+    for (const auto& name : offsetChain) {
+        offsets.push_back(getOffset(name));
+    }
+    
+    return compilePointerChain(startAddress, offsets);
+}
+
+OffsetManager::ChainHandle OffsetManager::compilePointerChain(uintptr_t startAddress, const std::vector<uintptr_t>& offsets) {
+    if (offsets.empty()) {
+        return INVALID_CHAIN;
+    }
+    
+    // The same chain compiled twice shares one entry (and its cached resolution)
+    for (size_t i = 0; i < m_chains.size(); ++i) {
+        if (m_chains[i].startAddress == startAddress && m_chains[i].offsets == offsets) {
+            return i;
+        }
+    }
+    
+    CompiledChain chain;
+    chain.startAddress = startAddress;
+    chain.offsets = offsets;
+    
+    m_chains.push_back(std::move(chain));
+    return m_chains.size() - 1;
+}
+
+uintptr_t OffsetManager::resolvePointerChain(ChainHandle handle) {
+    if (!m_memory || handle >= m_chains.size()) {
+        return 0;
+    }
+    
+    CompiledChain& chain = m_chains[handle];
+    
+    // Single offset: no dereference, the address never changes
+    if (chain.offsets.size() == 1) {
+        return chain.startAddress + chain.offsets[0];
+    }
+    
+    if (chain.resolvedAddress == 0) {
+        return walkPointerChain(chain);
+    }
+    
+    // Already validated during this tick
+    uint64_t generation = m_memory->getGeneration();
+    if (chain.validatedGeneration == generation) {
+        return chain.resolvedAddress;
+    }
+    
+    // Cheap revalidation: re-read only the last hop's parent pointer
+    try {
+        uintptr_t lastPointer = m_memory->read<uintptr_t>(chain.lastPointerAddress);
+        if (lastPointer == chain.lastPointerValue) {
+            chain.validatedGeneration = generation;
+            return chain.resolvedAddress;
+        }
+    }
+    catch (const std::exception&) {
+        // Fall through to a full walk
+    }
+    
+    return walkPointerChain(chain);
+}
+
+void OffsetManager::invalidatePointerChains() {
+    for (auto& chain : m_chains) {
+        chain.resolvedAddress = 0;
+    }
+}
+
+uintptr_t OffsetManager::walkPointerChain(CompiledChain& chain) const {
+    chain.resolvedAddress = 0;
+    
+    try {
+        uintptr_t currentAddress = chain.startAddress;
+        
+        // Dereference every offset except the last one
+        for (size_t i = 0; i + 1 < chain.offsets.size(); ++i) {
+            uintptr_t pointerAddress = currentAddress + chain.offsets[i];
+            currentAddress = m_memory->read<uintptr_t>(pointerAddress);
+            if (currentAddress == 0) {
+                return 0; // Null pointer in chain
+            }
+            
+            chain.lastPointerAddress = pointerAddress;
+            chain.lastPointerValue = currentAddress;
+        }
+        
+        chain.resolvedAddress = currentAddress + chain.offsets.back();
+        chain.validatedGeneration = m_memory->getGeneration();
+        return chain.resolvedAddress;
+    }
+    catch (const std::exception&) {
+        return 0;
+    }
+}
+
 // ============ UTILITY METHODS ============
 
 std::vector<OffsetManager::OffsetEntry> OffsetManager::getOffsetsByType(OffsetType type) const {
     std::vector<OffsetEntry> result;
-    for (const auto& pair : m_offsets) {
-        if (pair.second.type == type) {
-            result.push_back(pair.second);
+    for (const auto& entry : m_offsets) {
+        if (entry.isRegistered && entry.type == type) {
+            result.push_back(entry);
         }
     }
     return result;
 }
 
 bool OffsetManager::hasOffset(const std::string& name) const {
-    return m_offsets.find(name) != m_offsets.end();
+    return getOffsetId(name).isValid();
 }
 
 void OffsetManager::removeOffset(const std::string& name) {
-    m_offsets.erase(name);
+    OffsetId id = getOffsetId(name);
+    if (id.isValid()) {
+        m_offsets[id.index].isRegistered = false;
+        ++m_revision;
+    }
 }
 
 void OffsetManager::clearOffsets() {
-    m_offsets.clear();
+    // Handles stay reserved so a re-registered name gets its old OffsetId back
+    for (auto& entry : m_offsets) {
+        entry.isRegistered = false;
+    }
+    ++m_revision;
 }
 
 bool OffsetManager::validateAddress(uintptr_t address) const {
@@ -142,8 +315,10 @@ bool OffsetManager::validateAddress(uintptr_t address) const {
 
 void OffsetManager::printAllOffsets() const {
     std::cout << "=== Registered Offsets ===" << std::endl;
-    for (const auto& pair : m_offsets) {
-        const auto& entry = pair.second;
+    for (const auto& entry : m_offsets) {
+        if (!entry.isRegistered) {
+            continue;
+        }
         std::cout << "Name: " << entry.name 
                   << ", Static: 0x" << std::hex << entry.staticValue
                   << ", Dynamic: 0x" << entry.dynamicAdjustment
@@ -156,14 +331,87 @@ void OffsetManager::printAllOffsets() const {
 
 // ============ FILE OPERATIONS ============
 
-bool OffsetManager::loadOffsetsFromFile(const std::string& filename) {
-    // Implementation for loading offsets from JSON file
-    // This would use nlohmann::json to load offset configurations
-    return true; // Placeholder
+bool OffsetManager::loadOffsetsFromFile(const std::string& filename, const ModuleBuildId& buildId) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    ModuleBuildId fileBuildId;
+    uint32_t count = 0;
+    
+    if (!BinaryIO::read(file, magic) || magic != OFFSET_FILE_MAGIC ||
+        !BinaryIO::read(file, version) || version != OFFSET_FILE_VERSION ||
+        !BinaryIO::read(file, fileBuildId) || !BinaryIO::read(file, count)) {
+        return false;
+    }
+    
+    if (buildId.isValid() && fileBuildId != buildId) {
+        return false; // Offsets were saved for a different game build
+    }
+    
+    // A count the file cannot hold means a corrupt file, not an allocation to attempt
+    constexpr uint64_t minEntryBytes = sizeof(uint16_t) + sizeof(uint64_t) + 2 * sizeof(uint8_t);
+    if (count > BinaryIO::remaining(file) / minEntryBytes) {
+        return false;
+    }
+    
+    // Parse everything first so a truncated file leaves the registry untouched
+    struct LoadedEntry {
+        std::string name;
+        uint64_t value;
+        uint8_t type;
+        uint8_t isDynamic;
+    };
+    
+    std::vector<LoadedEntry> entries;
+    entries.reserve(count);
+    
+    for (uint32_t i = 0; i < count; ++i) {
+        LoadedEntry entry;
+        if (!BinaryIO::readString(file, entry.name) || !BinaryIO::read(file, entry.value) ||
+            !BinaryIO::read(file, entry.type) || !BinaryIO::read(file, entry.isDynamic) ||
+            entry.type > static_cast<uint8_t>(OffsetType::CUSTOM)) {
+            return false;
+        }
+        entries.push_back(std::move(entry));
+    }
+    
+    for (const auto& entry : entries) {
+        registerEntry(entry.name, static_cast<uintptr_t>(entry.value), 
+                      static_cast<OffsetType>(entry.type), entry.isDynamic != 0);
+    }
+    
+    return true;
 }
 
-bool OffsetManager::saveOffsetsToFile(const std::string& filename) const {
-    // Implementation for saving offsets to JSON file
-    // This would use nlohmann::json to save offset configurations
-    return true; // Placeholder
+bool OffsetManager::saveOffsetsToFile(const std::string& filename, const ModuleBuildId& buildId) const {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    uint32_t count = static_cast<uint32_t>(std::count_if(m_offsets.begin(), m_offsets.end(),
+        [](const OffsetEntry& entry) { return entry.isRegistered; }));
+    
+    BinaryIO::write(file, OFFSET_FILE_MAGIC);
+    BinaryIO::write(file, OFFSET_FILE_VERSION);
+    BinaryIO::write(file, buildId);
+    BinaryIO::write(file, count);
+    
+    // Dynamic adjustments are runtime state and are not persisted
+    for (const auto& entry : m_offsets) {
+        if (!entry.isRegistered) {
+            continue;
+        }
+        
+        BinaryIO::writeString(file, entry.name);
+        BinaryIO::write(file, static_cast<uint64_t>(entry.staticValue));
+        BinaryIO::write(file, static_cast<uint8_t>(entry.type));
+        BinaryIO::write(file, static_cast<uint8_t>(entry.isDynamic));
+    }
+    
+    return file.good();
 }
@@ -3,6 +3,8 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
+#include "ModuleBuildId.h"
 
 class Memory;
 
@@ -22,6 +24,40 @@ public:
         CUSTOM
     };
 
+    // Built-in offsets registered by initializeDefaultOffsets(), in registration order
+    // Their handles are known at compile time: OffsetId(BuiltinOffset::PLAYER_HEALTH)
+    enum class BuiltinOffset : uint32_t {
+        PLAYER_POSITION,
+        PLAYER_HEALTH,
+        PLAYER_MAX_HEALTH,
+        PLAYER_MANA,
+        PLAYER_MAX_MANA,
+        PLAYER_LEVEL,
+        PLAYER_IN_COMBAT,
+        PLAYER_IS_DEAD,
+        PLAYER_MOVEMENT_SPEED,
+        PLAYER_CLASS,
+        INVENTORY_SLOT,
+        INVENTORY_ITEM_COUNT,
+        INVENTORY_ITEM_QUALITY,
+        ENTITY_POSITION,
+        ENTITY_HEALTH,
+        ENTITY_TYPE,
+        ENTITY_IS_ALIVE,
+        COUNT
+    };
+
+    // Stable handle to a registered offset (index into the flat offset table)
+    struct OffsetId {
+        static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFF;
+        uint32_t index = INVALID_INDEX;
+        
+        constexpr OffsetId() = default;
+        constexpr explicit OffsetId(uint32_t i) : index(i) {}
+        constexpr OffsetId(BuiltinOffset builtin) : index(static_cast<uint32_t>(builtin)) {}
+        constexpr bool isValid() const { return index != INVALID_INDEX; }
+    };
+
     // Offset entry structure
     struct OffsetEntry {
         std::string name;           // Offset identifier
@@ -29,18 +65,55 @@ public:
         uintptr_t dynamicAdjustment; // Runtime adjustment
         bool isDynamic;             // Whether this offset changes at runtime
         OffsetType type;            // Category of this offset
+        bool isRegistered = true;   // False once removed (the handle stays reserved)
         
         OffsetEntry(const std::string& n, uintptr_t val, OffsetType t = OffsetType::CUSTOM, bool dynamic = false)
             : name(n), staticValue(val), dynamicAdjustment(0), isDynamic(dynamic), type(t) {}
     };
 
+    // Binary offset file: magic, version, ModuleBuildId, count, then {name, value, type, isDynamic} per entry
+    static constexpr uint32_t OFFSET_FILE_MAGIC = 0x464F4C54;  // "TLOF"
+    static constexpr uint32_t OFFSET_FILE_VERSION = 1;
+
+    // Handle to a compiled pointer chain
+    using ChainHandle = size_t;
+    static constexpr ChainHandle INVALID_CHAIN = static_cast<ChainHandle>(-1);
+
 private:
-    std::unordered_map<std::string, OffsetEntry> m_offsets;
+    // Pointer chain compiled to integer offsets with its cached resolution
+    struct CompiledChain {
+        uintptr_t startAddress;
+        std::vector<uintptr_t> offsets;  // Resolved once from offset names
+        uintptr_t resolvedAddress = 0;   // Cached final address (0 = not resolved)
+        uintptr_t lastPointerAddress = 0; // Where the last dereferenced pointer lives
+        uintptr_t lastPointerValue = 0;   // Value of that pointer when resolved
+        uint64_t validatedGeneration = 0; // Memory generation of the last validation
+    };
+
+    // Flat offset table indexed by OffsetId; names are only used to find the handle
+    std::vector<OffsetEntry> m_offsets;
+    std::unordered_map<std::string, OffsetId> m_offsetIds;
+    std::vector<CompiledChain> m_chains;
+    uint64_t m_revision = 0;         // Bumped on every change to an offset value
     const Memory* m_memory;
     uintptr_t m_gameBaseAddress;
     
     // Initialize default offsets
     void initializeDefaultOffsets();
+    
+    // Register or overwrite an entry, keeping the handle of an existing name
+    OffsetId registerEntry(const std::string& name, uintptr_t offset, OffsetType type, bool isDynamic);
+    
+    // Entry for a handle, or nullptr if the handle is invalid or removed
+    const OffsetEntry* findEntry(OffsetId id) const {
+        if (id.index >= m_offsets.size() || !m_offsets[id.index].isRegistered) {
+            return nullptr;
+        }
+        return &m_offsets[id.index];
+    }
+    
+    // Walk a compiled chain hop by hop and refresh its cache
+    uintptr_t walkPointerChain(CompiledChain& chain) const;
 
 public:
     explicit OffsetManager(const Memory* memory);
@@ -48,16 +121,23 @@ public:
     // ============ BASIC OFFSET OPERATIONS ============
     
     /**
-     * Register a static offset
-     * Example: registerOffset("player_health", 0x10, OffsetType::PLAYER);
+     * Register a static offset and get its handle
+     * Re-registering an existing name updates it in place and keeps the same handle
+     * Example: auto healthId = registerOffset("player_health", 0x10, OffsetType::PLAYER);
      */
-    void registerOffset(const std::string& name, uintptr_t offset, OffsetType type = OffsetType::CUSTOM);
+    OffsetId registerOffset(const std::string& name, uintptr_t offset, OffsetType type = OffsetType::CUSTOM);
     
     /**
      * Register a dynamic offset that can change at runtime
      * Example: registerDynamicOffset("inventory_slot", 0x100, OffsetType::INVENTORY);
      */
-    void registerDynamicOffset(const std::string& name, uintptr_t baseOffset, OffsetType type = OffsetType::CUSTOM);
+    OffsetId registerDynamicOffset(const std::string& name, uintptr_t baseOffset, OffsetType type = OffsetType::CUSTOM);
+    
+    /**
+     * Look up the handle of a named offset (do this once, not per tick)
+     * Returns an invalid OffsetId if the name is not registered
+     */
+    OffsetId getOffsetId(const std::string& name) const;
     
     /**
      * Get the final calculated offset value
@@ -65,11 +145,31 @@ public:
      */
     uintptr_t getOffset(const std::string& name) const;
     
+    /**
+     * Get the final offset value by handle (indexed load, no hashing)
+     */
+    uintptr_t getOffset(OffsetId id) const {
+        const OffsetEntry* entry = findEntry(id);
+        return entry ? entry->staticValue + entry->dynamicAdjustment : 0;
+    }
+    
+    /**
+     * Check if a handle refers to a registered offset
+     */
+    bool hasOffset(OffsetId id) const { return findEntry(id) != nullptr; }
+    
+    /**
+     * Changes whenever an offset is registered, updated, loaded or removed
+     * Callers that cache resolved offsets compare it once per tick instead of re-reading the table
+     */
+    uint64_t getRevision() const { return m_revision; }
+    
     /**
      * Update dynamic adjustment for an offset
      * Example: updateDynamicOffset("inventory_slot", slotIndex * 0x8);
      */
     void updateDynamicOffset(const std::string& name, uintptr_t adjustment);
+    void updateDynamicOffset(OffsetId id, uintptr_t adjustment);
     
     // ============ ADDRESS CALCULATION HELPERS ============
     
@@ -80,6 +180,12 @@ public:
      */
     uintptr_t calculateAddress(uintptr_t baseAddress, const std::string& offsetName) const;
     
+    /**
+     * Calculate final memory address by handle
+     * Example: calculateAddress(playerBase, BuiltinOffset::PLAYER_HEALTH)
+     */
+    uintptr_t calculateAddress(uintptr_t baseAddress, OffsetId id) const { return baseAddress + getOffset(id); }
+    
     /**
      * Calculate address with manual offset
      * Formula: final_address = base_address + offset
@@ -92,6 +198,9 @@ public:
      * Example: calculateArrayAddress(inventoryBase, 5, 0x8, "item_data") for 6th item
      */
     uintptr_t calculateArrayAddress(uintptr_t baseAddress, size_t index, size_t elementSize, const std::string& offsetName) const;
+    uintptr_t calculateArrayAddress(uintptr_t baseAddress, size_t index, size_t elementSize, OffsetId id) const {
+        return baseAddress + (index * elementSize) + getOffset(id);
+    }
     
     // ============ MULTI-LEVEL POINTER CHAINS ============
     
@@ -102,6 +211,38 @@ public:
      */
     uintptr_t calculatePointerChain(uintptr_t startAddress, const std::vector<std::string>& offsetChain) const;
     
+    /**
+     * Compile a pointer chain into a handle (offset names are resolved once)
+     * Example: auto chain = compilePointerChain(gameBase, {"player_ptr", "stats_ptr", "health"});
+     * Note: recompile the chain if any of its offsets are changed afterwards
+     * Compiling an identical chain again returns the existing handle; still, keep
+     * the handle instead of compiling per tick
+     */
+    ChainHandle compilePointerChain(uintptr_t startAddress, const std::vector<std::string>& offsetChain);
+    
+    /**
+     * Compile a pointer chain from raw offsets
+     */
+    ChainHandle compilePointerChain(uintptr_t startAddress, const std::vector<uintptr_t>& offsets);
+    
+    /**
+     * Resolve a compiled chain using the cached result
+     * Once per memory generation (tick) only the last hop's parent pointer is re-read;
+     * the full chain is walked again only if that pointer changed
+     * Returns 0 if the chain could not be resolved
+     */
+    uintptr_t resolvePointerChain(ChainHandle chain);
+    
+    /**
+     * Drop the cached resolution of every compiled chain (e.g. after a map change)
+     */
+    void invalidatePointerChains();
+    
+    /**
+     * Remove all compiled chains (invalidates existing handles)
+     */
+    void clearPointerChains() { m_chains.clear(); }
+    
     // ============ UTILITY METHODS ============
     
     /**
@@ -125,19 +266,23 @@ public:
     void removeOffset(const std::string& name);
     
     /**
-     * Clear all offsets
+     * Clear all offsets (handles stay reserved and are reused if the names are registered again)
      */
     void clearOffsets();
     
     /**
-     * Load offsets from configuration file
+     * Load offsets from a binary offset file
+     * Entries are registered by name, so existing handles keep pointing at them.
+     * @param buildId If valid, the file is rejected unless it was saved for this module build
+     * @return false if the file is missing, corrupt or belongs to another build (nothing is changed)
      */
-    bool loadOffsetsFromFile(const std::string& filename);
+    bool loadOffsetsFromFile(const std::string& filename, const ModuleBuildId& buildId = {});
     
     /**
-     * Save current offsets to configuration file
+     * Save all registered offsets to a binary offset file
+     * @param buildId Module build the offsets belong to (stored in the file header)
      */
-    bool saveOffsetsToFile(const std::string& filename) const;
+    bool saveOffsetsToFile(const std::string& filename, const ModuleBuildId& buildId = {}) const;
     
     // ============ DEBUG AND VALIDATION ============
     
@@ -0,0 +1,525 @@
+#include "PathFinder.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    constexpr float DIAGONAL_COST = 1.41421356f;
+
+    struct Direction {
+        int32_t dx, dy;
+        float cost;
+    };
+
+    constexpr Direction DIRECTIONS[8] = {
+        { 1,  0, 1.0f}, {-1,  0, 1.0f}, { 0,  1, 1.0f}, { 0, -1, 1.0f},
+        { 1,  1, DIAGONAL_COST}, { 1, -1, DIAGONAL_COST}, {-1,  1, DIAGONAL_COST}, {-1, -1, DIAGONAL_COST}
+    };
+
+    inline int32_t sign(int32_t value) {
+        return (value > 0) - (value < 0);
+    }
+
+    // Bresenham from "from" (exclusive) to "to" (inclusive); fn(x, y, diagonal, stepX, stepY) per cell
+    template<typename Fn>
+    bool walkLine(PathFinder::Cell from, PathFinder::Cell to, Fn&& fn) {
+        int32_t dx = std::abs(to.x - from.x);
+        int32_t dy = -std::abs(to.y - from.y);
+        int32_t sx = sign(to.x - from.x);
+        int32_t sy = sign(to.y - from.y);
+        int32_t error = dx + dy;
+        int32_t x = from.x;
+        int32_t y = from.y;
+
+        while (x != to.x || y != to.y) {
+            int32_t doubled = 2 * error;
+            bool stepX = doubled >= dy;
+            bool stepY = doubled <= dx;
+            if (stepX) {
+                error += dy;
+                x += sx;
+            }
+            if (stepY) {
+                error += dx;
+                y += sy;
+            }
+            if (!fn(x, y, stepX && stepY, sx, sy)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+PathFinder::PathFinder(int32_t width, int32_t height) {
+    resize(width, height);
+}
+
+void PathFinder::resize(int32_t width, int32_t height) {
+    m_width = std::max(width, 0);
+    m_height = std::max(height, 0);
+
+    size_t cells = static_cast<size_t>(m_width) * m_height;
+    m_walkable.assign(cells, 1);
+    m_nodes.assign(cells, Node());
+    m_generation = 0;
+    ++m_gridVersion;
+
+    // Lazy deletion can push a node more than once; the grid size is a good
+    // starting capacity and the heap keeps whatever it grows to
+    m_open.clear();
+    m_open.reserve(cells);
+}
+
+void PathFinder::fillWalkable(bool walkable) {
+    std::fill(m_walkable.begin(), m_walkable.end(), walkable ? 1 : 0);
+    ++m_gridVersion;
+}
+
+bool PathFinder::isLineClear(Cell a, Cell b) const {
+    if (!isWalkable(a.x, a.y)) {
+        return false;
+    }
+    return walkLine(a, b, [this](int32_t x, int32_t y, bool diagonal, int32_t sx, int32_t sy) {
+        if (diagonal && (!isWalkable(x - sx, y) || !isWalkable(x, y - sy))) {
+            return false;
+        }
+        return isWalkable(x, y);
+    });
+}
+
+void PathFinder::setPathCache(size_t entries, int quantizeShift) {
+    m_cache.clear();
+    m_cache.resize(entries);
+    m_cacheIndex.clear();
+    m_cacheIndex.reserve(entries);
+    m_cacheShift = std::max(0, std::min(quantizeShift, 15));
+    clearPathCache();
+}
+
+void PathFinder::clearPathCache() {
+    m_cacheIndex.clear();
+    m_cacheHead = NO_PARENT;
+    m_cacheTail = NO_PARENT;
+
+    // Chain every slot into the LRU list; unused slots have a stale version and get recycled first
+    for (uint32_t i = 0; i < m_cache.size(); ++i) {
+        CacheEntry& entry = m_cache[i];
+        entry.key = 0;
+        entry.gridVersion = ~uint64_t{0};
+        entry.path.clear();
+        entry.prev = i == 0 ? NO_PARENT : i - 1;
+        entry.next = i + 1 < m_cache.size() ? i + 1 : NO_PARENT;
+    }
+    if (!m_cache.empty()) {
+        m_cacheHead = 0;
+        m_cacheTail = static_cast<uint32_t>(m_cache.size() - 1);
+    }
+}
+
+PathFinder::Result PathFinder::findPath(Cell start, Cell goal, std::vector<Cell>& path) {
+    path.clear();
+    ++m_stats.searches;
+    m_stats.lastExpandedNodes = 0;
+
+    if (!isWalkable(start.x, start.y) || !isWalkable(goal.x, goal.y)) {
+        ++m_stats.failedSearches;
+        return Result::INVALID;
+    }
+    if (start == goal) {
+        path.push_back(start);
+        return Result::FOUND;
+    }
+
+    if (!m_cache.empty()) {
+        if (lookupCache(start, goal, path)) {
+            ++m_stats.cacheHits;
+            return Result::FOUND;
+        }
+        ++m_stats.cacheMisses;
+    }
+
+    Result result = search(start, goal, path);
+    if (result == Result::FOUND && !m_cache.empty()) {
+        storeCache(start, goal, path);
+    }
+    return result;
+}
+
+PathFinder::Result PathFinder::search(Cell start, Cell goal, std::vector<Cell>& path) {
+    nextGeneration();
+    m_open.clear();
+
+    uint32_t startNode = index(start.x, start.y);
+    uint32_t goalNode = index(goal.x, goal.y);
+
+    Node& first = m_nodes[startNode];
+    first.g = 0;
+    first.parent = NO_PARENT;
+    first.visited = m_generation;
+    float startH = heuristic(goal.x - start.x, goal.y - start.y);
+    pushOpen(0, startH, startNode);
+
+    uint32_t closestNode = startNode;
+    float closestH = startH;
+    size_t expanded = 0;
+    bool budgetExhausted = false;
+
+    while (!m_open.empty()) {
+        OpenEntry entry = popOpen();
+        Node& node = m_nodes[entry.node];
+        if (node.closed == m_generation) {
+            continue; // Stale entry, the node was already expanded via a cheaper one
+        }
+        node.closed = m_generation;
+
+        if (entry.node == goalNode) {
+            m_stats.lastExpandedNodes = expanded;
+            m_stats.expandedNodes += expanded;
+            buildPath(goalNode, path);
+            return Result::FOUND;
+        }
+
+        if (entry.h < closestH) {
+            closestH = entry.h;
+            closestNode = entry.node;
+        }
+
+        ++expanded;
+        if (m_maxExpansions != 0 && expanded >= m_maxExpansions) {
+            budgetExhausted = true;
+            break;
+        }
+
+        int32_t x = static_cast<int32_t>(entry.node % static_cast<uint32_t>(m_width));
+        int32_t y = static_cast<int32_t>(entry.node / static_cast<uint32_t>(m_width));
+        if (m_jumpPointSearch) {
+            expandJumpPoints(entry.node, x, y, goal);
+        } else {
+            expandNeighbors(entry.node, x, y, goal);
+        }
+    }
+
+    m_stats.lastExpandedNodes = expanded;
+    m_stats.expandedNodes += expanded;
+
+    if (budgetExhausted) {
+        ++m_stats.partialPaths;
+        buildPath(closestNode, path);
+        return Result::PARTIAL;
+    }
+
+    ++m_stats.failedSearches;
+    return Result::NO_PATH;
+}
+
+void PathFinder::expandNeighbors(uint32_t node, int32_t x, int32_t y, Cell goal) {
+    for (const Direction& direction : DIRECTIONS) {
+        int32_t nx = x + direction.dx;
+        int32_t ny = y + direction.dy;
+        if (!isWalkable(nx, ny)) {
+            continue;
+        }
+        if (direction.dx != 0 && direction.dy != 0 &&
+            (!isWalkable(x + direction.dx, y) || !isWalkable(x, y + direction.dy))) {
+            continue; // No corner cutting
+        }
+        relax(node, nx, ny, direction.cost, goal);
+    }
+}
+
+void PathFinder::expandJumpPoints(uint32_t node, int32_t x, int32_t y, Cell goal) {
+    // Directions worth jumping in, pruned by the direction we arrived from
+    int32_t directions[8][2];
+    int count = 0;
+    auto add = [&](int32_t dx, int32_t dy) {
+        directions[count][0] = dx;
+        directions[count][1] = dy;
+        ++count;
+    };
+
+    uint32_t parent = m_nodes[node].parent;
+    if (parent == NO_PARENT) {
+        for (const Direction& direction : DIRECTIONS) {
+            if (direction.dx != 0 && direction.dy != 0 &&
+                (!isWalkable(x + direction.dx, y) || !isWalkable(x, y + direction.dy))) {
+                continue;
+            }
+            add(direction.dx, direction.dy);
+        }
+    } else {
+        int32_t dx = sign(x - static_cast<int32_t>(parent % static_cast<uint32_t>(m_width)));
+        int32_t dy = sign(y - static_cast<int32_t>(parent / static_cast<uint32_t>(m_width)));
+
+        if (dx != 0 && dy != 0) {
+            // Without corner cutting a diagonal move has no forced neighbours
+            bool horizontal = isWalkable(x + dx, y);
+            bool vertical = isWalkable(x, y + dy);
+            if (vertical) add(0, dy);
+            if (horizontal) add(dx, 0);
+            if (horizontal && vertical) add(dx, dy);
+        } else if (dx != 0) {
+            bool next = isWalkable(x + dx, y);
+            bool up = isWalkable(x, y + 1);
+            bool down = isWalkable(x, y - 1);
+            if (next) {
+                add(dx, 0);
+                if (up) add(dx, 1);
+                if (down) add(dx, -1);
+            }
+            if (up) add(0, 1);
+            if (down) add(0, -1);
+        } else {
+            bool next = isWalkable(x, y + dy);
+            bool right = isWalkable(x + 1, y);
+            bool left = isWalkable(x - 1, y);
+            if (next) {
+                add(0, dy);
+                if (right) add(1, dy);
+                if (left) add(-1, dy);
+            }
+            if (right) add(1, 0);
+            if (left) add(-1, 0);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        int32_t dx = directions[i][0];
+        int32_t dy = directions[i][1];
+        uint32_t jumpPoint = jump(x + dx, y + dy, dx, dy, goal);
+        if (jumpPoint == NO_PARENT) {
+            continue;
+        }
+
+        int32_t jx = static_cast<int32_t>(jumpPoint % static_cast<uint32_t>(m_width));
+        int32_t jy = static_cast<int32_t>(jumpPoint / static_cast<uint32_t>(m_width));
+        relax(node, jx, jy, heuristic(jx - x, jy - y), goal);
+    }
+}
+
+uint32_t PathFinder::jump(int32_t x, int32_t y, int32_t dx, int32_t dy, Cell goal) const {
+    for (;;) {
+        if (!isWalkable(x, y)) {
+            return NO_PARENT;
+        }
+        if (x == goal.x && y == goal.y) {
+            return index(x, y);
+        }
+
+        if (dx != 0 && dy != 0) {
+            // A diagonal run stops wherever one of its straight components finds a jump point
+            if (jump(x + dx, y, dx, 0, goal) != NO_PARENT || jump(x, y + dy, 0, dy, goal) != NO_PARENT) {
+                return index(x, y);
+            }
+            if (!isWalkable(x + dx, y) || !isWalkable(x, y + dy)) {
+                return NO_PARENT;
+            }
+        } else if (dx != 0) {
+            // A side opening the previous cell did not have is a forced neighbour
+            if ((isWalkable(x, y + 1) && !isWalkable(x - dx, y + 1)) ||
+                (isWalkable(x, y - 1) && !isWalkable(x - dx, y - 1))) {
+                return index(x, y);
+            }
+        } else {
+            if ((isWalkable(x + 1, y) && !isWalkable(x + 1, y - dy)) ||
+                (isWalkable(x - 1, y) && !isWalkable(x - 1, y - dy))) {
+                return index(x, y);
+            }
+        }
+
+        x += dx;
+        y += dy;
+    }
+}
+
+void PathFinder::relax(uint32_t from, int32_t x, int32_t y, float cost, Cell goal) {
+    uint32_t target = index(x, y);
+    Node& neighbor = m_nodes[target];
+    if (neighbor.closed == m_generation) {
+        return;
+    }
+
+    float g = m_nodes[from].g + cost;
+    if (neighbor.visited != m_generation || g < neighbor.g) {
+        neighbor.g = g;
+        neighbor.parent = from;
+        neighbor.visited = m_generation;
+        pushOpen(g, heuristic(goal.x - x, goal.y - y), target);
+    }
+}
+
+void PathFinder::nextGeneration() {
+    if (++m_generation == 0) {
+        // Wrapped around: old stamps could now match, so clear them once
+        for (Node& node : m_nodes) {
+            node.visited = 0;
+            node.closed = 0;
+        }
+        m_generation = 1;
+    }
+}
+
+void PathFinder::pushOpen(float g, float h, uint32_t node) {
+    m_open.push_back({g + h, h, node});
+
+    // Sift up
+    size_t child = m_open.size() - 1;
+    OpenEntry value = m_open[child];
+    while (child > 0) {
+        size_t parent = (child - 1) / 2;
+        const OpenEntry& above = m_open[parent];
+        if (above.f < value.f || (above.f == value.f && above.h <= value.h)) {
+            break;
+        }
+        m_open[child] = above;
+        child = parent;
+    }
+    m_open[child] = value;
+}
+
+PathFinder::OpenEntry PathFinder::popOpen() {
+    OpenEntry top = m_open.front();
+    OpenEntry value = m_open.back();
+    m_open.pop_back();
+
+    size_t size = m_open.size();
+    if (size == 0) {
+        return top;
+    }
+
+    // Sift the former last entry down from the root
+    size_t parent = 0;
+    for (;;) {
+        size_t child = parent * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size) {
+            const OpenEntry& left = m_open[child];
+            const OpenEntry& right = m_open[child + 1];
+            if (right.f < left.f || (right.f == left.f && right.h < left.h)) {
+                ++child;
+            }
+        }
+        const OpenEntry& below = m_open[child];
+        if (value.f < below.f || (value.f == below.f && value.h <= below.h)) {
+            break;
+        }
+        m_open[parent] = below;
+        parent = child;
+    }
+    m_open[parent] = value;
+    return top;
+}
+
+void PathFinder::buildPath(uint32_t end, std::vector<Cell>& path) {
+    m_waypoints.clear();
+    for (uint32_t node = end; node != NO_PARENT; node = m_nodes[node].parent) {
+        m_waypoints.push_back(node);
+    }
+
+    // Jump points are joined by straight or diagonal runs; fill in the cells between them
+    auto toCell = [this](uint32_t node) {
+        return Cell(static_cast<int32_t>(node % static_cast<uint32_t>(m_width)),
+                    static_cast<int32_t>(node / static_cast<uint32_t>(m_width)));
+    };
+    Cell previous = toCell(m_waypoints.back());
+    path.push_back(previous);
+    for (size_t i = m_waypoints.size() - 1; i-- > 0;) {
+        Cell next = toCell(m_waypoints[i]);
+        appendLine(previous, next, path);
+        previous = next;
+    }
+}
+
+void PathFinder::appendLine(Cell from, Cell to, std::vector<Cell>& path) {
+    walkLine(from, to, [&path](int32_t x, int32_t y, bool, int32_t, int32_t) {
+        path.emplace_back(x, y);
+        return true;
+    });
+}
+
+uint64_t PathFinder::cacheKey(Cell start, Cell goal) const {
+    auto quantize = [this](int32_t value) {
+        return static_cast<uint64_t>(static_cast<uint16_t>(value >> m_cacheShift));
+    };
+    return (quantize(start.x) << 48) | (quantize(start.y) << 32) | (quantize(goal.x) << 16) | quantize(goal.y);
+}
+
+bool PathFinder::lookupCache(Cell start, Cell goal, std::vector<Cell>& path) {
+    auto it = m_cacheIndex.find(cacheKey(start, goal));
+    if (it == m_cacheIndex.end()) {
+        return false;
+    }
+
+    CacheEntry& entry = m_cache[it->second];
+    if (entry.gridVersion != m_gridVersion) {
+        return false; // The grid changed since; the slot is overwritten on store
+    }
+
+    // Nearby endpoints reuse the route if they can walk straight onto it
+    if ((start != entry.start && !isLineClear(start, entry.start)) ||
+        (goal != entry.goal && !isLineClear(entry.goal, goal))) {
+        return false;
+    }
+
+    path.push_back(start);
+    appendLine(start, entry.start, path);
+    path.insert(path.end(), entry.path.begin() + 1, entry.path.end());
+    appendLine(entry.goal, goal, path);
+
+    touchCache(it->second);
+    return true;
+}
+
+void PathFinder::storeCache(Cell start, Cell goal, const std::vector<Cell>& path) {
+    uint64_t key = cacheKey(start, goal);
+
+    uint32_t slot;
+    auto it = m_cacheIndex.find(key);
+    if (it != m_cacheIndex.end()) {
+        slot = it->second;
+    } else {
+        // Recycle the least recently used slot
+        slot = m_cacheTail;
+        CacheEntry& victim = m_cache[slot];
+        auto victimIt = m_cacheIndex.find(victim.key);
+        if (victimIt != m_cacheIndex.end() && victimIt->second == slot) {
+            m_cacheIndex.erase(victimIt);
+        }
+        m_cacheIndex.emplace(key, slot);
+    }
+
+    CacheEntry& entry = m_cache[slot];
+    entry.key = key;
+    entry.gridVersion = m_gridVersion;
+    entry.start = start;
+    entry.goal = goal;
+    entry.path.assign(path.begin(), path.end());
+    touchCache(slot);
+}
+
+void PathFinder::touchCache(uint32_t slot) {
+    if (slot == m_cacheHead) {
+        return;
+    }
+
+    CacheEntry& entry = m_cache[slot];
+    // Unlink
+    if (entry.prev != NO_PARENT) m_cache[entry.prev].next = entry.next;
+    if (entry.next != NO_PARENT) m_cache[entry.next].prev = entry.prev;
+    if (slot == m_cacheTail) m_cacheTail = entry.prev;
+
+    // Push front
+    entry.prev = NO_PARENT;
+    entry.next = m_cacheHead;
+    m_cache[m_cacheHead].prev = slot;
+    m_cacheHead = slot;
+}
+
+float PathFinder::heuristic(int32_t dx, int32_t dy) {
+    // Octile distance: diagonal steps for the shorter axis, straight for the rest
+    int32_t ax = std::abs(dx);
+    int32_t ay = std::abs(dy);
+    int32_t diagonal = std::min(ax, ay);
+    return static_cast<float>(ax + ay) + (DIAGONAL_COST - 2.0f) * diagonal;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+
+/**
+ * @class PathFinder
+ * @brief Allocation-free A* / Jump Point Search over a flat walkability grid
+ *
+ * The grid is one byte per cell in row-major order. Search state lives in a
+ * node arena indexed by cell and reused across calls: instead of clearing it,
+ * every search bumps a generation counter and a node only counts as visited
+ * or closed if its stamp matches the current generation. The open list is a
+ * binary heap of (f, node) entries with lazy deletion - a node improved after
+ * being pushed is simply pushed again and the stale entry is skipped when it
+ * surfaces. Once the arena and heap have grown to the grid size, findPath()
+ * does not allocate.
+ *
+ * Movement is 8-connected with an octile heuristic; diagonals may not cut past
+ * a blocked orthogonal neighbour. Because every step has a uniform cost, Jump
+ * Point Search (on by default) can skip the symmetric runs of open cells and
+ * only push the cells where the path may turn; it returns the same path
+ * length as plain A* with far fewer heap operations on open maps.
+ *
+ * Completed paths go into a small LRU cache keyed by start and goal quantized
+ * to cache cells. A hit whose exact endpoints differ is stitched onto the
+ * request with straight lines, provided those are clear. Any change to the
+ * grid bumps a version number, which invalidates every entry at once.
+ */
+class PathFinder {
+public:
+    struct Cell {
+        int32_t x = 0, y = 0;
+
+        Cell() = default;
+        Cell(int32_t x, int32_t y) : x(x), y(y) {}
+
+        bool operator==(const Cell& other) const { return x == other.x && y == other.y; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    enum class Result {
+        FOUND,             // Path reaches the goal
+        PARTIAL,           // Expansion budget ran out; path leads to the closest cell reached
+        NO_PATH,           // Goal is unreachable from start
+        INVALID            // Start or goal outside the grid or blocked
+    };
+
+    struct Statistics {
+        uint64_t searches = 0;
+        uint64_t expandedNodes = 0;        // Summed over all searches
+        uint64_t partialPaths = 0;
+        uint64_t failedSearches = 0;       // NO_PATH or INVALID
+        uint64_t cacheHits = 0;
+        uint64_t cacheMisses = 0;
+        size_t lastExpandedNodes = 0;
+    };
+
+private:
+    static constexpr uint32_t NO_PARENT = 0xFFFFFFFFu;
+
+    struct Node {
+        float g = 0;
+        uint32_t parent = NO_PARENT;
+        uint32_t visited = 0;      // Generation in which g/parent were set
+        uint32_t closed = 0;       // Generation in which the node was expanded
+    };
+
+    struct OpenEntry {
+        float f;
+        float h;                   // Tie-break towards the goal on equal f
+        uint32_t node;
+    };
+
+    struct CacheEntry {
+        uint64_t key = 0;
+        uint64_t gridVersion = 0;
+        Cell start, goal;
+        std::vector<Cell> path;
+        uint32_t prev = NO_PARENT; // LRU list, most recent at m_cacheHead
+        uint32_t next = NO_PARENT;
+    };
+
+    int32_t m_width = 0;
+    int32_t m_height = 0;
+    std::vector<uint8_t> m_walkable;       // 1 = walkable, row-major
+
+    std::vector<Node> m_nodes;
+    std::vector<OpenEntry> m_open;         // Binary min-heap on (f, h)
+    uint32_t m_generation = 0;
+    uint64_t m_gridVersion = 0;            // Bumped on every walkability change
+    std::vector<uint32_t> m_waypoints;     // Reused by buildPath()
+
+    size_t m_maxExpansions = 0;            // 0 = unlimited
+    bool m_jumpPointSearch = true;
+    Statistics m_stats;
+
+    // Path cache
+    std::vector<CacheEntry> m_cache;
+    std::unordered_map<uint64_t, uint32_t> m_cacheIndex;
+    uint32_t m_cacheHead = NO_PARENT;
+    uint32_t m_cacheTail = NO_PARENT;
+    int m_cacheShift = 2;                  // Cache cell = 2^shift grid cells per side
+
+public:
+    PathFinder() = default;
+    PathFinder(int32_t width, int32_t height);
+
+    /**
+     * @brief Resize the grid; every cell becomes walkable
+     */
+    void resize(int32_t width, int32_t height);
+
+    int32_t getWidth() const { return m_width; }
+    int32_t getHeight() const { return m_height; }
+
+    bool isValid(int32_t x, int32_t y) const { return x >= 0 && y >= 0 && x < m_width && y < m_height; }
+    bool isWalkable(int32_t x, int32_t y) const {
+        return isValid(x, y) && m_walkable[static_cast<size_t>(y) * m_width + x] != 0;
+    }
+    void setWalkable(int32_t x, int32_t y, bool walkable) {
+        if (!isValid(x, y)) return;
+        uint8_t& cell = m_walkable[static_cast<size_t>(y) * m_width + x];
+        uint8_t value = walkable ? 1 : 0;
+        if (cell != value) {
+            cell = value;
+            ++m_gridVersion;
+        }
+    }
+    void fillWalkable(bool walkable);
+    uint64_t getGridVersion() const { return m_gridVersion; }
+
+    /**
+     * @brief Whether a straight line of cells from a to b is walkable (no corner cutting)
+     */
+    bool isLineClear(Cell a, Cell b) const;
+
+    /**
+     * @brief Cap the nodes one search may expand (0 = unlimited)
+     *
+     * An exhausted search returns PARTIAL with a path to the expanded cell
+     * closest to the goal, so the caller can start moving and search again
+     * from there on a later tick instead of stalling this one.
+     */
+    void setMaxExpansions(size_t maxExpansions) { m_maxExpansions = maxExpansions; }
+    size_t getMaxExpansions() const { return m_maxExpansions; }
+
+    /**
+     * @brief Use Jump Point Search (default) or expand every neighbour like plain A*
+     * @note With JPS the expansion budget counts jump points, not cells
+     */
+    void setJumpPointSearch(bool enabled) { m_jumpPointSearch = enabled; }
+    bool getJumpPointSearch() const { return m_jumpPointSearch; }
+
+    /**
+     * @brief Size the path cache (0 = off); existing entries are dropped
+     * @param quantizeShift Start and goal share an entry when they agree after >> shift
+     */
+    void setPathCache(size_t entries, int quantizeShift = 2);
+    void clearPathCache();
+
+    /**
+     * @brief Find a path from start to goal
+     * @param path Receives the cells from start to the end of the path (inclusive);
+     *             cleared first, capacity is kept so callers can reuse it
+     */
+    Result findPath(Cell start, Cell goal, std::vector<Cell>& path);
+
+    const Statistics& getStatistics() const { return m_stats; }
+    void resetStatistics() { m_stats = Statistics(); }
+
+private:
+    uint32_t index(int32_t x, int32_t y) const { return static_cast<uint32_t>(y) * m_width + x; }
+
+    Result search(Cell start, Cell goal, std::vector<Cell>& path);
+    void expandNeighbors(uint32_t node, int32_t x, int32_t y, Cell goal);
+    void expandJumpPoints(uint32_t node, int32_t x, int32_t y, Cell goal);
+    uint32_t jump(int32_t x, int32_t y, int32_t dx, int32_t dy, Cell goal) const;
+    void relax(uint32_t from, int32_t x, int32_t y, float cost, Cell goal);
+
+    void nextGeneration();
+    void pushOpen(float g, float h, uint32_t node);
+    OpenEntry popOpen();
+    void buildPath(uint32_t end, std::vector<Cell>& path);
+    static void appendLine(Cell from, Cell to, std::vector<Cell>& path);
+
+    uint64_t cacheKey(Cell start, Cell goal) const;
+    bool lookupCache(Cell start, Cell goal, std::vector<Cell>& path);
+    void storeCache(Cell start, Cell goal, const std::vector<Cell>& path);
+    void touchCache(uint32_t entry);
+
+    static float heuristic(int32_t dx, int32_t dy);
+};
@@ -0,0 +1,512 @@
+#include "PatternScanner.h"
+#include "Memory.h"
+#include "SignatureCache.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <emmintrin.h>
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define PATTERN_SCANNER_AVX2
+#else
+#define PATTERN_SCANNER_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+    // Bytes that show up everywhere in x64 code; poor choices for the prefilter
+    bool isCommonByte(uint8_t value) {
+        switch (value) {
+            case 0x00: case 0xFF: case 0xCC: case 0x90:
+            case 0x48: case 0x49: case 0x4C: case 0x8B:
+            case 0x89: case 0x0F: case 0xE8: case 0x24:
+                return true;
+            default:
+                return false;
+        }
+    }
+    
+    inline unsigned countTrailingZeros(uint32_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, value);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(value));
+#endif
+    }
+    
+    bool detectAvx2() {
+#if defined(_MSC_VER)
+        int registers[4];
+        __cpuid(registers, 1);
+        bool osxsave = (registers[2] & (1 << 27)) != 0;
+        if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+            return false; // OS does not save YMM state
+        }
+        __cpuidex(registers, 7, 0);
+        return (registers[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+    
+    const bool s_hasAvx2 = detectAvx2();
+    
+    // Returns the first start position that was not tested
+    template<typename Check>
+    PATTERN_SCANNER_AVX2
+    size_t prefilterAvx2(const uint8_t* first, const uint8_t* second, uint8_t firstValue, uint8_t secondValue,
+                         size_t begin, size_t end, Check& check) {
+        const __m256i firstNeedle = _mm256_set1_epi8(static_cast<char>(firstValue));
+        const __m256i secondNeedle = _mm256_set1_epi8(static_cast<char>(secondValue));
+        
+        size_t pos = begin;
+        for (; pos + 32 <= end; pos += 32) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + pos));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + pos));
+            uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpeq_epi8(a, firstNeedle), _mm256_cmpeq_epi8(b, secondNeedle))));
+            
+            while (bits) {
+                if (check(pos + countTrailingZeros(bits))) {
+                    return end;
+                }
+                bits &= bits - 1;
+            }
+        }
+        return pos;
+    }
+    
+    template<typename Check>
+    size_t prefilterSse2(const uint8_t* first, const uint8_t* second, uint8_t firstValue, uint8_t secondValue,
+                         size_t begin, size_t end, Check& check) {
+        const __m128i firstNeedle = _mm_set1_epi8(static_cast<char>(firstValue));
+        const __m128i secondNeedle = _mm_set1_epi8(static_cast<char>(secondValue));
+        
+        size_t pos = begin;
+        for (; pos + 16 <= end; pos += 16) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + pos));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + pos));
+            uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(a, firstNeedle), _mm_cmpeq_epi8(b, secondNeedle))));
+            
+            while (bits) {
+                if (check(pos + countTrailingZeros(bits))) {
+                    return end;
+                }
+                bits &= bits - 1;
+            }
+        }
+        return pos;
+    }
+}
+
+PatternScanner::PatternScanner(const Memory* memory) 
+    : m_memory(memory), m_threadCount(std::max(1u, std::thread::hardware_concurrency())) {
+    if (!memory) {
+        throw std::invalid_argument("Memory pointer cannot be null");
+    }
+}
+
+void PatternScanner::setModule(uintptr_t moduleBase, size_t moduleSize) {
+    releaseModule();
+    m_moduleBase = moduleBase;
+    m_moduleSize = moduleSize;
+}
+
+bool PatternScanner::mapModule(uintptr_t moduleBase, size_t moduleSize) {
+    setModule(moduleBase, moduleSize);
+    return mapModule();
+}
+
+bool PatternScanner::mapModule() {
+    releaseModule();
+    
+    uintptr_t moduleBase = m_moduleBase;
+    size_t moduleSize = m_moduleSize;
+    if (moduleBase == 0 || moduleSize == 0) {
+        return false;
+    }
+    
+    m_moduleImage.assign(moduleSize, 0);
+    
+    size_t bytesRead = 0;
+    for (size_t offset = 0; offset < moduleSize; offset += READ_CHUNK_SIZE) {
+        size_t chunk = std::min(READ_CHUNK_SIZE, moduleSize - offset);
+        
+        if (m_memory->readMemory(moduleBase + offset, m_moduleImage.data() + offset, chunk)) {
+            bytesRead += chunk;
+            continue;
+        }
+        
+        // Part of the chunk is unreadable (e.g. guard pages); salvage it page by page
+        for (size_t page = 0; page < chunk; page += Memory::PAGE_SIZE) {
+            size_t pageSize = std::min(Memory::PAGE_SIZE, chunk - page);
+            uint8_t* destination = m_moduleImage.data() + offset + page;
+            
+            if (m_memory->readMemory(moduleBase + offset + page, destination, pageSize)) {
+                bytesRead += pageSize;
+            } else {
+                std::memset(destination, 0, pageSize);
+            }
+        }
+    }
+    
+    if (bytesRead == 0) {
+        releaseModule();
+        return false;
+    }
+    
+    return true;
+}
+
+void PatternScanner::releaseModule() {
+    // Base and size are kept so cached locations can still be rebased
+    m_moduleImage.clear();
+    m_moduleImage.shrink_to_fit();
+}
+
+uintptr_t PatternScanner::findPattern(const Pattern& pattern) const {
+    return findPatterns({pattern}).front();
+}
+
+uintptr_t PatternScanner::findPattern(const std::string& signature) const {
+    try {
+        return findPattern(parsePattern(signature));
+    }
+    catch (const std::invalid_argument&) {
+        return 0;
+    }
+}
+
+std::vector<uintptr_t> PatternScanner::findPatterns(const std::vector<Pattern>& patterns) const {
+    std::vector<uintptr_t> addresses(patterns.size(), 0);
+    if (!isModuleMapped() || patterns.empty()) {
+        return addresses;
+    }
+    
+    auto startTime = std::chrono::steady_clock::now();
+    
+    // Lowest match offset per pattern; slices past it are skipped
+    constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+    std::vector<std::atomic<size_t>> best(patterns.size());
+    for (auto& value : best) {
+        value.store(NOT_FOUND);
+    }
+    
+    forEachSlice(m_moduleImage.size(), [&](size_t sliceBegin, size_t sliceEnd) {
+        std::vector<size_t> matches;
+        
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            const Pattern& pattern = patterns[i];
+            if (!pattern.isValid() || pattern.size() > m_moduleImage.size()) {
+                continue;
+            }
+            
+            size_t lastStart = m_moduleImage.size() - pattern.size() + 1;
+            size_t end = std::min(sliceEnd, lastStart);
+            if (sliceBegin >= end || sliceBegin >= best[i].load(std::memory_order_relaxed)) {
+                continue;
+            }
+            
+            matches.clear();
+            scanRange(pattern, sliceBegin, end, matches, 1);
+            if (matches.empty()) {
+                continue;
+            }
+            
+            // Keep the lowest offset found by any worker
+            size_t current = best[i].load();
+            while (matches.front() < current && !best[i].compare_exchange_weak(current, matches.front())) {
+            }
+        }
+    });
+    
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        size_t offset = best[i].load();
+        if (offset != NOT_FOUND) {
+            addresses[i] = m_moduleBase + offset;
+        }
+    }
+    
+    m_lastScanTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return addresses;
+}
+
+std::vector<uintptr_t> PatternScanner::findAllMatches(const Pattern& pattern, size_t maxResults) const {
+    std::vector<uintptr_t> addresses;
+    if (!isModuleMapped() || !pattern.isValid() || pattern.size() > m_moduleImage.size() || maxResults == 0) {
+        return addresses;
+    }
+    
+    auto startTime = std::chrono::steady_clock::now();
+    
+    std::mutex resultsMutex;
+    std::vector<size_t> offsets;
+    size_t lastStart = m_moduleImage.size() - pattern.size() + 1;
+    
+    forEachSlice(lastStart, [&](size_t sliceBegin, size_t sliceEnd) {
+        std::vector<size_t> matches;
+        scanRange(pattern, sliceBegin, sliceEnd, matches, maxResults);
+        
+        if (!matches.empty()) {
+            std::lock_guard<std::mutex> lock(resultsMutex);
+            offsets.insert(offsets.end(), matches.begin(), matches.end());
+        }
+    });
+    
+    std::sort(offsets.begin(), offsets.end());
+    if (offsets.size() > maxResults) {
+        offsets.resize(maxResults);
+    }
+    
+    addresses.reserve(offsets.size());
+    for (size_t offset : offsets) {
+        addresses.push_back(m_moduleBase + offset);
+    }
+    
+    m_lastScanTimeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+    return addresses;
+}
+
+std::vector<uintptr_t> PatternScanner::resolveSignatures(const std::vector<Signature>& signatures) {
+    std::vector<uintptr_t> addresses(signatures.size(), 0);
+    std::vector<size_t> misses;
+    m_lastScanTimeMs = 0.0; // Stays 0 when everything comes from the cache
+    
+    // Cached locations only need a validation read
+    for (size_t i = 0; i < signatures.size(); ++i) {
+        uint64_t moduleOffset = 0;
+        if (m_cache && m_cache->lookup(signatures[i].name, signatures[i].pattern, moduleOffset) &&
+            validateLocation(m_moduleBase + moduleOffset)) {
+            addresses[i] = m_moduleBase + moduleOffset;
+        } else {
+            misses.push_back(i);
+        }
+    }
+    
+    // Scan for the rest in one pass, copying the module on first use
+    if (!misses.empty() && (isModuleMapped() || mapModule())) {
+        std::vector<Pattern> patterns;
+        patterns.reserve(misses.size());
+        
+        for (size_t index : misses) {
+            try {
+                patterns.push_back(parsePattern(signatures[index].pattern, signatures[index].name));
+            }
+            catch (const std::invalid_argument&) {
+                patterns.emplace_back(); // Invalid patterns are skipped by findPatterns
+            }
+        }
+        
+        std::vector<uintptr_t> matches = findPatterns(patterns);
+        
+        for (size_t i = 0; i < misses.size(); ++i) {
+            const Signature& signature = signatures[misses[i]];
+            uintptr_t location = matches[i];
+            
+            if (location != 0 && signature.displacementOffset != 0) {
+                location = resolveRelativeAddress(location, signature.displacementOffset, 
+                                                  signature.instructionLength);
+            }
+            
+            // Cached as module offsets, so targets in other mappings (a RIP-relative hop
+            // out of the module) are returned but not cached rather than stored wrapped
+            bool inModule = location >= m_moduleBase && location - m_moduleBase < m_moduleSize;
+            if (location != 0 && inModule && m_cache) {
+                m_cache->store(signature.name, signature.pattern, location - m_moduleBase);
+            }
+            addresses[misses[i]] = location;
+        }
+    }
+    
+    for (size_t i = 0; i < signatures.size(); ++i) {
+        if (signatures[i].dereference && addresses[i] != 0) {
+            try {
+                addresses[i] = m_memory->read<uintptr_t>(addresses[i]);
+            }
+            catch (const std::exception&) {
+                addresses[i] = 0;
+            }
+        }
+    }
+    
+    return addresses;
+}
+
+bool PatternScanner::validateLocation(uintptr_t location) const {
+    return location >= m_moduleBase && location + sizeof(uintptr_t) <= m_moduleBase + m_moduleSize &&
+           m_memory->isValidAddress(location, sizeof(uintptr_t));
+}
+
+uintptr_t PatternScanner::resolveRelativeAddress(uintptr_t instructionAddress, size_t displacementOffset,
+                                                 size_t instructionLength) const {
+    if (instructionAddress < m_moduleBase) {
+        return 0;
+    }
+    
+    size_t offset = instructionAddress - m_moduleBase + displacementOffset;
+    if (offset + sizeof(int32_t) > m_moduleImage.size()) {
+        return 0;
+    }
+    
+    int32_t displacement;
+    std::memcpy(&displacement, m_moduleImage.data() + offset, sizeof(displacement));
+    
+    // Formula: target = next_instruction + disp32
+    return instructionAddress + instructionLength + static_cast<intptr_t>(displacement);
+}
+
+PatternScanner::Pattern PatternScanner::parsePattern(const std::string& signature, const std::string& name) {
+    Pattern pattern;
+    pattern.name = name;
+    
+    std::istringstream stream(signature);
+    std::string token;
+    
+    while (stream >> token) {
+        if (token == "?" || token == "??") {
+            pattern.bytes.push_back(0);
+            pattern.mask.push_back(0);
+            continue;
+        }
+        
+        if (token.size() != 2 || !std::isxdigit(static_cast<unsigned char>(token[0])) ||
+            !std::isxdigit(static_cast<unsigned char>(token[1]))) {
+            throw std::invalid_argument("Invalid pattern token '" + token + "' in: " + signature);
+        }
+        
+        pattern.bytes.push_back(static_cast<uint8_t>(std::stoul(token, nullptr, 16)));
+        pattern.mask.push_back(1);
+    }
+    
+    // Anchor: first fixed byte that is not a very common opcode byte
+    bool hasFixedByte = false;
+    for (size_t i = 0; i < pattern.bytes.size(); ++i) {
+        if (!pattern.mask[i]) {
+            continue;
+        }
+        if (!hasFixedByte) {
+            pattern.anchorIndex = i;
+            hasFixedByte = true;
+        }
+        if (!isCommonByte(pattern.bytes[i])) {
+            pattern.anchorIndex = i;
+            break;
+        }
+    }
+    
+    if (!hasFixedByte) {
+        throw std::invalid_argument("Pattern has no fixed bytes: " + signature);
+    }
+    
+    // Second prefilter byte: last fixed byte other than the anchor, preferring rare ones
+    pattern.secondIndex = pattern.anchorIndex;
+    for (size_t i = pattern.bytes.size(); i-- > 0;) {
+        if (!pattern.mask[i] || i == pattern.anchorIndex) {
+            continue;
+        }
+        if (pattern.secondIndex == pattern.anchorIndex) {
+            pattern.secondIndex = i;
+        }
+        if (!isCommonByte(pattern.bytes[i])) {
+            pattern.secondIndex = i;
+            break;
+        }
+    }
+    
+    return pattern;
+}
+
+void PatternScanner::scanRange(const Pattern& pattern, size_t begin, size_t end,
+                               std::vector<size_t>& results, size_t maxResults) const {
+    const uint8_t* data = m_moduleImage.data();
+    
+    auto check = [&](size_t start) {
+        if (matchesAt(pattern, start)) {
+            results.push_back(start);
+            return results.size() >= maxResults;
+        }
+        return false;
+    };
+    
+    // The prefilter compares the two chosen bytes for a whole vector of start positions;
+    // only positions where both match get the full masked comparison
+    const uint8_t* first = data + pattern.anchorIndex;
+    const uint8_t* second = data + pattern.secondIndex;
+    uint8_t firstValue = pattern.bytes[pattern.anchorIndex];
+    uint8_t secondValue = pattern.bytes[pattern.secondIndex];
+    
+    size_t pos = begin;
+    if (s_hasAvx2) {
+        pos = prefilterAvx2(first, second, firstValue, secondValue, pos, end, check);
+    }
+    pos = prefilterSse2(first, second, firstValue, secondValue, pos, end, check);
+    
+    // Scalar tail
+    for (; pos < end; ++pos) {
+        if (first[pos] == firstValue && second[pos] == secondValue && check(pos)) {
+            return;
+        }
+    }
+}
+
+bool PatternScanner::matchesAt(const Pattern& pattern, size_t offset) const {
+    const uint8_t* data = m_moduleImage.data() + offset;
+    
+    for (size_t i = 0; i < pattern.bytes.size(); ++i) {
+        if (pattern.mask[i] && data[i] != pattern.bytes[i]) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+template<typename Fn>
+void PatternScanner::forEachSlice(size_t lastStart, Fn&& fn) const {
+    size_t sliceCount = (lastStart + SCAN_SLICE_SIZE - 1) / SCAN_SLICE_SIZE;
+    if (sliceCount == 0) {
+        return;
+    }
+    
+    // Workers pull slices from a shared counter, so uneven slices balance out.
+    // Scans only run during address discovery, so threads are created per scan.
+    std::atomic<size_t> nextSlice{0};
+    auto worker = [&]() {
+        for (;;) {
+            size_t slice = nextSlice.fetch_add(1);
+            if (slice >= sliceCount) {
+                break;
+            }
+            
+            size_t sliceBegin = slice * SCAN_SLICE_SIZE;
+            size_t sliceEnd = std::min(sliceBegin + SCAN_SLICE_SIZE, lastStart);
+            fn(sliceBegin, sliceEnd);
+        }
+    };
+    
+    size_t threadCount = std::min(m_threadCount, sliceCount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
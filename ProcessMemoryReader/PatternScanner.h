@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// Forward declaration
+class Memory;
+class SignatureCache;
+
+/**
+ * @class PatternScanner
+ * @brief Finds IDA-style byte signatures in a module of the target process
+ *
+ * The module image is copied into local memory with large chunked reads once,
+ * then searched by a pool of worker threads. Each worker takes 1 MB slices and
+ * uses an SSE2/AVX2 prefilter on two fixed bytes of the pattern before
+ * verifying the full masked pattern, so only a handful of positions per slice
+ * are compared byte by byte. Several patterns can be resolved in one pass.
+ */
+class PatternScanner {
+public:
+    /**
+     * @brief A parsed signature: bytes plus a mask of the positions that must match
+     */
+    struct Pattern {
+        std::string name;
+        std::vector<uint8_t> bytes;
+        std::vector<uint8_t> mask;  ///< 1 = byte must match, 0 = wildcard
+        size_t anchorIndex = 0;     ///< First prefilter byte
+        size_t secondIndex = 0;     ///< Second prefilter byte (may equal anchorIndex)
+
+        size_t size() const { return bytes.size(); }
+        bool isValid() const { return !bytes.empty() && mask[anchorIndex] != 0; }
+    };
+
+    /**
+     * @brief Static description of a signature and how to turn a match into an address
+     *
+     * For RIP-relative instructions (e.g. "48 8B 05 ? ? ? ?" = mov rax, [rip+disp32])
+     * set displacementOffset to the position of the disp32 and instructionLength to the
+     * instruction size; the resolved address is then match + instructionLength + disp32.
+     */
+    struct Signature {
+        const char* name;
+        const char* pattern;        ///< IDA-style pattern, e.g. "48 8B 05 ? ? ? ? 48 85 C0"
+        size_t displacementOffset;  ///< Offset of the rel32 inside the match (0 = use the match address)
+        size_t instructionLength;   ///< Length of the instruction holding the rel32
+        bool dereference;           ///< Read a pointer at the resolved address
+    };
+
+private:
+    const Memory* m_memory;
+
+    // Local copy of the scanned module
+    std::vector<uint8_t> m_moduleImage;
+    uintptr_t m_moduleBase = 0;
+    size_t m_moduleSize = 0;
+    
+    SignatureCache* m_cache = nullptr;
+
+    size_t m_threadCount;
+    mutable double m_lastScanTimeMs = 0.0;
+
+    static constexpr size_t READ_CHUNK_SIZE = 1024 * 1024;   ///< Bytes per ReadProcessMemory while mapping
+    static constexpr size_t SCAN_SLICE_SIZE = 1024 * 1024;   ///< Bytes per worker task while scanning
+
+public:
+    /**
+     * @brief Constructor
+     * @param memory Memory instance used to copy the module image
+     * @throws std::invalid_argument if memory is null
+     */
+    explicit PatternScanner(const Memory* memory);
+
+    /**
+     * @brief Select the module to scan without copying it yet
+     *
+     * resolveSignatures() copies the module on the first signature that is not
+     * served from the cache, so a fully cached launch never reads the image.
+     */
+    void setModule(uintptr_t moduleBase, size_t moduleSize);
+
+    /**
+     * @brief Copy a module image from the target process into local memory
+     * @param moduleBase Base address of the module
+     * @param moduleSize Size of the module image in bytes
+     * @return true if at least part of the module could be read
+     * @note Unreadable pages are zero-filled so offsets stay aligned with the module
+     */
+    bool mapModule(uintptr_t moduleBase, size_t moduleSize);
+    bool mapModule();
+
+    /**
+     * @brief Release the local module copy (call once address discovery is done)
+     */
+    void releaseModule();
+
+    bool isModuleMapped() const { return !m_moduleImage.empty(); }
+    uintptr_t getModuleBase() const { return m_moduleBase; }
+    size_t getModuleSize() const { return m_moduleSize; }
+    const std::vector<uint8_t>& getModuleImage() const { return m_moduleImage; }
+
+    /**
+     * @brief Find the first match of a pattern
+     * @return Remote address of the match, or 0 if not found
+     */
+    uintptr_t findPattern(const Pattern& pattern) const;
+    uintptr_t findPattern(const std::string& signature) const;
+
+    /**
+     * @brief Find the first match of several patterns in a single pass over the module
+     * @return Remote match addresses in the order of the input (0 = not found)
+     */
+    std::vector<uintptr_t> findPatterns(const std::vector<Pattern>& patterns) const;
+
+    /**
+     * @brief Find every match of a pattern (sorted by address)
+     * @param maxResults Stop collecting after this many matches
+     */
+    std::vector<uintptr_t> findAllMatches(const Pattern& pattern, size_t maxResults = 64) const;
+
+    /**
+     * @brief Resolve signatures to addresses in a single scan pass
+     *
+     * Signatures found in the attached cache are validated with a read and used
+     * directly; only the remaining ones are scanned, and their locations are
+     * stored back into the cache.
+     * @return Resolved addresses in the order of the input (0 = not found / unresolvable)
+     */
+    std::vector<uintptr_t> resolveSignatures(const std::vector<Signature>& signatures);
+
+    /**
+     * @brief Attach a cache of signature locations (may be null)
+     */
+    void setSignatureCache(SignatureCache* cache) { m_cache = cache; }
+
+    /**
+     * @brief Resolve a RIP-relative operand inside the mapped module
+     * @param instructionAddress Remote address of the instruction
+     * @param displacementOffset Offset of the disp32 within the instruction
+     * @param instructionLength Length of the instruction
+     * @return Target address, or 0 if the instruction lies outside the mapped module
+     */
+    uintptr_t resolveRelativeAddress(uintptr_t instructionAddress, size_t displacementOffset,
+                                     size_t instructionLength) const;
+
+    /**
+     * @brief Parse an IDA-style signature ("48 8B ? ? 89" - '?' or '??' are wildcards)
+     * @throws std::invalid_argument if the signature is malformed or has no fixed bytes
+     */
+    static Pattern parsePattern(const std::string& signature, const std::string& name = "");
+
+    void setThreadCount(size_t count) { m_threadCount = count > 0 ? count : 1; }
+    size_t getThreadCount() const { return m_threadCount; }
+    double getLastScanTimeMs() const { return m_lastScanTimeMs; }
+
+private:
+    /**
+     * @brief Scan candidate start positions [begin, end) of the image for a pattern
+     * @param results Receives match offsets; scanning stops after maxResults matches
+     */
+    void scanRange(const Pattern& pattern, size_t begin, size_t end,
+                   std::vector<size_t>& results, size_t maxResults) const;
+
+    bool matchesAt(const Pattern& pattern, size_t offset) const;
+
+    /**
+     * @brief Check that a cached location lies in the module and is readable
+     */
+    bool validateLocation(uintptr_t location) const;
+
+    /**
+     * @brief Run fn(sliceBegin, sliceEnd) for every slice of the module across the worker pool
+     */
+    template<typename Fn>
+    void forEachSlice(size_t lastStart, Fn&& fn) const;
+};
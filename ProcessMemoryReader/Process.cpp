@@ -1,6 +1,7 @@
 #include "Process.h"
 #include <TlHelp32.h>
 #include <Psapi.h>
+#include <algorithm>
 #include <stdexcept>
 
 Process::Process() : m_processHandle(nullptr), m_processId(0) {}
@@ -47,6 +48,30 @@ bool Process::attachToProcess(const std::string& processName) {
         return false;
     }
     
+    if (!attachToProcessId(processId)) {
+        return false;
+    }
+    
+    m_processName = processName;
+    return true;
+}
+
+bool Process::attachToProcess(const std::vector<std::string>& processNames) {
+    detach();
+    
+    std::string processName;
+    DWORD processId = findProcessId(processNames, processName);
+    if (processId == 0 || !attachToProcessId(processId)) {
+        return false;
+    }
+    
+    m_processName = processName;
+    return true;
+}
+
+bool Process::attachToProcessId(DWORD processId) {
+    detach();
+    
     // Open the process with required permissions
     HANDLE processHandle = OpenProcess(
         PROCESS_VM_READ | PROCESS_QUERY_INFORMATION,
@@ -61,7 +86,7 @@ bool Process::attachToProcess(const std::string& processName) {
     // Store the process information
     m_processHandle = processHandle;
     m_processId = processId;
-    m_processName = processName;
+    m_processName = std::to_string(processId);
     
     return true;
 }
@@ -71,29 +96,50 @@ void Process::detach() {
 }
 
 uintptr_t Process::getModuleBaseAddress(const std::string& moduleName) const {
-    if (!isAttached()) {
-        return 0;
+    return reinterpret_cast<uintptr_t>(findModule(moduleName));
+}
+
+bool Process::getModuleInfo(const std::string& moduleName, uintptr_t& baseAddress, size_t& moduleSize) const {
+    HMODULE module = findModule(moduleName);
+    if (module == nullptr) {
+        return false;
     }
     
-    HMODULE modules[1024];
-    DWORD bytesNeeded;
+    MODULEINFO moduleInfo;
+    if (!GetModuleInformation(m_processHandle, module, &moduleInfo, sizeof(moduleInfo))) {
+        return false;
+    }
     
-    if (!EnumProcessModules(m_processHandle, modules, sizeof(modules), &bytesNeeded)) {
-        return 0;
+    baseAddress = reinterpret_cast<uintptr_t>(moduleInfo.lpBaseOfDll);
+    moduleSize = moduleInfo.SizeOfImage;
+    return true;
+}
+
+bool Process::getModuleBuildId(const std::string& moduleName, ModuleBuildId& buildId) const {
+    uintptr_t baseAddress = getModuleBaseAddress(moduleName);
+    if (baseAddress == 0) {
+        return false;
     }
     
-    DWORD moduleCount = bytesNeeded / sizeof(HMODULE);
+    // Only the headers are needed: two small reads instead of touching the image
+    IMAGE_DOS_HEADER dosHeader;
+    if (!ReadProcessMemory(m_processHandle, reinterpret_cast<LPCVOID>(baseAddress), 
+                           &dosHeader, sizeof(dosHeader), nullptr) ||
+        dosHeader.e_magic != IMAGE_DOS_SIGNATURE) {
+        return false;
+    }
     
-    for (DWORD i = 0; i < moduleCount; i++) {
-        char moduleNameBuffer[MAX_PATH];
-        if (GetModuleBaseNameA(m_processHandle, modules[i], moduleNameBuffer, sizeof(moduleNameBuffer))) {
-            if (std::string(moduleNameBuffer) == moduleName) {
-                return reinterpret_cast<uintptr_t>(modules[i]);
-            }
-        }
+    IMAGE_NT_HEADERS64 ntHeaders;
+    if (!ReadProcessMemory(m_processHandle, reinterpret_cast<LPCVOID>(baseAddress + dosHeader.e_lfanew),
+                           &ntHeaders, sizeof(ntHeaders), nullptr) ||
+        ntHeaders.Signature != IMAGE_NT_SIGNATURE) {
+        return false;
     }
     
-    return 0;
+    buildId.timeDateStamp = ntHeaders.FileHeader.TimeDateStamp;
+    buildId.sizeOfImage = ntHeaders.OptionalHeader.SizeOfImage;
+    buildId.checksum = ntHeaders.OptionalHeader.CheckSum;
+    return buildId.isValid();
 }
 
 bool Process::isAttached() const {
@@ -123,6 +169,11 @@ const std::string& Process::getProcessName() const {
 }
 
 DWORD Process::findProcessId(const std::string& processName) const {
+    std::string matchedName;
+    return findProcessId(std::vector<std::string>{processName}, matchedName);
+}
+
+DWORD Process::findProcessId(const std::vector<std::string>& processNames, std::string& matchedName) const {
     HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
     if (snapshot == INVALID_HANDLE_VALUE) {
         return 0;
@@ -133,7 +184,9 @@ DWORD Process::findProcessId(const std::string& processName) const {
     
     if (Process32First(snapshot, &processEntry)) {
         do {
-            if (std::string(processEntry.szExeFile) == processName) {
+            auto name = std::find(processNames.begin(), processNames.end(), processEntry.szExeFile);
+            if (name != processNames.end()) {
+                matchedName = *name;
                 CloseHandle(snapshot);
                 return processEntry.th32ProcessID;
             }
@@ -144,6 +197,32 @@ DWORD Process::findProcessId(const std::string& processName) const {
     return 0;
 }
 
+HMODULE Process::findModule(const std::string& moduleName) const {
+    if (!isAttached()) {
+        return nullptr;
+    }
+    
+    HMODULE modules[1024];
+    DWORD bytesNeeded;
+    
+    if (!EnumProcessModules(m_processHandle, modules, sizeof(modules), &bytesNeeded)) {
+        return nullptr;
+    }
+    
+    DWORD moduleCount = bytesNeeded / sizeof(HMODULE);
+    
+    for (DWORD i = 0; i < moduleCount; i++) {
+        char moduleNameBuffer[MAX_PATH];
+        if (GetModuleBaseNameA(m_processHandle, modules[i], moduleNameBuffer, sizeof(moduleNameBuffer))) {
+            if (std::string(moduleNameBuffer) == moduleName) {
+                return modules[i];
+            }
+        }
+    }
+    
+    return nullptr;
+}
+
 void Process::cleanup() {
     if (m_processHandle != nullptr) {
         CloseHandle(m_processHandle);
@@ -5,6 +5,7 @@
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include "ModuleBuildId.h"
 
 /**
  * @class Process
@@ -53,6 +54,20 @@ public:
      */
     bool attachToProcess(const std::string& processName);
 
+    /**
+     * @brief Attach to the first running process matching any of the names
+     * @param processNames Candidate names; the process list is walked once for all of them
+     * @return true if successfully attached, false otherwise
+     */
+    bool attachToProcess(const std::vector<std::string>& processNames);
+
+    /**
+     * @brief Attach to a process by id (e.g. GetCurrentProcessId() for an in-process target)
+     * @param processId The id of the process to attach to
+     * @return true if successfully attached, false otherwise
+     */
+    bool attachToProcessId(DWORD processId);
+
     /**
      * @brief Detach from the current process and close handle
      */
@@ -65,6 +80,23 @@ public:
      */
     uintptr_t getModuleBaseAddress(const std::string& moduleName) const;
 
+    /**
+     * @brief Get the base address and image size of a module within the process
+     * @param moduleName The name of the module (e.g., "client.dll")
+     * @param baseAddress Receives the module base address
+     * @param moduleSize Receives the size of the module image in bytes
+     * @return true if the module was found, false otherwise
+     */
+    bool getModuleInfo(const std::string& moduleName, uintptr_t& baseAddress, size_t& moduleSize) const;
+
+    /**
+     * @brief Read the build identity of a module from its PE header
+     * @param moduleName The name of the module (e.g., "client.dll")
+     * @param buildId Receives the timestamp, image size and checksum
+     * @return true if the header could be read and looks like a PE image, false otherwise
+     */
+    bool getModuleBuildId(const std::string& moduleName, ModuleBuildId& buildId) const;
+
     /**
      * @brief Check if the process is currently attached and valid
      * @return true if attached to a valid process, false otherwise
@@ -97,6 +129,21 @@ private:
      */
     DWORD findProcessId(const std::string& processName) const;
 
+    /**
+     * @brief Find a process ID by any of several names in one process list walk
+     * @param processNames The names to look for
+     * @param matchedName Receives the name that matched
+     * @return The process ID, or 0 if none was found
+     */
+    DWORD findProcessId(const std::vector<std::string>& processNames, std::string& matchedName) const;
+
+    /**
+     * @brief Find a loaded module handle by name
+     * @param moduleName The name of the module to find
+     * @return The module handle, or nullptr if not found
+     */
+    HMODULE findModule(const std::string& moduleName) const;
+
     /**
      * @brief Clean up resources and reset to invalid state
      */
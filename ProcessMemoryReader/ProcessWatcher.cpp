@@ -0,0 +1,93 @@
+#include "ProcessWatcher.h"
+#include "Process.h"
+#include <algorithm>
+#include <utility>
+
+ProcessWatcher::ProcessWatcher(std::vector<std::string> processNames)
+    : m_processNames(std::move(processNames)) {
+    m_stopEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    m_cancelEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+}
+
+ProcessWatcher::~ProcessWatcher() {
+    unwatch();
+    if (m_stopEvent) {
+        CloseHandle(m_stopEvent);
+    }
+    if (m_cancelEvent) {
+        CloseHandle(m_cancelEvent);
+    }
+}
+
+void ProcessWatcher::setScanInterval(std::chrono::milliseconds interval) {
+    m_scanInterval = std::max(interval, std::chrono::milliseconds(1));
+}
+
+bool ProcessWatcher::watch(const Process& process) {
+    unwatch();
+    if (!m_stopEvent || !process.isAttached()) {
+        return false;
+    }
+
+    // Our own handle: the process object may detach while the thread still waits
+    m_watchedProcess = OpenProcess(SYNCHRONIZE, FALSE, process.getProcessId());
+    if (!m_watchedProcess) {
+        return false;
+    }
+
+    m_exited.store(false, std::memory_order_release);
+    ResetEvent(m_stopEvent);
+    m_thread = std::thread(&ProcessWatcher::watchLoop, this);
+    return true;
+}
+
+void ProcessWatcher::unwatch() {
+    if (m_thread.joinable()) {
+        SetEvent(m_stopEvent);
+        m_thread.join();
+    }
+    if (m_watchedProcess) {
+        CloseHandle(m_watchedProcess);
+        m_watchedProcess = nullptr;
+    }
+}
+
+bool ProcessWatcher::waitForStart(Process& process, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (true) {
+        if (process.attachToProcess(m_processNames)) {
+            return true;
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0 || !wait(std::min(m_scanInterval, remaining))) {
+            return false;
+        }
+    }
+}
+
+bool ProcessWatcher::wait(std::chrono::milliseconds duration) {
+    if (!m_cancelEvent) {
+        std::this_thread::sleep_for(duration);
+        return true;
+    }
+    return WaitForSingleObject(m_cancelEvent, static_cast<DWORD>(duration.count())) != WAIT_OBJECT_0;
+}
+
+void ProcessWatcher::cancel() {
+    if (m_cancelEvent) {
+        SetEvent(m_cancelEvent);
+    }
+}
+
+void ProcessWatcher::watchLoop() {
+    HANDLE handles[2] = {m_watchedProcess, m_stopEvent};
+    if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) == WAIT_OBJECT_0 + 1) {
+        return;  // unwatch()
+    }
+
+    // Exited, or the wait itself failed: either way the handle can no longer be trusted
+    m_exited.store(true, std::memory_order_release);
+}
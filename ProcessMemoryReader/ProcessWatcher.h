@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Windows.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Process;
+
+/**
+ * @class ProcessWatcher
+ * @brief Notices the game client exiting and restarting without polling on the decision loop
+ *
+ * watch() parks a thread on the process handle, so an exit is known the moment
+ * it happens and hasExited() is a flag read instead of a system call per tick.
+ * waitForStart() then looks for any of the client's process names with one
+ * process list walk per scan interval until the client is back.
+ */
+class ProcessWatcher {
+private:
+    std::vector<std::string> m_processNames;
+    std::chrono::milliseconds m_scanInterval{250};
+
+    HANDLE m_watchedProcess = nullptr;  // SYNCHRONIZE-only handle of our own
+    HANDLE m_stopEvent = nullptr;       // Releases the watch thread
+    HANDLE m_cancelEvent = nullptr;     // Wakes waitForStart()/wait() early
+    std::thread m_thread;
+    std::atomic<bool> m_exited{false};
+
+public:
+    /**
+     * @param processNames Executable names the client may run as
+     */
+    explicit ProcessWatcher(std::vector<std::string> processNames);
+    ~ProcessWatcher();
+
+    ProcessWatcher(const ProcessWatcher&) = delete;
+    ProcessWatcher& operator=(const ProcessWatcher&) = delete;
+
+    const std::vector<std::string>& getProcessNames() const { return m_processNames; }
+    void setScanInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds getScanInterval() const { return m_scanInterval; }
+
+    /**
+     * @brief Start waiting for process to exit
+     * @return false if the process could not be opened for waiting (use Process::isAttached instead)
+     */
+    bool watch(const Process& process);
+    void unwatch();
+    bool isWatching() const { return m_watchedProcess != nullptr; }
+
+    // Set by the watch thread when the watched process exited
+    bool hasExited() const { return m_exited.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Attach process to the client as soon as it is running
+     * @param timeout Longest time to wait
+     * @return true once attached; false on timeout or cancel()
+     */
+    bool waitForStart(Process& process, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Sleep that cancel() cuts short
+     * @return false if cancelled
+     */
+    bool wait(std::chrono::milliseconds duration);
+
+    /**
+     * @brief Wake the next or current waitForStart()/wait() (e.g. when the bot stops)
+     */
+    void cancel();
+
+private:
+    void watchLoop();
+};
@@ -0,0 +1,254 @@
+#include "Profiler.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    inline int mostSignificantBit(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return static_cast<int>(index);
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    void appendEscaped(std::string& out, const std::string& text) {
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+    }
+}
+
+Profiler::Profiler(size_t traceCapacity)
+    : m_zones(new Zone[MAX_ZONES]), m_epoch(Clock::now()), m_traceRing(traceCapacity) {
+}
+
+Profiler::~Profiler() {
+    stopTrace();
+}
+
+Profiler::ZoneId Profiler::addZone(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_registerMutex);
+
+    size_t count = m_zoneCount.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; ++i) {
+        if (m_zones[i].name == name) {
+            return static_cast<ZoneId>(i);
+        }
+    }
+
+    if (count >= MAX_ZONES) {
+        return INVALID_ZONE;
+    }
+
+    m_zones[count].name = name;
+    m_zoneCount.store(count + 1, std::memory_order_release);
+    return static_cast<ZoneId>(count);
+}
+
+void Profiler::record(ZoneId zone, Clock::time_point start, Clock::time_point end) {
+    if (zone >= m_zoneCount.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    uint64_t ns = elapsed > 0 ? static_cast<uint64_t>(elapsed) : 0;
+
+    Zone& entry = m_zones[zone];
+    entry.count.fetch_add(1, std::memory_order_relaxed);
+    entry.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    entry.buckets[bucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t previousMax = entry.maxNs.load(std::memory_order_relaxed);
+    while (ns > previousMax && !entry.maxNs.compare_exchange_weak(previousMax, ns, std::memory_order_relaxed)) {
+    }
+
+    if (m_tracing.load(std::memory_order_relaxed)) {
+        bool pushed = m_traceRing.tryPush([&](TraceEvent& event) {
+            event.zone = zone;
+            event.thread = currentThreadTag();
+            event.startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - m_epoch).count();
+            event.durationUs = static_cast<int64_t>(ns / 1000);
+        });
+        if (!pushed) {
+            m_traceDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool Profiler::startTrace(const std::string& path) {
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+
+    if (m_traceStream.is_open()) {
+        m_traceStream << "\n]\n";
+        m_traceStream.close();
+    }
+
+    m_traceStream.open(path, std::ios::trunc);
+    if (!m_traceStream.is_open()) {
+        m_tracing = false;
+        return false;
+    }
+
+    m_traceStream << "[\n";
+    m_traceHasEvents = false;
+    m_tracing = true;
+    return true;
+}
+
+void Profiler::stopTrace() {
+    if (!m_traceStream.is_open()) {
+        return;
+    }
+
+    m_tracing = false;
+    flushTrace();
+
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    m_traceStream << "\n]\n";
+    m_traceStream.close();
+}
+
+void Profiler::flushTrace() {
+    std::lock_guard<std::mutex> lock(m_traceMutex);
+    if (!m_traceStream.is_open()) {
+        return;
+    }
+
+    // The closing bracket is optional in the JSON array format, so a trace cut
+    // short by a crash still loads up to the last flush
+    std::string out;
+    size_t zoneCount = m_zoneCount.load(std::memory_order_acquire);
+    while (m_traceRing.tryPop([&](const TraceEvent& event) {
+        if (m_traceHasEvents) {
+            out += ",\n";
+        }
+        m_traceHasEvents = true;
+
+        out += "{\"name\":\"";
+        if (event.zone < zoneCount) {
+            appendEscaped(out, m_zones[event.zone].name);
+        }
+        out += "\",\"ph\":\"X\",\"pid\":1,\"tid\":" + std::to_string(event.thread) +
+               ",\"ts\":" + std::to_string(event.startUs) +
+               ",\"dur\":" + std::to_string(event.durationUs) + "}";
+    })) {
+    }
+
+    m_traceStream << out;
+    m_traceStream.flush();
+}
+
+Profiler::Statistics Profiler::getStatistics() const {
+    Statistics stats;
+
+    size_t zoneCount = m_zoneCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < zoneCount; ++i) {
+        const Zone& zone = m_zones[i];
+        uint64_t count = zone.count.load(std::memory_order_relaxed);
+        if (count == 0) {
+            continue;
+        }
+
+        ZoneStatistics zoneStats;
+        zoneStats.name = zone.name;
+        zoneStats.count = count;
+        zoneStats.averageMs = zone.totalNs.load(std::memory_order_relaxed) / 1e6 / count;
+        zoneStats.p50Ms = percentile(zone, count, 0.50) / 1e6;
+        zoneStats.p99Ms = percentile(zone, count, 0.99) / 1e6;
+        zoneStats.maxMs = zone.maxNs.load(std::memory_order_relaxed) / 1e6;
+        stats.zones.push_back(std::move(zoneStats));
+    }
+
+    for (size_t i = 0; i < stats.counters.size(); ++i) {
+        stats.counters[i] = m_counters[i].load(std::memory_order_relaxed);
+    }
+    stats.traceEventsDropped = m_traceDropped.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+void Profiler::reset() {
+    size_t zoneCount = m_zoneCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < zoneCount; ++i) {
+        Zone& zone = m_zones[i];
+        zone.count.store(0, std::memory_order_relaxed);
+        zone.totalNs.store(0, std::memory_order_relaxed);
+        zone.maxNs.store(0, std::memory_order_relaxed);
+        for (auto& bucket : zone.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    for (auto& counter : m_counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    m_traceDropped.store(0, std::memory_order_relaxed);
+}
+
+const char* Profiler::counterName(Counter counter) {
+    switch (counter) {
+        case Counter::READ_CALLS: return "read_calls";
+        case Counter::BYTES_READ: return "bytes_read";
+        case Counter::FAILED_READS: return "failed_reads";
+        case Counter::PAGE_CACHE_HITS: return "page_cache_hits";
+        case Counter::PAGE_CACHE_MISSES: return "page_cache_misses";
+        default: return "unknown";
+    }
+}
+
+int Profiler::bucketIndex(uint64_t ns) {
+    if (ns < SUB_BUCKETS) {
+        return static_cast<int>(ns);
+    }
+
+    int exponent = mostSignificantBit(ns);
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+
+    int subBucket = static_cast<int>((ns >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket;
+}
+
+uint64_t Profiler::bucketValue(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<uint64_t>(index);
+    }
+
+    // Midpoint of the bucket's range
+    int exponent = index / SUB_BUCKETS - 1 + SUB_BUCKET_BITS;
+    int subBucket = index % SUB_BUCKETS;
+    uint64_t width = uint64_t{1} << (exponent - SUB_BUCKET_BITS);
+    return (static_cast<uint64_t>(SUB_BUCKETS + subBucket) << (exponent - SUB_BUCKET_BITS)) + width / 2;
+}
+
+uint64_t Profiler::percentile(const Zone& zone, uint64_t count, double fraction) {
+    uint64_t rank = static_cast<uint64_t>(fraction * count);
+    if (rank >= count) {
+        rank = count - 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += zone.buckets[i].load(std::memory_order_relaxed);
+        if (seen > rank) {
+            // The midpoint can overshoot the true maximum in the top bucket
+            return std::min(bucketValue(i), zone.maxNs.load(std::memory_order_relaxed));
+        }
+    }
+    return zone.maxNs.load(std::memory_order_relaxed);
+}
+
+uint32_t Profiler::currentThreadTag() {
+    static std::atomic<uint32_t> nextTag{1};
+    thread_local uint32_t tag = nextTag.fetch_add(1, std::memory_order_relaxed);
+    return tag;
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "MpscRing.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class Profiler
+ * @brief Per-zone latency histograms, counters and an optional Chrome trace
+ *
+ * Zones are registered by name up front (before the threads that record them
+ * start) and recorded through ProfileScope. Each zone keeps a log-linear
+ * histogram of atomic buckets (8 sub-buckets per power of two, so percentiles
+ * are within ~12%), which any thread can record into without a lock and any
+ * thread can read for p50/p99/max. Counters are plain relaxed atomics.
+ *
+ * When tracing is enabled, every scope additionally pushes a complete event
+ * into a bounded ring; flushTrace() drains it into a Chrome trace file
+ * (chrome://tracing / Perfetto "JSON array" format). When the ring is full,
+ * events are dropped and counted rather than blocking the caller.
+ */
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using ZoneId = uint16_t;
+
+    static constexpr size_t MAX_ZONES = 64;
+    static constexpr ZoneId INVALID_ZONE = 0xFFFF;
+
+    enum class Counter {
+        READ_CALLS,         // ReadProcessMemory calls
+        BYTES_READ,
+        FAILED_READS,
+        PAGE_CACHE_HITS,
+        PAGE_CACHE_MISSES,
+        COUNT
+    };
+
+    struct ZoneStatistics {
+        std::string name;
+        uint64_t count = 0;
+        double averageMs = 0.0;
+        double p50Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    struct Statistics {
+        std::vector<ZoneStatistics> zones;     // Only zones recorded at least once
+        std::array<uint64_t, static_cast<size_t>(Counter::COUNT)> counters{};
+        uint64_t traceEventsDropped = 0;
+    };
+
+private:
+    // 8 sub-buckets per power of two up to 2^40 ns (~18 minutes)
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + SUB_BUCKETS;
+
+    struct Zone {
+        std::string name;
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> totalNs{0};
+        std::atomic<uint64_t> maxNs{0};
+        std::atomic<uint64_t> buckets[BUCKET_COUNT] = {};
+    };
+
+    struct TraceEvent {
+        ZoneId zone;
+        uint32_t thread;
+        int64_t startUs;        // Relative to the profiler's creation
+        int64_t durationUs;
+    };
+
+    std::unique_ptr<Zone[]> m_zones;
+    std::atomic<size_t> m_zoneCount{0};
+    std::mutex m_registerMutex;             // Registration only, never on the record path
+
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(Counter::COUNT)> m_counters{};
+
+    Clock::time_point m_epoch;
+    std::atomic<bool> m_tracing{false};
+    MpscRing<TraceEvent> m_traceRing;
+    std::atomic<uint64_t> m_traceDropped{0};
+    std::mutex m_traceMutex;                // Serializes flushTrace() (the ring has one consumer)
+    std::ofstream m_traceStream;
+    bool m_traceHasEvents = false;
+
+public:
+    /**
+     * @param traceCapacity Trace events buffered between flushTrace() calls
+     */
+    explicit Profiler(size_t traceCapacity = 65536);
+    ~Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /**
+     * @brief Get or create the zone with this name
+     * @return INVALID_ZONE once MAX_ZONES are registered (recording into it is a no-op)
+     */
+    ZoneId addZone(const std::string& name);
+
+    /**
+     * @brief Record one sample of a zone (any thread)
+     */
+    void record(ZoneId zone, Clock::time_point start, Clock::time_point end);
+
+    void add(Counter counter, uint64_t value) {
+        m_counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+    }
+    void set(Counter counter, uint64_t value) {
+        m_counters[static_cast<size_t>(counter)].store(value, std::memory_order_relaxed);
+    }
+    uint64_t get(Counter counter) const {
+        return m_counters[static_cast<size_t>(counter)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Start writing a Chrome trace to a file (truncates it)
+     * @return false if the file could not be opened
+     */
+    bool startTrace(const std::string& path);
+    void stopTrace();
+    bool isTracing() const { return m_tracing.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Append buffered trace events to the trace file
+     * Called periodically by one thread; a no-op while tracing is off.
+     */
+    void flushTrace();
+
+    Statistics getStatistics() const;
+
+    /**
+     * @brief Clear every histogram and counter (zone names are kept)
+     */
+    void reset();
+
+    static const char* counterName(Counter counter);
+
+private:
+    static int bucketIndex(uint64_t ns);
+    static uint64_t bucketValue(int index);
+    static uint64_t percentile(const Zone& zone, uint64_t count, double fraction);
+    static uint32_t currentThreadTag();
+};
+
+/**
+ * @class ProfileScope
+ * @brief RAII timer recording the lifetime of the scope into a profiler zone
+ *
+ * A null profiler makes the scope free, so instrumented code does not need to
+ * check whether profiling is set up.
+ */
+class ProfileScope {
+private:
+    Profiler* m_profiler;
+    Profiler::ZoneId m_zone;
+    Profiler::Clock::time_point m_start;
+
+public:
+    ProfileScope(Profiler* profiler, Profiler::ZoneId zone)
+        : m_profiler(profiler), m_zone(zone) {
+        if (m_profiler) {
+            m_start = Profiler::Clock::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (m_profiler) {
+            m_profiler->record(m_zone, m_start, Profiler::Clock::now());
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
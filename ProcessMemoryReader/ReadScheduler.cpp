@@ -0,0 +1,80 @@
+#include "ReadScheduler.h"
+
+ReadScheduler::GroupId ReadScheduler::addGroup(const std::string& name, Clock::duration interval) {
+    Group group;
+    group.name = name;
+    group.interval = interval;
+    m_groups.push_back(group);
+    return static_cast<GroupId>(m_groups.size() - 1);
+}
+
+void ReadScheduler::setKeyGroup(GroupId group, GroupId keyGroup) {
+    m_groups[group].keyGroup = keyGroup;
+}
+
+void ReadScheduler::setInterval(GroupId group, Clock::duration interval) {
+    Group& entry = m_groups[group];
+    entry.interval = interval;
+    entry.forced = true;   // Apply the new interval from the next pass on
+}
+
+ReadScheduler::GroupId ReadScheduler::findGroup(const std::string& name) const {
+    for (size_t i = 0; i < m_groups.size(); ++i) {
+        if (m_groups[i].name == name) {
+            return static_cast<GroupId>(i);
+        }
+    }
+    return INVALID_GROUP;
+}
+
+void ReadScheduler::beginPass(Clock::time_point now) {
+    m_now = now;
+    ++m_stats.passes;
+}
+
+bool ReadScheduler::isDue(GroupId group) const {
+    const Group& entry = m_groups[group];
+    return entry.forced || entry.interval == Clock::duration::zero() || m_now >= entry.nextDue;
+}
+
+void ReadScheduler::complete(GroupId group, bool success) {
+    Group& entry = m_groups[group];
+    ++m_stats.groupReads;
+
+    if (success) {
+        entry.forced = false;
+        entry.nextDue = m_now + entry.interval;
+    }
+}
+
+bool ReadScheduler::shouldRead(GroupId group) {
+    if (isDue(group)) {
+        return true;
+    }
+    ++m_stats.groupsSkipped;
+    return false;
+}
+
+void ReadScheduler::reportKey(GroupId group, uint64_t key) {
+    Group& entry = m_groups[group];
+    bool changed = !entry.hasKey || entry.lastKey != key;
+    entry.lastKey = key;
+    entry.hasKey = true;
+
+    if (!changed) {
+        return;
+    }
+
+    for (Group& dependent : m_groups) {
+        if (dependent.keyGroup == group) {
+            dependent.forced = true;
+        }
+    }
+}
+
+void ReadScheduler::invalidateAll() {
+    for (Group& entry : m_groups) {
+        entry.forced = true;
+        entry.hasKey = false;
+    }
+}
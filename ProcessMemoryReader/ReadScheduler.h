@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ReadScheduler
+ * @brief Decides which groups of remote fields are due in the current read pass
+ *
+ * Fields that change every frame (position, health) are read on every pass,
+ * while rarely changing ones (level, max health, map and season names) declare
+ * a refresh interval and/or a key group: when a read of the key group reports a
+ * new key value, the dependent group becomes due on the next pass regardless of
+ * its interval. Readers call beginPass() once, ask shouldRead() before queueing a
+ * group into their ReadBatch and report the outcome with complete().
+ *
+ * Example:
+ *   auto stats = scheduler.addGroup("player_stats", std::chrono::seconds(1));
+ *   scheduler.setKeyGroup(stats, hotGroup);       // Re-read when the level changes
+ *   ...
+ *   scheduler.reportKey(hotGroup, level);
+ */
+class ReadScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using GroupId = uint32_t;
+    static constexpr GroupId INVALID_GROUP = 0xFFFFFFFFu;
+
+    struct Statistics {
+        uint64_t passes = 0;
+        uint64_t groupReads = 0;       // Groups that were due and read
+        uint64_t groupsSkipped = 0;    // Groups skipped because they were not due
+    };
+
+private:
+    struct Group {
+        std::string name;
+        Clock::duration interval;      // zero = every pass
+        Clock::time_point nextDue;
+        GroupId keyGroup = INVALID_GROUP;
+        uint64_t lastKey = 0;
+        bool hasKey = false;
+        bool forced = true;            // Never read yet, invalidated or triggered by a key change
+    };
+
+    std::vector<Group> m_groups;
+    Clock::time_point m_now;
+    Statistics m_stats;
+
+public:
+    /**
+     * @brief Register a group of fields
+     * @param interval Minimum time between reads (zero = read every pass)
+     * @return Handle used by the other methods
+     */
+    GroupId addGroup(const std::string& name, Clock::duration interval);
+
+    /**
+     * @brief Make a group due whenever the key reported for keyGroup changes
+     */
+    void setKeyGroup(GroupId group, GroupId keyGroup);
+
+    void setInterval(GroupId group, Clock::duration interval);
+    GroupId findGroup(const std::string& name) const;
+
+    /**
+     * @brief Start a read pass; isDue() answers relative to this time
+     */
+    void beginPass(Clock::time_point now);
+
+    bool isDue(GroupId group) const;
+
+    /**
+     * @brief isDue() that also counts skipped groups in the statistics
+     */
+    bool shouldRead(GroupId group);
+
+    /**
+     * @brief Record the outcome of a read issued for a due group
+     * @param success false keeps the group due for the next pass
+     */
+    void complete(GroupId group, bool success);
+
+    /**
+     * @brief Report the current key value of a group; dependents are forced when it changed
+     */
+    void reportKey(GroupId group, uint64_t key);
+
+    /**
+     * @brief Force all groups to be read on the next pass (e.g. after re-attaching)
+     */
+    void invalidateAll();
+
+    const Statistics& getStatistics() const { return m_stats; }
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Memory.h"
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief Compile-time description of a single field inside a remote structure
+ * @tparam T The field type (must be trivially copyable)
+ * @tparam Offset Byte offset of the field from the structure base
+ */
+template<typename T, uintptr_t Offset>
+struct RemoteField {
+    static_assert(std::is_trivially_copyable_v<T>, "Field type must be trivially copyable");
+
+    using Type = T;
+    static constexpr uintptr_t offset = Offset;
+    static constexpr size_t size = sizeof(T);
+    static constexpr size_t end = Offset + sizeof(T);
+};
+
+/**
+ * @class RemoteStruct
+ * @brief Snapshot of a remote structure pulled in with a single read
+ *
+ * The field layout is declared once as a list of RemoteField types. The block
+ * size is derived at compile time from the furthest field end, the raw bytes
+ * live in a stack buffer and fields are decoded on demand without allocations.
+ *
+ * Example:
+ *   using Health = RemoteField<float, 0x10>;
+ *   using Level  = RemoteField<int, 0x20>;
+ *   RemoteStruct<Health, Level> block;
+ *   if (block.read(memory, base)) { float hp = block.get<Health>(); }
+ */
+template<typename... Fields>
+class RemoteStruct {
+    static_assert(sizeof...(Fields) > 0, "RemoteStruct needs at least one field");
+
+public:
+    static constexpr size_t SIZE = std::max({Fields::end...}); ///< Bytes covered by the layout
+
+    /**
+     * @brief Read the whole block with one ReadProcessMemory call
+     * @param memory The Memory instance to read through
+     * @param baseAddress Remote address of the structure
+     * @return true if the block was read successfully, false otherwise
+     */
+    bool read(const Memory* memory, uintptr_t baseAddress) {
+        return memory && memory->readMemory(baseAddress, m_buffer.data(), SIZE);
+    }
+
+    /**
+     * @brief Register the block in a batch so adjacent structures share one read
+     * @param batch The batch that will perform the read
+     * @param baseAddress Remote address of the structure
+     * @note The snapshot must outlive the batch's execute() call
+     */
+    void queue(Memory::ReadBatch& batch, uintptr_t baseAddress) {
+        batch.add(baseAddress, m_buffer.data(), SIZE);
+    }
+
+    /**
+     * @brief Decode a field from the snapshot
+     * @tparam Field One of the RemoteField types this layout was declared with
+     * @return The decoded field value
+     */
+    template<typename Field>
+    typename Field::Type get() const {
+        static_assert((std::is_same_v<Field, Fields> || ...), "Field is not part of this layout");
+
+        if constexpr (std::is_same_v<typename Field::Type, bool>) {
+            // Decode booleans from the raw byte so non 0/1 values stay well defined
+            return m_buffer[Field::offset] != 0;
+        } else {
+            typename Field::Type value;
+            std::memcpy(&value, m_buffer.data() + Field::offset, sizeof(value));
+            return value;
+        }
+    }
+
+    const uint8_t* data() const { return m_buffer.data(); }
+
+private:
+    std::array<uint8_t, SIZE> m_buffer{};
+};
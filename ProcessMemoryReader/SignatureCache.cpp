@@ -0,0 +1,119 @@
+#include "SignatureCache.h"
+#include "BinaryIO.h"
+#include <fstream>
+
+SignatureCache::SignatureCache(const std::string& filename) : m_filename(filename) {
+}
+
+bool SignatureCache::load(const ModuleBuildId& buildId) {
+    m_entries.clear();
+    m_buildId = buildId;
+    m_dirty = false;
+    
+    std::ifstream file(m_filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    ModuleBuildId fileBuildId;
+    uint32_t count = 0;
+    
+    if (!BinaryIO::read(file, magic) || magic != FILE_MAGIC ||
+        !BinaryIO::read(file, version) || version != FILE_VERSION ||
+        !BinaryIO::read(file, fileBuildId) || fileBuildId != buildId ||
+        !BinaryIO::read(file, count)) {
+        m_dirty = true; // Stale or foreign file, rewrite on save
+        return false;
+    }
+    
+    // A count the file cannot hold means a corrupt file: treat it as a miss and rescan
+    constexpr uint64_t minEntryBytes = sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint64_t);
+    if (count > BinaryIO::remaining(file) / minEntryBytes) {
+        m_dirty = true;
+        return false;
+    }
+    
+    m_entries.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string name;
+        Entry entry;
+        
+        if (!BinaryIO::readString(file, name) || !BinaryIO::read(file, entry.patternHash) ||
+            !BinaryIO::read(file, entry.moduleOffset)) {
+            m_entries.clear();
+            m_dirty = true;
+            return false;
+        }
+        
+        m_entries[name] = entry;
+    }
+    
+    return true;
+}
+
+bool SignatureCache::save() {
+    if (!m_dirty) {
+        return true;
+    }
+    
+    std::ofstream file(m_filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    BinaryIO::write(file, FILE_MAGIC);
+    BinaryIO::write(file, FILE_VERSION);
+    BinaryIO::write(file, m_buildId);
+    BinaryIO::write(file, static_cast<uint32_t>(m_entries.size()));
+    
+    for (const auto& [name, entry] : m_entries) {
+        BinaryIO::writeString(file, name);
+        BinaryIO::write(file, entry.patternHash);
+        BinaryIO::write(file, entry.moduleOffset);
+    }
+    
+    if (!file.good()) {
+        return false;
+    }
+    
+    m_dirty = false;
+    return true;
+}
+
+bool SignatureCache::lookup(const std::string& name, const char* pattern, uint64_t& moduleOffset) const {
+    auto it = m_entries.find(name);
+    if (it == m_entries.end() || it->second.patternHash != BinaryIO::hash(pattern)) {
+        return false;
+    }
+    
+    moduleOffset = it->second.moduleOffset;
+    return true;
+}
+
+void SignatureCache::store(const std::string& name, const char* pattern, uint64_t moduleOffset) {
+    Entry entry{BinaryIO::hash(pattern), moduleOffset};
+    
+    auto it = m_entries.find(name);
+    if (it != m_entries.end() && it->second.patternHash == entry.patternHash && 
+        it->second.moduleOffset == moduleOffset) {
+        return;
+    }
+    
+    m_entries[name] = entry;
+    m_dirty = true;
+}
+
+void SignatureCache::remove(const std::string& name) {
+    if (m_entries.erase(name) > 0) {
+        m_dirty = true;
+    }
+}
+
+void SignatureCache::clear() {
+    if (!m_entries.empty()) {
+        m_entries.clear();
+        m_dirty = true;
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ModuleBuildId.h"
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+/**
+ * @class SignatureCache
+ * @brief On-disk cache of resolved signature locations for one game build
+ *
+ * Locations are stored relative to the module base (ASLR moves the base every
+ * launch) together with a hash of the signature text, so editing a signature
+ * invalidates just that entry. The whole file is discarded when the module's
+ * build id no longer matches.
+ *
+ * File layout: magic, version, ModuleBuildId, entry count, then per entry
+ * {name, pattern hash, module-relative offset}.
+ */
+class SignatureCache {
+public:
+    struct Entry {
+        uint32_t patternHash;
+        uint64_t moduleOffset;
+    };
+
+private:
+    std::string m_filename;
+    ModuleBuildId m_buildId;
+    std::unordered_map<std::string, Entry> m_entries;
+    bool m_dirty = false;
+
+    static constexpr uint32_t FILE_MAGIC = 0x43534C54;  // "TLSC"
+    static constexpr uint32_t FILE_VERSION = 1;
+
+public:
+    explicit SignatureCache(const std::string& filename = "signature_cache.bin");
+
+    /**
+     * @brief Load the cache for a module build
+     * @param buildId Build id of the running module
+     * @return true if a cache for exactly this build was loaded; otherwise the
+     *         cache starts empty for this build
+     */
+    bool load(const ModuleBuildId& buildId);
+
+    /**
+     * @brief Write the cache if it changed since it was loaded
+     * @return true on success (or when nothing needed writing)
+     */
+    bool save();
+
+    /**
+     * @brief Look up a cached location
+     * @param name Signature name
+     * @param pattern Signature text; a cached entry for an edited pattern is ignored
+     * @param moduleOffset Receives the offset from the module base
+     */
+    bool lookup(const std::string& name, const char* pattern, uint64_t& moduleOffset) const;
+
+    void store(const std::string& name, const char* pattern, uint64_t moduleOffset);
+    void remove(const std::string& name);
+    void clear();
+
+    const ModuleBuildId& getBuildId() const { return m_buildId; }
+    size_t getEntryCount() const { return m_entries.size(); }
+    bool isDirty() const { return m_dirty; }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "PatternScanner.h"
+
+/**
+ * Byte signatures used to locate the game's global structures
+ * These need to be updated via reverse engineering after game patches;
+ * addresses fall back to the development placeholders when a signature is not found.
+ */
+namespace Signatures {
+    // mov rax, [rip+disp32] ; test rax, rax ; jz ...
+    constexpr PatternScanner::Signature PLAYER_BASE = {
+        "player_base", "48 8B 05 ? ? ? ? 48 85 C0 74 ? F3 0F 10 40 10", 3, 7, true
+    };
+    
+    // lea rcx, [rip+disp32] ; call ...
+    constexpr PatternScanner::Signature MAP_DATA = {
+        "map_data", "48 8D 0D ? ? ? ? E8 ? ? ? ? 83 B8 ? ? ? ? 00", 3, 7, false
+    };
+    
+    // mov rcx, [rip+disp32] ; mov edx, [rcx+...]
+    constexpr PatternScanner::Signature SEASON_DATA = {
+        "season_data", "48 8B 0D ? ? ? ? 8B 91 ? ? ? ? 85 D2 7E", 3, 7, true
+    };
+    
+    // mov rbx, [rip+disp32] ; mov edi, [rbx+8]
+    constexpr PatternScanner::Signature ENTITY_LIST = {
+        "entity_list", "48 8B 1D ? ? ? ? 8B 7B 08 85 FF 0F 84", 3, 7, true
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "GameState.h"
+#include "EntityStore.h"
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * On-disk layout of recorded WorldSnapshots (SnapshotRecorder / SnapshotReplay)
+ *
+ *   FileHeader
+ *   Tick records, back to back, each a multiple of 8 bytes:
+ *     TickHeader
+ *     Symbols first used by this tick: { uint32 id, uint16 length, chars }...
+ *     Explored areas: float x, y pairs
+ *     Entity columns, one contiguous array each (see TickHeader::entityCount)
+ *   Index: uint64 offset of every tick record
+ *   Footer
+ *
+ * Every section starts on an 8-byte boundary. Names are stored as the
+ * recording process' SymbolIds, and each string is written once, in the tick
+ * that first used it; replay maps them to its own symbol table. Times are
+ * nanoseconds since the first recorded capture. The index and footer are
+ * written when the recording is closed; without them (the bot crashed) the
+ * records are walked to rebuild the index. Values are in native layout:
+ * recordings are machine-local tools, not an exchange format.
+ */
+namespace SnapshotFormat {
+    constexpr uint32_t FILE_MAGIC = 0x50414E53;    // "SNAP"
+    constexpr uint32_t TICK_MAGIC = 0x4B434954;    // "TICK"
+    constexpr uint32_t INDEX_MAGIC = 0x58444E49;   // "INDX"
+    constexpr uint32_t VERSION = 1;
+
+    struct FileHeader {
+        uint32_t magic = FILE_MAGIC;
+        uint32_t version = VERSION;
+        uint32_t headerSize = sizeof(FileHeader);
+        uint32_t tickHeaderSize = 0;   // sizeof(TickHeader) of the writer
+    };
+
+    struct MapRecord {
+        SymbolId name = SymbolTable::EMPTY;
+        int32_t tier = 0;
+        float completionPercent = 0;
+        uint32_t exploredCount = 0;
+        uint8_t isCompleted = 0;
+        uint8_t hasBoss = 0;
+        uint8_t bossDefeated = 0;
+        uint8_t reserved = 0;
+    };
+
+    struct SeasonRecord {
+        SymbolId name = SymbolTable::EMPTY;
+        SymbolId eventType = SymbolTable::EMPTY;
+        int32_t level = 0;
+        uint8_t hasActiveEvent = 0;
+        uint8_t reserved[3] = {};
+        int64_t eventEndNs = 0;
+    };
+
+    struct TickHeader {
+        uint32_t magic = TICK_MAGIC;
+        uint32_t size = 0;             // Whole record, header included
+        uint64_t sequence = 0;
+        int64_t captureTimeNs = 0;
+        int64_t readDurationUs = 0;
+        uint32_t entityCount = 0;
+        uint32_t symbolCount = 0;
+        uint32_t symbolBytes = 0;      // Symbol section, before padding
+        uint8_t complete = 0;
+        uint8_t reserved[3] = {};
+        GameState::PlayerData player{};
+        MapRecord map;
+        SeasonRecord season;
+    };
+
+    struct Footer {
+        uint32_t magic = INDEX_MAGIC;
+        uint32_t reserved = 0;
+        uint64_t tickCount = 0;
+        uint64_t indexOffset = 0;
+    };
+
+    static_assert(std::is_trivially_copyable_v<GameState::PlayerData>, "Player data is stored as raw bytes");
+    static_assert(std::is_trivially_copyable_v<Entity::TypeData>, "Type data is stored as raw bytes");
+
+    constexpr size_t align(size_t bytes) { return (bytes + 7) & ~size_t(7); }
+
+    // Entity column section: ids, lastSeen, x, y, z, health, maxHealth, threat, level, name, type, flags, type data
+    constexpr size_t columnBytes(size_t count) {
+        return align(count * sizeof(uint64_t)) + align(count * sizeof(int64_t)) +
+               6 * align(count * sizeof(float)) + align(count * sizeof(int32_t)) +
+               align(count * sizeof(SymbolId)) + 2 * align(count) + align(count * sizeof(Entity::TypeData));
+    }
+}
@@ -0,0 +1,151 @@
+#include "SnapshotReader.h"
+#include "Memory.h"
+#include "GameState.h"
+#include "EntityManager.h"
+#include "SnapshotRecorder.h"
+#include <algorithm>
+#include <stdexcept>
+
+SnapshotReader::SnapshotReader(Memory* memory, std::unique_ptr<GameState> gameState, 
+                               std::unique_ptr<EntityManager> entityManager)
+    : m_memory(memory), m_gameState(std::move(gameState)), m_entityManager(std::move(entityManager)) {
+    if (!m_memory || !m_gameState || !m_entityManager) {
+        throw std::invalid_argument("SnapshotReader requires memory, game state and entity manager");
+    }
+}
+
+SnapshotReader::~SnapshotReader() {
+    stop();
+}
+
+void SnapshotReader::start(std::chrono::milliseconds interval) {
+    if (m_running) {
+        return;
+    }
+    
+    setInterval(interval);
+    m_running = true;
+    m_thread = std::thread(&SnapshotReader::readerLoop, this);
+}
+
+void SnapshotReader::setInterval(std::chrono::milliseconds interval) {
+    m_intervalMs.store(std::max<int64_t>(interval.count(), 1), std::memory_order_relaxed);
+}
+
+void SnapshotReader::stop() {
+    m_running = false;
+    
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SnapshotReader::setProfiler(Profiler* profiler) {
+    m_profiler = profiler;
+    if (m_profiler) {
+        m_readPassZone = m_profiler->addZone("SnapshotReader::capture");
+        m_gameStateZone = m_profiler->addZone("GameState::update");
+        m_entityManagerZone = m_profiler->addZone("EntityManager::update");
+    }
+}
+
+bool SnapshotReader::capture() {
+    ProfileScope passScope(m_profiler, m_readPassZone);
+    auto startTime = std::chrono::steady_clock::now();
+    
+    // New pass: cached pages from the previous pass are stale now
+    m_memory->advanceGeneration();
+    
+    bool complete;
+    {
+        ProfileScope scope(m_profiler, m_gameStateZone);
+        complete = m_gameState->update();
+    }
+    {
+        ProfileScope scope(m_profiler, m_entityManagerZone);
+        complete &= m_entityManager->update();
+    }
+    
+    WorldSnapshot& snapshot = m_buffer.writeSlot();
+    snapshot.sequence = ++m_sequence;
+    snapshot.captureTime = startTime;
+    snapshot.complete = complete;
+    snapshot.player = m_gameState->getPlayer();
+    snapshot.map = m_gameState->getCurrentMap();
+    snapshot.season = m_gameState->getSeason();
+    m_entityManager->copyEntities(snapshot.entities);
+    
+    auto readDuration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    snapshot.readDuration = readDuration;
+    
+    m_buffer.publish();
+    
+    // Recorded after publishing so the decision loop never waits on the file;
+    // the published slot is not written again until the next pass
+    if (m_recorder) {
+        m_recorder->append(snapshot);
+    }
+    
+    m_published.fetch_add(1, std::memory_order_relaxed);
+    m_lastReadUs.store(readDuration.count(), std::memory_order_relaxed);
+    m_totalReadUs.fetch_add(readDuration.count(), std::memory_order_relaxed);
+    if (!complete) {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // Memory's counters are only touched on this thread; publish copies for readers
+    if (m_profiler) {
+        auto readStats = m_memory->getReadStats();
+        auto cacheStats = m_memory->getPageCacheStats();
+        m_profiler->set(Profiler::Counter::READ_CALLS, readStats.calls);
+        m_profiler->set(Profiler::Counter::BYTES_READ, readStats.bytes);
+        m_profiler->set(Profiler::Counter::FAILED_READS, readStats.failures);
+        m_profiler->set(Profiler::Counter::PAGE_CACHE_HITS, cacheStats.hits);
+        m_profiler->set(Profiler::Counter::PAGE_CACHE_MISSES, cacheStats.misses);
+    }
+    
+    return complete;
+}
+
+const WorldSnapshot* SnapshotReader::acquireLatest() {
+    if (!m_buffer.acquire()) {
+        return nullptr;
+    }
+    return &m_buffer.readSlot();
+}
+
+SnapshotReader::Statistics SnapshotReader::getStatistics() const {
+    Statistics stats;
+    stats.snapshotsPublished = m_published.load(std::memory_order_relaxed);
+    stats.failedPasses = m_failed.load(std::memory_order_relaxed);
+    stats.lastReadMs = m_lastReadUs.load(std::memory_order_relaxed) / 1000.0;
+    
+    if (stats.snapshotsPublished > 0) {
+        stats.averageReadMs = m_totalReadUs.load(std::memory_order_relaxed) / 1000.0 / stats.snapshotsPublished;
+    }
+    
+    return stats;
+}
+
+void SnapshotReader::readerLoop() {
+    auto nextPass = std::chrono::steady_clock::now();
+    
+    while (m_running) {
+        try {
+            capture();
+        }
+        catch (const std::exception&) {
+            // A failed pass publishes nothing; the decision loop keeps the previous snapshot
+            m_failed.fetch_add(1, std::memory_order_relaxed);
+        }
+        
+        // Fixed cadence; if a pass overran, start the next one right away instead of bursting
+        nextPass += std::chrono::milliseconds(m_intervalMs.load(std::memory_order_relaxed));
+        auto now = std::chrono::steady_clock::now();
+        if (nextPass < now) {
+            nextPass = now;
+        }
+        std::this_thread::sleep_until(nextPass);
+    }
+}
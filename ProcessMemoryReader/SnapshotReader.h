@@ -0,0 +1,125 @@
+#pragma once
+
+#include "TripleBuffer.h"
+#include "WorldSnapshot.h"
+#include "Profiler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// Forward declarations
+class Memory;
+class GameState;
+class EntityManager;
+class SnapshotRecorder;
+
+/**
+ * @class SnapshotReader
+ * @brief Reads game memory on its own thread and publishes WorldSnapshots
+ *
+ * The reader owns the GameState/EntityManager instances that perform memory
+ * reads. Every interval it runs one read pass, copies the results into the
+ * write slot of a triple buffer and publishes it atomically. The decision loop
+ * picks up the latest snapshot without locks, so slow input handling no longer
+ * delays reads and the read rate can be tuned independently of the tick rate.
+ */
+class SnapshotReader {
+public:
+    struct Statistics {
+        uint64_t snapshotsPublished = 0;
+        uint64_t failedPasses = 0;         // Passes where some read failed or threw
+        double lastReadMs = 0.0;
+        double averageReadMs = 0.0;
+    };
+
+private:
+    Memory* m_memory;
+    std::unique_ptr<GameState> m_gameState;
+    std::unique_ptr<EntityManager> m_entityManager;
+
+    TripleBuffer<WorldSnapshot> m_buffer;
+    uint64_t m_sequence = 0;  // Producer side only
+
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+    std::atomic<int64_t> m_intervalMs{16};  // May be retuned while running
+    
+    // Profiling (optional)
+    Profiler* m_profiler = nullptr;
+    Profiler::ZoneId m_readPassZone = Profiler::INVALID_ZONE;
+    Profiler::ZoneId m_gameStateZone = Profiler::INVALID_ZONE;
+    Profiler::ZoneId m_entityManagerZone = Profiler::INVALID_ZONE;
+    
+    SnapshotRecorder* m_recorder = nullptr;
+
+    // Statistics (written by the reader thread, read from anywhere)
+    std::atomic<uint64_t> m_published{0};
+    std::atomic<uint64_t> m_failed{0};
+    std::atomic<int64_t> m_lastReadUs{0};
+    std::atomic<int64_t> m_totalReadUs{0};
+
+public:
+    /**
+     * @brief Constructor
+     * @param memory Memory instance the read pass goes through
+     * @param gameState Game state with its addresses already discovered
+     * @param entityManager Entity manager with its entity list already discovered
+     * @throws std::invalid_argument if any argument is null
+     */
+    SnapshotReader(Memory* memory, std::unique_ptr<GameState> gameState, 
+                   std::unique_ptr<EntityManager> entityManager);
+    ~SnapshotReader();
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    /**
+     * @brief Start the reader thread
+     * @param interval Target time between read passes
+     */
+    void start(std::chrono::milliseconds interval);
+    void stop();
+    
+    /**
+     * @brief Change the time between read passes; safe while the reader thread runs
+     */
+    void setInterval(std::chrono::milliseconds interval);
+    bool isRunning() const { return m_running; }
+    
+    /**
+     * @brief Time read passes and publish memory read counters into a profiler
+     * @note Only call while the reader thread is not running
+     */
+    void setProfiler(Profiler* profiler);
+    
+    /**
+     * @brief Append every published snapshot to a recording (nullptr stops recording)
+     * @note Only call while the reader thread is not running
+     */
+    void setRecorder(SnapshotRecorder* recorder) { m_recorder = recorder; }
+
+    /**
+     * @brief Run one read pass and publish it on the calling thread
+     * @note Only call while the reader thread is not running
+     * @return true if every read of the pass succeeded
+     */
+    bool capture();
+
+    /**
+     * @brief Take the newest snapshot (decision thread only)
+     * @return The snapshot, or nullptr if nothing new was published since the last call.
+     *         The pointer stays valid until the next call.
+     */
+    const WorldSnapshot* acquireLatest();
+
+    Statistics getStatistics() const;
+
+    // Reading instances; only touch them while the reader thread is stopped
+    GameState* getGameState() { return m_gameState.get(); }
+    EntityManager* getEntityManager() { return m_entityManager.get(); }
+
+private:
+    void readerLoop();
+};
@@ -0,0 +1,195 @@
+#include "SnapshotRecorder.h"
+#include "SnapshotFormat.h"
+#include "WorldSnapshot.h"
+#include "SymbolTable.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace SnapshotFormat;
+
+namespace {
+    // Copies one section and returns the start of the next (sections are 8-byte aligned)
+    uint8_t* writeSection(uint8_t* out, const void* data, size_t bytes) {
+        if (bytes > 0) {
+            std::memcpy(out, data, bytes);
+        }
+        return out + align(bytes);
+    }
+}
+
+SnapshotRecorder::~SnapshotRecorder() {
+    close();
+}
+
+bool SnapshotRecorder::open(const std::string& path) {
+    close();
+
+    if (!m_file.create(path, INITIAL_CAPACITY)) {
+        return false;
+    }
+
+    FileHeader header;
+    header.tickHeaderSize = sizeof(TickHeader);
+    std::memcpy(m_file.data(), &header, sizeof(header));
+
+    m_path = path;
+    m_size = align(sizeof(FileHeader));
+    m_index.clear();
+    m_symbolsWritten = 1;
+    m_ticks = 0;
+    m_bytes = m_size;
+    m_failed = 0;
+    return true;
+}
+
+void SnapshotRecorder::close() {
+    // Without the index a reader rebuilds it by walking the records
+    size_t indexBytes = m_index.size() * sizeof(uint64_t);
+    uint8_t* out = m_file.isOpen() ? reserve(indexBytes + sizeof(Footer)) : nullptr;
+    if (out) {
+        Footer footer;
+        footer.tickCount = m_index.size();
+        footer.indexOffset = m_size;
+        out = writeSection(out, m_index.data(), indexBytes);
+        std::memcpy(out, &footer, sizeof(footer));
+        m_size += align(indexBytes) + sizeof(Footer);
+    }
+
+    m_file.close(m_size);
+    m_bytes = m_size;
+}
+
+bool SnapshotRecorder::append(const WorldSnapshot& snapshot) {
+    if (!m_file.isOpen()) {
+        return false;
+    }
+    if (m_index.empty()) {
+        m_origin = snapshot.captureTime;
+    }
+
+    SymbolTable& symbols = SymbolTable::global();
+    const EntityStore& entities = snapshot.entities;
+    size_t count = entities.size();
+
+    TickHeader header;
+    header.sequence = snapshot.sequence;
+    header.captureTimeNs = toNs(snapshot.captureTime);
+    header.readDurationUs = snapshot.readDuration.count();
+    header.entityCount = static_cast<uint32_t>(count);
+    header.complete = snapshot.complete ? 1 : 0;
+    header.player = snapshot.player;
+
+    header.map.name = symbols.intern(snapshot.map.mapName);
+    header.map.tier = snapshot.map.mapTier;
+    header.map.completionPercent = snapshot.map.completionPercent;
+    header.map.exploredCount = static_cast<uint32_t>(snapshot.map.exploredAreas.size());
+    header.map.isCompleted = snapshot.map.isCompleted ? 1 : 0;
+    header.map.hasBoss = snapshot.map.hasBoss ? 1 : 0;
+    header.map.bossDefeated = snapshot.map.bossDefeated ? 1 : 0;
+
+    header.season.name = symbols.intern(snapshot.season.seasonName);
+    header.season.eventType = symbols.intern(snapshot.season.eventType);
+    header.season.level = snapshot.season.seasonLevel;
+    header.season.hasActiveEvent = snapshot.season.hasActiveEvent ? 1 : 0;
+    header.season.eventEndNs = toNs(snapshot.season.eventEndTime);
+
+    // Strings interned since the previous tick, this tick's map and season names included
+    size_t symbolEnd = symbols.size();
+    size_t symbolBytes = 0;
+    for (size_t id = m_symbolsWritten; id < symbolEnd; ++id) {
+        symbolBytes += sizeof(uint32_t) + sizeof(uint16_t) +
+                       std::min<size_t>(symbols.name(static_cast<SymbolId>(id)).size(), 0xFFFF);
+    }
+    header.symbolCount = static_cast<uint32_t>(symbolEnd - m_symbolsWritten);
+    header.symbolBytes = static_cast<uint32_t>(symbolBytes);
+
+    size_t exploredBytes = snapshot.map.exploredAreas.size() * 2 * sizeof(float);
+    size_t size = align(sizeof(TickHeader)) + align(symbolBytes) + align(exploredBytes) + columnBytes(count);
+    if (size > std::numeric_limits<uint32_t>::max()) {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    header.size = static_cast<uint32_t>(size);
+
+    uint8_t* out = reserve(size);
+    if (!out) {
+        m_failed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Space past the written end is zero-filled by the file system, padding included
+    out = writeSection(out, &header, sizeof(header));
+
+    uint8_t* symbolOut = out;
+    for (size_t id = m_symbolsWritten; id < symbolEnd; ++id) {
+        const std::string& name = symbols.name(static_cast<SymbolId>(id));
+        uint32_t symbol = static_cast<uint32_t>(id);
+        uint16_t length = static_cast<uint16_t>(std::min<size_t>(name.size(), 0xFFFF));
+        std::memcpy(symbolOut, &symbol, sizeof(symbol));
+        std::memcpy(symbolOut + sizeof(symbol), &length, sizeof(length));
+        std::memcpy(symbolOut + sizeof(symbol) + sizeof(length), name.data(), length);
+        symbolOut += sizeof(symbol) + sizeof(length) + length;
+    }
+    out += align(symbolBytes);
+
+    for (const auto& area : snapshot.map.exploredAreas) {
+        float point[2] = {area.first, area.second};
+        std::memcpy(out, point, sizeof(point));
+        out += sizeof(point);
+    }
+    out += align(exploredBytes) - exploredBytes;
+
+    out = writeSection(out, entities.ids(), count * sizeof(uint64_t));
+    int64_t* lastSeen = reinterpret_cast<int64_t*>(out);
+    for (EntityStore::Slot slot = 0; slot < count; ++slot) {
+        lastSeen[slot] = toNs(entities.lastSeen(slot));
+    }
+    out += align(count * sizeof(int64_t));
+    out = writeSection(out, entities.xs(), count * sizeof(float));
+    out = writeSection(out, entities.ys(), count * sizeof(float));
+    out = writeSection(out, entities.zs(), count * sizeof(float));
+    out = writeSection(out, entities.healths(), count * sizeof(float));
+    out = writeSection(out, entities.maxHealths(), count * sizeof(float));
+    out = writeSection(out, entities.threatLevels(), count * sizeof(float));
+    out = writeSection(out, entities.levels(), count * sizeof(int32_t));
+    SymbolId* names = reinterpret_cast<SymbolId*>(out);
+    for (EntityStore::Slot slot = 0; slot < count; ++slot) {
+        names[slot] = entities.nameIdOf(slot);
+    }
+    out += align(count * sizeof(SymbolId));
+    out = writeSection(out, entities.types(), count);
+    out = writeSection(out, entities.flags(), count);
+    for (EntityStore::Slot slot = 0; slot < count; ++slot) {
+        std::memcpy(out + slot * sizeof(Entity::TypeData), &entities.typeData(slot), sizeof(Entity::TypeData));
+    }
+
+    m_index.push_back(m_size);
+    m_size += size;
+    m_symbolsWritten = symbolEnd;
+    m_ticks.fetch_add(1, std::memory_order_relaxed);
+    m_bytes.store(m_size, std::memory_order_relaxed);
+    return true;
+}
+
+SnapshotRecorder::Statistics SnapshotRecorder::getStatistics() const {
+    Statistics stats;
+    stats.ticks = m_ticks.load(std::memory_order_relaxed);
+    stats.bytes = m_bytes.load(std::memory_order_relaxed);
+    stats.failedWrites = m_failed.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint8_t* SnapshotRecorder::reserve(size_t bytes) {
+    if (m_size + bytes > m_file.capacity()) {
+        size_t capacity = std::max(m_file.capacity() * 2, m_size + bytes);
+        if (!m_file.grow(capacity)) {
+            return nullptr;
+        }
+    }
+    return m_file.data() + m_size;
+}
+
+int64_t SnapshotRecorder::toNs(std::chrono::steady_clock::time_point time) const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_origin).count();
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "MappedFile.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+struct WorldSnapshot;
+
+/**
+ * @class SnapshotRecorder
+ * @brief Appends WorldSnapshots to a memory-mapped columnar file (see SnapshotFormat.h)
+ *
+ * Each append() writes one tick record straight into the mapped file: the
+ * player, map and season values, the strings first seen in this tick, and the
+ * entity table as one array per column. The file grows by doubling its
+ * mapping; close() writes the per-tick index and trims the unused tail.
+ * Called from the snapshot reader thread; not thread-safe.
+ */
+class SnapshotRecorder {
+public:
+    struct Statistics {
+        uint64_t ticks = 0;
+        uint64_t bytes = 0;           // File size so far
+        uint64_t failedWrites = 0;    // Ticks dropped because the file could not grow
+    };
+
+private:
+    static constexpr size_t INITIAL_CAPACITY = size_t{16} << 20;
+
+    MappedFile m_file;
+    std::string m_path;
+    size_t m_size = 0;
+    std::vector<uint64_t> m_index;
+    size_t m_symbolsWritten = 1;      // Symbol 0 is the empty string in every table
+    std::chrono::steady_clock::time_point m_origin;
+
+    std::atomic<uint64_t> m_ticks{0};
+    std::atomic<uint64_t> m_bytes{0};
+    std::atomic<uint64_t> m_failed{0};
+
+public:
+    SnapshotRecorder() = default;
+    ~SnapshotRecorder();
+
+    SnapshotRecorder(const SnapshotRecorder&) = delete;
+    SnapshotRecorder& operator=(const SnapshotRecorder&) = delete;
+
+    /**
+     * @brief Start a new recording, replacing any file at path
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Write the index and close the file
+     */
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    const std::string& getPath() const { return m_path; }
+
+    /**
+     * @brief Append one tick
+     * @return false if the file could not grow (the tick is dropped)
+     */
+    bool append(const WorldSnapshot& snapshot);
+
+    Statistics getStatistics() const;
+
+private:
+    uint8_t* reserve(size_t bytes);
+    int64_t toNs(std::chrono::steady_clock::time_point time) const;
+};
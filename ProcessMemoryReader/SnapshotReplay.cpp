@@ -0,0 +1,259 @@
+#include "SnapshotReplay.h"
+#include "SnapshotFormat.h"
+#include "WorldSnapshot.h"
+#include "GameState.h"
+#include "EntityManager.h"
+#include <cstring>
+#include <string_view>
+
+using namespace SnapshotFormat;
+
+namespace {
+    // Header of the record at offset, if it is a complete tick record
+    bool readTickHeader(const uint8_t* data, size_t fileSize, uint64_t offset, TickHeader& header) {
+        if (offset % 8 != 0 || offset > fileSize || fileSize - offset < sizeof(TickHeader)) {
+            return false;
+        }
+        std::memcpy(&header, data + offset, sizeof(header));
+
+        size_t expected = align(sizeof(TickHeader)) + align(header.symbolBytes) +
+                          align(size_t{header.map.exploredCount} * 2 * sizeof(float)) + columnBytes(header.entityCount);
+        return header.magic == TICK_MAGIC && header.size == expected && header.size <= fileSize - offset;
+    }
+
+    // Next column of a tick record (columns are 8-byte aligned within the mapped view)
+    template<typename T>
+    const T* column(const uint8_t*& cursor, size_t count) {
+        const T* values = reinterpret_cast<const T*>(cursor);
+        cursor += align(count * sizeof(T));
+        return values;
+    }
+}
+
+bool SnapshotReplay::open(const std::string& path) {
+    close();
+
+    if (!m_file.openRead(path)) {
+        return false;
+    }
+    m_size = m_file.capacity();
+
+    FileHeader header;
+    if (m_size < sizeof(header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, m_file.data(), sizeof(header));
+    if (header.magic != FILE_MAGIC || header.version != VERSION || header.tickHeaderSize != sizeof(TickHeader)) {
+        close();
+        return false;
+    }
+
+    if (!loadIndex() && !recoverIndex()) {
+        close();
+        return false;
+    }
+    loadSymbols();
+
+    m_position = 0;
+    m_origin = std::chrono::steady_clock::now();
+    return true;
+}
+
+void SnapshotReplay::close() {
+    m_file.close();
+    m_size = 0;
+    m_index.clear();
+    m_symbols.clear();
+    m_position = 0;
+    m_indexRecovered = false;
+}
+
+bool SnapshotReplay::loadIndex() {
+    if (m_size < align(sizeof(FileHeader)) + sizeof(Footer)) {
+        return false;
+    }
+
+    Footer footer;
+    std::memcpy(&footer, m_file.data() + m_size - sizeof(Footer), sizeof(footer));
+    size_t indexEnd = m_size - sizeof(Footer);
+    if (footer.magic != INDEX_MAGIC || footer.indexOffset > indexEnd ||
+        footer.tickCount > (indexEnd - footer.indexOffset) / sizeof(uint64_t)) {
+        return false;
+    }
+
+    m_index.resize(static_cast<size_t>(footer.tickCount));
+    std::memcpy(m_index.data(), m_file.data() + footer.indexOffset, m_index.size() * sizeof(uint64_t));
+
+    TickHeader header;
+    for (uint64_t offset : m_index) {
+        if (!readTickHeader(m_file.data(), m_size, offset, header)) {
+            m_index.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SnapshotReplay::recoverIndex() {
+    // Walk the records up to the first incomplete one (the tail of an interrupted recording)
+    m_index.clear();
+    m_indexRecovered = true;
+
+    TickHeader header;
+    uint64_t offset = align(sizeof(FileHeader));
+    while (readTickHeader(m_file.data(), m_size, offset, header)) {
+        m_index.push_back(offset);
+        offset += header.size;
+    }
+    return true;
+}
+
+bool SnapshotReplay::loadSymbols() {
+    // Symbols were written in id order, each by the first tick that used it
+    SymbolTable& symbols = SymbolTable::global();
+    m_symbols.assign(1, SymbolTable::EMPTY);
+
+    for (size_t tick = 0; tick < m_index.size(); ++tick) {
+        const uint8_t* data = record(tick);
+        TickHeader header;
+        std::memcpy(&header, data, sizeof(header));
+
+        const uint8_t* cursor = data + align(sizeof(TickHeader));
+        const uint8_t* end = cursor + header.symbolBytes;
+        for (uint32_t i = 0; i < header.symbolCount; ++i) {
+            uint32_t id;
+            uint16_t length;
+            if (end - cursor < static_cast<ptrdiff_t>(sizeof(id) + sizeof(length))) {
+                return false;
+            }
+            std::memcpy(&id, cursor, sizeof(id));
+            std::memcpy(&length, cursor + sizeof(id), sizeof(length));
+            cursor += sizeof(id) + sizeof(length);
+            if (end - cursor < length || id != m_symbols.size()) {
+                return false;
+            }
+
+            m_symbols.push_back(symbols.intern(std::string_view(reinterpret_cast<const char*>(cursor), length)));
+            cursor += length;
+        }
+    }
+    return true;
+}
+
+const uint8_t* SnapshotReplay::record(size_t tick) const {
+    return tick < m_index.size() ? m_file.data() + m_index[tick] : nullptr;
+}
+
+bool SnapshotReplay::read(size_t tick, WorldSnapshot& snapshot) {
+    const uint8_t* data = record(tick);
+    if (!data) {
+        return false;
+    }
+
+    using std::chrono::nanoseconds;
+    const SymbolTable& symbols = SymbolTable::global();
+    TickHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    snapshot.sequence = header.sequence;
+    snapshot.captureTime = m_origin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                          nanoseconds(header.captureTimeNs));
+    snapshot.readDuration = std::chrono::microseconds(header.readDurationUs);
+    snapshot.complete = header.complete != 0;
+    snapshot.player = header.player;
+
+    snapshot.map.mapName = symbols.name(symbol(header.map.name));
+    snapshot.map.mapTier = header.map.tier;
+    snapshot.map.completionPercent = header.map.completionPercent;
+    snapshot.map.isCompleted = header.map.isCompleted != 0;
+    snapshot.map.hasBoss = header.map.hasBoss != 0;
+    snapshot.map.bossDefeated = header.map.bossDefeated != 0;
+
+    snapshot.season.seasonName = symbols.name(symbol(header.season.name));
+    snapshot.season.eventType = symbols.name(symbol(header.season.eventType));
+    snapshot.season.seasonLevel = header.season.level;
+    snapshot.season.hasActiveEvent = header.season.hasActiveEvent != 0;
+    snapshot.season.eventEndTime = m_origin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                                  nanoseconds(header.season.eventEndNs));
+
+    const uint8_t* cursor = data + align(sizeof(TickHeader)) + align(header.symbolBytes);
+    const float* explored = column<float>(cursor, size_t{header.map.exploredCount} * 2);
+    snapshot.map.exploredAreas.resize(header.map.exploredCount);
+    for (size_t i = 0; i < header.map.exploredCount; ++i) {
+        snapshot.map.exploredAreas[i] = {explored[i * 2], explored[i * 2 + 1]};
+    }
+
+    size_t count = header.entityCount;
+    const uint64_t* ids = column<uint64_t>(cursor, count);
+    const int64_t* lastSeen = column<int64_t>(cursor, count);
+    const float* xs = column<float>(cursor, count);
+    const float* ys = column<float>(cursor, count);
+    const float* zs = column<float>(cursor, count);
+    const float* healths = column<float>(cursor, count);
+    const float* maxHealths = column<float>(cursor, count);
+    const float* threats = column<float>(cursor, count);
+    const int32_t* levels = column<int32_t>(cursor, count);
+    const SymbolId* names = column<SymbolId>(cursor, count);
+    const uint8_t* types = column<uint8_t>(cursor, count);
+    const uint8_t* flags = column<uint8_t>(cursor, count);
+    const uint8_t* typeData = cursor;
+
+    EntityStore& entities = snapshot.entities;
+    m_present.assign(entities.size(), 0);
+    entities.reserve(count);
+    for (size_t slot = 0; slot < count; ++slot) {
+        Entity entity;
+        entity.id = ids[slot];
+        entity.type = static_cast<EntityType>(types[slot]);
+        entity.x = xs[slot];
+        entity.y = ys[slot];
+        entity.z = zs[slot];
+        entity.health = healths[slot];
+        entity.maxHealth = maxHealths[slot];
+        entity.isAlive = (flags[slot] & EntityStore::FLAG_ALIVE) != 0;
+        entity.isTargetable = (flags[slot] & EntityStore::FLAG_TARGETABLE) != 0;
+        entity.isVisible = (flags[slot] & EntityStore::FLAG_VISIBLE) != 0;
+        entity.name = symbol(names[slot]);
+        entity.level = levels[slot];
+        entity.threatLevel = threats[slot];
+        entity.lastSeen = m_origin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                         nanoseconds(lastSeen[slot]));
+        std::memcpy(&entity.data, typeData + slot * sizeof(Entity::TypeData), sizeof(Entity::TypeData));
+        entity.data.item.itemType = symbol(entity.data.item.itemType);
+        entity.data.seasonal.eventType = symbol(entity.data.seasonal.eventType);
+
+        // Upserts only append, so slots seen so far stay where they are
+        EntityStore::Slot stored = entities.upsert(entity);
+        if (stored >= m_present.size()) {
+            m_present.resize(stored + 1, 0);
+        }
+        m_present[stored] = 1;
+    }
+
+    // Drop what the tick does not have; descending, so the last slot moved into a hole was already visited
+    for (size_t slot = entities.size(); slot-- > 0;) {
+        if (!m_present[slot]) {
+            size_t last = entities.size() - 1;
+            entities.removeAt(static_cast<EntityStore::Slot>(slot));
+            m_present[slot] = m_present[last];
+        }
+    }
+    return true;
+}
+
+bool SnapshotReplay::next(WorldSnapshot& snapshot) {
+    if (m_position >= m_index.size()) {
+        return false;
+    }
+    return read(m_position++, snapshot);
+}
+
+bool SnapshotReplay::next(WorldSnapshot& scratch, GameState& gameState, EntityManager& entityManager) {
+    if (!next(scratch)) {
+        return false;
+    }
+    gameState.applySnapshot(scratch);
+    entityManager.applySnapshot(scratch);
+    return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "SymbolTable.h"
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+struct WorldSnapshot;
+class GameState;
+class EntityManager;
+
+/**
+ * @class SnapshotReplay
+ * @brief Plays back a SnapshotRecorder file as WorldSnapshots
+ *
+ * The file is mapped read-only and every tick is reachable through the
+ * index, so ticks can be read in order or at random. The recorded strings
+ * are interned into this process' symbol table when the file is opened.
+ * Ticks are produced as fast as they are asked for: feeding GameState and
+ * EntityManager from a replay runs the decision logic on recorded worlds
+ * without a game and without waiting for real time.
+ */
+class SnapshotReplay {
+private:
+    MappedFile m_file;
+    size_t m_size = 0;
+    std::vector<uint64_t> m_index;              // Offset of every tick record
+    std::vector<SymbolId> m_symbols;            // Recorded symbol id -> ours
+    std::vector<uint8_t> m_present;             // Scratch: slots of the target store seen in the tick
+    size_t m_position = 0;
+    bool m_indexRecovered = false;
+    std::chrono::steady_clock::time_point m_origin;  // Recorded time 0 maps here
+
+public:
+    SnapshotReplay() = default;
+
+    SnapshotReplay(const SnapshotReplay&) = delete;
+    SnapshotReplay& operator=(const SnapshotReplay&) = delete;
+
+    /**
+     * @brief Map a recording and load its index and strings
+     * @return false if the file is missing or is not a recording
+     */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+    size_t getTickCount() const { return m_index.size(); }
+    size_t getPosition() const { return m_position; }
+    void seek(size_t tick) { m_position = tick < m_index.size() ? tick : m_index.size(); }
+    void rewind() { m_position = 0; }
+
+    // The recording was not closed cleanly and its index was rebuilt
+    bool wasIndexRecovered() const { return m_indexRecovered; }
+
+    /**
+     * @brief Decode one tick into snapshot
+     *
+     * The snapshot's entity table is updated in place rather than rebuilt:
+     * entities of the previous tick keep their slots, and only spawns and
+     * despawns touch the id index. Reusing one snapshot for consecutive
+     * ticks is the fast path.
+     */
+    bool read(size_t tick, WorldSnapshot& snapshot);
+
+    /**
+     * @brief Decode the tick at the current position and advance
+     * @return false at the end of the recording
+     */
+    bool next(WorldSnapshot& snapshot);
+
+    /**
+     * @brief Apply the next tick to gameState and entityManager, as the decision loop does
+     */
+    bool next(WorldSnapshot& scratch, GameState& gameState, EntityManager& entityManager);
+
+private:
+    bool loadIndex();
+    bool recoverIndex();
+    bool loadSymbols();
+    const uint8_t* record(size_t tick) const;
+    SymbolId symbol(SymbolId recorded) const {
+        return recorded < m_symbols.size() ? m_symbols[recorded] : SymbolTable::EMPTY;
+    }
+};
@@ -0,0 +1,119 @@
+#include "SpatialGrid.h"
+
+SpatialGrid::SpatialGrid(float cellSize) {
+    setCellSize(cellSize);
+}
+
+void SpatialGrid::setCellSize(float cellSize) {
+    m_cellSize = cellSize > 0.01f ? cellSize : 0.01f;
+    m_inverseCellSize = 1.0f / m_cellSize;
+    clear();
+}
+
+void SpatialGrid::insert(Slot slot, float x, float y) {
+    if (slot >= m_slots.size()) {
+        m_slots.resize(slot + 1);
+    }
+    
+    int32_t cx = cellCoord(x);
+    int32_t cy = cellCoord(y);
+    addToCell(slot, cellKey(cx, cy));
+    
+    m_minCellX = std::min(m_minCellX, cx);
+    m_minCellY = std::min(m_minCellY, cy);
+    m_maxCellX = std::max(m_maxCellX, cx);
+    m_maxCellY = std::max(m_maxCellY, cy);
+}
+
+void SpatialGrid::move(Slot slot, float x, float y) {
+    int32_t cx = cellCoord(x);
+    int32_t cy = cellCoord(y);
+    if (m_cells[m_slots[slot].cell].key == cellKey(cx, cy)) {
+        return; // Still in the same cell
+    }
+    
+    removeFromCell(slot);
+    insert(slot, x, y);
+}
+
+void SpatialGrid::remove(Slot slot) {
+    removeFromCell(slot);
+    
+    if (slot + 1 == m_slots.size()) {
+        m_slots.pop_back();
+    }
+}
+
+void SpatialGrid::relocate(Slot from, Slot to) {
+    SlotEntry entry = m_slots[from];
+    m_chunks[entry.chunk].slots[entry.index] = to;
+    
+    if (to >= m_slots.size()) {
+        m_slots.resize(to + 1);
+    }
+    m_slots[to] = entry;
+    
+    if (from + 1 == m_slots.size()) {
+        m_slots.pop_back();
+    }
+}
+
+void SpatialGrid::clear() {
+    m_slots.clear();
+    m_cells.clear();
+    m_chunks.clear();
+    m_freeChunk = NO_CHUNK;
+    m_cellIndex.clear();
+    m_minCellX = std::numeric_limits<int32_t>::max();
+    m_minCellY = std::numeric_limits<int32_t>::max();
+    m_maxCellX = std::numeric_limits<int32_t>::min();
+    m_maxCellY = std::numeric_limits<int32_t>::min();
+}
+
+void SpatialGrid::addToCell(Slot slot, uint64_t key) {
+    // Empty cells are kept so entities moving back and forth don't re-register them
+    uint32_t cell = m_cellIndex.find(key);
+    if (cell == FlatIndex::NONE) {
+        cell = static_cast<uint32_t>(m_cells.size());
+        m_cells.push_back({key, NO_CHUNK});
+        m_cellIndex.assign(key, cell);
+    }
+    
+    // Append to the front chunk, starting a new one when it is full
+    uint32_t head = m_cells[cell].head;
+    if (head == NO_CHUNK || m_chunks[head].count == CHUNK_SLOTS) {
+        uint32_t chunk = m_freeChunk;
+        if (chunk != NO_CHUNK) {
+            m_freeChunk = m_chunks[chunk].next;
+        } else {
+            chunk = static_cast<uint32_t>(m_chunks.size());
+            m_chunks.emplace_back();
+        }
+        m_chunks[chunk].count = 0;
+        m_chunks[chunk].next = head;
+        m_cells[cell].head = head = chunk;
+    }
+    
+    Chunk& front = m_chunks[head];
+    m_slots[slot] = {cell, head, front.count};
+    front.slots[front.count++] = slot;
+}
+
+void SpatialGrid::removeFromCell(Slot slot) {
+    const SlotEntry& entry = m_slots[slot];
+    Cell& cell = m_cells[entry.cell];
+    Chunk& front = m_chunks[cell.head];
+    
+    // The front chunk's last slot fills the hole
+    Slot moved = front.slots[--front.count];
+    m_chunks[entry.chunk].slots[entry.index] = moved;
+    m_slots[moved].chunk = entry.chunk;
+    m_slots[moved].index = entry.index;
+    
+    if (front.count == 0) {
+        uint32_t empty = cell.head;
+        cell.head = front.next;
+        front.next = m_freeChunk;
+        m_freeChunk = empty;
+    }
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstdint>
+#include <cmath>
+#include "FlatIndex.h"
+
+/**
+ * @class SpatialGrid
+ * @brief Uniform grid over the XY plane mapping cells to entity slots
+ *
+ * Cells are looked up by their integer coordinates in a FlatIndex, so the
+ * world does not need fixed bounds. A cell's slots sit in a short list of
+ * fixed-size chunks from one pool (the front chunk is the only partly filled
+ * one), so a cell walk reads contiguous slots, insert and remove are O(1) and
+ * the whole grid lives in flat vectors: copying it (as every snapshot of the
+ * store does) allocates nothing once the copy has grown.
+ * Range queries only visit the cells overlapping the query; the caller does
+ * the exact distance test.
+ */
+class SpatialGrid {
+public:
+    using Slot = uint32_t;
+
+private:
+    static constexpr uint32_t NO_CHUNK = 0xFFFFFFFFu;
+    static constexpr uint32_t CHUNK_SLOTS = 14;      // With count and next a chunk fills one 64-byte line
+
+    struct SlotEntry {
+        uint32_t cell = 0;      // Index into m_cells
+        uint32_t chunk = 0;     // Chunk and position holding the slot
+        uint32_t index = 0;
+    };
+
+    struct Chunk {
+        Slot slots[CHUNK_SLOTS];
+        uint32_t count = 0;
+        uint32_t next = NO_CHUNK;   // Next chunk of the cell, or of the free list
+    };
+
+    struct Cell {
+        uint64_t key = 0;
+        uint32_t head = NO_CHUNK;   // Only this chunk may be partly filled
+    };
+
+    std::vector<SlotEntry> m_slots;                        // Indexed by slot
+    std::vector<Cell> m_cells;                             // Every cell occupied since clear(), empty ones too
+    std::vector<Chunk> m_chunks;
+    uint32_t m_freeChunk = NO_CHUNK;
+    FlatIndex m_cellIndex;                                 // Cell key -> index into m_cells
+    float m_cellSize;
+    float m_inverseCellSize;
+    static constexpr int32_t MAX_CELL = 1 << 30;          // Cell coordinates are clamped to +-MAX_CELL
+
+    // Bounding box of every cell that was ever occupied (reset by clear())
+    int32_t m_minCellX = std::numeric_limits<int32_t>::max();
+    int32_t m_minCellY = std::numeric_limits<int32_t>::max();
+    int32_t m_maxCellX = std::numeric_limits<int32_t>::min();
+    int32_t m_maxCellY = std::numeric_limits<int32_t>::min();
+
+public:
+    explicit SpatialGrid(float cellSize = 16.0f);
+
+    /**
+     * @brief Change the cell size; the grid is emptied and must be refilled
+     */
+    void setCellSize(float cellSize);
+    float getCellSize() const { return m_cellSize; }
+
+    void insert(Slot slot, float x, float y);
+    void move(Slot slot, float x, float y);     // No-op if the cell did not change
+    void remove(Slot slot);
+
+    /**
+     * @brief Renumber a slot (after the store moved its last slot into a hole)
+     * @note "to" must have been removed before
+     */
+    void relocate(Slot from, Slot to);
+
+    void clear();
+    bool empty() const { return m_slots.empty(); }
+
+    int32_t cellCoord(float value) const {
+        // NaN and far-out values go to the outermost cell instead of overflowing the cast
+        float cell = std::floor(value * m_inverseCellSize);
+        if (!(cell > -static_cast<float>(MAX_CELL))) {
+            return -MAX_CELL;
+        }
+        return cell < static_cast<float>(MAX_CELL) ? static_cast<int32_t>(cell) : MAX_CELL;
+    }
+
+    /**
+     * @brief Call fn(slot) for every slot in cells overlapping the circle
+     * @return false if fn returned false (stop early), true otherwise
+     */
+    template<typename Fn>
+    bool forEachCandidate(float x, float y, float radius, Fn&& fn) const {
+        if (m_cells.empty()) {
+            return true;
+        }
+
+        int32_t minX = std::max(cellCoord(x - radius), m_minCellX);
+        int32_t maxX = std::min(cellCoord(x + radius), m_maxCellX);
+        int32_t minY = std::max(cellCoord(y - radius), m_minCellY);
+        int32_t maxY = std::min(cellCoord(y + radius), m_maxCellY);
+        if (minX > maxX || minY > maxY) {
+            return true;
+        }
+
+        // Huge radius: walking the occupied cells is cheaper than the rectangle
+        uint64_t area = static_cast<uint64_t>(maxX - minX + 1) * static_cast<uint64_t>(maxY - minY + 1);
+        if (area > m_cells.size()) {
+            for (const Cell& cell : m_cells) {
+                int32_t cx = keyX(cell.key);
+                int32_t cy = keyY(cell.key);
+                if (cx < minX || cx > maxX || cy < minY || cy > maxY) {
+                    continue;
+                }
+                if (!visitSlots(cell, fn)) return false;
+            }
+            return true;
+        }
+
+        for (int32_t cy = minY; cy <= maxY; ++cy) {
+            for (int32_t cx = minX; cx <= maxX; ++cx) {
+                if (!visitCell(cx, cy, fn)) return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Call fn(slot) for every slot in the square ring of cells at Chebyshev
+     *        distance "ring" around (centerX, centerY); used for nearest-neighbour search
+     * @return false if fn stopped early
+     */
+    template<typename Fn>
+    bool forEachInRing(int32_t centerX, int32_t centerY, int32_t ring, Fn&& fn) const {
+        if (ring == 0) {
+            return visitCell(centerX, centerY, fn);
+        }
+
+        // Walk the perimeter clockwise from the top-left corner; one call site keeps the visit inlined
+        static constexpr int32_t STEP_X[4] = {1, 0, -1, 0};
+        static constexpr int32_t STEP_Y[4] = {0, 1, 0, -1};
+        int32_t cx = centerX - ring;
+        int32_t cy = centerY - ring;
+        for (int side = 0; side < 4; ++side) {
+            for (int32_t step = 0; step < 2 * ring; ++step) {
+                if (!visitCell(cx, cy, fn)) return false;
+                cx += STEP_X[side];
+                cy += STEP_Y[side];
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Whether a ring around the cell still overlaps any occupied cell
+     */
+    bool ringInBounds(int32_t centerX, int32_t centerY, int32_t ring) const {
+        // Once the occupied box lies strictly inside the ring, this and all larger rings are empty
+        return !(centerX - ring < m_minCellX && centerX + ring > m_maxCellX &&
+                 centerY - ring < m_minCellY && centerY + ring > m_maxCellY);
+    }
+
+private:
+    static uint64_t cellKey(int32_t cx, int32_t cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+    static int32_t keyX(uint64_t key) { return static_cast<int32_t>(static_cast<uint32_t>(key >> 32)); }
+    static int32_t keyY(uint64_t key) { return static_cast<int32_t>(static_cast<uint32_t>(key)); }
+
+    template<typename Fn>
+    bool visitCell(int32_t cx, int32_t cy, Fn& fn) const {
+        uint32_t cell = m_cellIndex.find(cellKey(cx, cy));
+        return cell == FlatIndex::NONE || visitSlots(m_cells[cell], fn);
+    }
+
+    template<typename Fn>
+    bool visitSlots(const Cell& cell, Fn& fn) const {
+        for (uint32_t chunk = cell.head; chunk != NO_CHUNK; chunk = m_chunks[chunk].next) {
+            const Chunk& entry = m_chunks[chunk];
+            for (uint32_t i = 0; i < entry.count; ++i) {
+                if (!fn(entry.slots[i])) return false;
+            }
+        }
+        return true;
+    }
+
+    void addToCell(Slot slot, uint64_t key);
+    void removeFromCell(Slot slot);
+};
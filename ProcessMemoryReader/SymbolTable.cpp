@@ -0,0 +1,49 @@
+#include "SymbolTable.h"
+
+SymbolTable::SymbolTable() {
+    intern("");
+}
+
+SymbolTable& SymbolTable::global() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolId SymbolTable::intern(std::string_view text) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_lookup.find(text);
+    if (it != m_lookup.end()) {
+        return it->second;
+    }
+
+    uint32_t id = m_size.load(std::memory_order_relaxed);
+    size_t chunk = id >> CHUNK_BITS;
+    if (chunk >= MAX_CHUNKS) {
+        return EMPTY;
+    }
+    if (!m_chunks[chunk]) {
+        m_chunks[chunk] = std::make_unique<std::string[]>(CHUNK_SIZE);
+    }
+
+    std::string& stored = m_chunks[chunk][id & (CHUNK_SIZE - 1)];
+    stored.assign(text.data(), text.size());
+    m_lookup.emplace(std::string_view(stored), id);
+    m_size.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view text) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_lookup.find(text);
+    return it != m_lookup.end() ? it->second : NOT_FOUND;
+}
+
+uint64_t SymbolTable::hash(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Interned string id; 0 is the empty string
+ */
+using SymbolId = uint32_t;
+
+/**
+ * @class SymbolTable
+ * @brief Process-wide, append-only string interning table
+ *
+ * Entity names, item types and affixes are stored once here and carried
+ * everywhere else as a 32-bit SymbolId, so copying an entity or a snapshot
+ * never touches a string and equality is an integer compare.
+ *
+ * intern() and find() take a lock. name() does not: strings live in fixed
+ * chunks that are never moved or freed, and an id is only handed out after
+ * its string is in place, so any thread that received the id (e.g. through a
+ * published WorldSnapshot) can resolve it.
+ */
+class SymbolTable {
+public:
+    static constexpr SymbolId EMPTY = 0;
+    static constexpr SymbolId NOT_FOUND = 0xFFFFFFFFu;
+
+private:
+    static constexpr size_t CHUNK_BITS = 12;
+    static constexpr size_t CHUNK_SIZE = size_t{1} << CHUNK_BITS;
+    static constexpr size_t MAX_CHUNKS = 1024;                  // 4M symbols
+
+    std::unique_ptr<std::string[]> m_chunks[MAX_CHUNKS];
+    std::atomic<uint32_t> m_size{0};
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string_view, SymbolId> m_lookup;    // Views into m_chunks
+
+public:
+    SymbolTable();
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /**
+     * @brief The table shared by the reader thread and the decision loop
+     */
+    static SymbolTable& global();
+
+    /**
+     * @brief Id of text, adding it on first sight
+     * @return EMPTY if the table is full
+     */
+    SymbolId intern(std::string_view text);
+
+    /**
+     * @brief Id of text if it was interned before, NOT_FOUND otherwise
+     */
+    SymbolId find(std::string_view text) const;
+
+    const std::string& name(SymbolId id) const { return m_chunks[id >> CHUNK_BITS][id & (CHUNK_SIZE - 1)]; }
+    size_t size() const { return m_size.load(std::memory_order_acquire); }
+
+    /**
+     * @brief 64-bit FNV-1a, used to recognise remote strings that did not change
+     */
+    static uint64_t hash(const char* data, size_t length);
+};
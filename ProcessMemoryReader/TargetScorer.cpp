@@ -0,0 +1,143 @@
+#include "TargetScorer.h"
+#include <algorithm>
+#include <limits>
+
+#include <emmintrin.h>
+
+namespace {
+    constexpr float NOT_A_TARGET = -std::numeric_limits<float>::infinity();
+}
+
+TargetScorer::Result TargetScorer::scoreAll(const EntityStore& store, const Query& query,
+                                            std::vector<float>& scores) const {
+    size_t count = store.size();
+    scores.resize(count);
+    buildTables(query);
+    const float* typeBonus = m_typeBonus;
+    const float* flagBonus = m_flagBonus;
+
+    const float* xs = store.xs();
+    const float* ys = store.ys();
+    const float* healths = store.healths();
+    const float* maxHealths = store.maxHealths();
+    const float* threats = store.threatLevels();
+    const uint8_t* types = reinterpret_cast<const uint8_t*>(store.types());
+    const uint8_t* flags = store.flags();
+
+    float rangeSquared = query.range * query.range;
+    float inverseRange = rangeSquared > 0 ? 1.0f / rangeSquared : 0.0f;
+
+    const __m128 px = _mm_set1_ps(query.x);
+    const __m128 py = _mm_set1_ps(query.y);
+    const __m128 limit = _mm_set1_ps(rangeSquared);
+    const __m128 inverse = _mm_set1_ps(inverseRange);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 tiny = _mm_set1_ps(1e-6f);
+    const __m128 excluded = _mm_set1_ps(NOT_A_TARGET);
+    const __m128 distanceWeight = _mm_set1_ps(m_weights.distance);
+    const __m128 healthWeight = _mm_set1_ps(m_weights.lowHealth);
+    const __m128 threatWeight = _mm_set1_ps(m_weights.threat);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(xs + i), px);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(ys + i), py);
+        __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 inRange = _mm_cmple_ps(distanceSquared, limit);
+        __m128 closeness = _mm_sub_ps(one, _mm_mul_ps(distanceSquared, inverse));
+
+        __m128 maxHealth = _mm_loadu_ps(maxHealths + i);
+        __m128 fraction = _mm_div_ps(_mm_loadu_ps(healths + i), _mm_max_ps(maxHealth, tiny));
+        __m128 missing = _mm_min_ps(one, _mm_max_ps(zero, _mm_sub_ps(one, fraction)));
+        missing = _mm_and_ps(missing, _mm_cmpgt_ps(maxHealth, zero));
+
+        __m128 bonus = _mm_set_ps(typeBonus[types[i + 3]] + flagBonus[flags[i + 3]],
+                                  typeBonus[types[i + 2]] + flagBonus[flags[i + 2]],
+                                  typeBonus[types[i + 1]] + flagBonus[flags[i + 1]],
+                                  typeBonus[types[i]] + flagBonus[flags[i]]);
+
+        __m128 score = _mm_add_ps(_mm_mul_ps(distanceWeight, closeness), _mm_mul_ps(healthWeight, missing));
+        score = _mm_add_ps(score, _mm_mul_ps(threatWeight, _mm_loadu_ps(threats + i)));
+        score = _mm_add_ps(score, bonus);
+        score = _mm_or_ps(_mm_and_ps(inRange, score), _mm_andnot_ps(inRange, excluded));
+        _mm_storeu_ps(scores.data() + i, score);
+    }
+    for (; i < count; ++i) {
+        scores[i] = score(store, static_cast<Slot>(i), query);
+    }
+
+    Result result;
+    result.score = NOT_A_TARGET;
+    for (size_t slot = 0; slot < count; ++slot) {
+        float value = scores[slot];
+        if (value > NOT_A_TARGET) {
+            ++result.candidates;
+            if (value > result.score) {
+                result.score = value;
+                result.slot = static_cast<Slot>(slot);
+            }
+        }
+    }
+    return result;
+}
+
+void TargetScorer::buildTables(const Query& query) const {
+    if (m_tablesValid && m_tableTypeMask == query.typeMask && m_tableFlags == query.requiredFlags) {
+        return;
+    }
+
+    // Type and flags are bytes, so two lookups replace the mask tests and bonus branches
+    for (int value = 0; value < 256; ++value) {
+        bool typeAllowed = value < 32 && ((query.typeMask >> value) & 1) != 0;
+        m_typeBonus[value] = !typeAllowed ? NOT_A_TARGET :
+                             value == static_cast<int>(EntityType::BOSS) ? m_weights.boss : 0.0f;
+        bool flagsPresent = (value & query.requiredFlags) == query.requiredFlags;
+        m_flagBonus[value] = !flagsPresent ? NOT_A_TARGET :
+                             (value & EntityStore::FLAG_ELITE) ? m_weights.elite : 0.0f;
+    }
+    m_tableTypeMask = query.typeMask;
+    m_tableFlags = query.requiredFlags;
+    m_tablesValid = true;
+}
+
+TargetScorer::Result TargetScorer::findBest(const EntityStore& store, const Query& query, uint64_t currentTarget) const {
+    Result result = scoreAll(store, query, m_scores);
+
+    // Keep the current target unless another one is clearly better
+    Slot current = currentTarget != 0 ? store.find(currentTarget) : EntityStore::INVALID_SLOT;
+    if (current != EntityStore::INVALID_SLOT && m_scores[current] > NOT_A_TARGET &&
+        m_scores[current] + m_weights.stickiness >= result.score) {
+        result.slot = current;
+        result.score = m_scores[current] + m_weights.stickiness;
+    }
+    return result;
+}
+
+float TargetScorer::score(const EntityStore& store, Slot slot, const Query& query) const {
+    if (!store.matchesType(slot, query.typeMask) || !store.hasFlags(slot, query.requiredFlags)) {
+        return NOT_A_TARGET;
+    }
+
+    float dx = store.xs()[slot] - query.x;
+    float dy = store.ys()[slot] - query.y;
+    float distanceSquared = dx * dx + dy * dy;
+    float rangeSquared = query.range * query.range;
+    if (distanceSquared > rangeSquared) {
+        return NOT_A_TARGET;
+    }
+
+    float maxHealth = store.maxHealths()[slot];
+    float missing = maxHealth > 0 ? std::min(1.0f, std::max(0.0f, 1.0f - store.healths()[slot] / std::max(maxHealth, 1e-6f))) : 0.0f;
+    float closeness = 1.0f - distanceSquared * (rangeSquared > 0 ? 1.0f / rangeSquared : 0.0f);
+
+    float value = m_weights.distance * closeness + m_weights.lowHealth * missing +
+                  m_weights.threat * store.threatLevels()[slot];
+    if (store.hasFlags(slot, EntityStore::FLAG_ELITE)) {
+        value += m_weights.elite;
+    }
+    if (store.types()[slot] == EntityType::BOSS) {
+        value += m_weights.boss;
+    }
+    return value;
+}
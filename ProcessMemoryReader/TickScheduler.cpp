@@ -0,0 +1,101 @@
+#include "TickScheduler.h"
+#include <thread>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+TickScheduler::TickScheduler(Clock::duration period)
+    : m_period(period), m_deadline(Clock::now() + period) {
+    // High-resolution timers need Windows 10 1803+; older systems get a regular one
+    m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    m_highResolution = m_timer != nullptr;
+
+    if (!m_timer) {
+        m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+    }
+}
+
+TickScheduler::~TickScheduler() {
+    if (m_timer) {
+        CloseHandle(m_timer);
+    }
+}
+
+void TickScheduler::setPeriod(Clock::duration period) {
+    if (period == m_period) {
+        return;
+    }
+
+    // m_deadline is always one old period after the last tick, both when waiting and after an overrun
+    m_deadline += period - m_period;
+    m_period = period;
+}
+
+void TickScheduler::reset() {
+    m_deadline = Clock::now() + m_period;
+}
+
+void TickScheduler::waitNextTick() {
+    m_ticks.fetch_add(1, std::memory_order_relaxed);
+
+    auto now = Clock::now();
+    if (now >= m_deadline) {
+        // The tick overran: run the next one right away and drop the deadlines it missed
+        m_overruns.fetch_add(1, std::memory_order_relaxed);
+        if (m_period > Clock::duration::zero()) {
+            m_missed.fetch_add(static_cast<uint64_t>((now - m_deadline) / m_period), std::memory_order_relaxed);
+        }
+        m_deadline = now + m_period;
+        return;
+    }
+
+    sleepUntil(m_deadline);
+
+    auto jitterUs = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - m_deadline).count();
+    if (jitterUs < 0) {
+        jitterUs = 0;
+    }
+    m_totalJitterUs.fetch_add(jitterUs, std::memory_order_relaxed);
+    if (jitterUs > m_maxJitterUs.load(std::memory_order_relaxed)) {
+        m_maxJitterUs.store(jitterUs, std::memory_order_relaxed);
+    }
+
+    m_deadline += m_period;
+}
+
+void TickScheduler::sleepUntil(Clock::time_point time) {
+    auto remaining = time - Clock::now();
+    if (remaining <= Clock::duration::zero()) {
+        return;
+    }
+
+    if (m_timer) {
+        // Negative due time = relative, in 100 ns units
+        LARGE_INTEGER dueTime;
+        dueTime.QuadPart = -static_cast<LONGLONG>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count() / 100);
+
+        if (SetWaitableTimer(m_timer, &dueTime, 0, nullptr, nullptr, FALSE)) {
+            WaitForSingleObject(m_timer, INFINITE);
+            return;
+        }
+    }
+
+    std::this_thread::sleep_until(time);
+}
+
+TickScheduler::Statistics TickScheduler::getStatistics() const {
+    Statistics stats;
+    stats.ticks = m_ticks.load(std::memory_order_relaxed);
+    stats.overruns = m_overruns.load(std::memory_order_relaxed);
+    stats.missedTicks = m_missed.load(std::memory_order_relaxed);
+    stats.maxJitterMs = m_maxJitterUs.load(std::memory_order_relaxed) / 1000.0;
+
+    uint64_t waited = stats.ticks - stats.overruns;
+    if (waited > 0) {
+        stats.averageJitterMs = m_totalJitterUs.load(std::memory_order_relaxed) / 1000.0 / waited;
+    }
+
+    return stats;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <Windows.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @class TickScheduler
+ * @brief Fixed-rate deadlines for the decision loop
+ *
+ * Deadlines advance by the period from the previous deadline rather than from
+ * the end of the work, so the tick rate does not drift with the time a tick
+ * takes. A tick that overruns its deadline is counted and the schedule is
+ * re-anchored to now (missed ticks are dropped instead of run back to back).
+ * Waiting uses a high-resolution waitable timer where available, which wakes
+ * within well under a millisecond instead of the 1-15.6 ms of sleep_for.
+ */
+class TickScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Statistics {
+        uint64_t ticks = 0;
+        uint64_t overruns = 0;         // Ticks whose work ran past the next deadline
+        uint64_t missedTicks = 0;      // Deadlines skipped because of overruns
+        double averageJitterMs = 0.0;  // Mean wake-up lateness
+        double maxJitterMs = 0.0;
+    };
+
+private:
+    HANDLE m_timer = nullptr;
+    bool m_highResolution = false;
+
+    Clock::duration m_period;
+    Clock::time_point m_deadline;
+
+    // Statistics (written by the ticking thread, read from anywhere)
+    std::atomic<uint64_t> m_ticks{0};
+    std::atomic<uint64_t> m_overruns{0};
+    std::atomic<uint64_t> m_missed{0};
+    std::atomic<int64_t> m_totalJitterUs{0};
+    std::atomic<int64_t> m_maxJitterUs{0};
+
+public:
+    explicit TickScheduler(Clock::duration period = std::chrono::milliseconds(50));
+    ~TickScheduler();
+
+    TickScheduler(const TickScheduler&) = delete;
+    TickScheduler& operator=(const TickScheduler&) = delete;
+
+    /**
+     * @brief Change the tick period; the pending deadline moves to one new period after the last tick
+     * A shorter period whose deadline has already passed runs the next tick right away (counted as an overrun).
+     */
+    void setPeriod(Clock::duration period);
+    Clock::duration getPeriod() const { return m_period; }
+
+    /**
+     * @brief Start a new schedule with the first deadline one period from now
+     * Call after a deliberate pause (back-off, re-attach) so it is not counted as an overrun.
+     */
+    void reset();
+
+    /**
+     * @brief Wait for the next deadline and advance the schedule
+     */
+    void waitNextTick();
+
+    /**
+     * @brief Sleep until a point in time with the same timer as the ticks
+     */
+    void sleepUntil(Clock::time_point time);
+
+    bool isHighResolution() const { return m_highResolution; }
+    Statistics getStatistics() const;
+};
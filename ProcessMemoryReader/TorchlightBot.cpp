@@ -2,19 +2,68 @@
 #include "GameState.h"
 #include "NavigationSystem.h"
 #include "LootFilter.h"
+#include "LootRoutePlanner.h"
 #include "CombatSystem.h"
 #include "EntityManager.h"
 #include "Logger.h"
 #include "ConfigManager.h"
 #include "InputManager.h"
+#include "PatternScanner.h"
+#include "ProcessWatcher.h"
+#include "SignatureCache.h"
+#include "OffsetManager.h"
+#include "SnapshotReader.h"
+#include "SnapshotRecorder.h"
+#include "TickScheduler.h"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 
+namespace {
+    // Common Torchlight Infinity process names
+    const std::vector<std::string> GAME_PROCESS_NAMES = {
+        "Torchlight3.exe",
+        "TorchlightInfinity.exe",
+        "TL3.exe",
+        "Game.exe"
+    };
+    
+    Logger::LogLevel parseLogLevel(const std::string& level) {
+        if (level == "debug") return Logger::LogLevel::DEBUG;
+        if (level == "warning") return Logger::LogLevel::WARNING;
+        if (level == "error") return Logger::LogLevel::ERROR;
+        if (level == "critical") return Logger::LogLevel::CRITICAL;
+        return Logger::LogLevel::INFO;
+    }
+    
+    CombatSystem::TacticsMode parseTactics(const std::string& tactics) {
+        if (tactics == "aggressive") return CombatSystem::TacticsMode::AGGRESSIVE;
+        if (tactics == "defensive") return CombatSystem::TacticsMode::DEFENSIVE;
+        if (tactics == "boss_only") return CombatSystem::TacticsMode::BOSS_ONLY;
+        return CombatSystem::TacticsMode::BALANCED;
+    }
+}
+
 TorchlightBot::TorchlightBot() {
     // Initialize all subsystems
     m_logger = std::make_unique<Logger>();
     m_config = std::make_unique<ConfigManager>();
     m_process = std::make_unique<Process>();
+    m_watcher = std::make_unique<ProcessWatcher>(GAME_PROCESS_NAMES);
+    m_profiler = std::make_unique<Profiler>();
+    
+    m_tickZone = m_profiler->addZone("TorchlightBot::tick");
+    m_stateZones[static_cast<size_t>(BotState::IDLE)] = m_profiler->addZone("TorchlightBot::idle");
+    m_stateZones[static_cast<size_t>(BotState::FARMING)] = m_profiler->addZone("TorchlightBot::handleFarming");
+    m_stateZones[static_cast<size_t>(BotState::COMBAT)] = m_profiler->addZone("TorchlightBot::handleCombat");
+    m_stateZones[static_cast<size_t>(BotState::LOOTING)] = m_profiler->addZone("TorchlightBot::handleLooting");
+    m_stateZones[static_cast<size_t>(BotState::NAVIGATING)] = m_profiler->addZone("TorchlightBot::handleNavigation");
+    m_stateZones[static_cast<size_t>(BotState::BOSS_FIGHT)] = m_profiler->addZone("TorchlightBot::handleBossFight");
+    m_stateZones[static_cast<size_t>(BotState::SEASONAL_ACTIVITY)] = m_profiler->addZone("TorchlightBot::handleSeasonalActivity");
+    m_stateZones[static_cast<size_t>(BotState::ERROR)] = m_profiler->addZone("TorchlightBot::handleError");
+    m_lootFilterZone = m_profiler->addZone("LootFilter::filterItems");
+    m_lootRouteZone = m_profiler->addZone("LootRoutePlanner::plan");
+    m_navigationZone = m_profiler->addZone("NavigationSystem::update");
     
     m_logger->info("TorchlightBot initialized");
 }
@@ -31,6 +80,7 @@ bool TorchlightBot::initialize() {
     if (!m_config->loadConfig()) {
         m_logger->warning("Could not load config, using defaults");
     }
+    applyLoggingConfig(m_config->getConfig());
     
     // Attach to game process
     if (!attachToGame()) {
@@ -40,33 +90,53 @@ bool TorchlightBot::initialize() {
     
     // Initialize memory reader
     m_memory = std::make_unique<Memory>(m_process.get());
+    m_memory->enablePageCache(m_config->getConfig().enablePageCache);
     
-    // Initialize game state
+    // Initialize game state and entity manager
+    const auto& botConfig = m_config->getConfig();
+    m_scanner = std::make_unique<PatternScanner>(m_memory.get());
     m_gameState = std::make_unique<GameState>(m_memory.get());
-    if (!m_gameState->findGameAddresses()) {
-        m_logger->error("Failed to find game memory addresses");
+    m_gameState->setPatternScanner(m_scanner.get());
+    m_entityManager = std::make_unique<EntityManager>(m_memory.get(), m_gameState.get());
+    m_entityManager->setPatternScanner(m_scanner.get());
+    m_entityManager->setUpdateRadius(botConfig.updateRadius);
+    
+    if (!discoverAddresses(*m_gameState, *m_entityManager)) {
         return false;
     }
     
-    // Initialize entity manager
-    m_entityManager = std::make_unique<EntityManager>(m_memory.get(), m_gameState.get());
-    if (!m_entityManager->findEntityList()) {
-        m_logger->warning("Entity list not found, will retry during runtime");
+    // Memory reads move to the snapshot reader; the decision loop works on
+    // copies fed from its snapshots and never reads game memory itself
+    m_snapshotReader = std::make_unique<SnapshotReader>(
+        m_memory.get(), std::move(m_gameState), std::move(m_entityManager));
+    m_snapshotReader->setProfiler(m_profiler.get());
+    if (!botConfig.snapshotRecordFile.empty()) {
+        m_recorder = std::make_unique<SnapshotRecorder>();
+        if (m_recorder->open(botConfig.snapshotRecordFile)) {
+            m_snapshotReader->setRecorder(m_recorder.get());
+            m_logger->info("Recording world snapshots to " + botConfig.snapshotRecordFile);
+        } else {
+            m_logger->warning("Could not create snapshot recording " + botConfig.snapshotRecordFile);
+            m_recorder.reset();
+        }
     }
+    m_gameState = std::make_unique<GameState>(m_memory.get());
+    m_entityManager = std::make_unique<EntityManager>(m_memory.get(), m_gameState.get());
     
     // Initialize input manager
-    auto inputManager = std::make_unique<InputManager>();
-    if (!inputManager->initialize()) {
+    m_inputManager = std::make_unique<InputManager>();
+    if (!m_inputManager->initialize()) {
         m_logger->error("Failed to initialize input manager");
         return false;
     }
     
     // Store the input manager pointer for other systems
-    InputManager* inputPtr = inputManager.get();
+    InputManager* inputPtr = m_inputManager.get();
     
     // Initialize navigation system
     m_navigation = std::make_unique<NavigationSystem>(
         m_gameState.get(), m_entityManager.get(), inputPtr);
+    m_navigation->setProfiler(m_profiler.get());
     
     // Initialize combat system
     m_combat = std::make_unique<CombatSystem>(
@@ -74,12 +144,37 @@ bool TorchlightBot::initialize() {
     
     // Initialize loot filter
     m_lootFilter = std::make_unique<LootFilter>();
-    
-    // Apply configuration
-    const auto& config = m_config->getConfig();
-    m_tickRate = std::chrono::milliseconds(config.tickRate);
-    setFarmMode(config.farmMode == "aggressive" ? FarmMode::AGGRESSIVE :
-                config.farmMode == "safe" ? FarmMode::SAFE : FarmMode::BALANCED);
+    m_lootRoute = std::make_unique<LootRoutePlanner>();
+    
+    // React to entity set changes instead of re-querying every tick
+    m_entityManager->subscribe([this](const EntityEvents& events) {
+        m_combat->onEntityEvents(events);
+        for (const EntityEvent& event : events.despawned) {
+            if (event.type == EntityType::ITEM) {
+                // A despawned item was picked up (or vanished): only now does it leave the route
+                m_lootFilter->forgetItem(event.id);
+                m_lootRoute->markCollected(event.id);
+                if (event.id == m_pendingPickup) {
+                    m_pendingPickup = 0;
+                }
+            }
+        }
+    });
+    
+    // Apply configuration; later edits arrive as published snapshots at tick boundaries
+    m_configVersion = m_config->getVersion();
+    m_activeConfig = m_config->getSnapshot();
+    applyConfig(*m_activeConfig, nullptr);
+    m_tickScheduler = std::make_unique<TickScheduler>(m_tickRate);
+    if (!m_tickScheduler->isHighResolution()) {
+        m_logger->warning("High-resolution timer unavailable, tick timing falls back to the system timer");
+    }
+    if (!m_activeConfig->chromeTraceFile.empty() && !m_profiler->startTrace(m_activeConfig->chromeTraceFile)) {
+        m_logger->warning("Could not open trace file " + m_activeConfig->chromeTraceFile);
+    }
+    if (!m_config->startWatching()) {
+        m_logger->warning("Cannot watch " + m_config->getConfigFile() + ", settings only change on restart");
+    }
     
     m_logger->info("TorchlightBot initialization complete");
     return true;
@@ -95,6 +190,11 @@ void TorchlightBot::start() {
     m_running = true;
     m_currentState = BotState::FARMING;
     
+    // Capture one snapshot up front so the first tick sees real data
+    m_snapshotReader->capture();
+    updateGameState();
+    m_snapshotReader->start(m_snapshotInterval);
+    
     // Start main bot thread
     m_botThread = std::thread(&TorchlightBot::botMainLoop, this);
 }
@@ -106,11 +206,23 @@ void TorchlightBot::stop() {
     
     m_logger->info("Stopping TorchlightBot");
     m_running = false;
+    m_watcher->cancel();    // The bot thread may be waiting for the client to restart
     
     if (m_botThread.joinable()) {
         m_botThread.join();
     }
     
+    // Queued input would otherwise keep playing out after the bot stopped
+    if (m_inputManager) {
+        m_inputManager->cancelPendingInput();
+    }
+    
+    if (m_snapshotReader) {
+        m_snapshotReader->stop();
+    }
+    
+    dumpProfile();
+    
     m_currentState = BotState::IDLE;
     m_logger->info("TorchlightBot stopped");
 }
@@ -141,6 +253,31 @@ TorchlightBot::Statistics TorchlightBot::getStatistics() const {
         stats.itemsLooted = m_lootFilter->getItemsLooted();
     }
     
+    if (m_snapshotReader) {
+        auto readerStats = m_snapshotReader->getStatistics();
+        stats.snapshotsRead = readerStats.snapshotsPublished;
+        stats.averageReadMs = readerStats.averageReadMs;
+    }
+    stats.decisionTicks = m_decisionTicks.load();
+    stats.gameRestarts = m_gameRestarts.load();
+    stats.lastDowntimeMs = m_lastDowntimeMs.load();
+    
+    if (m_tickScheduler) {
+        auto tickStats = m_tickScheduler->getStatistics();
+        stats.tickOverruns = tickStats.overruns;
+        stats.missedTicks = tickStats.missedTicks;
+        stats.averageTickJitterMs = tickStats.averageJitterMs;
+        stats.maxTickJitterMs = tickStats.maxJitterMs;
+    }
+    
+    auto profile = m_profiler->getStatistics();
+    stats.profileZones = std::move(profile.zones);
+    stats.memoryReadCalls = profile.counters[static_cast<size_t>(Profiler::Counter::READ_CALLS)];
+    stats.bytesRead = profile.counters[static_cast<size_t>(Profiler::Counter::BYTES_READ)];
+    stats.failedReads = profile.counters[static_cast<size_t>(Profiler::Counter::FAILED_READS)];
+    stats.pageCacheHits = profile.counters[static_cast<size_t>(Profiler::Counter::PAGE_CACHE_HITS)];
+    stats.pageCacheMisses = profile.counters[static_cast<size_t>(Profiler::Counter::PAGE_CACHE_MISSES)];
+    
     // Calculate runtime
     static auto startTime = std::chrono::steady_clock::now();
     auto now = std::chrono::steady_clock::now();
@@ -149,58 +286,57 @@ TorchlightBot::Statistics TorchlightBot::getStatistics() const {
     return stats;
 }
 
+std::chrono::milliseconds TorchlightBot::getTickRate(BotState state) const {
+    switch (state) {
+        case BotState::COMBAT:
+        case BotState::BOSS_FIGHT:
+            return m_combatTickRate;
+        case BotState::NAVIGATING:
+            return m_navigationTickRate;
+        case BotState::IDLE:
+            return m_idleTickRate;
+        default:
+            return m_tickRate;
+    }
+}
+
 void TorchlightBot::botMainLoop() {
     m_logger->info("Bot main loop started");
     
+    m_tickScheduler->setPeriod(getTickRate(m_currentState));
+    m_tickScheduler->reset();
+    auto lastProfileDump = std::chrono::steady_clock::now();
+    
     while (m_running) {
         try {
+            // A lost client is recovered right away, not after the validation back-off
+            if (!isProcessAlive()) {
+                setState(BotState::ERROR);
+                handleError();
+                m_tickScheduler->reset();
+                continue;
+            }
+            
             // Validate game state
             if (!isGameValid()) {
                 m_logger->error("Game validation failed");
                 setState(BotState::ERROR);
                 std::this_thread::sleep_for(std::chrono::seconds(5));
+                m_tickScheduler->reset();   // Deliberate back-off, not an overrun
                 continue;
             }
             
-            // Update all subsystems
-            updateGameState();
+            runTick();
             
-            // Handle current state
-            switch (m_currentState) {
-                case BotState::IDLE:
-                    std::this_thread::sleep_for(std::chrono::seconds(1));
-                    break;
-                    
-                case BotState::FARMING:
-                    handleFarming();
-                    break;
-                    
-                case BotState::COMBAT:
-                    handleCombat();
-                    break;
-                    
-                case BotState::LOOTING:
-                    handleLooting();
-                    break;
-                    
-                case BotState::NAVIGATING:
-                    handleNavigation();
-                    break;
-                    
-                case BotState::BOSS_FIGHT:
-                    handleBossFight();
-                    break;
-                    
-                case BotState::SEASONAL_ACTIVITY:
-                    handleSeasonalActivity();
-                    break;
-                    
-                case BotState::ERROR:
-                    handleError();
-                    break;
+            if (m_profileDumpInterval.count() > 0 && 
+                std::chrono::steady_clock::now() - lastProfileDump >= m_profileDumpInterval) {
+                dumpProfile();
+                lastProfileDump = std::chrono::steady_clock::now();
             }
             
-            std::this_thread::sleep_for(m_tickRate);
+            // Deadline-based: the time the tick took is not added on top of the period
+            m_tickScheduler->setPeriod(getTickRate(m_currentState));
+            m_tickScheduler->waitNextTick();
         }
         catch (const std::exception& e) {
             m_logger->error("Exception in bot main loop: %s", e.what());
@@ -211,38 +347,209 @@ void TorchlightBot::botMainLoop() {
     m_logger->info("Bot main loop ended");
 }
 
+void TorchlightBot::runTick() {
+    ProfileScope tickScope(m_profiler.get(), m_tickZone);
+    
+    // Settings edited since the last tick (parsed off-thread; one integer compare otherwise)
+    checkConfigReload();
+    
+    // Pick up the latest world snapshot (never blocks on memory reads)
+    updateGameState();
+    m_decisionTicks++;
+    
+    // Handle current state
+    BotState state = m_currentState;
+    ProfileScope stateScope(m_profiler.get(), m_stateZones[static_cast<size_t>(state)]);
+    switch (state) {
+        case BotState::IDLE:
+            break;  // Polled at the idle tick rate
+            
+        case BotState::FARMING:
+            handleFarming();
+            break;
+            
+        case BotState::COMBAT:
+            handleCombat();
+            break;
+            
+        case BotState::LOOTING:
+            handleLooting();
+            break;
+            
+        case BotState::NAVIGATING:
+            handleNavigation();
+            break;
+            
+        case BotState::BOSS_FIGHT:
+            handleBossFight();
+            break;
+            
+        case BotState::SEASONAL_ACTIVITY:
+            handleSeasonalActivity();
+            break;
+            
+        case BotState::ERROR:
+            handleError();
+            break;
+    }
+}
+
+void TorchlightBot::dumpProfile() {
+    auto profile = m_profiler->getStatistics();
+    for (const auto& zone : profile.zones) {
+        TL_LOG_INFO(*m_logger, "PROFILE %s: n=%llu avg=%.3f p50=%.3f p99=%.3f max=%.3f ms",
+                    zone.name, zone.count, zone.averageMs, zone.p50Ms, zone.p99Ms, zone.maxMs);
+    }
+    for (size_t i = 0; i < profile.counters.size(); ++i) {
+        auto counter = static_cast<Profiler::Counter>(i);
+        m_logger->logPerformance(std::string("memory.") + Profiler::counterName(counter),
+                                 static_cast<double>(profile.counters[i]));
+    }
+    if (profile.traceEventsDropped > 0) {
+        m_logger->logPerformance("profiler.trace_events_dropped", static_cast<double>(profile.traceEventsDropped));
+    }
+    
+    m_profiler->flushTrace();
+}
+
+void TorchlightBot::checkConfigReload() {
+    uint64_t version = m_config->getVersion();
+    if (version == m_configVersion) {
+        return;
+    }
+    m_configVersion = version;
+    
+    std::shared_ptr<const ConfigManager::BotConfig> config = m_config->getSnapshot();
+    if (config == m_activeConfig) {
+        return;
+    }
+    
+    applyConfig(*config, m_activeConfig.get());
+    m_activeConfig = std::move(config);
+    m_logger->info("Configuration reloaded");
+}
+
+void TorchlightBot::applyLoggingConfig(const ConfigManager::BotConfig& config) {
+    m_logger->setOverflowPolicy(config.logOverflowPolicy == "block"
+                                    ? Logger::OverflowPolicy::BLOCK
+                                    : Logger::OverflowPolicy::DROP);
+    m_logger->setFlushInterval(std::chrono::milliseconds(config.logFlushIntervalMs));
+    m_logger->setMinLogLevel(parseLogLevel(config.logLevel));
+}
+
+void TorchlightBot::applyConfig(const ConfigManager::BotConfig& config, const ConfigManager::BotConfig* previous) {
+    using BotConfig = ConfigManager::BotConfig;
+    
+    // Only what changed is touched, so a reload keeps path caches, loot decisions and combat state
+    auto changed = [&](auto BotConfig::* field) { return !previous || previous->*field != config.*field; };
+    
+    applyLoggingConfig(config);
+    
+    // Tick rates take effect with the next deadline
+    m_tickRate = std::chrono::milliseconds(config.tickRate);
+    m_combatTickRate = std::chrono::milliseconds(config.combatTickRate);
+    m_navigationTickRate = std::chrono::milliseconds(config.navigationTickRate);
+    m_idleTickRate = std::chrono::milliseconds(config.idleTickRate);
+    m_snapshotInterval = std::chrono::milliseconds(config.snapshotIntervalMs);
+    m_snapshotReader->setInterval(m_snapshotInterval);
+    m_watcher->setScanInterval(std::chrono::milliseconds(config.processScanIntervalMs));
+    m_profileDumpInterval = std::chrono::seconds(config.profileDumpIntervalSec);
+    
+    if (changed(&BotConfig::maxPathExpansions)) {
+        m_navigation->setMaxPathExpansions(static_cast<size_t>(std::max(config.maxPathExpansions, 0)));
+    }
+    if (changed(&BotConfig::pathCacheSize)) {
+        m_navigation->setPathCacheSize(static_cast<size_t>(std::max(config.pathCacheSize, 0)));
+    }
+    if (changed(&BotConfig::lootRouteBudgetUs)) {
+        m_lootRoute->setTimeBudget(std::chrono::microseconds(std::max(config.lootRouteBudgetUs, 0)));
+    }
+    if (changed(&BotConfig::lootRoutePriorityWeight)) {
+        m_lootRoute->setPriorityWeight(config.lootRoutePriorityWeight);
+    }
+    
+    // The preset sets the rules; the explicit thresholds override the preset's own
+    if (changed(&BotConfig::lootFilter) || changed(&BotConfig::minimumRarity) || changed(&BotConfig::minimumLevel) ||
+        changed(&BotConfig::minimumValue) || changed(&BotConfig::enableSeasonalLoot)) {
+        if (config.lootFilter == "aggressive") {
+            m_lootFilter->loadAggressiveFilter();
+        } else if (config.lootFilter == "safe") {
+            m_lootFilter->loadSafeFilter();
+        } else if (config.lootFilter == "seasonal") {
+            m_lootFilter->loadSeasonalFilter();
+        } else {
+            m_lootFilter->loadBalancedFilter();
+        }
+        m_lootFilter->setMinimumRarity(LootFilter::parseRarity(config.minimumRarity));
+        m_lootFilter->setMinimumLevel(config.minimumLevel);
+        m_lootFilter->setMinimumValue(config.minimumValue);
+        m_lootFilter->enableSeasonalFilter(config.enableSeasonalLoot);
+        
+        // Rules recompile on the next filter pass; items rejected under the old ones get another look
+        m_lootFilter->clearRejectedItems();
+    }
+    
+    if (changed(&BotConfig::engagementRange)) {
+        m_combat->setEngagementRange(config.engagementRange);
+    }
+    if (changed(&BotConfig::retreatHealthPercent)) {
+        m_combat->setRetreatHealthPercent(config.retreatHealthPercent);
+    }
+    if (changed(&BotConfig::healHealthPercent)) {
+        m_combat->setHealHealthPercent(config.healHealthPercent);
+    }
+    if (changed(&BotConfig::combatTactics)) {
+        m_combat->setTacticsMode(parseTactics(config.combatTactics));
+    }
+    if (changed(&BotConfig::farmMode)) {
+        setFarmMode(config.farmMode == "aggressive" ? FarmMode::AGGRESSIVE :
+                    config.farmMode == "safe" ? FarmMode::SAFE : FarmMode::BALANCED);
+    }
+    
+    // Read-side and file settings are wired up once in initialize()
+    if (previous) {
+        const std::pair<const char*, bool> restartOnly[] = {
+            {"enablePageCache", changed(&BotConfig::enablePageCache)},
+            {"updateRadius", changed(&BotConfig::updateRadius)},
+            {"signatureCacheFile", changed(&BotConfig::signatureCacheFile)},
+            {"offsetCacheFile", changed(&BotConfig::offsetCacheFile)},
+            {"chromeTraceFile", changed(&BotConfig::chromeTraceFile)},
+            {"snapshotRecordFile", changed(&BotConfig::snapshotRecordFile)},
+        };
+        for (const auto& [setting, settingChanged] : restartOnly) {
+            if (settingChanged) {
+                m_logger->warning("Changed setting %s takes effect after a restart", setting);
+            }
+        }
+    }
+}
+
 void TorchlightBot::handleFarming() {
     // Check if player is alive
     if (!m_gameState->isPlayerAlive()) {
         m_logger->warning("Player is dead, waiting for respawn");
         std::this_thread::sleep_for(std::chrono::seconds(5));
+        m_tickScheduler->reset();
         return;
     }
     
-    // Check for nearby enemies
-    if (m_entityManager->hasNearbyEnemies(
-            m_gameState->getPlayer().x, 
-            m_gameState->getPlayer().y, 
-            m_combat->getEngagementRange())) {
+    // Check for nearby enemies (early-exit grid queries, nothing is copied)
+    if (m_entityManager->anyOf(EntityManager::ENEMY_TYPES, m_combat->getEngagementRange(), 
+                               EntityStore::FLAG_ALIVE)) {
         setState(BotState::COMBAT);
         return;
     }
     
     // Check for nearby loot
-    if (m_entityManager->hasLootableItems(
-            m_gameState->getPlayer().x, 
-            m_gameState->getPlayer().y)) {
+    if (m_entityManager->anyOf(entityTypeBit(EntityType::ITEM), 10.0f)) {
         setState(BotState::LOOTING);
         return;
     }
     
     // Check for seasonal activities
-    if (m_gameState->hasActiveSeason()) {
-        auto seasonalObjects = m_entityManager->findSeasonalObjects();
-        if (!seasonalObjects.empty()) {
-            setState(BotState::SEASONAL_ACTIVITY);
-            return;
-        }
+    if (m_gameState->hasActiveSeason() && !m_entityManager->seasonalObjects().empty()) {
+        setState(BotState::SEASONAL_ACTIVITY);
+        return;
     }
     
     // Check if map is completed
@@ -275,33 +582,81 @@ void TorchlightBot::handleCombat() {
 }
 
 void TorchlightBot::handleLooting() {
-    auto nearbyItems = m_entityManager->getLootableItems();
+    EntityRange nearbyItems = m_entityManager->lootableItems();
     
     if (nearbyItems.empty()) {
         setState(BotState::FARMING);
         return;
     }
     
-        // Convert entities to loot filter items
-        std::vector<LootFilter::ItemInfo> items;
-        for (const auto& entity : nearbyItems) {
-            LootFilter::ItemInfo item;
-            item.name = entity.name;
-            item.type = static_cast<LootFilter::ItemType>(entity.data.item.itemType == "weapon" ? 1 : 2);
-            item.rarity = static_cast<LootFilter::ItemRarity>(entity.data.item.rarity);
-            item.x = entity.x;
-            item.y = entity.y;
-            item.z = entity.z;
-            items.push_back(item);
-        }    // Filter and prioritize items
-    auto filteredItems = m_lootFilter->filterItems(items);
-    auto prioritizedItems = m_lootFilter->prioritizeItems(filteredItems);
-    
-    // Pick up items in priority order
-    for (const auto& item : prioritizedItems) {
-        if (item.shouldLoot) {
-            m_logger->info("Looting item: %s", item.name.c_str());
-            // TODO: Implement actual item pickup via InputManager
+    // Convert entity views to loot filter items; items rejected earlier stay
+    // rejected until they despawn, so they are not rebuilt and re-filtered
+    static const SymbolId WEAPON = SymbolTable::global().intern("weapon");
+    std::vector<LootFilter::ItemInfo> items;
+    items.reserve(nearbyItems.count());
+    for (EntityView entity : nearbyItems) {
+        if (m_lootFilter->isRejected(entity.id())) {
+            continue;
+        }
+        
+        const Entity::TypeData& data = entity.data();
+        LootFilter::ItemInfo item;
+        item.entityId = entity.id();
+        item.name = entity.nameId();
+        item.type = data.item.itemType == WEAPON ? LootFilter::ItemType::WEAPON : LootFilter::ItemType::ARMOR;
+        item.rarity = static_cast<LootFilter::ItemRarity>(data.item.rarity);
+        item.x = entity.x();
+        item.y = entity.y();
+        item.z = entity.z();
+        items.push_back(item);
+    }
+    
+    // Filter and prioritize items
+    std::vector<LootFilter::ItemInfo> filteredItems;
+    {
+        ProfileScope scope(m_profiler.get(), m_lootFilterZone);
+        filteredItems = m_lootFilter->filterItems(items);
+    }
+    for (const auto& item : items) {
+        bool accepted = std::any_of(filteredItems.begin(), filteredItems.end(), [&](const auto& kept) {
+            return kept.entityId == item.entityId && kept.shouldLoot;
+        });
+        if (!accepted) {
+            m_lootFilter->rejectItem(item.entityId);
+        }
+    }
+    
+    // Pick up items along a short route; the previous route is kept and new drops are inserted into it
+    std::vector<LootRoutePlanner::Stop> stops;
+    stops.reserve(filteredItems.size());
+    for (const auto& item : filteredItems) {
+        stops.push_back({item.entityId, item.x, item.y, item.priority});
+    }
+    
+    const GameState::PlayerData& player = m_gameState->getPlayer();
+    const std::vector<LootRoutePlanner::Stop>* route;
+    {
+        ProfileScope scope(m_profiler.get(), m_lootRouteZone);
+        route = &m_lootRoute->plan(player.x, player.y, stops, [this](float ax, float ay, float bx, float by) {
+            return m_navigation->isPathClear({ax, ay}, {bx, by});
+        });
+    }
+    
+    // One pickup per tick; the stop stays on the route until its item despawns, and
+    // a click still in flight is not repeated until PICKUP_RETRY has passed
+    if (!route->empty()) {
+        const LootRoutePlanner::Stop& stop = route->front();
+        auto now = std::chrono::steady_clock::now();
+        if (stop.id != m_pendingPickup || now - m_pickupSentAt >= PICKUP_RETRY) {
+            auto item = std::find_if(filteredItems.begin(), filteredItems.end(),
+                                     [&](const auto& candidate) { return candidate.entityId == stop.id; });
+            if (item != filteredItems.end()) {
+                TL_LOG_INFO(*m_logger, "Looting item: %s", SymbolTable::global().name(item->name));
+            }
+            
+            m_inputManager->pickupItem(stop.x, stop.y);
+            m_pendingPickup = stop.id;
+            m_pickupSentAt = now;
         }
     }
     
@@ -309,7 +664,10 @@ void TorchlightBot::handleLooting() {
 }
 
 void TorchlightBot::handleNavigation() {
-    m_navigation->update();
+    {
+        ProfileScope scope(m_profiler.get(), m_navigationZone);
+        m_navigation->update();
+    }
     
     if (m_navigation->hasReachedGoal() || !m_navigation->isNavigating()) {
         setState(BotState::FARMING);
@@ -317,6 +675,7 @@ void TorchlightBot::handleNavigation() {
 }
 
 void TorchlightBot::handleBossFight() {
+    m_combat->update();
     m_combat->handleBossCombat();
     
     if (!m_combat->isFightingBoss()) {
@@ -325,68 +684,179 @@ void TorchlightBot::handleBossFight() {
 }
 
 void TorchlightBot::handleSeasonalActivity() {
-    auto seasonalObjects = m_entityManager->findSeasonalObjects();
+    const auto& player = m_gameState->getPlayer();
+    auto nearestObject = m_entityManager->nearestOf(entityTypeBit(EntityType::SEASONAL_OBJECT), player.x, player.y);
     
-    if (seasonalObjects.empty()) {
+    if (!nearestObject) {
         setState(BotState::FARMING);
         return;
     }
     
     // Navigate to nearest seasonal object
-    auto nearestObject = seasonalObjects[0];
-    m_navigation->navigateTo({nearestObject.x, nearestObject.y});
+    m_navigation->navigateTo({nearestObject->x(), nearestObject->y()});
     
     setState(BotState::NAVIGATING);
 }
 
 void TorchlightBot::handleError() {
-    m_logger->error("Bot is in error state, attempting recovery");
+    // Still attached: a failed tick, not a lost client
+    if (isProcessAlive()) {
+        setState(BotState::FARMING);
+        return;
+    }
+    
+    m_logger->error("Game process lost, waiting for the client to restart");
+    auto lostAt = std::chrono::steady_clock::now();
+    
+    // The reader thread uses the process handle, so park it while re-attaching
+    m_snapshotReader->stop();
+    m_watcher->unwatch();
+    m_process->detach();
     
-    // Try to re-attach to game
-    if (!isGameValid()) {
-        if (attachToGame()) {
-            m_logger->info("Successfully re-attached to game");
+    while (m_running) {
+        // Returns early on stop(), so the loop condition is re-checked promptly
+        if (!m_process->isAttached() && !m_watcher->waitForStart(*m_process, std::chrono::seconds(1))) {
+            continue;
+        }
+        
+        if (warmRestart()) {
+            int64_t downtimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - lostAt).count();
+            m_gameRestarts++;
+            m_lastDowntimeMs = downtimeMs;
+            TL_LOG_INFO(*m_logger, "Re-attached to %s after %lld ms", 
+                        m_process->getProcessName().c_str(), static_cast<long long>(downtimeMs));
+            
+            m_snapshotReader->start(m_snapshotInterval);
             setState(BotState::FARMING);
-        } else {
-            m_logger->error("Failed to re-attach to game, retrying in 10 seconds");
-            std::this_thread::sleep_for(std::chrono::seconds(10));
+            return;
         }
-    } else {
-        setState(BotState::FARMING);
+        
+        // A client that just started may not have loaded its module yet
+        m_watcher->wait(m_watcher->getScanInterval());
     }
 }
 
 bool TorchlightBot::attachToGame() {
-    // Try common Torchlight Infinity process names
-    std::vector<std::string> processNames = {
-        "Torchlight3.exe",
-        "TorchlightInfinity.exe", 
-        "TL3.exe",
-        "Game.exe"
-    };
+    // One process list walk for all of the client's names
+    if (!m_process->attachToProcess(GAME_PROCESS_NAMES)) {
+        m_logger->error("Could not find Torchlight Infinity process");
+        return false;
+    }
     
-    for (const auto& processName : processNames) {
-        if (m_process->attachToProcess(processName)) {
-            m_logger->info("Successfully attached to process: %s", processName.c_str());
-            return true;
+    m_logger->info("Successfully attached to process: %s", m_process->getProcessName().c_str());
+    if (!m_watcher->watch(*m_process)) {
+        m_logger->warning("Cannot wait on the game process, client exits are detected by polling");
+    }
+    return true;
+}
+
+bool TorchlightBot::discoverAddresses(GameState& gameState, EntityManager& entityManager) {
+    // Addresses discovered for this game build are cached on disk; the module
+    // is only copied and scanned when a signature is not in the cache
+    const auto& botConfig = m_config->getConfig();
+    ModuleBuildId buildId;
+    uintptr_t moduleBase = 0;
+    size_t moduleSize = 0;
+    
+    if (m_process->getModuleInfo(m_process->getProcessName(), moduleBase, moduleSize)) {
+        m_scanner->setModule(moduleBase, moduleSize);
+    } else {
+        m_logger->warning("Could not query game module, signature scanning disabled");
+    }
+    
+    // After a client restart the caches are already loaded unless a patch changed the build
+    if (m_process->getModuleBuildId(m_process->getProcessName(), buildId) && !botConfig.signatureCacheFile.empty()) {
+        if (!m_signatureCache) {
+            m_signatureCache = std::make_unique<SignatureCache>(botConfig.signatureCacheFile);
+            m_scanner->setSignatureCache(m_signatureCache.get());
+        }
+        if (m_signatureCache->getBuildId() != buildId && m_signatureCache->load(buildId)) {
+            m_logger->info("Loaded " + std::to_string(m_signatureCache->getEntryCount()) + 
+                           " cached signatures for this game build");
         }
     }
     
-    m_logger->error("Could not find Torchlight Infinity process");
-    return false;
+    if (buildId.isValid() && buildId != m_offsetBuildId && !botConfig.offsetCacheFile.empty()) {
+        OffsetManager* offsets = gameState.getOffsetManager();
+        if (offsets->loadOffsetsFromFile(botConfig.offsetCacheFile, buildId)) {
+            m_logger->info("Loaded offsets for this game build from " + botConfig.offsetCacheFile);
+        } else if (!offsets->saveOffsetsToFile(botConfig.offsetCacheFile, buildId)) {
+            m_logger->warning("Could not write offset cache " + botConfig.offsetCacheFile);
+        }
+        m_offsetBuildId = buildId;
+    }
+    
+    if (!gameState.findGameAddresses()) {
+        m_logger->error("Failed to find game memory addresses");
+        m_scanner->releaseModule();
+        return false;
+    }
+    double scanTimeMs = m_scanner->getLastScanTimeMs();
+    
+    if (!entityManager.findEntityList()) {
+        m_logger->warning("Entity list not found, will retry during runtime");
+    }
+    scanTimeMs += m_scanner->getLastScanTimeMs();
+    
+    if (m_scanner->isModuleMapped()) {
+        m_logger->info("Signature scan finished in " + std::to_string(scanTimeMs) + " ms");
+        m_scanner->releaseModule(); // The image is only needed during address discovery
+    }
+    
+    if (m_signatureCache && !m_signatureCache->save()) {
+        m_logger->warning("Could not write signature cache " + botConfig.signatureCacheFile);
+    }
+    return true;
+}
+
+bool TorchlightBot::warmRestart() {
+    // Without the module there is nothing to resolve against yet; retried shortly
+    if (m_process->getModuleBaseAddress(m_process->getProcessName()) == 0) {
+        return false;
+    }
+    
+    // Cached pages belong to the old process; everything else (navigation
+    // caches, loot and combat state, statistics) carries over as is
+    m_memory->invalidatePageCache();
+    
+    GameState& gameState = *m_snapshotReader->getGameState();
+    EntityManager& entityManager = *m_snapshotReader->getEntityManager();
+    if (!discoverAddresses(gameState, entityManager)) {
+        return false;
+    }
+    entityManager.clearEntities();
+    
+    if (!m_watcher->watch(*m_process)) {
+        m_logger->warning("Cannot wait on the game process, client exits are detected by polling");
+    }
+    return true;
+}
+
+bool TorchlightBot::isProcessAlive() const {
+    // The watcher's flag saves a system call per tick
+    if (m_watcher->isWatching()) {
+        return !m_watcher->hasExited();
+    }
+    return m_process->isAttached();
 }
 
 void TorchlightBot::updateGameState() {
-    if (m_gameState) {
-        m_gameState->update();
+    if (!m_snapshotReader) {
+        return;
     }
     
-    if (m_entityManager) {
-        m_entityManager->update();
+    // Nothing new published: keep deciding on the previous snapshot
+    const WorldSnapshot* snapshot = m_snapshotReader->acquireLatest();
+    if (!snapshot) {
+        return;
     }
+    
+    m_gameState->applySnapshot(*snapshot);
+    m_entityManager->applySnapshot(*snapshot);
 }
 
 bool TorchlightBot::isGameValid() const {
-    return m_process && m_process->isAttached() && 
+    return m_process && isProcessAlive() && 
            m_gameState && m_gameState->isPlayerAlive();
 }
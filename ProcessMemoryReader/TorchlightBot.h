@@ -2,6 +2,8 @@
 
 #include "Process.h"
 #include "Memory.h"
+#include "Profiler.h"
+#include "ConfigManager.h"
 #include <memory>
 #include <atomic>
 #include <thread>
@@ -16,10 +18,17 @@
 class GameState;
 class NavigationSystem;
 class LootFilter;
+class LootRoutePlanner;
 class CombatSystem;
 class EntityManager;
 class Logger;
-class ConfigManager;
+class PatternScanner;
+class ProcessWatcher;
+class SignatureCache;
+class SnapshotReader;
+class SnapshotRecorder;
+class TickScheduler;
+class InputManager;
 
 /**
  * @brief Main bot class that orchestrates all subsystems
@@ -45,21 +54,51 @@ public:
 
 private:
     std::unique_ptr<Process> m_process;
+    std::unique_ptr<ProcessWatcher> m_watcher;         // Client exit/restart detection
     std::unique_ptr<Memory> m_memory;
+    std::unique_ptr<PatternScanner> m_scanner;
+    std::unique_ptr<SignatureCache> m_signatureCache;
+    ModuleBuildId m_offsetBuildId;                     // Build the offset cache was loaded for
+    std::unique_ptr<SnapshotRecorder> m_recorder;      // Optional; written by the reader thread
+    std::unique_ptr<SnapshotReader> m_snapshotReader;  // Owns the memory-reading GameState/EntityManager
     std::unique_ptr<GameState> m_gameState;
+    std::unique_ptr<InputManager> m_inputManager;      // Outlives the systems holding raw pointers to it
     std::unique_ptr<NavigationSystem> m_navigation;
     std::unique_ptr<LootFilter> m_lootFilter;
+    std::unique_ptr<LootRoutePlanner> m_lootRoute;  // Pickup order, re-planned incrementally as items drop
+    uint64_t m_pendingPickup = 0;                   // Stop clicked last; stays on the route until it despawns
+    std::chrono::steady_clock::time_point m_pickupSentAt;
+    static constexpr std::chrono::milliseconds PICKUP_RETRY{1000};  // Click a pending stop again after this
     std::unique_ptr<CombatSystem> m_combat;
     std::unique_ptr<EntityManager> m_entityManager;
     std::unique_ptr<Logger> m_logger;
     std::unique_ptr<ConfigManager> m_config;
+    std::shared_ptr<const ConfigManager::BotConfig> m_activeConfig;  // Settings the subsystems run with
+    uint64_t m_configVersion = 0;
 
     std::atomic<bool> m_running{false};
     std::atomic<BotState> m_currentState{BotState::IDLE};
     std::thread m_botThread;
+    std::unique_ptr<TickScheduler> m_tickScheduler;
+    
+    // Profiling: one zone per decision tick, per state handler and per costly call
+    std::unique_ptr<Profiler> m_profiler;
+    Profiler::ZoneId m_tickZone = Profiler::INVALID_ZONE;
+    Profiler::ZoneId m_stateZones[8];   // Indexed by BotState
+    Profiler::ZoneId m_lootFilterZone = Profiler::INVALID_ZONE;
+    Profiler::ZoneId m_lootRouteZone = Profiler::INVALID_ZONE;
+    Profiler::ZoneId m_navigationZone = Profiler::INVALID_ZONE;
+    std::chrono::seconds m_profileDumpInterval{60};
     
     FarmMode m_farmMode{FarmMode::BALANCED};
     std::chrono::milliseconds m_tickRate{50}; // 20 FPS
+    std::chrono::milliseconds m_combatTickRate{25};      // COMBAT and BOSS_FIGHT
+    std::chrono::milliseconds m_navigationTickRate{100};
+    std::chrono::milliseconds m_idleTickRate{250};
+    std::chrono::milliseconds m_snapshotInterval{16}; // Reader thread cadence
+    std::atomic<uint64_t> m_decisionTicks{0};
+    std::atomic<uint64_t> m_gameRestarts{0};
+    std::atomic<int64_t> m_lastDowntimeMs{0};
 
 public:
     TorchlightBot();
@@ -87,12 +126,41 @@ public:
         uint64_t itemsLooted = 0;
         uint64_t bossesKilled = 0;
         std::chrono::seconds runtime{0};
+        
+        // Read and decision rates are measured separately
+        uint64_t snapshotsRead = 0;
+        uint64_t decisionTicks = 0;
+        double averageReadMs = 0.0;
+        
+        // Client restarts recovered by re-attaching, and how long the last one took
+        uint64_t gameRestarts = 0;
+        int64_t lastDowntimeMs = 0;
+        
+        // Decision loop timing
+        uint64_t tickOverruns = 0;
+        uint64_t missedTicks = 0;
+        double averageTickJitterMs = 0.0;
+        double maxTickJitterMs = 0.0;
+        
+        // Profiler zones (p50/p99/max) and memory read counters
+        std::vector<Profiler::ZoneStatistics> profileZones;
+        uint64_t memoryReadCalls = 0;
+        uint64_t bytesRead = 0;
+        uint64_t failedReads = 0;
+        uint64_t pageCacheHits = 0;
+        uint64_t pageCacheMisses = 0;
     };
     
     Statistics getStatistics() const;
 
 private:
     void botMainLoop();
+    std::chrono::milliseconds getTickRate(BotState state) const;
+    void runTick();
+    void dumpProfile();
+    void checkConfigReload();    // Tick boundary: apply a newly published config snapshot
+    void applyConfig(const ConfigManager::BotConfig& config, const ConfigManager::BotConfig* previous);
+    void applyLoggingConfig(const ConfigManager::BotConfig& config);
     void handleFarming();
     void handleCombat();
     void handleLooting();
@@ -102,6 +170,9 @@ private:
     void handleError();
     
     bool attachToGame();
-    void updateGameState();
+    bool discoverAddresses(GameState& gameState, EntityManager& entityManager);
+    bool warmRestart();          // Re-discover addresses in a restarted client, keeping all other state
+    bool isProcessAlive() const;
+    void updateGameState();      // Apply the latest snapshot from the reader thread
     bool isGameValid() const;
 };
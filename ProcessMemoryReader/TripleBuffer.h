@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TripleBuffer
+ * @brief Lock-free single-producer/single-consumer "latest value" exchange
+ *
+ * The producer fills writeSlot() and publish()es it; the consumer acquire()s
+ * the most recently published slot and reads it through readSlot(). Three
+ * slots mean neither side ever waits: the writer always has a free slot and
+ * the reader's slot is never touched by the writer. Intermediate values that
+ * the consumer did not pick up are simply overwritten.
+ *
+ * Slots are reused, so containers inside T keep their capacity between publishes.
+ */
+template<typename T>
+class TripleBuffer {
+public:
+    /**
+     * @brief Slot the producer may fill (producer thread only)
+     */
+    T& writeSlot() { return m_slots[m_writeIndex]; }
+
+    /**
+     * @brief Make the current write slot the latest value (producer thread only)
+     */
+    void publish() {
+        uint8_t previous = m_shared.exchange(static_cast<uint8_t>(m_writeIndex | FRESH), std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Take the latest published value if there is one (consumer thread only)
+     * @return true if readSlot() now holds a value that was not seen before
+     */
+    bool acquire() {
+        if ((m_shared.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        uint8_t previous = m_shared.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Slot acquired last (consumer thread only, valid until the next acquire())
+     */
+    const T& readSlot() const { return m_slots[m_readIndex]; }
+
+    /**
+     * @brief Whether a value was published that the consumer has not acquired yet
+     */
+    bool hasFresh() const { return (m_shared.load(std::memory_order_relaxed) & FRESH) != 0; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH = 0x4;  // Set while the shared slot holds an unread value
+
+    std::array<T, 3> m_slots{};
+    std::atomic<uint8_t> m_shared{1};  // Slot exchanged between producer and consumer
+    uint8_t m_writeIndex = 0;          // Owned by the producer
+    uint8_t m_readIndex = 2;           // Owned by the consumer
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "GameState.h"
+#include "EntityStore.h"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Immutable copy of the game world captured in one read pass
+ *
+ * Produced by SnapshotReader on the reader thread and handed to the decision
+ * loop through a TripleBuffer; once published a snapshot is never modified.
+ */
+struct WorldSnapshot {
+    uint64_t sequence = 0;                                   // 0 = nothing captured yet
+    std::chrono::steady_clock::time_point captureTime;       // When the read pass started
+    std::chrono::microseconds readDuration{0};               // How long the read pass took
+    bool complete = false;                                   // All reads of this pass succeeded
+
+    GameState::PlayerData player{};
+    GameState::MapData map{};
+    GameState::SeasonData season{};
+    EntityStore entities;  // Column copy of the reader's entity table
+};
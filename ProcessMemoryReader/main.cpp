@@ -135,6 +135,25 @@ int main() {
                 if (stats.runtime.count() > 0) {
                     std::cout << "Monsters/Hour: " << (stats.monstersKilled * 3600) / stats.runtime.count() << "\n";
                     std::cout << "Items/Hour: " << (stats.itemsLooted * 3600) / stats.runtime.count() << "\n";
+                    std::cout << "Snapshots/s: " << stats.snapshotsRead / stats.runtime.count() << "\n";
+                    std::cout << "Decision Ticks/s: " << stats.decisionTicks / stats.runtime.count() << "\n";
+                }
+                std::cout << "Average Read Pass: " << stats.averageReadMs << " ms\n";
+                std::cout << "Tick Jitter: avg " << stats.averageTickJitterMs << " ms, max " 
+                          << stats.maxTickJitterMs << " ms\n";
+                std::cout << "Tick Overruns: " << stats.tickOverruns << " (" << stats.missedTicks << " ticks missed)\n";
+                std::cout << "Memory Reads: " << stats.memoryReadCalls << " calls, " << stats.bytesRead << " bytes, "
+                          << stats.failedReads << " failed\n";
+                std::cout << "Page Cache: " << stats.pageCacheHits << " hits, " << stats.pageCacheMisses << " misses\n";
+                std::cout << "Client Restarts: " << stats.gameRestarts << " (last downtime " 
+                          << stats.lastDowntimeMs << " ms)\n";
+                
+                if (!stats.profileZones.empty()) {
+                    std::cout << "\n=== Profile (ms) ===\n";
+                    for (const auto& zone : stats.profileZones) {
+                        std::cout << zone.name << ": n=" << zone.count << " p50=" << zone.p50Ms 
+                                  << " p99=" << zone.p99Ms << " max=" << zone.maxMs << "\n";
+                    }
                 }
                 break;
             }